@@ -317,6 +317,10 @@ void Environment::printCompilationConfig() {
   OATPP_LOGd("oatpp/Config", "OATPP_DISABLE_ENV_OBJECT_COUNTERS")
 #endif
 
+#ifdef OATPP_DISABLE_POOL_ALLOCATIONS
+  OATPP_LOGd("oatpp/Config", "OATPP_DISABLE_POOL_ALLOCATIONS")
+#endif
+
 #ifdef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
   OATPP_LOGd("oatpp/Config", "OATPP_COMPAT_BUILD_NO_THREAD_LOCAL")
 #endif
@@ -29,6 +29,7 @@
 #include "./Error.hpp"
 
 #include "oatpp/async/utils/FastQueue.hpp"
+#include "oatpp/async/utils/FramePool.hpp"
 
 #include "oatpp/IODefinitions.hpp"
 #include "oatpp/Environment.hpp"
@@ -432,6 +433,14 @@ public:
   CoroutineHandle(Processor* processor, AbstractCoroutine* rootCoroutine);
   ~CoroutineHandle() override;
 
+  static void* operator new(std::size_t sz) {
+    return utils::FramePool::allocate(sz);
+  }
+
+  static void operator delete(void* ptr, std::size_t sz) {
+    utils::FramePool::deallocate(ptr, sz);
+  }
+
   Action takeAction(Action&& action);
   Action iterate();
   Action iterateAndTakeAction();
@@ -457,6 +466,16 @@ public:
 
   template<typename ...Args>
   class AbstractMemberCaller {
+  public:
+
+    static void* operator new(std::size_t sz) {
+      return utils::FramePool::allocate(sz);
+    }
+
+    static void operator delete(void* ptr, std::size_t sz) {
+      utils::FramePool::deallocate(ptr, sz);
+    }
+
   public:
     virtual ~AbstractMemberCaller() = default;
     virtual Action call(AbstractCoroutine* coroutine, const Args&... args) = 0;
@@ -598,12 +617,11 @@ public:
 public:
 
   static void* operator new(std::size_t sz) {
-    return ::operator new(sz);
+    return utils::FramePool::allocate(sz);
   }
 
   static void operator delete(void* ptr, std::size_t sz) {
-    (void)sz;
-    ::operator delete(ptr);
+    utils::FramePool::deallocate(ptr, sz);
   }
 
 public:
@@ -754,12 +772,11 @@ public:
 public:
 
   static void* operator new(std::size_t sz) {
-    return ::operator new(sz);
+    return utils::FramePool::allocate(sz);
   }
 
   static void operator delete(void* ptr, std::size_t sz) {
-    (void)sz;
-    ::operator delete(ptr);
+    utils::FramePool::deallocate(ptr, sz);
   }
 public:
 
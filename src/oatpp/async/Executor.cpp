@@ -25,20 +25,25 @@
 #include "Executor.hpp"
 
 #include "oatpp/async/worker/IOEventWorker.hpp"
+#include "oatpp/async/worker/IOUringWorker.hpp"
 #include "oatpp/async/worker/IOWorker.hpp"
 #include "oatpp/async/worker/TimerWorker.hpp"
 
 #include "oatpp/concurrency/Utils.hpp"
+#include "oatpp/base/Log.hpp"
 
 namespace oatpp { namespace async {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Executor::SubmissionProcessor
 
-Executor::SubmissionProcessor::SubmissionProcessor()
+Executor::SubmissionProcessor::SubmissionProcessor(const std::shared_ptr<Processor::StealingGroup>& stealingGroup)
   : worker::Worker(worker::Worker::Type::PROCESSOR)
   , m_isRunning(true)
 {
+  if(stealingGroup) {
+    m_processor.setStealingGroup(stealingGroup);
+  }
   m_thread = std::thread(&Executor::SubmissionProcessor::run, this);
 }
 
@@ -87,7 +92,11 @@ void Executor::SubmissionProcessor::detach() {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Executor
 
-Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int32 timerWorkersCount, v_int32 ioWorkerType)
+Executor::Executor(v_int32 processorWorkersCount,
+                   v_int32 ioWorkersCount,
+                   v_int32 timerWorkersCount,
+                   v_int32 ioWorkerType,
+                   bool workStealing)
   : m_balancer(0)
 {
 
@@ -96,8 +105,13 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
   timerWorkersCount = chooseTimerWorkersCount(timerWorkersCount);
   ioWorkerType = chooseIOWorkerType(ioWorkerType);
 
+  std::shared_ptr<Processor::StealingGroup> stealingGroup;
+  if(workStealing && processorWorkersCount > 1) {
+    stealingGroup = std::make_shared<Processor::StealingGroup>();
+  }
+
   for(v_int32 i = 0; i < processorWorkersCount; i ++) {
-    m_processorWorkers.push_back(std::make_shared<SubmissionProcessor>());
+    m_processorWorkers.push_back(std::make_shared<SubmissionProcessor>(stealingGroup));
   }
 
   m_allWorkers.insert(m_allWorkers.end(), m_processorWorkers.begin(), m_processorWorkers.end());
@@ -120,6 +134,13 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
       break;
     }
 
+    case IO_WORKER_TYPE_URING: {
+      for (v_int32 i = 0; i < ioWorkersCount; i++) {
+        ioWorkers.push_back(std::make_shared<worker::IOUringWorker>());
+      }
+      break;
+    }
+
     default:
       throw std::runtime_error("[oatpp::async::Executor::Executor()]: Error. Unknown IO worker type.");
 
@@ -181,6 +202,11 @@ v_int32 Executor::chooseIOWorkerType(v_int32 ioWorkerType) {
 #endif
   }
 
+  if(ioWorkerType == IO_WORKER_TYPE_URING && !worker::IOUringWorker::isSupported()) {
+    OATPP_LOGw("[oatpp::async::Executor::chooseIOWorkerType()]", "io_uring is not supported by the system - falling back to the default I/O worker type.")
+    return chooseIOWorkerType(VALUE_SUGGESTED);
+  }
+
   return ioWorkerType;
 
 }
@@ -254,6 +280,19 @@ v_int32 Executor::getTasksCount() {
 
 }
 
+std::vector<Processor::Stats> Executor::getProcessorsStats() {
+
+  std::vector<Processor::Stats> result;
+  result.reserve(m_processorWorkers.size());
+
+  for(const auto& procWorker : m_processorWorkers) {
+    result.push_back(procWorker->getProcessor().getStats());
+  }
+
+  return result;
+
+}
+
 void Executor::waitTasksFinished(const std::chrono::duration<v_int64, std::micro>& timeout) {
 
   auto startTime = std::chrono::system_clock::now();
@@ -53,7 +53,7 @@ private:
   private:
     std::thread m_thread;
   public:
-    SubmissionProcessor();
+    SubmissionProcessor(const std::shared_ptr<Processor::StealingGroup>& stealingGroup);
     ~SubmissionProcessor() override {
       stop();
       join();
@@ -97,6 +97,12 @@ public:
    * IO Worker type event.
    */
   static constexpr const v_int32 IO_WORKER_TYPE_EVENT = 1;
+
+  /**
+   * IO Worker type io_uring - &id:oatpp::async::worker::IOUringWorker;. <br>
+   * Falls back to &l:Executor::IO_WORKER_TYPE_EVENT; if `io_uring` is not supported by the system.
+   */
+  static constexpr const v_int32 IO_WORKER_TYPE_URING = 2;
 private:
   std::atomic<v_uint32> m_balancer;
 private:
@@ -115,12 +121,15 @@ public:
    * @param processorWorkersCount - number of data processing workers.
    * @param ioWorkersCount - number of I/O processing workers.
    * @param timerWorkersCount - number of timer processing workers.
-   * @param IOWorkerType
+   * @param ioWorkerType - one of &l:Executor::IO_WORKER_TYPE_NAIVE;, &l:Executor::IO_WORKER_TYPE_EVENT;, &l:Executor::IO_WORKER_TYPE_URING;.
+   * @param workStealing - if `true` idle data processing workers take ready coroutines from the busy ones.
+   * See &id:oatpp::async::Processor::StealingGroup;.
    */
   Executor(v_int32 processorWorkersCount = VALUE_SUGGESTED,
            v_int32 ioWorkersCount = VALUE_SUGGESTED,
            v_int32 timerWorkersCount = VALUE_SUGGESTED,
-           v_int32 ioWorkerType = VALUE_SUGGESTED);
+           v_int32 ioWorkerType = VALUE_SUGGESTED,
+           bool workStealing = true);
 
   /**
    * Non-virtual Destructor.
@@ -161,6 +170,12 @@ public:
    */
   v_int32 getTasksCount();
 
+  /**
+   * Get statistics of data processing workers - one entry per worker.
+   * @return - `std::vector` of &id:oatpp::async::Processor::Stats;.
+   */
+  std::vector<Processor::Stats> getProcessorsStats();
+
   /**
    * Wait until all tasks are finished.
    * @param timeout
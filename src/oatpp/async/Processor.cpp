@@ -29,6 +29,39 @@
 
 namespace oatpp { namespace async {
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Processor::StealingGroup
+
+void Processor::StealingGroup::addIdle(Processor* processor) {
+  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_lock);
+  m_idleProcessors.push_back(processor);
+  m_idleCount = static_cast<v_int32>(m_idleProcessors.size());
+}
+
+void Processor::StealingGroup::removeIdle(Processor* processor) {
+  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_lock);
+  for(auto it = m_idleProcessors.begin(); it != m_idleProcessors.end(); it++) {
+    if(*it == processor) {
+      m_idleProcessors.erase(it);
+      break;
+    }
+  }
+  m_idleCount = static_cast<v_int32>(m_idleProcessors.size());
+}
+
+Processor* Processor::StealingGroup::popIdle() {
+  if(m_idleProcessors.empty()) {
+    return nullptr;
+  }
+  auto processor = m_idleProcessors.back();
+  m_idleProcessors.pop_back();
+  m_idleCount = static_cast<v_int32>(m_idleProcessors.size());
+  return processor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Processor
+
 void Processor::addWorker(const std::shared_ptr<worker::Worker>& worker) {
 
   switch(worker->getType()) {
@@ -52,6 +85,10 @@ void Processor::addWorker(const std::shared_ptr<worker::Worker>& worker) {
 
 }
 
+void Processor::setStealingGroup(const std::shared_ptr<StealingGroup>& group) {
+  m_stealingGroup = group;
+}
+
 void Processor::popIOTask(CoroutineHandle* coroutine) {
   if(m_ioPopQueues.size() > 0) {
     auto &queue = m_ioPopQueues[(++m_ioBalancer) % m_ioPopQueues.size()];
@@ -130,11 +167,73 @@ void Processor::pushTasks(utils::FastQueue<CoroutineHandle>& tasks) {
 
 void Processor::waitForTasks() {
 
-  std::unique_lock<oatpp::concurrency::SpinLock> lock(m_taskLock);
-  while (m_pushList.first == nullptr && m_taskList.empty() && m_running) {
-    m_taskCondition.wait(lock);
+  if(m_stealingGroup) {
+    m_stealingGroup->addIdle(this);
+  }
+
+  {
+    std::unique_lock<oatpp::concurrency::SpinLock> lock(m_taskLock);
+    while (m_pushList.first == nullptr && m_stolenList.first == nullptr && m_taskList.empty() && m_running) {
+      v_int64 timeout = m_sleepNextTimeout.load(std::memory_order_relaxed);
+      if(timeout == NO_TIMEOUT) {
+        m_taskCondition.wait(lock);
+      } else if(timeout > oatpp::Environment::getMicroTickCount()) {
+        m_taskCondition.wait_until(lock, std::chrono::system_clock::time_point(std::chrono::microseconds(timeout)));
+      } else {
+        break;
+      }
+    }
+  }
+
+  /* once removed from the group no other processor can hand tasks over to this one */
+  if(m_stealingGroup) {
+    m_stealingGroup->removeIdle(this);
+  }
+
+}
+
+void Processor::acceptStolenTasks(utils::FastQueue<CoroutineHandle>& tasks) {
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_taskLock);
+    utils::FastQueue<CoroutineHandle>::moveAll(tasks, m_stolenList);
+  }
+  m_taskCondition.notify_one();
+}
+
+void Processor::shareTasks() {
+
+  std::lock_guard<oatpp::concurrency::SpinLock> groupLock(m_stealingGroup->m_lock);
+
+  auto thief = m_stealingGroup->popIdle();
+  if(thief == nullptr) {
+    return;
+  }
+
+  /* hand over half of the ready queue - coroutines become owned by the thief so that I/O and timer co-workers return them there */
+  utils::FastQueue<CoroutineHandle> tasks;
+  v_int32 count = m_queue.count / 2;
+  for(v_int32 i = 0; i < count; i++) {
+    auto coroutine = m_queue.popFront();
+    coroutine->_PP = thief;
+    tasks.pushBack(coroutine);
   }
 
+  /* increment thief's counter first so that the total tasks count never drops to zero during the transfer */
+  thief->m_tasksCounter += count;
+  thief->m_stolenTasks += count;
+  thief->acceptStolenTasks(tasks);
+
+  m_tasksCounter -= count;
+  m_givenTasks += count;
+
+}
+
+void Processor::updateQueueDepth() {
+  v_int32 depth = m_queue.count;
+  m_queueDepth.store(depth, std::memory_order_relaxed);
+  if(depth > m_maxQueueDepth.load(std::memory_order_relaxed)) {
+    m_maxQueueDepth.store(depth, std::memory_order_relaxed);
+  }
 }
 
 void Processor::popTasks() {
@@ -168,6 +267,8 @@ void Processor::pushQueues() {
     std::lock_guard<oatpp::concurrency::SpinLock> lock(m_taskLock);
     consumeAllTasks();
     utils::FastQueue<CoroutineHandle>::moveAll(m_pushList, tmpList);
+    /* stolen coroutines are ready for iteration - no action to take */
+    utils::FastQueue<CoroutineHandle>::moveAll(m_stolenList, m_queue);
   }
 
   while(tmpList.first != nullptr) {
@@ -177,61 +278,78 @@ void Processor::pushQueues() {
 }
 
 void Processor::putCoroutineToSleep(CoroutineHandle* ch) {
-  if(ch->_SCH_A.m_data.waitListData.timePointMicroseconds == 0) {
+  v_int64 timePoint = ch->_SCH_A.m_data.waitListData.timePointMicroseconds;
+  if(timePoint != 0) {
     std::lock_guard<std::mutex> lock(m_sleepMutex);
-    m_sleepNoTimeSet.insert(ch);
-  } else {
-    std::lock_guard<std::mutex> lock(m_sleepMutex);
-    m_sleepTimeSet.insert(ch);
-    m_sleepCV.notify_one();
+    m_sleepTimeSet.insert({timePoint, ch});
+    updateSleepNextTimeout();
   }
 }
 
 void Processor::wakeCoroutine(CoroutineHandle* ch) {
-  if(ch->_SCH_A.m_data.waitListData.timePointMicroseconds == 0) {
-    std::lock_guard<std::mutex> lock(m_sleepMutex);
-    m_sleepNoTimeSet.erase(ch);
-  } else {
+  v_int64 timePoint = ch->_SCH_A.m_data.waitListData.timePointMicroseconds;
+  if(timePoint != 0) {
     std::lock_guard<std::mutex> lock(m_sleepMutex);
-    m_sleepTimeSet.erase(ch);
+    if(m_sleepTimeSet.erase({timePoint, ch}) == 0) {
+      /* timeout has already expired - coroutine is rescheduled by checkCoroutinesSleep() */
+      return;
+    }
+    updateSleepNextTimeout();
   }
   ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
   pushOneTask(ch);
 }
 
+void Processor::updateSleepNextTimeout() {
+  if(m_sleepTimeSet.empty()) {
+    m_sleepNextTimeout.store(NO_TIMEOUT, std::memory_order_relaxed);
+  } else {
+    m_sleepNextTimeout.store(m_sleepTimeSet.begin()->first, std::memory_order_relaxed);
+  }
+}
+
 void Processor::checkCoroutinesSleep() {
-  while (m_running) {
-    {
-      std::unique_lock<std::mutex> lock{m_sleepMutex};
-      while (m_running && m_sleepTimeSet.empty()) {
-        m_sleepCV.wait(lock);
-      }
 
-      auto now = oatpp::Environment::getMicroTickCount();
-      for(auto it = m_sleepTimeSet.begin(); it != m_sleepTimeSet.end();) {
-        auto ch = *it;
-        if(ch->_SCH_A.m_data.waitListData.timePointMicroseconds < now) {
-          it = m_sleepTimeSet.erase(it);
-          ch->_SCH_A.m_data.waitListData.waitList->forgetCoroutine(ch);
-          ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
-          pushOneTask(ch);
-        } else {
-          it ++;
-        }
-      }
+  if(m_sleepNextTimeout.load(std::memory_order_relaxed) == NO_TIMEOUT) {
+    return;
+  }
+
+  auto now = oatpp::Environment::getMicroTickCount();
+  if(m_sleepNextTimeout.load(std::memory_order_relaxed) > now) {
+    return;
+  }
+
+  std::vector<CoroutineHandle*> expired;
 
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    while(!m_sleepTimeSet.empty() && m_sleepTimeSet.begin()->first <= now) {
+      expired.push_back(m_sleepTimeSet.begin()->second);
+      m_sleepTimeSet.erase(m_sleepTimeSet.begin());
     }
+    updateSleepNextTimeout();
+  }
 
-    if(m_running) std::this_thread::sleep_for(std::chrono::milliseconds{100});
+  /* coroutines are removed from the sleep set - concurrent notification of the wait-list won't reschedule them */
+  for(auto ch : expired) {
+    ch->_SCH_A.m_data.waitListData.waitList->forgetCoroutine(ch);
+    ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
+    pushOneTask(ch);
   }
+
 }
 
 bool Processor::iterate(v_int32 numIterations) {
 
+  checkCoroutinesSleep();
   pushQueues();
 
   for(v_int32 i = 0; i < numIterations; i++) {
 
+    if(m_stealingGroup && m_queue.count > 1 && m_stealingGroup->hasIdle()) {
+      shareTasks();
+    }
+
     auto CP = m_queue.first;
     if (CP == nullptr) {
       break;
@@ -273,9 +391,10 @@ bool Processor::iterate(v_int32 numIterations) {
   }
 
   popTasks();
+  updateQueueDepth();
 
   std::lock_guard<oatpp::concurrency::SpinLock> lock(m_taskLock);
-  return m_queue.first != nullptr || m_pushList.first != nullptr || !m_taskList.empty();
+  return m_queue.first != nullptr || m_pushList.first != nullptr || m_stolenList.first != nullptr || !m_taskList.empty();
   
 }
 
@@ -285,14 +404,20 @@ void Processor::stop() {
     m_running = false;
   }
   m_taskCondition.notify_one();
-  m_sleepCV.notify_one();
-
-  m_sleepSetTask.join();
-
 }
 
 v_int32 Processor::getTasksCount() {
   return m_tasksCounter.load();
 }
 
+Processor::Stats Processor::getStats() {
+  Stats stats;
+  stats.queueDepth = m_queueDepth.load(std::memory_order_relaxed);
+  stats.maxQueueDepth = m_maxQueueDepth.load(std::memory_order_relaxed);
+  stats.tasksCount = m_tasksCounter.load();
+  stats.stolenTasks = m_stolenTasks.load();
+  stats.givenTasks = m_givenTasks.load();
+  return stats;
+}
+
 }}
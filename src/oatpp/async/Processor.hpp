@@ -31,8 +31,10 @@
 #include "oatpp/async/utils/FastQueue.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
 
+#include <atomic>
 #include <thread>
 #include <condition_variable>
+#include <limits>
 #include <list>
 #include <mutex>
 #include <set>
@@ -47,6 +49,69 @@ namespace oatpp { namespace async {
  */
 class Processor {
     friend class CoroutineWaitList;
+public:
+
+  /**
+   * Group of processors sharing ready coroutines (work-stealing). <br>
+   * Idle processors register themselves in the group while waiting for tasks.
+   * Busy processors hand part of their ready queue over to registered idle processors.
+   * Only coroutines ready for iteration are moved - coroutines waiting on I/O, timer, or wait-list
+   * stay where they are and return to the processor they were scheduled from.
+   */
+  class StealingGroup {
+    friend Processor;
+  private:
+    oatpp::concurrency::SpinLock m_lock;
+    std::vector<Processor*> m_idleProcessors;
+    std::atomic<v_int32> m_idleCount{0};
+  private:
+    void addIdle(Processor* processor);
+    void removeIdle(Processor* processor);
+    Processor* popIdle();
+  public:
+
+    /**
+     * Check if there are idle processors waiting for work.
+     * @return - `true` if there are idle processors in the group.
+     */
+    bool hasIdle() const {
+      return m_idleCount.load(std::memory_order_relaxed) > 0;
+    }
+
+  };
+
+  /**
+   * Processor statistics.
+   */
+  struct Stats {
+
+    /**
+     * Number of coroutines in the ready queue as of the last iteration.
+     */
+    v_int32 queueDepth;
+
+    /**
+     * Max observed number of coroutines in the ready queue.
+     */
+    v_int32 maxQueueDepth;
+
+    /**
+     * Number of not-finished tasks including tasks rescheduled for processor's co-workers.
+     */
+    v_int32 tasksCount;
+
+    /**
+     * Number of coroutines taken from other processors of the &l:Processor::StealingGroup;.
+     */
+    v_int64 stolenTasks;
+
+    /**
+     * Number of coroutines handed over to other processors of the &l:Processor::StealingGroup;.
+     */
+    v_int64 givenTasks;
+
+  };
+
 private:
 
   class TaskSubmission {
@@ -90,6 +155,10 @@ private:
 
   };
 
+private:
+
+  static constexpr v_int64 NO_TIMEOUT = std::numeric_limits<v_int64>::max();
+
 private:
 
   std::vector<std::shared_ptr<worker::Worker>> m_ioWorkers;
@@ -103,10 +172,13 @@ private:
 
 private:
 
-  std::unordered_set<CoroutineHandle*> m_sleepNoTimeSet;
-  std::unordered_set<CoroutineHandle*> m_sleepTimeSet;
+  /*
+   * Coroutines sleeping on a wait-list with timeout, ordered by timeout time point.
+   * Timeouts are checked by the processor thread itself.
+   */
+  std::set<std::pair<v_int64, CoroutineHandle*>> m_sleepTimeSet;
+  std::atomic<v_int64> m_sleepNextTimeout{NO_TIMEOUT};
   std::mutex m_sleepMutex;
-  std::condition_variable m_sleepCV;
 
 private:
 
@@ -114,15 +186,23 @@ private:
   std::condition_variable_any m_taskCondition;
   std::list<std::shared_ptr<TaskSubmission>> m_taskList;
   utils::FastQueue<CoroutineHandle> m_pushList;
+  utils::FastQueue<CoroutineHandle> m_stolenList;
 
 private:
 
   utils::FastQueue<CoroutineHandle> m_queue;
 
+private:
+
+  std::shared_ptr<StealingGroup> m_stealingGroup;
+  std::atomic<v_int32> m_queueDepth{0};
+  std::atomic<v_int32> m_maxQueueDepth{0};
+  std::atomic<v_int64> m_stolenTasks{0};
+  std::atomic<v_int64> m_givenTasks{0};
+
 private:
   std::atomic_bool m_running{true};
   std::atomic<v_int32> m_tasksCounter{0};
-  std::thread m_sleepSetTask{&Processor::checkCoroutinesSleep, this};
 
 private:
 
@@ -134,8 +214,13 @@ private:
   void popTasks();
   void pushQueues();
 
+  void shareTasks();
+  void acceptStolenTasks(utils::FastQueue<CoroutineHandle>& tasks);
+  void updateQueueDepth();
+
   void putCoroutineToSleep(CoroutineHandle* ch);
   void wakeCoroutine(CoroutineHandle* ch);
+  void updateSleepNextTimeout();
   void checkCoroutinesSleep();
 
 public:
@@ -148,6 +233,13 @@ public:
    */
   void addWorker(const std::shared_ptr<worker::Worker>& worker);
 
+  /**
+   * Join &l:Processor::StealingGroup;. <br>
+   * Must be called before the processor starts iterating.
+   * @param group - &l:Processor::StealingGroup;.
+   */
+  void setStealingGroup(const std::shared_ptr<StealingGroup>& group);
+
   /**
    * Push one Coroutine back to processor.
    * @param coroutine - &id:oatpp::async::CoroutineHandle; previously popped-out(rescheduled to coworker) from this processor.
@@ -168,7 +260,9 @@ public:
    */
   template<typename CoroutineType, typename ... Args>
   void execute(Args... params) {
-    auto submission = std::make_shared<SubmissionTemplate<CoroutineType, Args...>>(params...);
+    auto submission = std::allocate_shared<SubmissionTemplate<CoroutineType, Args...>>(
+      utils::FramePool::Allocator<SubmissionTemplate<CoroutineType, Args...>>(), params...
+    );
     ++ m_tasksCounter;
     {
       std::lock_guard<oatpp::concurrency::SpinLock> lock(m_taskLock);
@@ -178,7 +272,8 @@ public:
   }
 
   /**
-   * Sleep and wait for tasks.
+   * Sleep and wait for tasks. <br>
+   * Wakes up on the nearest timeout of coroutines sleeping on wait-lists.
    */
   void waitForTasks();
 
@@ -200,6 +295,11 @@ public:
    */
   v_int32 getTasksCount();
 
+  /**
+   * Get processor statistics.
+   * @return - &l:Processor::Stats;.
+   */
+  Stats getStats();
   
 };
   
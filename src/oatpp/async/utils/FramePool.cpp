@@ -0,0 +1,241 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "FramePool.hpp"
+
+#include "oatpp/concurrency/SpinLock.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace oatpp { namespace async { namespace utils {
+
+namespace {
+
+std::atomic<v_int64> SYSTEM_ALLOCATIONS(0);
+
+void* systemAllocate(std::size_t size) {
+  SYSTEM_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(size);
+}
+
+#if !defined(OATPP_DISABLE_POOL_ALLOCATIONS) && !defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+
+constexpr std::size_t CLASSES_COUNT = FramePool::MAX_POOLED_SIZE / FramePool::GRANULARITY;
+
+struct FreeBlock {
+  FreeBlock* next;
+  FreeBlock* nextBatch;
+};
+
+static_assert(sizeof(FreeBlock) <= FramePool::GRANULARITY, "FreeBlock must fit the smallest size class.");
+
+std::size_t getClassIndex(std::size_t size) {
+  return size == 0 ? 0 : (size - 1) / FramePool::GRANULARITY;
+}
+
+std::size_t getClassSize(std::size_t classIndex) {
+  return (classIndex + 1) * FramePool::GRANULARITY;
+}
+
+/*
+ * Shared storage of free blocks. Blocks come here in batches from threads which release more than they allocate.
+ * Never destroyed - it may be used by threads finishing after static destructors.
+ */
+class Depot {
+private:
+
+  struct Shelf {
+    oatpp::concurrency::SpinLock lock;
+    FreeBlock* batches = nullptr;
+  };
+
+private:
+  Shelf m_shelves[CLASSES_COUNT];
+public:
+
+  static Depot& getInstance() {
+    static Depot* depot = new Depot();
+    return *depot;
+  }
+
+  void put(std::size_t classIndex, FreeBlock* batch) {
+    auto& shelf = m_shelves[classIndex];
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(shelf.lock);
+    batch->nextBatch = shelf.batches;
+    shelf.batches = batch;
+  }
+
+  FreeBlock* take(std::size_t classIndex) {
+    auto& shelf = m_shelves[classIndex];
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(shelf.lock);
+    FreeBlock* batch = shelf.batches;
+    if(batch != nullptr) {
+      shelf.batches = batch->nextBatch;
+    }
+    return batch;
+  }
+
+};
+
+struct ThreadCache {
+
+  FreeBlock* heads[CLASSES_COUNT] = {};
+  v_int32 counts[CLASSES_COUNT] = {};
+
+  ~ThreadCache() {
+    for(std::size_t i = 0; i < CLASSES_COUNT; i ++) {
+      if(heads[i] != nullptr) {
+        Depot::getInstance().put(i, heads[i]);
+      }
+    }
+  }
+
+};
+
+/*
+ * Plain pointer + flag stay accessible during the thread exit,
+ * so blocks released after the cache is gone go to the system allocator.
+ */
+thread_local ThreadCache* THREAD_CACHE = nullptr;
+thread_local bool THREAD_CACHE_RELEASED = false;
+
+struct ThreadCacheGuard {
+
+  bool armed = false;
+
+  ~ThreadCacheGuard() {
+    delete THREAD_CACHE;
+    THREAD_CACHE = nullptr;
+    THREAD_CACHE_RELEASED = true;
+  }
+
+};
+
+thread_local ThreadCacheGuard THREAD_CACHE_GUARD;
+
+ThreadCache* getThreadCache() {
+  if(THREAD_CACHE == nullptr && !THREAD_CACHE_RELEASED) {
+    THREAD_CACHE_GUARD.armed = true;
+    THREAD_CACHE = new ThreadCache();
+  }
+  return THREAD_CACHE;
+}
+
+#endif
+
+}
+
+void* FramePool::allocate(std::size_t size) {
+
+#if defined(OATPP_DISABLE_POOL_ALLOCATIONS) || defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  return systemAllocate(size);
+#else
+
+  if(size > MAX_POOLED_SIZE) {
+    return systemAllocate(size);
+  }
+
+  auto classIndex = getClassIndex(size);
+  auto cache = getThreadCache();
+  if(cache == nullptr) {
+    return systemAllocate(getClassSize(classIndex));
+  }
+
+  FreeBlock* block = cache->heads[classIndex];
+
+  if(block == nullptr) {
+    block = Depot::getInstance().take(classIndex);
+    if(block == nullptr) {
+      return systemAllocate(getClassSize(classIndex));
+    }
+    v_int32 count = 0;
+    for(FreeBlock* curr = block; curr != nullptr; curr = curr->next) {
+      count ++;
+    }
+    cache->counts[classIndex] = count;
+  }
+
+  cache->heads[classIndex] = block->next;
+  cache->counts[classIndex] --;
+
+  return block;
+
+#endif
+
+}
+
+void FramePool::deallocate(void* ptr, std::size_t size) {
+
+  if(ptr == nullptr) {
+    return;
+  }
+
+#if defined(OATPP_DISABLE_POOL_ALLOCATIONS) || defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  (void) size;
+  ::operator delete(ptr);
+#else
+
+  if(size > MAX_POOLED_SIZE) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto cache = getThreadCache();
+  if(cache == nullptr) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto classIndex = getClassIndex(size);
+
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = cache->heads[classIndex];
+  cache->heads[classIndex] = block;
+  cache->counts[classIndex] ++;
+
+  /* thread releases more than it allocates - share surplus with other threads */
+  if(cache->counts[classIndex] >= 2 * BATCH_SIZE) {
+    FreeBlock* batch = cache->heads[classIndex];
+    FreeBlock* last = batch;
+    for(v_int32 i = 1; i < BATCH_SIZE; i ++) {
+      last = last->next;
+    }
+    cache->heads[classIndex] = last->next;
+    cache->counts[classIndex] -= BATCH_SIZE;
+    last->next = nullptr;
+    Depot::getInstance().put(classIndex, batch);
+  }
+
+#endif
+
+}
+
+v_int64 FramePool::getSystemAllocationsCount() {
+  return SYSTEM_ALLOCATIONS.load(std::memory_order_relaxed);
+}
+
+}}}
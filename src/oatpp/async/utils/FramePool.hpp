@@ -0,0 +1,126 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_async_utils_FramePool_hpp
+#define oatpp_async_utils_FramePool_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <cstddef>
+
+namespace oatpp { namespace async { namespace utils {
+
+/**
+ * Size-class pool of memory blocks for coroutines, coroutine handles and other per-task objects of the async engine. <br>
+ * Every thread (processor, IO worker, timer worker) keeps its own free lists, so the fast path takes no locks
+ * and does no malloc/free. Blocks released on a different thread than they were allocated on just migrate to that thread's lists,
+ * surplus goes to the shared depot in batches, where threads with empty lists pick it up. <br>
+ * Sizes above &l:FramePool::MAX_POOLED_SIZE; go directly to `::operator new`. <br>
+ * Define `OATPP_DISABLE_POOL_ALLOCATIONS` to forward all calls to `::operator new` / `::operator delete`.
+ */
+class FramePool {
+public:
+
+  /**
+   * Size classes granularity.
+   */
+  static constexpr std::size_t GRANULARITY = 16;
+
+  /**
+   * Max size of the pooled block.
+   */
+  static constexpr std::size_t MAX_POOLED_SIZE = 1024;
+
+  /**
+   * Number of blocks moved between thread's free list and the shared depot at once.
+   */
+  static constexpr v_int32 BATCH_SIZE = 32;
+
+public:
+
+  /**
+   * Allocate memory block.
+   * @param size - size of the block.
+   * @return - pointer to memory.
+   */
+  static void* allocate(std::size_t size);
+
+  /**
+   * Release memory block obtained with &l:FramePool::allocate ();.
+   * @param ptr - pointer to memory.
+   * @param size - size of the block. Must be the same as passed to &l:FramePool::allocate ();.
+   */
+  static void deallocate(void* ptr, std::size_t size);
+
+  /**
+   * Get the number of blocks obtained from the system allocator since the program start. <br>
+   * In steady state this number doesn't grow.
+   * @return
+   */
+  static v_int64 getSystemAllocationsCount();
+
+public:
+
+  /**
+   * STL-compatible allocator on top of &l:FramePool;. <br>
+   * Ex.: `std::allocate_shared<T>(FramePool::Allocator<T>(), args...)`.
+   * @tparam T
+   */
+  template<typename T>
+  class Allocator {
+  public:
+    typedef T value_type;
+  public:
+
+    Allocator() = default;
+
+    template<typename U>
+    Allocator(const Allocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(FramePool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) {
+      FramePool::deallocate(ptr, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const Allocator<U>&) const {
+      return true;
+    }
+
+    template<typename U>
+    bool operator!=(const Allocator<U>&) const {
+      return false;
+    }
+
+  };
+
+};
+
+}}}
+
+#endif // oatpp_async_utils_FramePool_hpp
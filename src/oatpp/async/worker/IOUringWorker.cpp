@@ -0,0 +1,477 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "IOUringWorker.hpp"
+
+#include "oatpp/async/Processor.hpp"
+#include "oatpp/base/Log.hpp"
+
+#if defined(__linux__) && defined(__has_include)
+  #if __has_include(<linux/io_uring.h>)
+    #define OATPP_IO_URING_AVAILABLE
+  #endif
+#endif
+
+#ifdef OATPP_IO_URING_AVAILABLE
+  #include <linux/io_uring.h>
+  #include <sys/eventfd.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <poll.h>
+  #include <unistd.h>
+  #include <algorithm>
+  #include <cstring>
+#endif
+
+namespace oatpp { namespace async { namespace worker {
+
+#ifdef OATPP_IO_URING_AVAILABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// io_uring based implementation
+
+namespace {
+
+int ringSetup(v_uint32 entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ringEnter(int ringFd, v_uint32 toSubmit, v_uint32 minComplete, v_uint32 flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+template<typename T>
+T* ringField(void* ring, v_uint32 offset) {
+  return reinterpret_cast<T*>(static_cast<v_char8*>(ring) + offset);
+}
+
+}
+
+struct IOUringWorker::Ring {
+
+  int fd = -1;
+
+  void* sqRing = MAP_FAILED;
+  size_t sqRingSize = 0;
+  void* cqRing = MAP_FAILED;
+  size_t cqRingSize = 0;
+  void* sqesPtr = MAP_FAILED;
+  size_t sqesSize = 0;
+
+  unsigned* sqHead = nullptr;
+  unsigned* sqTail = nullptr;
+  unsigned* sqArray = nullptr;
+  unsigned sqMask = 0;
+  unsigned sqEntries = 0;
+  io_uring_sqe* sqes = nullptr;
+
+  unsigned* cqHead = nullptr;
+  unsigned* cqTail = nullptr;
+  unsigned cqMask = 0;
+  io_uring_cqe* cqes = nullptr;
+
+  unsigned sqTailLocal = 0;
+  unsigned toSubmit = 0;
+
+  ~Ring() {
+    if(sqesPtr != MAP_FAILED) {
+      ::munmap(sqesPtr, sqesSize);
+    }
+    if(cqRing != MAP_FAILED && cqRing != sqRing) {
+      ::munmap(cqRing, cqRingSize);
+    }
+    if(sqRing != MAP_FAILED) {
+      ::munmap(sqRing, sqRingSize);
+    }
+    if(fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+};
+
+bool IOUringWorker::isSupported() {
+  static const bool supported = [] {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(io_uring_params));
+    int ringFd = ringSetup(4, &params);
+    if(ringFd < 0) {
+      return false;
+    }
+    ::close(ringFd);
+    /* completions must never be dropped - we may have more polls in flight than the completion queue size */
+    return (params.features & IORING_FEAT_NODROP) != 0;
+  }();
+  return supported;
+}
+
+IOUringWorker::IOUringWorker()
+  : Worker(Type::IO)
+  , m_running(true)
+  , m_ring(new Ring())
+  , m_wakeupTrigger(INVALID_IO_HANDLE)
+{
+  initRing();
+  m_thread = std::thread(&IOUringWorker::run, this);
+}
+
+IOUringWorker::~IOUringWorker() {
+  m_ring.reset();
+  if(m_wakeupTrigger >= 0) {
+    ::close(m_wakeupTrigger);
+  }
+}
+
+void IOUringWorker::initRing() {
+
+  auto& ring = *m_ring;
+
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(io_uring_params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = COMPLETION_QUEUE_SIZE;
+
+  ring.fd = ringSetup(SUBMISSION_QUEUE_SIZE, &params);
+  if(ring.fd < 0) {
+    OATPP_LOGe("[oatpp::async::worker::IOUringWorker::initRing()]", "Error. Call to io_uring_setup failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Call to io_uring_setup failed.");
+  }
+
+  ring.sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring.cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+  bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if(singleMmap) {
+    ring.sqRingSize = std::max(ring.sqRingSize, ring.cqRingSize);
+    ring.cqRingSize = ring.sqRingSize;
+  }
+
+  ring.sqRing = ::mmap(nullptr, ring.sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+  if(ring.sqRing != MAP_FAILED) {
+    if(singleMmap) {
+      ring.cqRing = ring.sqRing;
+    } else {
+      ring.cqRing = ::mmap(nullptr, ring.cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_CQ_RING);
+    }
+  }
+  if(ring.cqRing != MAP_FAILED) {
+    ring.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring.sqesPtr = ::mmap(nullptr, ring.sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQES);
+  }
+
+  if(ring.sqesPtr == MAP_FAILED) {
+    OATPP_LOGe("[oatpp::async::worker::IOUringWorker::initRing()]", "Error. Unable to map ring buffers. errno={}", errno)
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Unable to map ring buffers.");
+  }
+
+  ring.sqHead = ringField<unsigned>(ring.sqRing, params.sq_off.head);
+  ring.sqTail = ringField<unsigned>(ring.sqRing, params.sq_off.tail);
+  ring.sqArray = ringField<unsigned>(ring.sqRing, params.sq_off.array);
+  ring.sqMask = *ringField<unsigned>(ring.sqRing, params.sq_off.ring_mask);
+  ring.sqEntries = params.sq_entries;
+  ring.sqes = static_cast<io_uring_sqe*>(ring.sqesPtr);
+
+  ring.cqHead = ringField<unsigned>(ring.cqRing, params.cq_off.head);
+  ring.cqTail = ringField<unsigned>(ring.cqRing, params.cq_off.tail);
+  ring.cqMask = *ringField<unsigned>(ring.cqRing, params.cq_off.ring_mask);
+  ring.cqes = ringField<io_uring_cqe>(ring.cqRing, params.cq_off.cqes);
+
+  ring.sqTailLocal = *ring.sqTail;
+
+  m_wakeupTrigger = ::eventfd(0, EFD_NONBLOCK);
+  if(m_wakeupTrigger == -1) {
+    OATPP_LOGe("[oatpp::async::worker::IOUringWorker::initRing()]", "Error. Call to ::eventfd() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::async::worker::IOUringWorker::initRing()]: Error. Call to ::eventfd() failed.");
+  }
+
+  /* user_data == 0 - wakeup trigger */
+  submitPoll(0, m_wakeupTrigger, POLLIN);
+
+}
+
+void IOUringWorker::triggerWakeup() {
+  eventfd_write(m_wakeupTrigger, 1);
+}
+
+void IOUringWorker::submitPoll(v_uint64 userData, v_io_handle handle, v_uint32 events) {
+
+  auto& ring = *m_ring;
+
+  while(ring.sqTailLocal - __atomic_load_n(ring.sqHead, __ATOMIC_ACQUIRE) >= ring.sqEntries) {
+    /* submission queue is full - submit right away. If the kernel is busy flushing completions - free completion queue space */
+    if(!enter(0)) {
+      reapCompletions();
+    }
+  }
+
+  unsigned index = ring.sqTailLocal & ring.sqMask;
+  io_uring_sqe* sqe = &ring.sqes[index];
+  std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = handle;
+#if defined(IORING_FEAT_POLL_32BITS)
+  #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    events = (events << 16) | (events >> 16);
+  #endif
+  sqe->poll32_events = events;
+#else
+  sqe->poll_events = static_cast<__u16>(events);
+#endif
+  sqe->user_data = userData;
+
+  ring.sqArray[index] = index;
+  ring.sqTailLocal ++;
+  __atomic_store_n(ring.sqTail, ring.sqTailLocal, __ATOMIC_RELEASE);
+  ring.toSubmit ++;
+
+}
+
+void IOUringWorker::submitCoroutinePoll(CoroutineHandle* coroutine) {
+
+  auto& action = getCoroutineScheduledAction(coroutine);
+
+  switch(action.getType()) {
+
+    case Action::TYPE_IO_WAIT: break;
+    case Action::TYPE_IO_REPEAT: break;
+
+    default:
+      OATPP_LOGe("[oatpp::async::worker::IOUringWorker::submitCoroutinePoll()]", "Error. Unknown Action. action.getType()=={}", action.getType())
+      throw std::runtime_error("[oatpp::async::worker::IOUringWorker::submitCoroutinePoll()]: Error. Unknown Action.");
+
+  }
+
+  switch(action.getIOEventType()) {
+
+    case Action::IOEventType::IO_EVENT_READ:
+      submitPoll(reinterpret_cast<v_uint64>(coroutine), action.getIOHandle(), POLLIN);
+      break;
+
+    case Action::IOEventType::IO_EVENT_WRITE:
+      submitPoll(reinterpret_cast<v_uint64>(coroutine), action.getIOHandle(), POLLOUT);
+      break;
+
+    default:
+      throw std::runtime_error("[oatpp::async::worker::IOUringWorker::submitCoroutinePoll()]: Error. Unknown Action Event Type.");
+
+  }
+
+}
+
+bool IOUringWorker::enter(v_uint32 minComplete) {
+
+  auto& ring = *m_ring;
+  v_uint32 flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+  auto res = ringEnter(ring.fd, ring.toSubmit, minComplete, flags);
+  if(res >= 0) {
+    ring.toSubmit -= static_cast<unsigned>(res);
+    return true;
+  }
+
+  if(errno == EINTR) {
+    return true;
+  }
+
+  if(errno == EBUSY || errno == EAGAIN) {
+    return false;
+  }
+
+  OATPP_LOGe("[oatpp::async::worker::IOUringWorker::enter()]", "Error. Call to io_uring_enter failed. errno={}", errno)
+  throw std::runtime_error("[oatpp::async::worker::IOUringWorker::enter()]: Error. Call to io_uring_enter failed.");
+
+}
+
+void IOUringWorker::reapCompletions() {
+
+  auto& ring = *m_ring;
+
+  unsigned head = *ring.cqHead;
+  unsigned tail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+
+  while(head != tail) {
+    auto& cqe = ring.cqes[head & ring.cqMask];
+    m_completions.push_back({cqe.user_data, cqe.res});
+    head ++;
+  }
+
+  __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+
+}
+
+void IOUringWorker::consumeBacklog() {
+
+  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_backlogLock);
+
+  auto curr = m_backlog.first;
+  while(curr != nullptr) {
+    submitCoroutinePoll(curr);
+    curr = nextCoroutine(curr);
+  }
+
+  m_backlog.first = nullptr;
+  m_backlog.last = nullptr;
+  m_backlog.count = 0;
+
+}
+
+void IOUringWorker::waitEvents() {
+
+  /* submit all pending polls and wait for at least one completion - single syscall */
+  enter(1);
+  reapCompletions();
+
+  /* m_completions may grow while iterating - when submission queue is full and completions have to be reaped */
+  for(size_t i = 0; i < m_completions.size(); i ++) {
+
+    auto completion = m_completions[i];
+
+    if(completion.userData == 0) {
+      eventfd_t value;
+      eventfd_read(m_wakeupTrigger, &value);
+      submitPoll(0, m_wakeupTrigger, POLLIN);
+      continue;
+    }
+
+    auto coroutine = reinterpret_cast<CoroutineHandle*>(completion.userData);
+    Action action = coroutine->iterate();
+
+    switch(action.getType()) {
+
+      case Action::TYPE_IO_WAIT:
+      case Action::TYPE_IO_REPEAT:
+        setCoroutineScheduledAction(coroutine, std::move(action));
+        submitCoroutinePoll(coroutine);
+        break;
+
+      default:
+        setCoroutineScheduledAction(coroutine, std::move(action));
+        pushToProcessor(coroutine);
+
+    }
+
+  }
+
+  m_completions.clear();
+
+  /* hand coroutines over in batches - one wake-up per processor */
+  for(auto& batch : m_done) {
+    batch.first->pushTasks(batch.second);
+  }
+  m_done.clear();
+
+}
+
+void IOUringWorker::pushToProcessor(CoroutineHandle* coroutine) {
+  auto processor = getCoroutineProcessor(coroutine);
+  for(auto& batch : m_done) {
+    if(batch.first == processor) {
+      batch.second.pushBack(coroutine);
+      return;
+    }
+  }
+  m_done.emplace_back(processor, utils::FastQueue<CoroutineHandle>());
+  m_done.back().second.pushBack(coroutine);
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// stub implementation - io_uring is not available
+
+struct IOUringWorker::Ring {};
+
+bool IOUringWorker::isSupported() {
+  return false;
+}
+
+IOUringWorker::IOUringWorker()
+  : Worker(Type::IO)
+  , m_running(false)
+  , m_wakeupTrigger(INVALID_IO_HANDLE)
+{
+  throw std::runtime_error("[oatpp::async::worker::IOUringWorker::IOUringWorker()]: Error. io_uring is not available on this platform.");
+}
+
+IOUringWorker::~IOUringWorker() = default;
+
+void IOUringWorker::initRing() {}
+void IOUringWorker::triggerWakeup() {}
+void IOUringWorker::submitPoll(v_uint64, v_io_handle, v_uint32) {}
+void IOUringWorker::submitCoroutinePoll(CoroutineHandle*) {}
+bool IOUringWorker::enter(v_uint32) { return false; }
+void IOUringWorker::reapCompletions() {}
+void IOUringWorker::consumeBacklog() {}
+void IOUringWorker::waitEvents() {}
+void IOUringWorker::pushToProcessor(CoroutineHandle*) {}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// common
+
+void IOUringWorker::pushTasks(utils::FastQueue<CoroutineHandle>& tasks) {
+  if (tasks.first != nullptr) {
+    {
+      std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
+      utils::FastQueue<CoroutineHandle>::moveAll(tasks, m_backlog);
+    }
+    triggerWakeup();
+  }
+}
+
+void IOUringWorker::pushOneTask(CoroutineHandle* task) {
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
+    m_backlog.pushBack(task);
+  }
+  triggerWakeup();
+}
+
+void IOUringWorker::run() {
+  while (m_running) {
+    consumeBacklog();
+    waitEvents();
+  }
+}
+
+void IOUringWorker::stop() {
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_backlogLock);
+    m_running = false;
+  }
+  triggerWakeup();
+}
+
+void IOUringWorker::join() {
+  m_thread.join();
+}
+
+void IOUringWorker::detach() {
+  m_thread.detach();
+}
+
+}}}
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_async_worker_IOUringWorker_hpp
+#define oatpp_async_worker_IOUringWorker_hpp
+
+#include "./Worker.hpp"
+#include "oatpp/concurrency/SpinLock.hpp"
+
+#include <thread>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace oatpp { namespace async { namespace worker {
+
+/**
+ * `io_uring` based implementation of I/O worker (Linux only). <br>
+ * Readiness polls of all scheduled coroutines are submitted to the ring in batches together with the wait for completions -
+ * one `io_uring_enter` call per event-loop iteration instead of one `epoll_ctl` call per I/O wait. <br>
+ * Unlike &id:oatpp::async::worker::IOEventWorkerForeman; one worker serves both read and write waits,
+ * since the same file-descriptor may have several polls in flight. <br>
+ * Use &l:IOUringWorker::isSupported (); to check if the running kernel supports the features required.
+ */
+class IOUringWorker : public Worker {
+private:
+  static constexpr const v_uint32 SUBMISSION_QUEUE_SIZE = 4096;
+  static constexpr const v_uint32 COMPLETION_QUEUE_SIZE = 16384;
+private:
+  struct Ring;
+  struct Completion {
+    v_uint64 userData;
+    v_int32 result;
+  };
+private:
+  std::atomic<bool> m_running;
+  utils::FastQueue<CoroutineHandle> m_backlog;
+  oatpp::concurrency::SpinLock m_backlogLock;
+private:
+  std::unique_ptr<Ring> m_ring;
+  oatpp::v_io_handle m_wakeupTrigger;
+  std::vector<Completion> m_completions;
+  std::vector<std::pair<Processor*, utils::FastQueue<CoroutineHandle>>> m_done;
+private:
+  std::thread m_thread;
+private:
+  void initRing();
+  void triggerWakeup();
+  void submitPoll(v_uint64 userData, v_io_handle handle, v_uint32 events);
+  void submitCoroutinePoll(CoroutineHandle* coroutine);
+  bool enter(v_uint32 minComplete);
+  void reapCompletions();
+  void consumeBacklog();
+  void waitEvents();
+  void pushToProcessor(CoroutineHandle* coroutine);
+public:
+
+  /**
+   * Check if `io_uring` is available and supports the features required by the worker.
+   * @return - `true` if supported.
+   */
+  static bool isSupported();
+
+  /**
+   * Constructor.
+   */
+  IOUringWorker();
+
+  /**
+   * Virtual destructor.
+   */
+  ~IOUringWorker() override;
+
+  /**
+   * Push list of tasks to worker.
+   * @param tasks - &id:oatpp::async::utils::FastQueue; of &id:oatpp::async::CoroutineHandle;.
+   */
+  void pushTasks(utils::FastQueue<CoroutineHandle>& tasks) override;
+
+  /**
+   * Push one task to worker.
+   * @param task - &id:CoroutineHandle;.
+   */
+  void pushOneTask(CoroutineHandle* task) override;
+
+  /**
+   * Run worker.
+   */
+  void run();
+
+  /**
+   * Break run loop.
+   */
+  void stop() override;
+
+  /**
+   * Join all worker-threads.
+   */
+  void join() override;
+
+  /**
+   * Detach all worker-threads.
+   */
+  void detach() override;
+
+};
+
+}}}
+
+#endif //oatpp_async_worker_IOUringWorker_hpp
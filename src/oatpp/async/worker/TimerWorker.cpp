@@ -26,6 +26,7 @@
 
 #include "oatpp/async/Processor.hpp"
 
+#include <algorithm>
 #include <chrono>
 
 namespace oatpp { namespace async { namespace worker {
@@ -38,6 +39,12 @@ TimerWorker::TimerWorker(const std::chrono::duration<v_int64, std::micro>& granu
   m_thread = std::thread(&TimerWorker::run, this);
 }
 
+TimerWorker::~TimerWorker() {
+  for(auto& timer : m_timers) {
+    delete timer.coroutine;
+  }
+}
+
 void TimerWorker::pushTasks(utils::FastQueue<CoroutineHandle>& tasks) {
   {
     std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
@@ -48,74 +55,106 @@ void TimerWorker::pushTasks(utils::FastQueue<CoroutineHandle>& tasks) {
 
 void TimerWorker::consumeBacklog() {
 
-  std::unique_lock<oatpp::concurrency::SpinLock> lock(m_backlogLock);
-  while (m_backlog.first == nullptr && m_queue.first == nullptr && m_running) {
-    m_backlogCondition.wait(lock);
-  }
-  utils::FastQueue<CoroutineHandle>::moveAll(m_backlog, m_queue);
-
-}
+  utils::FastQueue<CoroutineHandle> tasks;
 
-void TimerWorker::pushOneTask(CoroutineHandle* task) {
   {
-    std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
-    m_backlog.pushBack(task);
+    std::unique_lock<oatpp::concurrency::SpinLock> lock(m_backlogLock);
+    while (m_backlog.first == nullptr && m_running) {
+      if(m_timers.empty()) {
+        m_backlogCondition.wait(lock);
+      } else {
+        v_int64 timePoint = m_timers.front().timePoint;
+        if(timePoint <= oatpp::Environment::getMicroTickCount()) {
+          break;
+        }
+        m_backlogCondition.wait_until(lock, std::chrono::system_clock::time_point(std::chrono::microseconds(timePoint)));
+      }
+    }
+    utils::FastQueue<CoroutineHandle>::moveAll(m_backlog, tasks);
   }
-  m_backlogCondition.notify_one();
-}
 
-void TimerWorker::run() {
+  while(tasks.first != nullptr) {
+    auto coroutine = tasks.popFront();
+    scheduleTimer(coroutine, getCoroutineScheduledAction(coroutine).getTimePointMicroseconds());
+  }
 
-  while(m_running) {
+}
 
-    consumeBacklog();
-    auto curr = m_queue.first;
-    CoroutineHandle* prev = nullptr;
+void TimerWorker::scheduleTimer(CoroutineHandle* coroutine, v_int64 timePoint) {
+  m_timers.push_back({timePoint, coroutine});
+  std::push_heap(m_timers.begin(), m_timers.end(), TimerCompare());
+}
 
-    auto startTime = std::chrono::system_clock::now();
-    std::chrono::microseconds ms = std::chrono::duration_cast<std::chrono::microseconds>(startTime.time_since_epoch());
-    v_int64 tick = ms.count();
+void TimerWorker::fireTimers() {
 
-    while(curr != nullptr) {
+  v_int64 tick = oatpp::Environment::getMicroTickCount();
 
-      auto next = nextCoroutine(curr);
+  while(!m_timers.empty() && m_timers.front().timePoint <= tick) {
 
-      const Action& schA = getCoroutineScheduledAction(curr);
+    std::pop_heap(m_timers.begin(), m_timers.end(), TimerCompare());
+    auto curr = m_timers.back().coroutine;
+    m_timers.pop_back();
 
-      if(schA.getTimePointMicroseconds() < tick) {
+    Action action = curr->iterate();
 
-        Action action = curr->iterate();
+    switch(action.getType()) {
 
-        switch(action.getType()) {
+      case Action::TYPE_WAIT_REPEAT: {
+        v_int64 timePoint = action.getTimePointMicroseconds();
+        setCoroutineScheduledAction(curr, std::move(action));
+        scheduleTimer(curr, timePoint);
+        break;
+      }
 
-          case Action::TYPE_WAIT_REPEAT:
-            setCoroutineScheduledAction(curr, std::move(action));
-            break;
+      case Action::TYPE_IO_WAIT: {
+        v_int64 timePoint = tick + m_granularity.count();
+        setCoroutineScheduledAction(curr, oatpp::async::Action::createWaitRepeatAction(timePoint));
+        scheduleTimer(curr, timePoint);
+        break;
+      }
 
-          case Action::TYPE_IO_WAIT:
-            setCoroutineScheduledAction(curr, oatpp::async::Action::createWaitRepeatAction(0));
-            break;
+      default:
+        setCoroutineScheduledAction(curr, std::move(action));
+        pushToProcessor(curr);
+        break;
 
-          default:
-            m_queue.cutEntry(curr, prev);
-            setCoroutineScheduledAction(curr, std::move(action));
-            getCoroutineProcessor(curr)->pushOneTask(curr);
-            curr = prev;
-            break;
+    }
 
-        }
+  }
 
-      }
+  /* hand fired coroutines over in batches - one wake-up per processor */
+  for(auto& batch : m_fired) {
+    batch.first->pushTasks(batch.second);
+  }
+  m_fired.clear();
 
-      prev = curr;
-      curr = next;
-    }
+}
 
-    auto elapsed = std::chrono::system_clock::now() - startTime;
-    if(elapsed < m_granularity) {
-      std::this_thread::sleep_for(m_granularity - elapsed);
+void TimerWorker::pushToProcessor(CoroutineHandle* coroutine) {
+  auto processor = getCoroutineProcessor(coroutine);
+  for(auto& batch : m_fired) {
+    if(batch.first == processor) {
+      batch.second.pushBack(coroutine);
+      return;
     }
+  }
+  m_fired.emplace_back(processor, utils::FastQueue<CoroutineHandle>());
+  m_fired.back().second.pushBack(coroutine);
+}
 
+void TimerWorker::pushOneTask(CoroutineHandle* task) {
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> guard(m_backlogLock);
+    m_backlog.pushBack(task);
+  }
+  m_backlogCondition.notify_one();
+}
+
+void TimerWorker::run() {
+
+  while(m_running) {
+    consumeBacklog();
+    fireTimers();
   }
 
 }
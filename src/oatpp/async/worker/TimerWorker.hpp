@@ -31,34 +31,60 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <vector>
 
 namespace oatpp { namespace async { namespace worker {
 
 /**
  * Timer worker.
- * Used to wait for timer-scheduled coroutines.
+ * Used to wait for timer-scheduled coroutines. <br>
+ * Coroutines are kept in a min-heap ordered by their wake-up time point - scheduling and expiry are `O(log n)`,
+ * worker thread sleeps exactly until the nearest time point or until a new coroutine is pushed.
  */
 class TimerWorker : public Worker {
+private:
+
+  struct Timer {
+    v_int64 timePoint;
+    CoroutineHandle* coroutine;
+  };
+
+  struct TimerCompare {
+    bool operator()(const Timer& a, const Timer& b) const {
+      return a.timePoint > b.timePoint;
+    }
+  };
+
 private:
   std::atomic<bool> m_running;
   utils::FastQueue<CoroutineHandle> m_backlog;
-  utils::FastQueue<CoroutineHandle> m_queue;
   oatpp::concurrency::SpinLock m_backlogLock;
   std::condition_variable_any m_backlogCondition;
+private:
+  std::vector<Timer> m_timers;
+  std::vector<std::pair<Processor*, utils::FastQueue<CoroutineHandle>>> m_fired;
 private:
   std::chrono::duration<v_int64, std::micro> m_granularity;
 private:
   std::thread m_thread;
 private:
   void consumeBacklog();
+  void scheduleTimer(CoroutineHandle* coroutine, v_int64 timePoint);
+  void fireTimers();
+  void pushToProcessor(CoroutineHandle* coroutine);
 public:
 
   /**
    * Constructor.
-   * @param granularity - minimum possible time to wait.
+   * @param granularity - time to wait before coroutine, which requested I/O wait while being iterated by the timer worker, is retried.
    */
   TimerWorker(const std::chrono::duration<v_int64, std::micro>& granularity = std::chrono::milliseconds(100));
 
+  /**
+   * Destructor. Deletes coroutines left unfired.
+   */
+  ~TimerWorker() override;
+
   /**
    * Push list of tasks to worker.
    * @param tasks - &id:oatpp::aysnc::utils::FastQueue; of &id:oatpp::async::CoroutineHandle;.
@@ -39,7 +39,7 @@
 
 /**
  * Define this to disable memory-pool allocations.
- * This will make oatpp::base::memory::MemoryPool, method obtain and free call new and delete directly
+ * This will make oatpp::async::utils::FramePool, methods allocate and deallocate call new and delete directly
  */
 //#define OATPP_DISABLE_POOL_ALLOCATIONS
 
@@ -0,0 +1,299 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BufferPool.hpp"
+
+#include "oatpp/async/utils/FramePool.hpp"
+#include "oatpp/concurrency/SpinLock.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace data { namespace buffer {
+
+namespace {
+
+std::atomic<v_int64> SYSTEM_ALLOCATIONS(0);
+
+std::string* createBuffer(v_buff_size size) {
+  SYSTEM_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+  return new std::string(static_cast<std::size_t>(size), '\0');
+}
+
+stream::BufferOutputStream* createOutputStream(v_buff_size initialCapacity) {
+  SYSTEM_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+  return new stream::BufferOutputStream(initialCapacity);
+}
+
+#if !defined(OATPP_DISABLE_POOL_ALLOCATIONS) && !defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+
+constexpr v_int32 CLASSES_COUNT = 10;
+
+static_assert((BufferPool::MIN_POOLED_SIZE << (CLASSES_COUNT - 1)) == BufferPool::MAX_POOLED_SIZE,
+              "Size classes must cover [MIN_POOLED_SIZE, MAX_POOLED_SIZE].");
+
+v_buff_size getClassSize(v_int32 classIndex) {
+  return BufferPool::MIN_POOLED_SIZE << classIndex;
+}
+
+/*
+ * Smallest class which fits the size.
+ */
+v_int32 getLeaseClassIndex(v_buff_size size) {
+  v_int32 classIndex = 0;
+  while(getClassSize(classIndex) < size) {
+    classIndex ++;
+  }
+  return classIndex;
+}
+
+/*
+ * Largest class not exceeding the capacity. -1 if capacity is out of the pooled range.
+ */
+v_int32 getReleaseClassIndex(v_buff_size capacity) {
+  if(capacity < BufferPool::MIN_POOLED_SIZE || capacity > BufferPool::MAX_POOLED_SIZE) {
+    return -1;
+  }
+  v_int32 classIndex = CLASSES_COUNT - 1;
+  while(getClassSize(classIndex) > capacity) {
+    classIndex --;
+  }
+  return classIndex;
+}
+
+template<class T>
+struct FreeList {
+  T* items[BufferPool::THREAD_CACHE_SIZE];
+  v_int32 count = 0;
+};
+
+/*
+ * Shared storage of free objects. Objects come here from threads which release more than they lease.
+ * Never destroyed - it may be used by threads finishing after static destructors.
+ */
+template<class T>
+class Depot {
+private:
+
+  struct Shelf {
+    oatpp::concurrency::SpinLock lock;
+    std::vector<T*> items;
+  };
+
+private:
+  Shelf m_shelves[CLASSES_COUNT];
+public:
+
+  static Depot& getInstance() {
+    static Depot* depot = new Depot();
+    return *depot;
+  }
+
+  void put(v_int32 classIndex, T** items, v_int32 count) {
+
+    auto maxCount = static_cast<std::size_t>(BufferPool::MAX_RETAINED_SIZE / getClassSize(classIndex));
+    auto& shelf = m_shelves[classIndex];
+
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(shelf.lock);
+    for(v_int32 i = 0; i < count; i ++) {
+      if(shelf.items.size() < maxCount) {
+        shelf.items.push_back(items[i]);
+      } else {
+        delete items[i];
+      }
+    }
+
+  }
+
+  v_int32 take(v_int32 classIndex, T** items, v_int32 count) {
+    auto& shelf = m_shelves[classIndex];
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(shelf.lock);
+    v_int32 taken = 0;
+    while(taken < count && !shelf.items.empty()) {
+      items[taken ++] = shelf.items.back();
+      shelf.items.pop_back();
+    }
+    return taken;
+  }
+
+};
+
+template<class T>
+T* takeItem(FreeList<T>& list, v_int32 classIndex) {
+  if(list.count == 0) {
+    list.count = Depot<T>::getInstance().take(classIndex, list.items, BufferPool::THREAD_CACHE_SIZE / 2);
+    if(list.count == 0) {
+      return nullptr;
+    }
+  }
+  return list.items[-- list.count];
+}
+
+template<class T>
+void putItem(FreeList<T>& list, v_int32 classIndex, T* item) {
+  /* thread releases more than it leases - share surplus with other threads */
+  if(list.count == BufferPool::THREAD_CACHE_SIZE) {
+    list.count -= BufferPool::THREAD_CACHE_SIZE / 2;
+    Depot<T>::getInstance().put(classIndex, list.items + list.count, BufferPool::THREAD_CACHE_SIZE / 2);
+  }
+  list.items[list.count ++] = item;
+}
+
+struct ThreadCache {
+
+  FreeList<std::string> buffers[CLASSES_COUNT];
+  FreeList<stream::BufferOutputStream> streams[CLASSES_COUNT];
+
+  ~ThreadCache() {
+    for(v_int32 i = 0; i < CLASSES_COUNT; i ++) {
+      Depot<std::string>::getInstance().put(i, buffers[i].items, buffers[i].count);
+      Depot<stream::BufferOutputStream>::getInstance().put(i, streams[i].items, streams[i].count);
+    }
+  }
+
+};
+
+/*
+ * Plain pointer + flag stay accessible during the thread exit,
+ * so objects released after the cache is gone are just deleted.
+ */
+thread_local ThreadCache* THREAD_CACHE = nullptr;
+thread_local bool THREAD_CACHE_RELEASED = false;
+
+struct ThreadCacheGuard {
+
+  ~ThreadCacheGuard() {
+    delete THREAD_CACHE;
+    THREAD_CACHE = nullptr;
+    THREAD_CACHE_RELEASED = true;
+  }
+
+};
+
+thread_local ThreadCacheGuard THREAD_CACHE_GUARD;
+
+ThreadCache* getThreadCache() {
+  if(THREAD_CACHE == nullptr && !THREAD_CACHE_RELEASED) {
+    (void) THREAD_CACHE_GUARD; // odr-use - constructs the guard, so that its destructor runs on the thread exit
+    THREAD_CACHE = new ThreadCache();
+  }
+  return THREAD_CACHE;
+}
+
+struct BufferReleaser {
+
+  void operator()(std::string* buffer) const {
+    auto size = static_cast<v_buff_size>(buffer->size());
+    auto classIndex = getReleaseClassIndex(size);
+    auto cache = getThreadCache();
+    if(cache == nullptr || classIndex < 0 || getClassSize(classIndex) != size) {
+      delete buffer;
+      return;
+    }
+    putItem(cache->buffers[classIndex], classIndex, buffer);
+  }
+
+};
+
+struct OutputStreamReleaser {
+
+  void operator()(stream::BufferOutputStream* stream) const {
+    auto classIndex = getReleaseClassIndex(stream->getCapacity());
+    auto cache = getThreadCache();
+    if(cache == nullptr || classIndex < 0) {
+      delete stream;
+      return;
+    }
+    stream->setCurrentPosition(0);
+    stream->setOutputStreamIOMode(stream::IOMode::ASYNCHRONOUS);
+    putItem(cache->streams[classIndex], classIndex, stream);
+  }
+
+};
+
+#endif
+
+}
+
+std::shared_ptr<std::string> BufferPool::getBuffer(v_buff_size size) {
+
+#if defined(OATPP_DISABLE_POOL_ALLOCATIONS) || defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  return std::shared_ptr<std::string>(createBuffer(size));
+#else
+
+  if(size > MAX_POOLED_SIZE) {
+    return std::shared_ptr<std::string>(createBuffer(size));
+  }
+
+  auto classIndex = getLeaseClassIndex(size);
+  auto cache = getThreadCache();
+
+  std::string* buffer = nullptr;
+  if(cache != nullptr) {
+    buffer = takeItem(cache->buffers[classIndex], classIndex);
+  }
+  if(buffer == nullptr) {
+    buffer = createBuffer(getClassSize(classIndex));
+  }
+
+  return std::shared_ptr<std::string>(buffer, BufferReleaser(), async::utils::FramePool::Allocator<std::string>());
+
+#endif
+
+}
+
+std::shared_ptr<stream::BufferOutputStream> BufferPool::getOutputStream(v_buff_size initialCapacity) {
+
+#if defined(OATPP_DISABLE_POOL_ALLOCATIONS) || defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  return std::shared_ptr<stream::BufferOutputStream>(createOutputStream(initialCapacity));
+#else
+
+  if(initialCapacity > MAX_POOLED_SIZE) {
+    return std::shared_ptr<stream::BufferOutputStream>(createOutputStream(initialCapacity));
+  }
+
+  auto classIndex = getLeaseClassIndex(initialCapacity);
+  auto cache = getThreadCache();
+
+  stream::BufferOutputStream* stream = nullptr;
+  if(cache != nullptr) {
+    stream = takeItem(cache->streams[classIndex], classIndex);
+  }
+  if(stream == nullptr) {
+    stream = createOutputStream(getClassSize(classIndex));
+  }
+
+  return std::shared_ptr<stream::BufferOutputStream>(stream, OutputStreamReleaser(), async::utils::FramePool::Allocator<stream::BufferOutputStream>());
+
+#endif
+
+}
+
+v_int64 BufferPool::getSystemAllocationsCount() {
+  return SYSTEM_ALLOCATIONS.load(std::memory_order_relaxed);
+}
+
+}}}
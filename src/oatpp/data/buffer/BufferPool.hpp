@@ -0,0 +1,97 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_data_buffer_BufferPool_hpp
+#define oatpp_data_buffer_BufferPool_hpp
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <memory>
+#include <string>
+
+namespace oatpp { namespace data { namespace buffer {
+
+/**
+ * Pool of I/O buffers and buffer streams which are leased per connection. <br>
+ * Buffers are grouped in power-of-two size classes. Every thread keeps a few free buffers of each class,
+ * so lease and release take no locks in steady state. Surplus goes to the shared depot which retains
+ * at most &l:BufferPool::MAX_RETAINED_SIZE; bytes per size class - the rest is freed. <br>
+ * Leased objects are returned to the pool when the last `std::shared_ptr` to them is destroyed. <br>
+ * Sizes above &l:BufferPool::MAX_POOLED_SIZE; are not pooled.
+ * Define `OATPP_DISABLE_POOL_ALLOCATIONS` to allocate every buffer with `new`.
+ */
+class BufferPool {
+public:
+
+  /**
+   * Size of the smallest size class.
+   */
+  static constexpr v_buff_size MIN_POOLED_SIZE = 256;
+
+  /**
+   * Size of the largest size class.
+   */
+  static constexpr v_buff_size MAX_POOLED_SIZE = 131072;
+
+  /**
+   * Max number of free objects of one size class kept by a thread.
+   */
+  static constexpr v_int32 THREAD_CACHE_SIZE = 16;
+
+  /**
+   * Max amount of memory retained by the shared depot per size class.
+   */
+  static constexpr v_buff_size MAX_RETAINED_SIZE = 8 * 1024 * 1024;
+
+public:
+
+  /**
+   * Lease buffer. <br>
+   * Buffer size is `size` rounded up to the size class. Content of the buffer is not initialized.
+   * @param size - min size of the buffer.
+   * @return - `std::shared_ptr` to `std::string` used as a buffer.
+   */
+  static std::shared_ptr<std::string> getBuffer(v_buff_size size);
+
+  /**
+   * Lease &id:oatpp::data::stream::BufferOutputStream;. <br>
+   * Stream is returned with position `0`. Its capacity is at least `initialCapacity`.
+   * @param initialCapacity - min capacity of the stream.
+   * @return - &id:oatpp::data::stream::BufferOutputStream;.
+   */
+  static std::shared_ptr<stream::BufferOutputStream> getOutputStream(v_buff_size initialCapacity);
+
+  /**
+   * Get the number of buffers and streams created since the program start. <br>
+   * In steady state this number doesn't grow.
+   * @return
+   */
+  static v_int64 getSystemAllocationsCount();
+
+};
+
+}}}
+
+#endif // oatpp_data_buffer_BufferPool_hpp
@@ -82,6 +82,16 @@ const ObjectMapper::Info& ObjectMapper::getInfo() const {
   return m_info;
 }
 
+std::shared_ptr<ObjectReader> ObjectMapper::createReader(const oatpp::Type* type) const {
+  (void) type;
+  return nullptr;
+}
+
+std::shared_ptr<ObjectWriter> ObjectMapper::createWriter(const oatpp::Void& variant) const {
+  (void) variant;
+  return nullptr;
+}
+
 oatpp::String ObjectMapper::writeToString(const type::Void& variant) const {
   stream::BufferOutputStream stream;
   ErrorStack errorStack;
@@ -106,6 +106,63 @@ public:
 
 };
 
+/**
+ * Abstract incremental object reader. <br>
+ * Serialized data is fed to the reader chunk by chunk via &id:oatpp::data::stream::WriteCallback; interface -
+ * so it can be used as a target of body decoding. The object is built as data arrives.
+ * Once reading failed, `write` returns &id:oatpp::IOError::BROKEN_PIPE; so that the source stops early.
+ */
+class ObjectReader : public data::stream::WriteCallback {
+public:
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~ObjectReader() override = default;
+
+  /**
+   * Finish reading - call once all data is fed.
+   * @param errorStack - See &id:oatpp::data::mapping::ErrorStack;.
+   * @return - deserialized object wrapped in &id:oatpp::Void;.
+   */
+  virtual oatpp::Void finish(ErrorStack& errorStack) = 0;
+
+  /**
+   * Check if reading failed. Errors are returned by &l:ObjectReader::finish ();.
+   * @return - `true` if reading failed.
+   */
+  virtual bool hasError() const = 0;
+
+};
+
+/**
+ * Abstract incremental object writer. <br>
+ * Serialized data is pulled from the writer chunk by chunk via &id:oatpp::data::stream::ReadCallback; interface -
+ * so it can be used as a source of a streamed body. The object is serialized as data is read.
+ * Once writing failed, `read` returns &id:oatpp::IOError::BROKEN_PIPE;.
+ */
+class ObjectWriter : public data::stream::ReadCallback {
+public:
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~ObjectWriter() override = default;
+
+  /**
+   * Check if writing failed.
+   * @return - `true` if writing failed.
+   */
+  virtual bool hasError() const = 0;
+
+  /**
+   * Get errors of the failed writing.
+   * @return - See &id:oatpp::data::mapping::ErrorStack;.
+   */
+  virtual const ErrorStack& getErrorStack() const = 0;
+
+};
+
 /**
  * Abstract ObjectMapper class.
  */
@@ -176,6 +233,22 @@ public:
    */
   virtual oatpp::Void read(oatpp::utils::parser::Caret& caret, const oatpp::Type* type, ErrorStack& errorStack) const = 0;
 
+  /**
+   * Create incremental reader for the object of the given type. <br>
+   * Override this method if the mapper can deserialize data chunk by chunk. The reader must not outlive the mapper.
+   * @param type - pointer to object type. See &id:oatpp::data::type::Type;.
+   * @return - `std::shared_ptr` to &l:ObjectReader;. `nullptr` if incremental reading is not supported (default).
+   */
+  virtual std::shared_ptr<ObjectReader> createReader(const oatpp::Type* type) const;
+
+  /**
+   * Create incremental writer for the object. <br>
+   * Override this method if the mapper can serialize data chunk by chunk. The writer must not outlive the mapper.
+   * @param variant - object to serialize.
+   * @return - `std::shared_ptr` to &l:ObjectWriter;. `nullptr` if incremental writing is not supported (default).
+   */
+  virtual std::shared_ptr<ObjectWriter> createWriter(const oatpp::Void& variant) const;
+
   /**
    * Serialize object to String.
    * @param variant - Object to serialize.
@@ -73,6 +73,14 @@ void ObjectToTreeMapper::setMapperMethod(const data::type::ClassId& classId, Map
   m_methods[id] = method;
 }
 
+ObjectToTreeMapper::MapperMethod ObjectToTreeMapper::getMapperMethod(const data::type::ClassId& classId) const {
+  const auto id = static_cast<v_uint32>(classId.id);
+  if(id < m_methods.size()) {
+    return m_methods[id];
+  }
+  return nullptr;
+}
+
 void ObjectToTreeMapper::map(State& state, const oatpp::Void& polymorph) const
 {
   auto id = static_cast<v_uint32>(polymorph.getValueType()->classId.id);
@@ -89,6 +89,13 @@ public:
 
   void setMapperMethod(const data::type::ClassId& classId, MapperMethod method);
 
+  /**
+   * Get mapper method registered for the class.
+   * @param classId - class id.
+   * @return - &l:ObjectToTreeMapper::MapperMethod;. `nullptr` if no method is registered.
+   */
+  MapperMethod getMapperMethod(const data::type::ClassId& classId) const;
+
   void map(State& state, const oatpp::Void& polymorph) const;
 
 };
@@ -73,9 +73,17 @@ void TreeToObjectMapper::setMapperMethod(const data::type::ClassId& classId, Map
   m_methods[id] = method;
 }
 
+TreeToObjectMapper::MapperMethod TreeToObjectMapper::getMapperMethod(const data::type::ClassId& classId) const {
+  const auto id = static_cast<v_uint32>(classId.id);
+  if(id < m_methods.size()) {
+    return m_methods[id];
+  }
+  return nullptr;
+}
+
 TreeToObjectMapper::GuessedPrimitiveType TreeToObjectMapper::guessedPrimitiveType(const oatpp::String& text) {
 
-  if(text->empty()) {
+  if(!text || text->empty()) {
     return GuessedPrimitiveType::NOT_PRIMITIVE;
   }
 
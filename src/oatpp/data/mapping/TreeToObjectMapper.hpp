@@ -134,6 +134,13 @@ public:
 
   void setMapperMethod(const data::type::ClassId& classId, MapperMethod method);
 
+  /**
+   * Get mapper method registered for the class.
+   * @param classId - class id.
+   * @return - &l:TreeToObjectMapper::MapperMethod;. `nullptr` if no method is registered.
+   */
+  MapperMethod getMapperMethod(const data::type::ClassId& classId) const;
+
   oatpp::Void map(State& state, const Type* type) const;
 
 };
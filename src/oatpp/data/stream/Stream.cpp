@@ -26,8 +26,19 @@
 #include "oatpp/utils/Conversion.hpp"
 #include "oatpp/base/Log.hpp"
 
+#include <cstring>
+
 namespace oatpp { namespace data{ namespace stream {
 
+namespace {
+
+/*
+ * Leading small buffers up to this total size are copied and written at once by the default writev().
+ */
+constexpr v_buff_size WRITEV_COALESCE_SIZE = 4096;
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // WriteCallback
 
@@ -130,6 +141,159 @@ async::CoroutineStarter WriteCallback::writeExactSizeDataAsync(const void* data,
 
 }
 
+namespace {
+
+/*
+ * Advance vectored write buffers by the number of bytes written.
+ */
+void incBuffers(data::buffer::InlineWriteData* buffers, v_buff_size count, v_io_size amount) {
+  for(v_buff_size i = 0; i < count && amount > 0; i ++) {
+    auto size = buffers[i].bytesLeft < amount ? buffers[i].bytesLeft : amount;
+    buffers[i].inc(size);
+    amount -= size;
+  }
+}
+
+bool hasBytesLeft(const data::buffer::InlineWriteData* buffers, v_buff_size count) {
+  for(v_buff_size i = 0; i < count; i ++) {
+    if(buffers[i].bytesLeft > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+v_io_size WriteCallback::writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) {
+
+  v_io_size progress = 0;
+
+  /*
+   * Small leading buffers (ex.: headers + small body, chunk header + chunk) go out with one write -
+   * not as separate small writes (separate TLS records, separate tcp segments waiting for a delayed ACK).
+   */
+  v_buff_size coalescedCount = 0;
+  v_buff_size coalescedSize = 0;
+  while(coalescedCount < count && coalescedSize + buffers[coalescedCount].bytesLeft <= WRITEV_COALESCE_SIZE) {
+    coalescedSize += buffers[coalescedCount].bytesLeft;
+    coalescedCount ++;
+  }
+
+  v_buff_size start = 0;
+
+  if(coalescedCount > 1 && coalescedSize > 0) {
+
+    v_char8 coalesced[WRITEV_COALESCE_SIZE];
+    v_buff_size position = 0;
+    for(v_buff_size i = 0; i < coalescedCount; i ++) {
+      if(buffers[i].bytesLeft > 0) {
+        std::memcpy(coalesced + position, buffers[i].currBufferPtr, static_cast<size_t>(buffers[i].bytesLeft));
+        position += buffers[i].bytesLeft;
+      }
+    }
+
+    auto res = write(coalesced, coalescedSize, action);
+    if(res <= 0 || res < coalescedSize || coalescedCount == count) {
+      return res;
+    }
+
+    progress = res;
+    start = coalescedCount;
+
+  }
+
+  for(v_buff_size i = start; i < count; i ++) {
+
+    const auto& buffer = buffers[i];
+    if(buffer.bytesLeft == 0) {
+      continue;
+    }
+
+    v_io_size res;
+    if(progress == 0) {
+      res = write(buffer.currBufferPtr, buffer.bytesLeft, action);
+      if(res <= 0) {
+        return res;
+      }
+    } else {
+      async::Action nextAction; // some data is already written - report progress, not the retry
+      res = write(buffer.currBufferPtr, buffer.bytesLeft, nextAction);
+      if(res <= 0) {
+        return progress;
+      }
+    }
+
+    progress += res;
+    if(res < buffer.bytesLeft) {
+      break;
+    }
+
+  }
+
+  return progress;
+
+}
+
+v_io_size WriteCallback::writevExactSizeDataSimple(data::buffer::InlineWriteData* buffers, v_buff_size count) {
+  v_io_size progress = 0;
+  while(hasBytesLeft(buffers, count)) {
+    async::Action action;
+    auto res = writev(buffers, count, action);
+    if(!action.isNone()) {
+      OATPP_LOGe("[oatpp::data::stream::WriteCallback::writevExactSizeDataSimple()]", "Error. writevExactSizeDataSimple() is called on a stream in Async mode.")
+      throw std::runtime_error("[oatpp::data::stream::WriteCallback::writevExactSizeDataSimple()]: Error. writevExactSizeDataSimple() is called on a stream in Async mode.");
+    }
+    if(res > 0) {
+      incBuffers(buffers, count, res);
+      progress += res;
+    } else if(res == IOError::BROKEN_PIPE || res == IOError::ZERO_VALUE) {
+      break;
+    }
+  }
+  return progress;
+}
+
+async::Action WriteCallback::writevExactSizeDataAsyncInline(data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action&& nextAction) {
+
+  if(hasBytesLeft(buffers, count)) {
+
+    async::Action action;
+    auto res = writev(buffers, count, action);
+
+    if(res > 0) {
+      incBuffers(buffers, count, res);
+    }
+
+    if (!action.isNone()) {
+      return action;
+    }
+
+    if (res > 0) {
+      return async::Action::createActionByType(async::Action::TYPE_REPEAT);
+    } else {
+      switch (res) {
+        case IOError::BROKEN_PIPE:
+          return new AsyncIOError(IOError::BROKEN_PIPE);
+        case IOError::ZERO_VALUE:
+          break;
+        case IOError::RETRY_READ:
+          return async::Action::createActionByType(async::Action::TYPE_REPEAT);
+        case IOError::RETRY_WRITE:
+          return async::Action::createActionByType(async::Action::TYPE_REPEAT);
+        default:
+          OATPP_LOGe("[oatpp::data::stream::writevExactSizeDataAsyncInline()]", "Error. Unknown IO result.")
+          return new async::Error(
+            "[oatpp::data::stream::writevExactSizeDataAsyncInline()]: Error. Unknown IO result.");
+      }
+    }
+
+  }
+
+  return std::forward<async::Action>(nextAction);
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ReadCallback
 
@@ -224,6 +224,40 @@ public:
 
   async::CoroutineStarter writeExactSizeDataAsync(const void* data, v_buff_size size);
 
+  /**
+   * Vectored (scatter/gather) write. Write data from several buffers, in order, with as few I/O operations as possible. <br>
+   * Default implementation copies small leading buffers (up to 4KB in total) and writes them at once,
+   * then calls &l:WriteCallback::write (); for each of the remaining buffers and stops at the first incomplete write.
+   * Streams capable of native vectored I/O should override this method.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;. Buffers are not modified.
+   * @param count - number of buffers in the array.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written from all buffers. &id:oatpp::v_io_size;.
+   */
+  virtual v_io_size writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action);
+
+  /**
+   * Write all data from the `buffers` using &l:WriteCallback::writev ();. `buffers` are advanced by the number of bytes written.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @return - actual number of bytes written from all buffers. &id:oatpp::v_io_size;.
+   */
+  v_io_size writevExactSizeDataSimple(data::buffer::InlineWriteData* buffers, v_buff_size count);
+
+  /**
+   * Write all data from the `buffers` using &l:WriteCallback::writev ();. (Async-inline usage. Should be called from a separate method of coroutine). <br>
+   * Each call makes one `writev` attempt and advances `buffers` by the number of bytes written.
+   * On a partial write or &id:oatpp::IOError::RETRY_READ; / &id:oatpp::IOError::RETRY_WRITE; it returns
+   * `TYPE_REPEAT` (or the I/O wait action set by the stream), so the coroutine calls the same method again with the advanced `buffers`.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;. Must stay valid until `nextAction` is returned.
+   * @param count - number of buffers in the array.
+   * @param nextAction - action to take after all data is written, or if the stream returned &id:oatpp::IOError::ZERO_VALUE;.
+   * @return - &id:oatpp::async::Action;. &id:oatpp::AsyncIOError; on &id:oatpp::IOError::BROKEN_PIPE;,
+   * &id:oatpp::async::Error; on an unknown I/O result.
+   */
+  async::Action writevExactSizeDataAsyncInline(data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action&& nextAction);
+
   /**
    * Same as `write((p_char8)data, std::strlen(data));`.
    * @param data - data to write.
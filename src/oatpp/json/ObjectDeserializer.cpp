@@ -0,0 +1,475 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectDeserializer.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <unordered_map>
+
+namespace oatpp { namespace json {
+
+ObjectDeserializer::ObjectDeserializer() {
+
+  data::mapping::TreeToObjectMapper treeMapper;
+
+  m_methods.resize(static_cast<size_t>(data::type::ClassId::getClassCount()), {nullptr, nullptr});
+
+  setDeserializerMethod(treeMapper, data::type::__class::AbstractObject::CLASS_ID, &ObjectDeserializer::deserializeObject);
+
+  setDeserializerMethod(treeMapper, data::type::__class::AbstractVector::CLASS_ID, &ObjectDeserializer::deserializeCollection);
+  setDeserializerMethod(treeMapper, data::type::__class::AbstractList::CLASS_ID, &ObjectDeserializer::deserializeCollection);
+  setDeserializerMethod(treeMapper, data::type::__class::AbstractUnorderedSet::CLASS_ID, &ObjectDeserializer::deserializeCollection);
+
+  setDeserializerMethod(treeMapper, data::type::__class::AbstractPairList::CLASS_ID, &ObjectDeserializer::deserializeMap);
+  setDeserializerMethod(treeMapper, data::type::__class::AbstractUnorderedMap::CLASS_ID, &ObjectDeserializer::deserializeMap);
+
+}
+
+void ObjectDeserializer::setDeserializerMethod(const data::mapping::TreeToObjectMapper& defaultTreeMapper,
+                                               const data::type::ClassId& classId,
+                                               DeserializerMethod method)
+{
+  const auto id = static_cast<v_uint32>(classId.id);
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, {nullptr, nullptr});
+  }
+  m_methods[id] = {method, defaultTreeMapper.getMapperMethod(classId)};
+}
+
+ObjectDeserializer::DeserializerMethod ObjectDeserializer::getDirectMethod(const State& state, const data::type::Type* type) const {
+  const auto id = static_cast<v_uint32>(type->classId.id);
+  if(id < m_methods.size()) {
+    const auto& entry = m_methods[id];
+    /* direct method applies only as long as the tree mapper wasn't customized for this class */
+    if(entry.method && state.treeMapper->getMapperMethod(type->classId) == entry.treeMethod) {
+      return entry.method;
+    }
+  }
+  return nullptr;
+}
+
+void ObjectDeserializer::deserializeTree(State& state, data::mapping::Tree& tree) {
+
+  Deserializer::State deserializerState;
+  deserializerState.caret = state.caret;
+  deserializerState.config = state.config;
+  deserializerState.tree = &tree;
+
+  Deserializer::deserialize(deserializerState);
+  if(!deserializerState.errorStack.empty()) {
+    state.errorStack.splice(deserializerState.errorStack);
+    state.syntaxError = true;
+  }
+
+}
+
+void ObjectDeserializer::pushSyntaxError(State& state, const oatpp::String& message) {
+  state.errorStack.push(message);
+  state.syntaxError = true;
+}
+
+bool ObjectDeserializer::spliceNestedError(State& state, State& nestedState) {
+
+  if(nestedState.errorStack.empty()) {
+    return false;
+  }
+
+  /*
+   * Value which failed to parse without a syntax error of its own (ex.: broken string) is reported by
+   * the enclosing container - same as Deserializer does. Mapping errors of such values are dropped.
+   */
+  if(!nestedState.syntaxError && state.caret->hasError()) {
+    return false;
+  }
+
+  state.errorStack.splice(nestedState.errorStack);
+  state.syntaxError = nestedState.syntaxError;
+  return true;
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeViaTree(State& state, const data::type::Type* type) const {
+
+  data::mapping::Tree tree;
+
+  deserializeTree(state, tree);
+  if(!state.errorStack.empty()) {
+    return nullptr;
+  }
+
+  data::mapping::TreeToObjectMapper::State mapperState;
+  mapperState.config = state.mapperConfig;
+  mapperState.tree = &tree;
+
+  auto result = state.treeMapper->map(mapperState, type);
+  if(!mapperState.errorStack.empty()) {
+    state.errorStack.splice(mapperState.errorStack);
+    return nullptr;
+  }
+
+  return result;
+
+}
+
+oatpp::Void ObjectDeserializer::deserialize(State& state, const data::type::Type* type) const {
+
+  auto method = getDirectMethod(state, type);
+  if(method) {
+    return (*method)(this, state, type);
+  }
+
+  if(!state.treeMapper->getMapperMethod(type->classId)) {
+    auto* interpretation = type->findInterpretation(state.mapperConfig->enabledInterpretations);
+    if(interpretation) {
+      return interpretation->fromInterpretation(deserialize(state, interpretation->getInterpretationType()));
+    }
+  }
+
+  return deserializeViaTree(state, type);
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeCollection(const ObjectDeserializer* deserializer, State& state, const data::type::Type* type) {
+
+  auto caret = state.caret;
+
+  caret->skipBlankChars();
+  if(!caret->isAtChar('[')) {
+    /* null or json type mismatch */
+    return deserializer->deserializeViaTree(state, type);
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto collection = dispatcher->createObject();
+
+  auto itemType = dispatcher->getItemType();
+
+  caret->canContinueAtChar('[', 1);
+  caret->skipBlankChars();
+
+  v_int64 index = 0;
+
+  while(!caret->isAtChar(']') && caret->canContinue()) {
+
+    caret->skipBlankChars();
+
+    State nestedState;
+    nestedState.mapperConfig = state.mapperConfig;
+    nestedState.config = state.config;
+    nestedState.treeMapper = state.treeMapper;
+    nestedState.caret = caret;
+
+    auto item = deserializer->deserialize(nestedState, itemType);
+
+    if(spliceNestedError(state, nestedState)) {
+      if(state.syntaxError) {
+        state.errorStack.push("[oatpp::json::Deserializer::deserializeArray()]: index=" + utils::Conversion::int64ToStr(index));
+      } else {
+        state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapCollection()]: index=" +
+                              utils::Conversion::uint64ToStr(static_cast<v_uint64>(index)));
+      }
+      return nullptr;
+    }
+
+    dispatcher->addItem(collection, item);
+
+    caret->skipBlankChars();
+    caret->canContinueAtChar(',', 1);
+
+    index ++;
+
+  }
+
+  if(!caret->canContinueAtChar(']', 1)) {
+    pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeArray()]: ']' expected");
+    return nullptr;
+  }
+
+  return collection;
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeMap(const ObjectDeserializer* deserializer, State& state, const data::type::Type* type) {
+
+  auto caret = state.caret;
+
+  caret->skipBlankChars();
+  if(!caret->isAtChar('{')) {
+    /* null or json type mismatch */
+    return deserializer->deserializeViaTree(state, type);
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+
+  auto keyType = dispatcher->getKeyType();
+  if(keyType->classId != oatpp::String::Class::CLASS_ID){
+    /* let tree mapper report it - after the value is parsed */
+    return deserializer->deserializeViaTree(state, type);
+  }
+  auto valueType = dispatcher->getValueType();
+
+  auto map = dispatcher->createObject();
+
+  /*
+   * Json object with duplicate keys keeps the first position and the last value (see Tree::TreeMap).
+   * Unordered map does it on its own. Pairs of PairList are collected and deduplicated first.
+   */
+  const bool collectPairs = type->classId == data::type::__class::AbstractPairList::CLASS_ID;
+  std::vector<std::pair<oatpp::String, oatpp::Void>> pairs;
+  std::unordered_map<std::string, size_t> pairIndex;
+
+  caret->canContinueAtChar('{', 1);
+  caret->skipBlankChars();
+
+  while(!caret->isAtChar('}') && caret->canContinue()) {
+
+    caret->skipBlankChars();
+
+    auto key = Utils::parseString(*caret);
+    if(caret->hasError()){
+      pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeMap()]: Item key name expected");
+      return nullptr;
+    }
+
+    caret->skipBlankChars();
+    if(!caret->canContinueAtChar(':', 1)){
+      pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeMap()]: ':' expected");
+      return nullptr;
+    }
+
+    caret->skipBlankChars();
+
+    State nestedState;
+    nestedState.mapperConfig = state.mapperConfig;
+    nestedState.config = state.config;
+    nestedState.treeMapper = state.treeMapper;
+    nestedState.caret = caret;
+
+    auto item = deserializer->deserialize(nestedState, valueType);
+
+    if(spliceNestedError(state, nestedState)) {
+      if(state.syntaxError) {
+        state.errorStack.push("[oatpp::json::Deserializer::deserializeMap()]: key='" + key + "'");
+      } else {
+        state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapMap()]: key='" + key + "'");
+      }
+      return nullptr;
+    }
+
+    if(collectPairs) {
+      auto it = pairIndex.find(*key);
+      if(it != pairIndex.end()) {
+        pairs[it->second].second = item;
+      } else {
+        pairIndex.insert({*key, pairs.size()});
+        pairs.emplace_back(key, item);
+      }
+    } else {
+      dispatcher->addItem(map, key, item);
+    }
+
+    caret->skipBlankChars();
+    caret->canContinueAtChar(',', 1);
+
+  }
+
+  if(!caret->canContinueAtChar('}', 1)){
+    pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeMap()]: '}' expected");
+    return nullptr;
+  }
+
+  for(auto& pair : pairs) {
+    dispatcher->addItem(map, pair.first, pair.second);
+  }
+
+  return map;
+
+}
+
+oatpp::Void ObjectDeserializer::deserializeObject(const ObjectDeserializer* deserializer, State& state, const data::type::Type* type) {
+
+  auto caret = state.caret;
+
+  caret->skipBlankChars();
+  if(!caret->isAtChar('{')) {
+    /* null or json type mismatch */
+    return deserializer->deserializeViaTree(state, type);
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto object = dispatcher->createObject();
+  const std::unordered_map<std::string, BaseObject::Property*>* fieldsMap;
+
+  if(state.mapperConfig->useUnqualifiedFieldNames) {
+    fieldsMap = std::addressof(dispatcher->getProperties()->getUnqualifiedMap());
+  } else {
+    fieldsMap = std::addressof(dispatcher->getProperties()->getMap());
+  }
+
+  /* polymorphs are mapped after all other fields - their type depends on other fields */
+  std::vector<std::pair<oatpp::BaseObject::Property*, data::mapping::Tree>> polymorphs;
+
+  caret->canContinueAtChar('{', 1);
+  caret->skipBlankChars();
+
+  while(!caret->isAtChar('}') && caret->canContinue()) {
+
+    caret->skipBlankChars();
+
+    auto key = Utils::parseString(*caret);
+    if(caret->hasError()){
+      pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeMap()]: Item key name expected");
+      return nullptr;
+    }
+
+    caret->skipBlankChars();
+    if(!caret->canContinueAtChar(':', 1)){
+      pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeMap()]: ':' expected");
+      return nullptr;
+    }
+
+    caret->skipBlankChars();
+
+    State nestedState;
+    nestedState.mapperConfig = state.mapperConfig;
+    nestedState.config = state.config;
+    nestedState.treeMapper = state.treeMapper;
+    nestedState.caret = caret;
+
+    auto fieldIterator = fieldsMap->find(*key);
+    if(fieldIterator != fieldsMap->end()) {
+
+      auto field = fieldIterator->second;
+
+      if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
+
+        data::mapping::Tree tree;
+        deserializeTree(nestedState, tree);
+
+        if(spliceNestedError(state, nestedState)) {
+          state.errorStack.push("[oatpp::json::Deserializer::deserializeMap()]: key='" + key + "'");
+          return nullptr;
+        }
+
+        auto it = polymorphs.begin();
+        while(it != polymorphs.end() && it->first != field) {
+          it ++;
+        }
+        if(it != polymorphs.end()) {
+          it->second = std::move(tree);
+        } else {
+          polymorphs.emplace_back(field, std::move(tree));
+        }
+
+      } else {
+
+        auto value = deserializer->deserialize(nestedState, field->type);
+
+        if(spliceNestedError(state, nestedState)) {
+          if(state.syntaxError) {
+            state.errorStack.push("[oatpp::json::Deserializer::deserializeMap()]: key='" + key + "'");
+          } else {
+            state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: field='" + key + "'");
+          }
+          return nullptr;
+        }
+
+        if(!caret->hasError()) {
+
+          if(field->info.required && value == nullptr) {
+            state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. " +
+                                  oatpp::String(type->nameQualifier) + "::" +
+                                  oatpp::String(field->name) + " is required!");
+            return nullptr;
+          }
+
+          field->set(static_cast<oatpp::BaseObject *>(object.get()), value);
+
+        }
+
+      }
+
+    } else {
+
+      /* skip value of the unknown field */
+      data::mapping::Tree tree;
+      deserializeTree(nestedState, tree);
+
+      if(spliceNestedError(state, nestedState)) {
+        state.errorStack.push("[oatpp::json::Deserializer::deserializeMap()]: key='" + key + "'");
+        return nullptr;
+      }
+
+      if(!state.mapperConfig->allowUnknownFields && !caret->hasError()) {
+        state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. Unknown field '" + key + "'");
+        return nullptr;
+      }
+
+    }
+
+    caret->skipBlankChars();
+    caret->canContinueAtChar(',', 1);
+
+  }
+
+  if(!caret->canContinueAtChar('}', 1)){
+    pushSyntaxError(state, "[oatpp::json::Deserializer::deserializeMap()]: '}' expected");
+    return nullptr;
+  }
+
+  for(auto& p : polymorphs) {
+
+    auto selectedType = p.first->info.typeSelector->selectType(static_cast<oatpp::BaseObject *>(object.get()));
+
+    data::mapping::TreeToObjectMapper::State mapperState;
+    mapperState.config = state.mapperConfig;
+    mapperState.tree = &p.second;
+
+    auto value = state.treeMapper->map(mapperState, selectedType);
+
+    if(!mapperState.errorStack.empty()) {
+      state.errorStack.splice(mapperState.errorStack);
+      state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: field='" + oatpp::String(p.first->name) + "'");
+      return nullptr;
+    }
+
+    if(p.first->info.required && value == nullptr) {
+      state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. " +
+                            oatpp::String(type->nameQualifier) + "::" +
+                            oatpp::String(p.first->name) + " is required!");
+      return nullptr;
+    }
+
+    oatpp::Any any(value);
+    p.first->set(static_cast<oatpp::BaseObject *>(object.get()), oatpp::Void(any.getPtr(), p.first->type));
+
+  }
+
+  return object;
+
+}
+
+}}
@@ -0,0 +1,125 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_ObjectDeserializer_hpp
+#define oatpp_json_ObjectDeserializer_hpp
+
+#include "./Deserializer.hpp"
+
+#include "oatpp/data/mapping/TreeToObjectMapper.hpp"
+
+namespace oatpp { namespace json {
+
+/**
+ * Deserializes oatpp objects from json in a single pass - without building intermediate &id:oatpp::data::mapping::Tree;. <br>
+ * Produces the same result and reports the same errors as &id:oatpp::json::Deserializer; followed by
+ * &id:oatpp::data::mapping::TreeToObjectMapper;. <br>
+ * Objects, collections and maps are populated right from the token stream. Scalars are parsed into a single
+ * &id:oatpp::data::mapping::Tree; node and mapped by the tree mapper. `oatpp::Tree` and `oatpp::Any` values,
+ * values of classes which have custom (not default) mapper method set in the &id:oatpp::data::mapping::TreeToObjectMapper;,
+ * and values of unexpected json type are deserialized to &id:oatpp::data::mapping::Tree; first.
+ */
+class ObjectDeserializer : public base::Countable {
+public:
+
+  /**
+   * Deserializer state.
+   */
+  struct State {
+
+    /**
+     * Mapper config - &id:oatpp::data::mapping::TreeToObjectMapper::Config;.
+     */
+    const data::mapping::TreeToObjectMapper::Config* mapperConfig;
+
+    /**
+     * Json config - &id:oatpp::json::Deserializer::Config;.
+     */
+    const Deserializer::Config* config;
+
+    /**
+     * Tree mapper used for scalars and for classes with custom mapper methods.
+     */
+    const data::mapping::TreeToObjectMapper* treeMapper;
+
+    utils::parser::Caret* caret;
+    data::mapping::ErrorStack errorStack;
+
+    /**
+     * `true` if the error in `errorStack` is a json syntax error (not a mapping error).
+     */
+    bool syntaxError = false;
+
+  };
+
+public:
+  typedef oatpp::Void (*DeserializerMethod)(const ObjectDeserializer*, State&, const data::type::Type*);
+public:
+
+  static oatpp::Void deserializeCollection(const ObjectDeserializer* deserializer, State& state, const data::type::Type* type);
+  static oatpp::Void deserializeMap(const ObjectDeserializer* deserializer, State& state, const data::type::Type* type);
+
+  static oatpp::Void deserializeObject(const ObjectDeserializer* deserializer, State& state, const data::type::Type* type);
+
+private:
+
+  struct MethodEntry {
+    DeserializerMethod method;
+    /* default tree-mapper method this method stands for */
+    data::mapping::TreeToObjectMapper::MapperMethod treeMethod;
+  };
+
+private:
+  static void pushSyntaxError(State& state, const oatpp::String& message);
+  static bool spliceNestedError(State& state, State& nestedState);
+  static void deserializeTree(State& state, data::mapping::Tree& tree);
+private:
+  void setDeserializerMethod(const data::mapping::TreeToObjectMapper& defaultTreeMapper,
+                             const data::type::ClassId& classId,
+                             DeserializerMethod method);
+  DeserializerMethod getDirectMethod(const State& state, const data::type::Type* type) const;
+  oatpp::Void deserializeViaTree(State& state, const data::type::Type* type) const;
+private:
+  std::vector<MethodEntry> m_methods;
+public:
+
+  /**
+   * Constructor.
+   */
+  ObjectDeserializer();
+
+  /**
+   * Deserialize value of the given type from `state.caret`.
+   * @param state - &l:ObjectDeserializer::State;.
+   * @param type - &id:oatpp::data::type::Type;.
+   * @return - deserialized value. `nullptr` if `state.errorStack` is not empty.
+   */
+  oatpp::Void deserialize(State& state, const data::type::Type* type) const;
+
+};
+
+}}
+
+#endif /* oatpp_json_ObjectDeserializer_hpp */
@@ -24,6 +24,8 @@
 
 #include "ObjectMapper.hpp"
 
+#include "oatpp/data/stream/BufferStream.hpp"
+
 namespace oatpp { namespace json {
 
 ObjectMapper::ObjectMapper(const SerializerConfig& serializerConfig, const DeserializerConfig& deserializerConfig)
@@ -52,27 +54,45 @@ void ObjectMapper::write(data::stream::ConsistentOutputStream* stream, const oat
     return;
   }
 
-  data::mapping::Tree tree;
-  data::mapping::ObjectToTreeMapper::State state;
+  ObjectSerializer::State state;
+  state.mapperConfig = &m_serializerConfig.mapper;
+  state.config = &m_serializerConfig.json;
+  state.treeMapper = &m_objectToTreeMapper;
 
-  state.config = &m_serializerConfig.mapper;
-  state.tree = &tree;
+  /*
+   * Mapping error may be found in the middle of the object - the partial json must not reach the stream.
+   * Buffer stream is rolled back on error, other streams get the json via scratch buffer.
+   */
+  auto bufferStream = dynamic_cast<data::stream::BufferOutputStream*>(stream);
 
-  m_objectToTreeMapper.map(state, variant);
-  if(!state.errorStack.empty()) {
-    errorStack = std::move(state.errorStack);
-    return;
-  }
+  if(bufferStream) {
+
+    auto position = bufferStream->getCurrentPosition();
+    m_objectSerializer.serializeToStream(bufferStream, state, variant);
+    if(!state.errorStack.empty()) {
+      bufferStream->setCurrentPosition(position);
+      errorStack = std::move(state.errorStack);
+    }
 
-  writeTree(stream, tree, errorStack);
+  } else {
+
+    data::stream::BufferOutputStream scratch;
+    m_objectSerializer.serializeToStream(&scratch, state, variant);
+    if(!state.errorStack.empty()) {
+      errorStack = std::move(state.errorStack);
+      return;
+    }
+    stream->writeSimple(scratch.getData(), scratch.getCurrentPosition());
+
+  }
 
 }
 
 oatpp::Void ObjectMapper::read(utils::parser::Caret& caret, const data::type::Type* type, data::mapping::ErrorStack& errorStack) const {
 
-  data::mapping::Tree tree;
-
-  {
+  /* if expected type is Tree (root element is Tree) - then we can just move deserialized tree */
+  if(type == data::type::Tree::Class::getType()) {
+    data::mapping::Tree tree;
     Deserializer::State state;
     state.caret = &caret;
     state.tree = &tree;
@@ -82,25 +102,30 @@ oatpp::Void ObjectMapper::read(utils::parser::Caret& caret, const data::type::Ty
       errorStack = std::move(state.errorStack);
       return nullptr;
     }
-  }
-
-  /* if expected type is Tree (root element is Tree) - then we can just move deserialized tree */
-  if(type == data::type::Tree::Class::getType()) {
     return oatpp::Tree(std::move(tree));
   }
 
-  {
-    data::mapping::TreeToObjectMapper::State state;
-    state.tree = &tree;
-    state.config = &m_deserializerConfig.mapper;
-    const auto & result = m_treeToObjectMapper.map(state, type);
-    if(!state.errorStack.empty()) {
-      errorStack = std::move(state.errorStack);
-      return nullptr;
-    }
-    return result;
+  ObjectDeserializer::State state;
+  state.mapperConfig = &m_deserializerConfig.mapper;
+  state.config = &m_deserializerConfig.json;
+  state.treeMapper = &m_treeToObjectMapper;
+  state.caret = &caret;
+
+  const auto& result = m_objectDeserializer.deserialize(state, type);
+  if(!state.errorStack.empty()) {
+    errorStack = std::move(state.errorStack);
+    return nullptr;
   }
+  return result;
+
+}
+
+std::shared_ptr<data::mapping::ObjectReader> ObjectMapper::createReader(const oatpp::Type* type) const {
+  return std::make_shared<ObjectReader>(&m_deserializerConfig.mapper, &m_deserializerConfig.reader, &m_treeToObjectMapper, type);
+}
 
+std::shared_ptr<data::mapping::ObjectWriter> ObjectMapper::createWriter(const oatpp::Void& variant) const {
+  return std::make_shared<ObjectWriter>(&m_serializerConfig.mapper, &m_serializerConfig.json, &m_objectToTreeMapper, &m_objectSerializer, variant);
 }
 
 const data::mapping::ObjectToTreeMapper& ObjectMapper::objectToTreeMapper() const {
@@ -26,7 +26,11 @@
 #define oatpp_json_ObjectMapper_hpp
 
 #include "./Serializer.hpp"
+#include "./ObjectSerializer.hpp"
 #include "./Deserializer.hpp"
+#include "./ObjectDeserializer.hpp"
+#include "./ObjectReader.hpp"
+#include "./ObjectWriter.hpp"
 
 #include "oatpp/data/mapping/ObjectToTreeMapper.hpp"
 #include "oatpp/data/mapping/TreeToObjectMapper.hpp"
@@ -51,6 +55,7 @@ public:
   public:
     data::mapping::TreeToObjectMapper::Config mapper;
     Deserializer::Config json;
+    ObjectReader::Config reader;
   };
 
 public:
@@ -69,14 +74,51 @@ private:
 private:
   data::mapping::ObjectToTreeMapper m_objectToTreeMapper;
   data::mapping::TreeToObjectMapper m_treeToObjectMapper;
+  ObjectSerializer m_objectSerializer;
+  ObjectDeserializer m_objectDeserializer;
 public:
 
   ObjectMapper(const SerializerConfig& serializerConfig = {}, const DeserializerConfig& deserializerConfig = {});
 
+  /**
+   * Write object as json. <br>
+   * Objects are serialized in a single pass by &id:oatpp::json::ObjectSerializer; - without intermediate &id:oatpp::data::mapping::Tree;.
+   * Classes having custom mapper methods in &l:ObjectMapper::objectToTreeMapper (); are still mapped by that methods. <br>
+   * On a mapping error nothing is written to the stream - &id:oatpp::data::stream::BufferOutputStream; is rolled back,
+   * other streams receive the json from an intermediate buffer once serialization succeeds.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param variant - object to write.
+   * @param errorStack - &id:oatpp::data::mapping::ErrorStack;.
+   */
   void write(data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant, data::mapping::ErrorStack& errorStack) const override;
 
+  /**
+   * Read object from json. <br>
+   * Objects are deserialized in a single pass by &id:oatpp::json::ObjectDeserializer; - without intermediate &id:oatpp::data::mapping::Tree;.
+   * Classes having custom mapper methods in &l:ObjectMapper::treeToObjectMapper (); are still mapped by that methods.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param type - type of the object to read.
+   * @param errorStack - &id:oatpp::data::mapping::ErrorStack;.
+   * @return - deserialized object.
+   */
   oatpp::Void read(oatpp::utils::parser::Caret& caret, const oatpp::Type* type, data::mapping::ErrorStack& errorStack) const override;
 
+  /**
+   * Create incremental json reader - &id:oatpp::json::ObjectReader;. <br>
+   * Reader is configured with `mapper` and `reader` sections of &l:ObjectMapper::DeserializerConfig;.
+   * @param type - type of the object to read.
+   * @return - `std::shared_ptr` to &id:oatpp::data::mapping::ObjectReader;.
+   */
+  std::shared_ptr<data::mapping::ObjectReader> createReader(const oatpp::Type* type) const override;
+
+  /**
+   * Create incremental json writer - &id:oatpp::json::ObjectWriter;. <br>
+   * Writer is configured with &l:ObjectMapper::SerializerConfig;.
+   * @param variant - object to write.
+   * @return - `std::shared_ptr` to &id:oatpp::data::mapping::ObjectWriter;.
+   */
+  std::shared_ptr<data::mapping::ObjectWriter> createWriter(const oatpp::Void& variant) const override;
+
   const data::mapping::ObjectToTreeMapper& objectToTreeMapper() const;
   const data::mapping::TreeToObjectMapper& treeToObjectMapper() const;
 
@@ -0,0 +1,832 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectReader.hpp"
+
+#include "./Utils.hpp"
+
+#include "oatpp/utils/CharScan.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+namespace oatpp { namespace json {
+
+data::mapping::Tree* ObjectReader::Frame::getNode() {
+  switch(capture) {
+    case Capture::NONE: return node;
+    case Capture::DISCARD: return nullptr;
+    case Capture::TARGET:
+    case Capture::POLYMORPH:
+    default:
+      return &tree;
+  }
+}
+
+ObjectReader::ObjectReader(const data::mapping::TreeToObjectMapper::Config* mapperConfig,
+                           const Config* config,
+                           const data::mapping::TreeToObjectMapper* treeMapper,
+                           const data::type::Type* type)
+  : m_mapperConfig(mapperConfig)
+  , m_config(config)
+  , m_treeMapper(treeMapper)
+  , m_type(type)
+  , m_expect(Expect::VALUE)
+  , m_token(Token::NONE)
+  , m_escape(false)
+  , m_size(0)
+  , m_position(0)
+  , m_failed(false)
+{
+  m_frames.reserve(16);
+}
+
+void ObjectReader::failSyntax(const char* message) {
+  m_errorStack.push("[oatpp::json::ObjectReader]: Error. " + oatpp::String(message) +
+                    ". Position=" + utils::Conversion::int64ToStr(m_position));
+  m_failed = true;
+}
+
+void ObjectReader::failMapping(data::mapping::ErrorStack& errorStack, bool withTopContext) {
+  m_errorStack.splice(errorStack);
+  for(auto it = m_frames.rbegin(); it != m_frames.rend(); it ++) {
+    if(it != m_frames.rbegin() || withTopContext) {
+      pushContext(*it);
+    }
+  }
+  m_failed = true;
+}
+
+void ObjectReader::pushContext(const Frame& frame) {
+  switch(frame.frameType) {
+    case FrameType::OBJECT:
+      m_errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: field='" + frame.key + "'");
+      break;
+    case FrameType::COLLECTION:
+      m_errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapCollection()]: index=" +
+                        utils::Conversion::uint64ToStr(static_cast<v_uint64>(frame.index)));
+      break;
+    case FrameType::MAP:
+      m_errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapMap()]: key='" + frame.key + "'");
+      break;
+    case FrameType::TREE:
+    default:
+      break;
+  }
+}
+
+bool ObjectReader::isPolymorph(const BaseObject::Property* field) {
+  return field->info.typeSelector && field->type == oatpp::Any::Class::getType();
+}
+
+const data::type::Type* ObjectReader::getSlotType() const {
+  if(m_frames.empty()) {
+    return m_type;
+  }
+  const auto& top = m_frames.back();
+  if(top.frameType == FrameType::OBJECT) {
+    return top.field->type;
+  }
+  return top.itemType;
+}
+
+void ObjectReader::storePolymorph(Frame& frame, BaseObject::Property* field, data::mapping::Tree&& tree) {
+  for(auto& p : frame.polymorphs) {
+    if(p.first == field) {
+      p.second = std::move(tree);
+      return;
+    }
+  }
+  frame.polymorphs.emplace_back(field, std::move(tree));
+}
+
+void ObjectReader::beginValue(char c) {
+
+  switch(c) {
+
+    case '{':
+      beginContainer(false);
+      return;
+
+    case '[':
+      beginContainer(true);
+      return;
+
+    case '"':
+      m_token = Token::STRING;
+      m_tokenBuffer.clear();
+      m_escape = false;
+      return;
+
+    case 't':
+    case 'f':
+    case 'n':
+      m_token = Token::LITERAL;
+      m_tokenBuffer.assign(1, c);
+      return;
+
+    default:
+      if(c == '-' || (c >= '0' && c <= '9')) {
+        m_token = Token::NUMBER;
+        m_tokenBuffer.assign(1, c);
+        return;
+      }
+
+  }
+
+  failSyntax("Unexpected character");
+
+}
+
+void ObjectReader::beginContainer(bool isArray) {
+
+  if(m_config->maxDepth > 0 && m_frames.size() >= m_config->maxDepth) {
+    failSyntax("Max nesting depth exceeded");
+    return;
+  }
+
+  if(!m_frames.empty()) {
+    auto& top = m_frames.back();
+    if(top.frameType == FrameType::TREE) {
+      pushTreeFrame(isArray, Capture::NONE, top.slot, nullptr, nullptr);
+      return;
+    }
+    if(top.frameType == FrameType::OBJECT) {
+      if(top.field == nullptr) {
+        pushTreeFrame(isArray, Capture::DISCARD, nullptr, nullptr, nullptr);
+        return;
+      }
+      if(isPolymorph(top.field)) {
+        pushTreeFrame(isArray, Capture::POLYMORPH, nullptr, nullptr, top.field);
+        return;
+      }
+    }
+  }
+
+  const auto type = getSlotType();
+
+  /* containers of default mapped classes are populated directly - including those behind interpretations */
+  std::vector<const data::type::Type::AbstractInterpretation*> interpretations;
+  auto currType = type;
+
+  while(true) {
+
+    auto method = m_treeMapper->getMapperMethod(currType->classId);
+
+    if(method) {
+
+      const auto& classId = currType->classId;
+
+      if(isArray && method == &data::mapping::TreeToObjectMapper::mapCollection &&
+         (classId == data::type::__class::AbstractVector::CLASS_ID ||
+          classId == data::type::__class::AbstractList::CLASS_ID ||
+          classId == data::type::__class::AbstractUnorderedSet::CLASS_ID))
+      {
+
+        auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(currType->polymorphicDispatcher);
+
+        m_frames.emplace_back();
+        auto& frame = m_frames.back();
+        frame.frameType = FrameType::COLLECTION;
+        frame.type = currType;
+        frame.value = dispatcher->createObject();
+        frame.interpretations = std::move(interpretations);
+        frame.itemType = dispatcher->getItemType();
+        m_expect = Expect::ELEMENT;
+        return;
+
+      }
+
+      if(!isArray && method == &data::mapping::TreeToObjectMapper::mapObject &&
+         classId == data::type::__class::AbstractObject::CLASS_ID)
+      {
+
+        auto dispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(currType->polymorphicDispatcher);
+
+        m_frames.emplace_back();
+        auto& frame = m_frames.back();
+        frame.frameType = FrameType::OBJECT;
+        frame.type = currType;
+        frame.value = dispatcher->createObject();
+        frame.interpretations = std::move(interpretations);
+        if(m_mapperConfig->useUnqualifiedFieldNames) {
+          frame.fieldsMap = std::addressof(dispatcher->getProperties()->getUnqualifiedMap());
+        } else {
+          frame.fieldsMap = std::addressof(dispatcher->getProperties()->getMap());
+        }
+        m_expect = Expect::ELEMENT;
+        return;
+
+      }
+
+      if(!isArray && method == &data::mapping::TreeToObjectMapper::mapMap &&
+         (classId == data::type::__class::AbstractPairList::CLASS_ID ||
+          classId == data::type::__class::AbstractUnorderedMap::CLASS_ID))
+      {
+
+        auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(currType->polymorphicDispatcher);
+
+        if(dispatcher->getKeyType()->classId == oatpp::String::Class::CLASS_ID) {
+          m_frames.emplace_back();
+          auto& frame = m_frames.back();
+          frame.frameType = FrameType::MAP;
+          frame.type = currType;
+          frame.value = dispatcher->createObject();
+          frame.interpretations = std::move(interpretations);
+          frame.itemType = dispatcher->getValueType();
+          /* json object keeps the first position and the last value of a duplicate key - PairList can't do it on its own */
+          frame.collectPairs = classId == data::type::__class::AbstractPairList::CLASS_ID;
+          m_expect = Expect::ELEMENT;
+          return;
+        }
+
+      }
+
+      break;
+
+    }
+
+    auto interpretation = currType->findInterpretation(m_mapperConfig->enabledInterpretations);
+    if(!interpretation) {
+      break;
+    }
+    interpretations.push_back(interpretation);
+    currType = interpretation->getInterpretationType();
+
+  }
+
+  /* collect to tree and let the tree mapper map it (or report an error) */
+  pushTreeFrame(isArray, Capture::TARGET, nullptr, type, nullptr);
+
+}
+
+void ObjectReader::pushTreeFrame(bool isArray, Capture capture, data::mapping::Tree* node,
+                                 const data::type::Type* type, BaseObject::Property* field)
+{
+  m_frames.emplace_back();
+  auto& frame = m_frames.back();
+  frame.frameType = FrameType::TREE;
+  frame.isArray = isArray;
+  frame.capture = capture;
+  frame.node = node;
+  frame.type = type;
+  frame.field = field;
+  auto n = frame.getNode();
+  if(n) {
+    if(isArray) {
+      n->setVector(0);
+    } else {
+      n->setMap({});
+    }
+  }
+  m_expect = Expect::ELEMENT;
+}
+
+void ObjectReader::onKey(const oatpp::String& key) {
+
+  auto& top = m_frames.back();
+  top.key = key;
+
+  switch(top.frameType) {
+
+    case FrameType::OBJECT: {
+      auto it = top.fieldsMap->find(*key);
+      if(it != top.fieldsMap->end()) {
+        top.field = it->second;
+      } else {
+        top.field = nullptr;
+        if(!m_mapperConfig->allowUnknownFields) {
+          data::mapping::ErrorStack errorStack;
+          errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. Unknown field '" + key + "'");
+          failMapping(errorStack, false);
+          return;
+        }
+      }
+      break;
+    }
+
+    case FrameType::TREE: {
+      auto n = top.getNode();
+      top.slot = n ? std::addressof(n->getMap()[key]) : nullptr;
+      break;
+    }
+
+    case FrameType::COLLECTION:
+    case FrameType::MAP:
+    default:
+      break;
+
+  }
+
+  m_expect = Expect::COLON;
+
+}
+
+void ObjectReader::onScalar(Token token) {
+
+  if(!m_frames.empty()) {
+
+    auto& top = m_frames.back();
+
+    if(top.frameType == FrameType::TREE) {
+      if(parseScalar(token, top.slot ? *top.slot : m_leaf)) {
+        m_expect = Expect::AFTER_VALUE;
+      }
+      return;
+    }
+
+    if(top.frameType == FrameType::OBJECT) {
+      if(top.field == nullptr) {
+        if(parseScalar(token, m_leaf)) {
+          m_expect = Expect::AFTER_VALUE;
+        }
+        return;
+      }
+      if(isPolymorph(top.field)) {
+        if(parseScalar(token, m_leaf)) {
+          storePolymorph(top, top.field, std::move(m_leaf));
+          m_expect = Expect::AFTER_VALUE;
+        }
+        return;
+      }
+    }
+
+  }
+
+  if(!parseScalar(token, m_leaf)) {
+    return;
+  }
+
+  data::mapping::TreeToObjectMapper::State state;
+  state.config = m_mapperConfig;
+  state.tree = &m_leaf;
+
+  const auto& value = m_treeMapper->map(state, getSlotType());
+  if(!state.errorStack.empty()) {
+    failMapping(state.errorStack, true);
+    return;
+  }
+
+  onValue(value);
+
+}
+
+void ObjectReader::onValue(const oatpp::Void& value) {
+
+  if(m_frames.empty()) {
+    m_result = value;
+    m_expect = Expect::DONE;
+    return;
+  }
+
+  auto& top = m_frames.back();
+
+  switch(top.frameType) {
+
+    case FrameType::OBJECT: {
+      if(top.field->info.required && value == nullptr) {
+        data::mapping::ErrorStack errorStack;
+        errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. " +
+                        oatpp::String(top.type->nameQualifier) + "::" +
+                        oatpp::String(top.field->name) + " is required!");
+        failMapping(errorStack, false);
+        return;
+      }
+      top.field->set(static_cast<oatpp::BaseObject *>(top.value.get()), value);
+      break;
+    }
+
+    case FrameType::COLLECTION: {
+      auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(top.type->polymorphicDispatcher);
+      dispatcher->addItem(top.value, value);
+      top.index ++;
+      break;
+    }
+
+    case FrameType::MAP: {
+      if(top.collectPairs) {
+        auto it = top.pairIndex.find(*top.key);
+        if(it != top.pairIndex.end()) {
+          top.pairs[it->second].second = value;
+        } else {
+          top.pairIndex.insert({*top.key, top.pairs.size()});
+          top.pairs.emplace_back(top.key, value);
+        }
+      } else {
+        auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(top.type->polymorphicDispatcher);
+        dispatcher->addItem(top.value, top.key, value);
+      }
+      break;
+    }
+
+    case FrameType::TREE:
+    default:
+      break;
+
+  }
+
+  m_expect = Expect::AFTER_VALUE;
+
+}
+
+void ObjectReader::onFrameComplete() {
+
+  auto& top = m_frames.back();
+
+  oatpp::Void value;
+
+  switch(top.frameType) {
+
+    case FrameType::TREE: {
+
+      switch(top.capture) {
+
+        case Capture::POLYMORPH: {
+          auto field = top.field;
+          data::mapping::Tree tree = std::move(top.tree);
+          m_frames.pop_back();
+          storePolymorph(m_frames.back(), field, std::move(tree));
+          m_expect = Expect::AFTER_VALUE;
+          return;
+        }
+
+        case Capture::TARGET: {
+
+          auto type = top.type;
+          data::mapping::Tree tree = std::move(top.tree);
+          m_frames.pop_back();
+
+          if(type == oatpp::Tree::Class::getType() &&
+             m_treeMapper->getMapperMethod(type->classId) == &data::mapping::TreeToObjectMapper::mapTree)
+          {
+            onValue(oatpp::Tree(std::move(tree)));
+            return;
+          }
+
+          data::mapping::TreeToObjectMapper::State state;
+          state.config = m_mapperConfig;
+          state.tree = &tree;
+
+          const auto& result = m_treeMapper->map(state, type);
+          if(!state.errorStack.empty()) {
+            failMapping(state.errorStack, true);
+            return;
+          }
+
+          onValue(result);
+          return;
+
+        }
+
+        case Capture::NONE:
+        case Capture::DISCARD:
+        default:
+          m_frames.pop_back();
+          m_expect = Expect::AFTER_VALUE;
+          return;
+
+      }
+
+    }
+
+    case FrameType::OBJECT: {
+
+      auto object = static_cast<oatpp::BaseObject *>(top.value.get());
+
+      for(auto& p : top.polymorphs) {
+
+        auto selectedType = p.first->info.typeSelector->selectType(object);
+
+        data::mapping::TreeToObjectMapper::State state;
+        state.config = m_mapperConfig;
+        state.tree = &p.second;
+
+        auto polymorph = m_treeMapper->map(state, selectedType);
+
+        if(!state.errorStack.empty()) {
+          state.errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: field='" + oatpp::String(p.first->name) + "'");
+          m_frames.pop_back();
+          failMapping(state.errorStack, true);
+          return;
+        }
+
+        if(p.first->info.required && polymorph == nullptr) {
+          data::mapping::ErrorStack errorStack;
+          errorStack.push("[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. " +
+                          oatpp::String(top.type->nameQualifier) + "::" +
+                          oatpp::String(p.first->name) + " is required!");
+          m_frames.pop_back();
+          failMapping(errorStack, true);
+          return;
+        }
+
+        oatpp::Any any(polymorph);
+        p.first->set(object, oatpp::Void(any.getPtr(), p.first->type));
+
+      }
+
+      value = top.value;
+      break;
+
+    }
+
+    case FrameType::MAP: {
+      if(top.collectPairs) {
+        auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(top.type->polymorphicDispatcher);
+        for(auto& pair : top.pairs) {
+          dispatcher->addItem(top.value, pair.first, pair.second);
+        }
+      }
+      value = top.value;
+      break;
+    }
+
+    case FrameType::COLLECTION:
+    default:
+      value = top.value;
+      break;
+
+  }
+
+  for(auto it = top.interpretations.rbegin(); it != top.interpretations.rend(); it ++) {
+    value = (*it)->fromInterpretation(value);
+  }
+
+  m_frames.pop_back();
+  onValue(value);
+
+}
+
+bool ObjectReader::parseScalar(Token token, data::mapping::Tree& target) {
+
+  switch(token) {
+
+    case Token::STRING: {
+      v_int64 errorCode;
+      v_buff_size errorPosition;
+      auto str = Utils::unescapeString(m_tokenBuffer.data(), static_cast<v_buff_size>(m_tokenBuffer.size()), errorCode, errorPosition);
+      if(errorCode != 0) {
+        failSyntax("Invalid string");
+        return false;
+      }
+      target.setString(str);
+      return true;
+    }
+
+    case Token::NUMBER: {
+      const auto size = static_cast<v_buff_size>(m_tokenBuffer.size());
+      utils::parser::Caret caret(m_tokenBuffer.data(), size);
+      if(!Utils::findDecimalSeparatorInCurrentNumber(caret)) {
+        target.setInteger(caret.parseInt());
+      } else {
+        target.setFloat(caret.parseFloat64());
+      }
+      if(caret.hasError() || caret.getPosition() != size) {
+        failSyntax("Invalid number");
+        return false;
+      }
+      return true;
+    }
+
+    case Token::LITERAL: {
+      if(m_tokenBuffer == "null") {
+        target.setNull();
+      } else if(m_tokenBuffer == "true") {
+        target.setPrimitive<bool>(true);
+      } else if(m_tokenBuffer == "false") {
+        target.setPrimitive<bool>(false);
+      } else {
+        failSyntax("Invalid literal");
+        return false;
+      }
+      return true;
+    }
+
+    case Token::KEY:
+    case Token::NONE:
+    default:
+      return false;
+
+  }
+
+}
+
+void ObjectReader::completeToken() {
+
+  auto token = m_token;
+  m_token = Token::NONE;
+
+  if(token == Token::KEY) {
+    v_int64 errorCode;
+    v_buff_size errorPosition;
+    auto key = Utils::unescapeString(m_tokenBuffer.data(), static_cast<v_buff_size>(m_tokenBuffer.size()), errorCode, errorPosition);
+    if(errorCode != 0) {
+      failSyntax("Invalid key");
+      return;
+    }
+    onKey(key);
+    return;
+  }
+
+  onScalar(token);
+
+}
+
+v_io_size ObjectReader::write(const void *data, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  if(m_failed) {
+    return IOError::BROKEN_PIPE;
+  }
+
+  const auto base = m_size;
+  m_size += count;
+
+  if(m_config->maxDocumentSize > 0 && m_size > m_config->maxDocumentSize) {
+    m_position = m_config->maxDocumentSize;
+    failSyntax("Document size exceeds the limit");
+    return IOError::BROKEN_PIPE;
+  }
+
+  auto chars = static_cast<const char*>(data);
+  v_buff_size i = 0;
+
+  while(i < count && !m_failed) {
+
+    if(m_token == Token::STRING || m_token == Token::KEY) {
+      const auto start = i;
+      while(i < count) {
+        if(m_escape) {
+          m_escape = false;
+          i ++;
+          continue;
+        }
+        const auto found = utils::CharScan::findCharOf(chars + i, count - i, '"', '\\');
+        if(found < 0) {
+          i = count;
+          break;
+        }
+        i += found;
+        if(chars[i] == '"') {
+          break;
+        }
+        m_escape = true;
+        i ++;
+      }
+      m_tokenBuffer.append(chars + start, static_cast<size_t>(i - start));
+      if(i < count) {
+        m_position = base + i;
+        i ++;
+        completeToken();
+      }
+      continue;
+    }
+
+    const char c = chars[i];
+    m_position = base + i;
+
+    if(m_token == Token::NUMBER) {
+      if((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+        m_tokenBuffer.push_back(c);
+        i ++;
+      } else {
+        completeToken();
+      }
+      continue;
+    }
+
+    if(m_token == Token::LITERAL) {
+      if(c >= 'a' && c <= 'z') {
+        m_tokenBuffer.push_back(c);
+        i ++;
+      } else {
+        completeToken();
+      }
+      continue;
+    }
+
+    if(c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f') {
+      i ++;
+      continue;
+    }
+
+    switch(m_expect) {
+
+      case Expect::VALUE:
+        beginValue(c);
+        break;
+
+      case Expect::ELEMENT: {
+        auto& top = m_frames.back();
+        if(top.frameType == FrameType::COLLECTION || (top.frameType == FrameType::TREE && top.isArray)) {
+          if(c == ']') {
+            onFrameComplete();
+          } else {
+            if(top.frameType == FrameType::TREE) {
+              auto n = top.getNode();
+              if(n) {
+                auto& vector = n->getVector();
+                vector.emplace_back();
+                top.slot = std::addressof(vector.back());
+              } else {
+                top.slot = nullptr;
+              }
+            }
+            beginValue(c);
+          }
+        } else {
+          if(c == '}') {
+            onFrameComplete();
+          } else if(c == '"') {
+            m_token = Token::KEY;
+            m_tokenBuffer.clear();
+            m_escape = false;
+          } else {
+            failSyntax("Item key name expected");
+          }
+        }
+        break;
+      }
+
+      case Expect::AFTER_VALUE:
+        /* comma is optional - same as in oatpp::json::Deserializer */
+        m_expect = Expect::ELEMENT;
+        if(c != ',') {
+          continue;
+        }
+        break;
+
+      case Expect::COLON:
+        if(c == ':') {
+          m_expect = Expect::VALUE;
+        } else {
+          failSyntax("':' expected");
+        }
+        break;
+
+      case Expect::DONE:
+      default:
+        /* content after the root value is ignored - same as by ObjectMapper::read() */
+        return count;
+
+    }
+
+    i ++;
+
+  }
+
+  if(m_failed) {
+    return IOError::BROKEN_PIPE;
+  }
+
+  return count;
+
+}
+
+oatpp::Void ObjectReader::finish(data::mapping::ErrorStack& errorStack) {
+
+  if(!m_failed && (m_token == Token::NUMBER || m_token == Token::LITERAL)) {
+    m_position = m_size;
+    completeToken();
+  }
+
+  if(!m_failed && m_expect != Expect::DONE) {
+    m_position = m_size;
+    failSyntax("Unexpected end of document");
+  }
+
+  if(m_failed) {
+    errorStack.splice(m_errorStack);
+    return nullptr;
+  }
+
+  return m_result;
+
+}
+
+bool ObjectReader::hasError() const {
+  return m_failed;
+}
+
+}}
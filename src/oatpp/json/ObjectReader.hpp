@@ -0,0 +1,211 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_ObjectReader_hpp
+#define oatpp_json_ObjectReader_hpp
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+#include "oatpp/data/mapping/TreeToObjectMapper.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace json {
+
+/**
+ * Incremental (resumable) json reader. Consumes json chunk by chunk and builds the object as data arrives -
+ * only the current token is buffered. <br>
+ * Objects, collections and maps are populated right from the token stream. Scalars are mapped by the
+ * &id:oatpp::data::mapping::TreeToObjectMapper;. `oatpp::Tree` and `oatpp::Any` values, values of classes which have
+ * custom mapper method, and values of unexpected json type are collected to &id:oatpp::data::mapping::Tree; first. <br>
+ * Mapping errors are the same as of &id:oatpp::data::mapping::TreeToObjectMapper;. Syntax errors are reported with their byte position.
+ * Reading stops at the first error.
+ */
+class ObjectReader : public base::Countable, public data::mapping::ObjectReader {
+public:
+
+  /**
+   * Reader config.
+   */
+  struct Config {
+
+    /**
+     * Max size of the document in bytes. `0` - no limit.
+     */
+    v_buff_size maxDocumentSize = 0;
+
+    /**
+     * Max nesting depth of json objects and arrays. `0` - no limit.
+     */
+    v_uint32 maxDepth = 0;
+
+  };
+
+private:
+
+  enum class Expect : v_int32 {
+    VALUE = 0,
+    ELEMENT = 1,
+    AFTER_VALUE = 2,
+    COLON = 3,
+    DONE = 4
+  };
+
+  enum class Token : v_int32 {
+    NONE = 0,
+    STRING = 1,
+    KEY = 2,
+    NUMBER = 3,
+    LITERAL = 4
+  };
+
+  enum class FrameType : v_int32 {
+    OBJECT = 0,
+    COLLECTION = 1,
+    MAP = 2,
+    TREE = 3
+  };
+
+  enum class Capture : v_int32 {
+    NONE = 0,
+    TARGET = 1,
+    POLYMORPH = 2,
+    DISCARD = 3
+  };
+
+  struct Frame {
+
+    FrameType frameType = FrameType::TREE;
+    const data::type::Type* type = nullptr;
+    oatpp::Void value;
+    std::vector<const data::type::Type::AbstractInterpretation*> interpretations;
+
+    /* object & map */
+    oatpp::String key;
+
+    /* object */
+    const std::unordered_map<std::string, BaseObject::Property*>* fieldsMap = nullptr;
+    BaseObject::Property* field = nullptr;
+    std::vector<std::pair<BaseObject::Property*, data::mapping::Tree>> polymorphs;
+
+    /* collection */
+    const data::type::Type* itemType = nullptr;
+    v_int64 index = 0;
+
+    /* map */
+    bool collectPairs = false;
+    std::vector<std::pair<oatpp::String, oatpp::Void>> pairs;
+    std::unordered_map<std::string, size_t> pairIndex;
+
+    /* tree */
+    bool isArray = false;
+    Capture capture = Capture::NONE;
+    data::mapping::Tree tree;
+    data::mapping::Tree* node = nullptr;
+    data::mapping::Tree* slot = nullptr;
+
+    data::mapping::Tree* getNode();
+
+  };
+
+private:
+  const data::mapping::TreeToObjectMapper::Config* m_mapperConfig;
+  const Config* m_config;
+  const data::mapping::TreeToObjectMapper* m_treeMapper;
+  const data::type::Type* m_type;
+private:
+  std::vector<Frame> m_frames;
+  Expect m_expect;
+  Token m_token;
+  bool m_escape;
+  std::string m_tokenBuffer;
+  data::mapping::Tree m_leaf;
+  v_buff_size m_size;
+  v_buff_size m_position;
+  bool m_failed;
+  data::mapping::ErrorStack m_errorStack;
+  oatpp::Void m_result;
+private:
+  static bool isPolymorph(const BaseObject::Property* field);
+  static void storePolymorph(Frame& frame, BaseObject::Property* field, data::mapping::Tree&& tree);
+private:
+  void failSyntax(const char* message);
+  void failMapping(data::mapping::ErrorStack& errorStack, bool withTopContext);
+  void pushContext(const Frame& frame);
+
+  const data::type::Type* getSlotType() const;
+
+  void beginValue(char c);
+  void beginContainer(bool isArray);
+  void pushTreeFrame(bool isArray, Capture capture, data::mapping::Tree* node, const data::type::Type* type, BaseObject::Property* field);
+
+  void onKey(const oatpp::String& key);
+  void onScalar(Token token);
+  void onValue(const oatpp::Void& value);
+  void onFrameComplete();
+
+  void completeToken();
+  bool parseScalar(Token token, data::mapping::Tree& target);
+public:
+
+  /**
+   * Constructor.
+   * @param mapperConfig - &id:oatpp::data::mapping::TreeToObjectMapper::Config;.
+   * @param config - &l:ObjectReader::Config;.
+   * @param treeMapper - &id:oatpp::data::mapping::TreeToObjectMapper;.
+   * @param type - type of the object to read.
+   */
+  ObjectReader(const data::mapping::TreeToObjectMapper::Config* mapperConfig,
+               const Config* config,
+               const data::mapping::TreeToObjectMapper* treeMapper,
+               const data::type::Type* type);
+
+  /**
+   * Feed next chunk of json.
+   * @param data - pointer to data.
+   * @param count - size of the data in bytes.
+   * @param action - async specific action. Not used.
+   * @return - `count` or &id:oatpp::IOError::BROKEN_PIPE; if reading failed.
+   */
+  v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Finish reading.
+   * @param errorStack - &id:oatpp::data::mapping::ErrorStack;.
+   * @return - deserialized object.
+   */
+  oatpp::Void finish(data::mapping::ErrorStack& errorStack) override;
+
+  /**
+   * Check if reading failed.
+   * @return - `true` if reading failed.
+   */
+  bool hasError() const override;
+
+};
+
+}}
+
+#endif /* oatpp_json_ObjectReader_hpp */
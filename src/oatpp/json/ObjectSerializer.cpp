@@ -0,0 +1,451 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectSerializer.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+namespace oatpp { namespace json {
+
+ObjectSerializer::ObjectSerializer() {
+
+  data::mapping::ObjectToTreeMapper treeMapper;
+
+  m_methods.resize(static_cast<size_t>(data::type::ClassId::getClassCount()), {nullptr, nullptr});
+
+  setSerializerMethod(treeMapper, data::type::__class::String::CLASS_ID, &ObjectSerializer::serializeString);
+  setSerializerMethod(treeMapper, data::type::__class::Tree::CLASS_ID, &ObjectSerializer::serializeTree);
+  setSerializerMethod(treeMapper, data::type::__class::Any::CLASS_ID, &ObjectSerializer::serializeAny);
+
+  setSerializerMethod(treeMapper, data::type::__class::Int8::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int8>);
+  setSerializerMethod(treeMapper, data::type::__class::UInt8::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt8>);
+
+  setSerializerMethod(treeMapper, data::type::__class::Int16::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int16>);
+  setSerializerMethod(treeMapper, data::type::__class::UInt16::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt16>);
+
+  setSerializerMethod(treeMapper, data::type::__class::Int32::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int32>);
+  setSerializerMethod(treeMapper, data::type::__class::UInt32::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt32>);
+
+  setSerializerMethod(treeMapper, data::type::__class::Int64::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Int64>);
+  setSerializerMethod(treeMapper, data::type::__class::UInt64::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::UInt64>);
+
+  setSerializerMethod(treeMapper, data::type::__class::Float32::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Float32>);
+  setSerializerMethod(treeMapper, data::type::__class::Float64::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Float64>);
+  setSerializerMethod(treeMapper, data::type::__class::Boolean::CLASS_ID, &ObjectSerializer::serializePrimitive<oatpp::Boolean>);
+
+  setSerializerMethod(treeMapper, data::type::__class::AbstractObject::CLASS_ID, &ObjectSerializer::serializeObject);
+  setSerializerMethod(treeMapper, data::type::__class::AbstractEnum::CLASS_ID, &ObjectSerializer::serializeEnum);
+
+  setSerializerMethod(treeMapper, data::type::__class::AbstractVector::CLASS_ID, &ObjectSerializer::serializeCollection);
+  setSerializerMethod(treeMapper, data::type::__class::AbstractList::CLASS_ID, &ObjectSerializer::serializeCollection);
+  setSerializerMethod(treeMapper, data::type::__class::AbstractUnorderedSet::CLASS_ID, &ObjectSerializer::serializeCollection);
+
+  setSerializerMethod(treeMapper, data::type::__class::AbstractPairList::CLASS_ID, &ObjectSerializer::serializeMap);
+  setSerializerMethod(treeMapper, data::type::__class::AbstractUnorderedMap::CLASS_ID, &ObjectSerializer::serializeMap);
+
+}
+
+void ObjectSerializer::setSerializerMethod(const data::mapping::ObjectToTreeMapper& defaultTreeMapper,
+                                           const data::type::ClassId& classId,
+                                           SerializerMethod method)
+{
+  const auto id = static_cast<v_uint32>(classId.id);
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, {nullptr, nullptr});
+  }
+  m_methods[id] = {method, defaultTreeMapper.getMapperMethod(classId)};
+}
+
+ObjectSerializer::SerializerMethod ObjectSerializer::getDirectMethod(const State& state, const data::type::Type* type) const {
+  const auto id = static_cast<v_uint32>(type->classId.id);
+  if(id < m_methods.size()) {
+    const auto& entry = m_methods[id];
+    /* direct method applies only as long as the tree mapper wasn't customized for this class */
+    if(entry.method && state.treeMapper->getMapperMethod(type->classId) == entry.treeMethod) {
+      return entry.method;
+    }
+  }
+  return nullptr;
+}
+
+void ObjectSerializer::serializeViaTree(State& state, const oatpp::Void& polymorph) const {
+
+  data::mapping::Tree tree;
+
+  data::mapping::ObjectToTreeMapper::State mapperState;
+  mapperState.config = state.mapperConfig;
+  mapperState.tree = &tree;
+
+  state.treeMapper->map(mapperState, polymorph);
+  if(!mapperState.errorStack.empty()) {
+    state.errorStack.splice(mapperState.errorStack);
+    return;
+  }
+
+  Serializer::State serializerState;
+  serializerState.config = state.config;
+  serializerState.tree = &tree;
+  serializerState.stream = state.stream;
+
+  Serializer::serialize(serializerState);
+  if(!serializerState.errorStack.empty()) {
+    state.errorStack.splice(serializerState.errorStack);
+  }
+
+}
+
+bool ObjectSerializer::isNull(State& state, const oatpp::Void& polymorph) const {
+
+  auto type = polymorph.getValueType();
+
+  if(getDirectMethod(state, type)) {
+
+    if(type->classId.id == data::type::__class::AbstractEnum::CLASS_ID.id) {
+      auto dispatcher = static_cast<const data::type::__class::AbstractEnum::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+      data::type::EnumInterpreterError e = data::type::EnumInterpreterError::OK;
+      const auto& interpretation = dispatcher->toInterpretation(polymorph, state.mapperConfig->useUnqualifiedEnumNames, e);
+      /* not null on error - let serializeEnum() report it */
+      return e == data::type::EnumInterpreterError::OK && isNull(state, interpretation);
+    }
+
+    if(!polymorph) {
+      return true;
+    }
+
+    if(type->classId.id == data::type::__class::Any::CLASS_ID.id) {
+      auto anyHandle = static_cast<data::type::AnyHandle*>(polymorph.get());
+      return isNull(state, oatpp::Void(anyHandle->ptr, anyHandle->type));
+    }
+
+    if(type->classId.id == data::type::__class::Tree::CLASS_ID.id) {
+      return static_cast<data::mapping::Tree*>(polymorph.get())->isNull();
+    }
+
+    return false;
+
+  }
+
+  if(state.treeMapper->getMapperMethod(type->classId)) {
+    data::mapping::Tree tree;
+    data::mapping::ObjectToTreeMapper::State mapperState;
+    mapperState.config = state.mapperConfig;
+    mapperState.tree = &tree;
+    state.treeMapper->map(mapperState, polymorph);
+    return mapperState.errorStack.empty() && tree.isNull();
+  }
+
+  auto* interpretation = type->findInterpretation(state.mapperConfig->enabledInterpretations);
+  if(interpretation) {
+    return isNull(state, interpretation->toInterpretation(polymorph));
+  }
+
+  return false;
+
+}
+
+void ObjectSerializer::serializeString(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+  (void) serializer;
+  if(!polymorph) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+  auto str = static_cast<std::string*>(polymorph.get());
+  Serializer::serializeString(state.stream, str->data(), static_cast<v_buff_size>(str->size()), state.config->escapeFlags);
+}
+
+void ObjectSerializer::serializeTree(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  (void) serializer;
+
+  if(!polymorph) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+
+  Serializer::State serializerState;
+  serializerState.config = state.config;
+  serializerState.tree = static_cast<data::mapping::Tree*>(polymorph.get());
+  serializerState.stream = state.stream;
+
+  Serializer::serialize(serializerState);
+  if(!serializerState.errorStack.empty()) {
+    state.errorStack.splice(serializerState.errorStack);
+  }
+
+}
+
+void ObjectSerializer::serializeAny(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+  if(!polymorph) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+  auto anyHandle = static_cast<data::type::AnyHandle*>(polymorph.get());
+  serializer->serialize(state, oatpp::Void(anyHandle->ptr, anyHandle->type));
+}
+
+void ObjectSerializer::serializeEnum(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  auto polymorphicDispatcher = static_cast<const data::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+
+  data::type::EnumInterpreterError e = data::type::EnumInterpreterError::OK;
+  const auto& value = polymorphicDispatcher->toInterpretation(polymorph, state.mapperConfig->useUnqualifiedEnumNames, e);
+
+  if(e == data::type::EnumInterpreterError::OK) {
+    serializer->serialize(state, value);
+    return;
+  }
+
+  switch(e) {
+    case data::type::EnumInterpreterError::CONSTRAINT_NOT_NULL:
+      state.errorStack.push("[oatpp::json::ObjectSerializer::serializeEnum()]: Error. Enum constraint violated - 'NotNull'.");
+      break;
+    case data::type::EnumInterpreterError::OK:
+    case data::type::EnumInterpreterError::TYPE_MISMATCH_ENUM:
+    case data::type::EnumInterpreterError::TYPE_MISMATCH_ENUM_VALUE:
+    case data::type::EnumInterpreterError::ENTRY_NOT_FOUND:
+    default:
+      state.errorStack.push("[oatpp::json::ObjectSerializer::serializeEnum()]: Error. Can't serialize Enum.");
+  }
+
+}
+
+void ObjectSerializer::serializeCollection(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  if(!polymorph) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+
+  auto iterator = dispatcher->beginIteration(polymorph);
+
+  state.stream->writeCharSimple('[');
+
+  bool first = true;
+  v_int64 index = 0;
+
+  while (!iterator->finished()) {
+
+    const auto& value = iterator->get();
+
+    if(value || state.mapperConfig->includeNullFields || state.mapperConfig->alwaysIncludeNullCollectionElements) {
+
+      if(state.config->includeNullElements || !serializer->isNull(state, value)) {
+
+        if(!first) state.stream->writeCharSimple(',');
+        first = false;
+
+        serializer->serialize(state, value);
+
+        if(!state.errorStack.empty()) {
+          state.errorStack.push("[oatpp::json::ObjectSerializer::serializeCollection()]: index=" + utils::Conversion::int64ToStr(index));
+          return;
+        }
+
+      }
+
+    }
+
+    iterator->next();
+    index ++;
+
+  }
+
+  state.stream->writeCharSimple(']');
+
+}
+
+void ObjectSerializer::serializeMap(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  if(!polymorph) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+
+  auto keyType = dispatcher->getKeyType();
+  if(keyType->classId != oatpp::String::Class::CLASS_ID){
+    state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: Invalid map key. Key should be String");
+    return;
+  }
+
+  auto iterator = dispatcher->beginIteration(polymorph);
+
+  state.stream->writeCharSimple('{');
+
+  bool first = true;
+
+  while (!iterator->finished()) {
+
+    const auto& value = iterator->getValue();
+
+    if(value || state.mapperConfig->includeNullFields || state.mapperConfig->alwaysIncludeNullCollectionElements) {
+
+      if(state.config->includeNullElements || !serializer->isNull(state, value)) {
+
+        auto key = static_cast<std::string*>(iterator->getKey().get());
+        if(key == nullptr) {
+          state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: Invalid map key. Key should not be null");
+          return;
+        }
+
+        if(!first) state.stream->writeCharSimple(',');
+        first = false;
+
+        Serializer::serializeString(state.stream, key->data(), static_cast<v_buff_size>(key->size()), state.config->escapeFlags);
+        state.stream->writeCharSimple(':');
+
+        serializer->serialize(state, value);
+
+        if(!state.errorStack.empty()) {
+          state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: key='" + *key + "'");
+          return;
+        }
+
+      }
+
+    }
+
+    iterator->next();
+
+  }
+
+  state.stream->writeCharSimple('}');
+
+}
+
+void ObjectSerializer::serializeObject(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph) {
+
+  if(!polymorph) {
+    state.stream->writeSimple("null", 4);
+    return;
+  }
+
+  auto type = polymorph.getValueType();
+  auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(
+    type->polymorphicDispatcher
+  );
+  auto fields = dispatcher->getProperties()->getList();
+  auto object = static_cast<oatpp::BaseObject*>(polymorph.get());
+
+  state.stream->writeCharSimple('{');
+
+  bool first = true;
+
+  for (auto const& field : fields) {
+
+    oatpp::Void value;
+    if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
+      const auto& any = field->get(object).cast<oatpp::Any>();
+      value = any.retrieve(field->info.typeSelector->selectType(object));
+    } else {
+      value = field->get(object);
+    }
+
+    const std::string& key = state.mapperConfig->useUnqualifiedFieldNames ? field->unqualifiedName : field->name;
+
+    if(field->info.required && value == nullptr) {
+      state.errorStack.push("[oatpp::json::ObjectSerializer::serializeObject()]: "
+                            "Error. " + std::string(type->nameQualifier) + "::"
+                            + key + " is required!");
+      return;
+    }
+
+    if (value || state.mapperConfig->includeNullFields || (field->info.required && state.mapperConfig->alwaysIncludeRequired)) {
+
+      if(!state.config->includeNullElements && serializer->isNull(state, value)) {
+        continue;
+      }
+
+      if(!first) state.stream->writeCharSimple(',');
+      first = false;
+
+      Serializer::serializeString(state.stream, key.data(), static_cast<v_buff_size>(key.size()), state.config->escapeFlags);
+      state.stream->writeCharSimple(':');
+
+      serializer->serialize(state, value);
+
+      if(!state.errorStack.empty()) {
+        state.errorStack.push("[oatpp::json::ObjectSerializer::serializeObject()]: field='" + key + "'");
+        return;
+      }
+
+    }
+
+  }
+
+  state.stream->writeCharSimple('}');
+
+}
+
+void ObjectSerializer::serialize(State& state, const oatpp::Void& polymorph) const {
+
+  auto type = polymorph.getValueType();
+
+  auto method = getDirectMethod(state, type);
+  if(method) {
+    (*method)(this, state, polymorph);
+    return;
+  }
+
+  if(state.treeMapper->getMapperMethod(type->classId)) {
+    serializeViaTree(state, polymorph);
+    return;
+  }
+
+  auto* interpretation = type->findInterpretation(state.mapperConfig->enabledInterpretations);
+  if(interpretation) {
+    serialize(state, interpretation->toInterpretation(polymorph));
+  } else {
+    state.errorStack.push("[oatpp::json::ObjectSerializer::serialize()]: "
+                          "Error. No serialize method for type '" +
+                          oatpp::String(type->classId.name) + "'");
+  }
+
+}
+
+void ObjectSerializer::serializeToStream(data::stream::ConsistentOutputStream* stream, State& state, const oatpp::Void& polymorph) const {
+
+  if(state.config->useBeautifier) {
+    json::Beautifier beautifier(stream, "  ", "\n");
+    state.stream = &beautifier;
+    serialize(state, polymorph);
+    state.stream = stream;
+  } else {
+    state.stream = stream;
+    serialize(state, polymorph);
+  }
+
+}
+
+}}
@@ -0,0 +1,150 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_ObjectSerializer_hpp
+#define oatpp_json_ObjectSerializer_hpp
+
+#include "./Serializer.hpp"
+
+#include "oatpp/data/mapping/ObjectToTreeMapper.hpp"
+
+namespace oatpp { namespace json {
+
+/**
+ * Serializes oatpp objects to json in a single pass - without building intermediate &id:oatpp::data::mapping::Tree;. <br>
+ * Produces the same output as &id:oatpp::data::mapping::ObjectToTreeMapper; followed by &id:oatpp::json::Serializer;. <br>
+ * Values of classes which have custom (not default) mapper method set in the &id:oatpp::data::mapping::ObjectToTreeMapper;
+ * are mapped to &id:oatpp::data::mapping::Tree; using that method and are serialized by &id:oatpp::json::Serializer;.
+ */
+class ObjectSerializer : public base::Countable {
+public:
+
+  /**
+   * Serializer state.
+   */
+  struct State {
+
+    /**
+     * Mapper config - &id:oatpp::data::mapping::ObjectToTreeMapper::Config;.
+     */
+    const data::mapping::ObjectToTreeMapper::Config* mapperConfig;
+
+    /**
+     * Json config - &id:oatpp::json::Serializer::Config;.
+     */
+    const Serializer::Config* config;
+
+    /**
+     * Tree mapper used for classes with custom mapper methods.
+     */
+    const data::mapping::ObjectToTreeMapper* treeMapper;
+
+    data::stream::ConsistentOutputStream* stream;
+    data::mapping::ErrorStack errorStack;
+
+  };
+
+public:
+  typedef void (*SerializerMethod)(const ObjectSerializer*, State&, const oatpp::Void&);
+public:
+
+  template<class T>
+  static void serializePrimitive(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph){
+    (void) serializer;
+    if(polymorph){
+      state.stream->writeAsString(* static_cast<typename T::ObjectType*>(polymorph.get()));
+    } else {
+      state.stream->writeSimple("null", 4);
+    }
+  }
+
+  static void serializeString(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+  static void serializeTree(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+  static void serializeAny(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+  static void serializeEnum(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+
+  static void serializeCollection(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+  static void serializeMap(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+
+  static void serializeObject(const ObjectSerializer* serializer, State& state, const oatpp::Void& polymorph);
+
+private:
+
+  struct MethodEntry {
+    SerializerMethod method;
+    /* default tree-mapper method this method stands for */
+    data::mapping::ObjectToTreeMapper::MapperMethod treeMethod;
+  };
+
+private:
+  void setSerializerMethod(const data::mapping::ObjectToTreeMapper& defaultTreeMapper,
+                           const data::type::ClassId& classId,
+                           SerializerMethod method);
+  void serializeViaTree(State& state, const oatpp::Void& polymorph) const;
+private:
+  std::vector<MethodEntry> m_methods;
+public:
+
+  /**
+   * Constructor.
+   */
+  ObjectSerializer();
+
+  /**
+   * Get method serializing values of the type directly.
+   * @param state - &l:ObjectSerializer::State;.
+   * @param type - value type.
+   * @return - serializer method or `nullptr` if the type has no direct method or its tree-mapper method was customized.
+   */
+  SerializerMethod getDirectMethod(const State& state, const data::type::Type* type) const;
+
+  /**
+   * Check if the value is serialized as json `null`.
+   * @param state - &l:ObjectSerializer::State;.
+   * @param polymorph - value.
+   * @return - `true` if the value is serialized as `null`.
+   */
+  bool isNull(State& state, const oatpp::Void& polymorph) const;
+
+  /**
+   * Serialize value to `state.stream`.
+   * @param state - &l:ObjectSerializer::State;.
+   * @param polymorph - value to serialize.
+   */
+  void serialize(State& state, const oatpp::Void& polymorph) const;
+
+  /**
+   * Serialize value to stream. Applies beautifier if `state.config->useBeautifier` is set.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param state - &l:ObjectSerializer::State;.
+   * @param polymorph - value to serialize.
+   */
+  void serializeToStream(data::stream::ConsistentOutputStream* stream, State& state, const oatpp::Void& polymorph) const;
+
+};
+
+}}
+
+#endif /* oatpp_json_ObjectSerializer_hpp */
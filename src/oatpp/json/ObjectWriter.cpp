@@ -0,0 +1,353 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectWriter.hpp"
+
+#include "./Beautifier.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace json {
+
+ObjectWriter::ObjectWriter(const data::mapping::ObjectToTreeMapper::Config* mapperConfig,
+                           const Serializer::Config* config,
+                           const data::mapping::ObjectToTreeMapper* treeMapper,
+                           const ObjectSerializer* serializer,
+                           const oatpp::Void& variant)
+  : m_serializer(serializer)
+  , m_root(variant)
+  , m_readPosition(0)
+  , m_started(false)
+  , m_finished(false)
+{
+  m_state.mapperConfig = mapperConfig;
+  m_state.config = config;
+  m_state.treeMapper = treeMapper;
+  if(config->useBeautifier) {
+    m_beautifier = std::make_unique<Beautifier>(&m_buffer, "  ", "\n");
+    m_state.stream = m_beautifier.get();
+  } else {
+    m_state.stream = &m_buffer;
+  }
+  m_frames.reserve(16);
+}
+
+void ObjectWriter::fail(bool withTopContext) {
+  for(auto it = m_frames.rbegin(); it != m_frames.rend(); it ++) {
+    if(it == m_frames.rbegin() && !withTopContext) {
+      continue;
+    }
+    switch(it->frameType) {
+      case FrameType::OBJECT:
+        m_state.errorStack.push("[oatpp::json::ObjectSerializer::serializeObject()]: field='" + it->key + "'");
+        break;
+      case FrameType::COLLECTION:
+        m_state.errorStack.push("[oatpp::json::ObjectSerializer::serializeCollection()]: index=" + utils::Conversion::int64ToStr(it->index));
+        break;
+      case FrameType::MAP:
+        m_state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: key='" + it->key + "'");
+        break;
+      default:
+        break;
+    }
+  }
+  m_frames.clear();
+}
+
+void ObjectWriter::writeSeparator(Frame& frame) {
+  if(!frame.first) m_state.stream->writeCharSimple(',');
+  frame.first = false;
+}
+
+void ObjectWriter::writeKey(const std::string& key) {
+  Serializer::serializeString(m_state.stream, key.data(), static_cast<v_buff_size>(key.size()), m_state.config->escapeFlags);
+  m_state.stream->writeCharSimple(':');
+}
+
+void ObjectWriter::writeValue(const oatpp::Void& value) {
+
+  oatpp::Void polymorph = value;
+
+  /* resolve the value the same way as ObjectSerializer::serialize() does - containers are traversed step by step */
+  while(true) {
+
+    auto type = polymorph.getValueType();
+    auto method = m_serializer->getDirectMethod(m_state, type);
+
+    if(method) {
+
+      if(!polymorph) {
+        break;
+      }
+
+      if(method == &ObjectSerializer::serializeAny) {
+        auto anyHandle = static_cast<data::type::AnyHandle*>(polymorph.get());
+        polymorph = oatpp::Void(anyHandle->ptr, anyHandle->type);
+        continue;
+      }
+
+      if(method == &ObjectSerializer::serializeObject) {
+        auto dispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+        const auto& fields = dispatcher->getProperties()->getList();
+        m_frames.emplace_back();
+        auto& frame = m_frames.back();
+        frame.frameType = FrameType::OBJECT;
+        frame.value = polymorph;
+        frame.field = fields.begin();
+        frame.fieldsEnd = fields.end();
+        m_state.stream->writeCharSimple('{');
+        return;
+      }
+
+      if(method == &ObjectSerializer::serializeCollection) {
+        auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+        m_frames.emplace_back();
+        auto& frame = m_frames.back();
+        frame.frameType = FrameType::COLLECTION;
+        frame.value = polymorph;
+        frame.collectionIterator = dispatcher->beginIteration(polymorph);
+        m_state.stream->writeCharSimple('[');
+        return;
+      }
+
+      if(method == &ObjectSerializer::serializeMap) {
+        auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+        if(dispatcher->getKeyType()->classId != oatpp::String::Class::CLASS_ID) {
+          m_state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: Invalid map key. Key should be String");
+          fail(true);
+          return;
+        }
+        m_frames.emplace_back();
+        auto& frame = m_frames.back();
+        frame.frameType = FrameType::MAP;
+        frame.value = polymorph;
+        frame.mapIterator = dispatcher->beginIteration(polymorph);
+        m_state.stream->writeCharSimple('{');
+        return;
+      }
+
+      break;
+
+    }
+
+    if(m_state.treeMapper->getMapperMethod(type->classId)) {
+      break;
+    }
+
+    auto* interpretation = type->findInterpretation(m_state.mapperConfig->enabledInterpretations);
+    if(!interpretation) {
+      break;
+    }
+    polymorph = interpretation->toInterpretation(polymorph);
+
+  }
+
+  m_serializer->serialize(m_state, polymorph);
+  if(!m_state.errorStack.empty()) {
+    fail(true);
+  }
+
+}
+
+void ObjectWriter::stepObject(Frame& frame) {
+
+  auto object = static_cast<oatpp::BaseObject*>(frame.value.get());
+  auto type = frame.value.getValueType();
+
+  while(frame.field != frame.fieldsEnd) {
+
+    auto field = *frame.field;
+    frame.field ++;
+
+    oatpp::Void value;
+    if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
+      const auto& any = field->get(object).cast<oatpp::Any>();
+      value = any.retrieve(field->info.typeSelector->selectType(object));
+    } else {
+      value = field->get(object);
+    }
+
+    const std::string& key = m_state.mapperConfig->useUnqualifiedFieldNames ? field->unqualifiedName : field->name;
+
+    if(field->info.required && value == nullptr) {
+      m_state.errorStack.push("[oatpp::json::ObjectSerializer::serializeObject()]: "
+                              "Error. " + std::string(type->nameQualifier) + "::"
+                              + key + " is required!");
+      fail(false);
+      return;
+    }
+
+    if (value || m_state.mapperConfig->includeNullFields || (field->info.required && m_state.mapperConfig->alwaysIncludeRequired)) {
+
+      if(!m_state.config->includeNullElements && m_serializer->isNull(m_state, value)) {
+        continue;
+      }
+
+      writeSeparator(frame);
+      writeKey(key);
+      frame.key = key;
+
+      writeValue(value);
+      return;
+
+    }
+
+  }
+
+  m_state.stream->writeCharSimple('}');
+  m_frames.pop_back();
+
+}
+
+void ObjectWriter::stepCollection(Frame& frame) {
+
+  auto& iterator = frame.collectionIterator;
+
+  while(!iterator->finished()) {
+
+    const auto& value = iterator->get();
+    const auto index = frame.position ++;
+    iterator->next();
+
+    if(value || m_state.mapperConfig->includeNullFields || m_state.mapperConfig->alwaysIncludeNullCollectionElements) {
+
+      if(m_state.config->includeNullElements || !m_serializer->isNull(m_state, value)) {
+
+        writeSeparator(frame);
+        frame.index = index;
+
+        writeValue(value);
+        return;
+
+      }
+
+    }
+
+  }
+
+  m_state.stream->writeCharSimple(']');
+  m_frames.pop_back();
+
+}
+
+void ObjectWriter::stepMap(Frame& frame) {
+
+  auto& iterator = frame.mapIterator;
+
+  while(!iterator->finished()) {
+
+    const auto& value = iterator->getValue();
+    const auto& keyValue = iterator->getKey();
+    iterator->next();
+
+    if(value || m_state.mapperConfig->includeNullFields || m_state.mapperConfig->alwaysIncludeNullCollectionElements) {
+
+      if(m_state.config->includeNullElements || !m_serializer->isNull(m_state, value)) {
+
+        auto key = static_cast<std::string*>(keyValue.get());
+        if(key == nullptr) {
+          m_state.errorStack.push("[oatpp::json::ObjectSerializer::serializeMap()]: Invalid map key. Key should not be null");
+          fail(false);
+          return;
+        }
+
+        writeSeparator(frame);
+        writeKey(*key);
+        frame.key = *key;
+
+        writeValue(value);
+        return;
+
+      }
+
+    }
+
+  }
+
+  m_state.stream->writeCharSimple('}');
+  m_frames.pop_back();
+
+}
+
+void ObjectWriter::step() {
+
+  if(!m_started) {
+    m_started = true;
+    writeValue(m_root);
+  } else {
+    auto& frame = m_frames.back();
+    switch(frame.frameType) {
+      case FrameType::OBJECT: stepObject(frame); break;
+      case FrameType::COLLECTION: stepCollection(frame); break;
+      case FrameType::MAP: stepMap(frame); break;
+      default: break;
+    }
+  }
+
+  m_finished = m_frames.empty();
+
+}
+
+v_io_size ObjectWriter::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  while(!m_finished && m_state.errorStack.empty() && m_buffer.getCurrentPosition() - m_readPosition < count) {
+    step();
+  }
+
+  if(!m_state.errorStack.empty()) {
+    return IOError::BROKEN_PIPE;
+  }
+
+  auto size = m_buffer.getCurrentPosition() - m_readPosition;
+  if(size > count) {
+    size = count;
+  }
+
+  std::memcpy(buffer, m_buffer.getData() + m_readPosition, static_cast<size_t>(size));
+  m_readPosition += size;
+
+  /* everything buffered is consumed - reuse the buffer */
+  if(m_readPosition == m_buffer.getCurrentPosition()) {
+    m_buffer.setCurrentPosition(0);
+    m_readPosition = 0;
+  }
+
+  return size;
+
+}
+
+bool ObjectWriter::hasError() const {
+  return !m_state.errorStack.empty();
+}
+
+const data::mapping::ErrorStack& ObjectWriter::getErrorStack() const {
+  return m_state.errorStack;
+}
+
+}}
@@ -0,0 +1,137 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_json_ObjectWriter_hpp
+#define oatpp_json_ObjectWriter_hpp
+
+#include "./ObjectSerializer.hpp"
+
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace json {
+
+/**
+ * Incremental (resumable) json writer. Serializes the object as its json is read chunk by chunk -
+ * only the not yet consumed part of the current value is buffered. <br>
+ * Objects, collections and maps are traversed step by step. Other values are serialized at once by the
+ * &id:oatpp::json::ObjectSerializer;. Output and errors are the same as of &id:oatpp::json::ObjectSerializer;. <br>
+ * The object must not be modified while it is being written.
+ */
+class ObjectWriter : public base::Countable, public data::mapping::ObjectWriter {
+private:
+
+  enum class FrameType : v_int32 {
+    OBJECT = 0,
+    COLLECTION = 1,
+    MAP = 2
+  };
+
+  struct Frame {
+
+    FrameType frameType;
+    oatpp::Void value;
+    bool first = true;
+
+    /* object */
+    std::list<BaseObject::Property*>::const_iterator field;
+    std::list<BaseObject::Property*>::const_iterator fieldsEnd;
+    std::string key;
+
+    /* collection */
+    std::unique_ptr<data::type::__class::Collection::Iterator> collectionIterator;
+    v_int64 position = 0;
+    v_int64 index = 0;
+
+    /* map */
+    std::unique_ptr<data::type::__class::Map::Iterator> mapIterator;
+
+  };
+
+private:
+  const ObjectSerializer* m_serializer;
+  ObjectSerializer::State m_state;
+  oatpp::Void m_root;
+private:
+  data::stream::BufferOutputStream m_buffer;
+  std::unique_ptr<data::stream::ConsistentOutputStream> m_beautifier;
+  v_buff_size m_readPosition;
+  std::vector<Frame> m_frames;
+  bool m_started;
+  bool m_finished;
+private:
+  void fail(bool withTopContext);
+  void writeSeparator(Frame& frame);
+  void writeValue(const oatpp::Void& value);
+  void writeKey(const std::string& key);
+  void stepObject(Frame& frame);
+  void stepCollection(Frame& frame);
+  void stepMap(Frame& frame);
+  void step();
+public:
+
+  /**
+   * Constructor.
+   * @param mapperConfig - &id:oatpp::data::mapping::ObjectToTreeMapper::Config;.
+   * @param config - &id:oatpp::json::Serializer::Config;.
+   * @param treeMapper - &id:oatpp::data::mapping::ObjectToTreeMapper;.
+   * @param serializer - &id:oatpp::json::ObjectSerializer;.
+   * @param variant - object to write.
+   */
+  ObjectWriter(const data::mapping::ObjectToTreeMapper::Config* mapperConfig,
+               const Serializer::Config* config,
+               const data::mapping::ObjectToTreeMapper* treeMapper,
+               const ObjectSerializer* serializer,
+               const oatpp::Void& variant);
+
+  /**
+   * Read next chunk of json.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action. Not used.
+   * @return - actual number of bytes written to buffer. `0` - json is fully read.
+   * &id:oatpp::IOError::BROKEN_PIPE; if writing failed.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Check if writing failed.
+   * @return - `true` if writing failed.
+   */
+  bool hasError() const override;
+
+  /**
+   * Get errors of the failed writing.
+   * @return - &id:oatpp::data::mapping::ErrorStack;.
+   */
+  const data::mapping::ErrorStack& getErrorStack() const override;
+
+};
+
+}}
+
+#endif /* oatpp_json_ObjectWriter_hpp */
@@ -57,13 +57,15 @@ void Serializer::serializeArray(State& state) {
   auto& vector = state.tree->getVector();
 
   v_int64 index = 0;
+  bool first = true;
   for(auto& tree : vector) {
 
     nestedState.tree = &tree;
 
     if(!tree.isNull() || state.config->includeNullElements) {
 
-      if(index > 0) state.stream->writeSimple(",", 1);
+      if(!first) state.stream->writeSimple(",", 1);
+      first = false;
 
       serialize(nestedState);
 
@@ -92,6 +94,7 @@ void Serializer::serializeMap(State& state) {
 
   auto& map = state.tree->getMap();
   auto mapSize = map.size();
+  bool first = true;
 
   for(v_uint64 index = 0; index < mapSize; index ++) {
 
@@ -101,7 +104,8 @@ void Serializer::serializeMap(State& state) {
 
     if(!nestedState.tree->isNull() || state.config->includeNullElements) {
 
-      if(index > 0) state.stream->writeSimple(",", 1);
+      if(!first) state.stream->writeSimple(",", 1);
+      first = false;
 
       const auto& str = pair.first;
       serializeString(state.stream, str->data(), static_cast<v_buff_size>(str->size()), state.config->escapeFlags);
@@ -132,6 +136,7 @@ void Serializer::serializePairs(State& state) {
 
   auto& map = state.tree->getPairs();
   auto mapSize = map.size();
+  bool first = true;
 
   for(v_uint64 index = 0; index < mapSize; index ++) {
 
@@ -141,7 +146,8 @@ void Serializer::serializePairs(State& state) {
 
     if(!nestedState.tree->isNull() || state.config->includeNullElements) {
 
-      if(index > 0) state.stream->writeSimple(",", 1);
+      if(!first) state.stream->writeSimple(",", 1);
+      first = false;
 
       const auto& str = pair.first;
       serializeString(state.stream, str->data(), static_cast<v_buff_size>(str->size()), state.config->escapeFlags);
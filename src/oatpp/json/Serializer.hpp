@@ -89,21 +89,32 @@ public:
 
 private:
 
-  
-  static void serializeString(oatpp::data::stream::ConsistentOutputStream* stream,
-                              const char* data,
-                              v_buff_size size,
-                              v_uint32 escapeFlags);
-
   static void serializeNull(State& state);
   static void serializeString(State& state);
   static void serializeArray(State& state);
   static void serializeMap(State& state);
   static void serializePairs(State& state);
 
+public:
+
+  /**
+   * Write escaped and quoted json string.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param data - string data.
+   * @param size - string size.
+   * @param escapeFlags - escape flags. See &id:oatpp::json::Utils::escapeString;.
+   */
+  static void serializeString(oatpp::data::stream::ConsistentOutputStream* stream,
+                              const char* data,
+                              v_buff_size size,
+                              v_uint32 escapeFlags);
+
+  /**
+   * Serialize tree node to `state.stream`. Unlike &l:Serializer::serializeToStream (); doesn't apply beautifier.
+   * @param state
+   */
   static void serialize(State& state);
 
-public:
 
   static void serializeToStream(data::stream::ConsistentOutputStream* stream, State& state);
 
@@ -26,15 +26,83 @@
 
 #include "oatpp/encoding/Unicode.hpp"
 #include "oatpp/encoding/Hex.hpp"
+#include "oatpp/utils/CharScan.hpp"
 
 namespace oatpp { namespace json{
 
+namespace {
+
+/*
+ * Runs of clean characters are short in escape-heavy and multibyte-heavy strings.
+ * Walk characters one by one and go to the vectorized scan only once the run got this long.
+ */
+constexpr v_buff_size SCAN_RUN_THRESHOLD = 16;
+
+/*
+ * Character classes for escaping: 0 - copied as-is, 1 - solidus, 2 - needs escaping or is non-ASCII.
+ */
+constexpr v_char8 CLASS_SOLIDUS = 1;
+constexpr v_char8 CLASS_ESCAPE = 2;
+
+struct EscapeClasses {
+
+  v_char8 table[256];
+
+  constexpr EscapeClasses() : table() {
+    for(v_int32 c = 0; c < 256; c ++) {
+      if(c < 32 || c >= 128 || c == '"' || c == '\\') {
+        table[c] = CLASS_ESCAPE;
+      } else if(c == '/') {
+        table[c] = CLASS_SOLIDUS;
+      } else {
+        table[c] = 0;
+      }
+    }
+  }
+
+};
+
+constexpr EscapeClasses ESCAPE_CLASSES;
+
+inline bool isJsonClean(v_char8 a, v_char8 classMask) {
+  return (ESCAPE_CLASSES.table[a] & classMask) == 0;
+}
+
+inline v_buff_size findEscapableOrEnd(const char* data, v_buff_size size, bool escapeSolidus) {
+  v_buff_size found = utils::CharScan::findJsonEscapable(data, size, escapeSolidus);
+  return found < 0 ? size : found;
+}
+
+inline v_buff_size findBackslashOrEnd(const char* data, v_buff_size size) {
+  v_buff_size found = utils::CharScan::findChar(data, size, '\\');
+  return found < 0 ? size : found;
+}
+
+}
+
 v_buff_size Utils::calcEscapedStringSize(const char* data, v_buff_size size, v_buff_size& safeSize, v_uint32 flags) {
   v_buff_size result = 0;
   v_buff_size i = 0;
+  bool escapeSolidus = (flags & FLAG_ESCAPE_SOLIDUS) > 0;
+  v_char8 classMask = escapeSolidus ? static_cast<v_char8>(CLASS_ESCAPE | CLASS_SOLIDUS) : CLASS_ESCAPE;
   safeSize = size;
+  v_buff_size run = 0;
   while (i < size) {
     v_char8 a = static_cast<v_char8>(data[i]);
+
+    if(isJsonClean(a, classMask)) {
+      i ++;
+      result ++;
+      if(++ run == SCAN_RUN_THRESHOLD) {
+        v_buff_size clean = findEscapableOrEnd(&data[i], size - i, escapeSolidus);
+        i += clean;
+        result += clean;
+        run = 0;
+      }
+      continue;
+    }
+    run = 0;
+
     if(a < 32) {
       i ++;
 
@@ -98,11 +166,14 @@ v_buff_size Utils::calcUnescapedStringSize(const char* data, v_buff_size size, v
   errorCode = 0;
   v_buff_size result = 0;
   v_buff_size i = 0;
+  v_buff_size run = 0;
   
   while (i < size) {
     v_char8 a = static_cast<v_char8>(data[i]);
     if(a == '\\'){
-      
+
+      run = 0;
+
       if(i + 1 == size){
         errorCode = ERROR_CODE_INVALID_ESCAPED_CHAR;
         errorPosition = i;
@@ -182,6 +253,12 @@ v_buff_size Utils::calcUnescapedStringSize(const char* data, v_buff_size size, v
     } else {
       i ++;
       result ++;
+      if(++ run == SCAN_RUN_THRESHOLD) {
+        v_buff_size clean = findBackslashOrEnd(&data[i], size - i);
+        i += clean;
+        result += clean;
+        run = 0;
+      }
     }
     
   }
@@ -241,8 +318,27 @@ oatpp::String Utils::escapeString(const char* data, v_buff_size size, v_uint32 f
 
   {
     v_buff_size i = 0;
+    bool escapeSolidus = (flags & FLAG_ESCAPE_SOLIDUS) > 0;
+    v_char8 classMask = escapeSolidus ? static_cast<v_char8>(CLASS_ESCAPE | CLASS_SOLIDUS) : CLASS_ESCAPE;
+    v_buff_size run = 0;
     while (i < safeSize) {
       v_char8 a = static_cast<v_char8>(data[i]);
+
+      if(isJsonClean(a, classMask)) {
+        resultData[pos] = a;
+        pos ++;
+        i ++;
+        if(++ run == SCAN_RUN_THRESHOLD) {
+          v_buff_size clean = findEscapableOrEnd(&data[i], safeSize - i, escapeSolidus);
+          std::memcpy(&resultData[pos], &data[i], static_cast<size_t>(clean));
+          pos += clean;
+          i += clean;
+          run = 0;
+        }
+        continue;
+      }
+      run = 0;
+
       if (a < 32) {
 
         switch (a) {
@@ -326,11 +422,13 @@ void Utils::unescapeStringToBuffer(const char* data, v_buff_size size, p_char8 r
   
   v_buff_size i = 0;
   v_buff_size pos = 0;
+  v_buff_size run = 0;
   
   while (i < size) {
     v_char8 a = static_cast<v_char8>(data[i]);
     
     if(a == '\\'){
+      run = 0;
       v_char8 b = static_cast<v_char8>(data[i + 1]);
       if(b != 'u'){
         switch (b) {
@@ -372,7 +470,14 @@ void Utils::unescapeStringToBuffer(const char* data, v_buff_size size, p_char8 r
     } else {
       resultData[pos] = a;
       pos ++;
-      i++;
+      i ++;
+      if(++ run == SCAN_RUN_THRESHOLD) {
+        v_buff_size clean = findBackslashOrEnd(&data[i], size - i);
+        std::memcpy(&resultData[pos], &data[i], static_cast<size_t>(clean));
+        pos += clean;
+        i += clean;
+        run = 0;
+      }
     }
     
   }
@@ -422,15 +527,16 @@ const char* Utils::preparseString(ParsingCaret& caret, v_buff_size& size){
     v_buff_size length = caret.getDataSize();
     
     while (pos < length) {
-      v_char8 a = static_cast<v_char8>(data[pos]);
-      if(a == '"'){
+      v_buff_size found = utils::CharScan::findCharOf(&data[pos], length - pos, '"', '\\');
+      if(found < 0) {
+        break;
+      }
+      pos += found;
+      if(data[pos] == '"'){
         size = pos - pos0;
         return &data[pos0];
-      } else if(a == '\\') {
-        pos += 2;
-      } else {
-        pos ++;
       }
+      pos += 2;
     }
     caret.setPosition(caret.getDataSize());
     caret.setError("[oatpp::json::Utils::preparseString()]: Error. '\"' - expected", ERROR_CODE_PARSER_QUOTE_EXPECTED);
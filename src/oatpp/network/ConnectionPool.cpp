@@ -33,6 +33,10 @@ v_io_size ConnectionAcquisitionProxy::write(const void *buff, v_buff_size count,
   return _handle.object->write(buff, count, action);
 }
 
+v_io_size ConnectionAcquisitionProxy::writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) {
+  return _handle.object->writev(buffers, count, action);
+}
+
 v_io_size ConnectionAcquisitionProxy::read(void *buff, v_buff_size count, async::Action& action) {
   return _handle.object->read(buff, count, action);
 }
@@ -26,6 +26,7 @@
 
 #include "oatpp/base/Log.hpp"
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 
@@ -37,12 +38,149 @@ const v_int32 Server::STATUS_RUNNING = 2;
 const v_int32 Server::STATUS_STOPPING = 3;
 const v_int32 Server::STATUS_DONE = 4;
 
+const std::chrono::milliseconds Server::ASYNC_STOP_TIMEOUT(5000);
+const std::chrono::milliseconds Server::ACCEPT_RETRY_MIN_DELAY(10);
+const std::chrono::milliseconds Server::ACCEPT_RETRY_MAX_DELAY(1000);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Server::AcceptCoroutine
+
+class Server::AcceptCoroutine : public async::Coroutine<AcceptCoroutine> {
+private:
+  std::shared_ptr<AsyncAcceptState> m_state;
+  std::shared_ptr<ConnectionProvider> m_connectionProvider;
+  std::shared_ptr<const std::unordered_map<oatpp::String, oatpp::String>> m_params;
+  v_int64 m_failures;
+  std::chrono::milliseconds m_retryDelay;
+private:
+
+  /*
+   * Persistent accept errors (ex.: `EMFILE`) fail every attempt right away - back off instead of spinning,
+   * and log only the 1st, 2nd, 4th, 8th... consecutive failure.
+   */
+  Action retryAfterFailure(const std::string& message) {
+
+    if(!m_state->running) {
+      return finish();
+    }
+
+    ++ m_failures;
+    m_retryDelay = m_failures == 1 ? ACCEPT_RETRY_MIN_DELAY : std::min(m_retryDelay * 2, ACCEPT_RETRY_MAX_DELAY);
+
+    if((m_failures & (m_failures - 1)) == 0) {
+      OATPP_LOGe("[oatpp::network::server::AcceptCoroutine]", "Error. {} Failed {} time(s) in a row. Retrying in {}ms.",
+                 message, m_failures, m_retryDelay.count())
+    }
+
+    return waitFor(m_retryDelay).next(yieldTo(&AcceptCoroutine::act));
+
+  }
+
+public:
+
+  AcceptCoroutine(const std::shared_ptr<AsyncAcceptState>& state, const std::shared_ptr<ConnectionProvider>& connectionProvider)
+    : m_state(state)
+    , m_connectionProvider(connectionProvider)
+    , m_failures(0)
+    , m_retryDelay(0)
+  {}
+
+  ~AcceptCoroutine() override {
+    -- m_state->coroutines;
+  }
+
+  Action act() override {
+    if(!m_state->running) {
+      return finish();
+    }
+    return m_connectionProvider->getAsync().callbackTo(&AcceptCoroutine::onConnection);
+  }
+
+  Action onConnection(const provider::ResourceHandle<data::stream::IOStream>& connectionHandle) {
+
+    /* async providers return a null handle only if the accept failed or the provider is stopped */
+    if (!connectionHandle) {
+      return retryAfterFailure("Failed to accept connection.");
+    }
+
+    m_failures = 0;
+
+    if (m_state->running) {
+      m_state->connectionHandler->handleConnection(connectionHandle, m_params /* null params */);
+    } else {
+      OATPP_LOGd("[oatpp::network::server::AcceptCoroutine::onConnection()]", "Error. Server already stopped - closing connection...")
+    }
+
+    /* try the next accept right away - pending connections are drained without waiting for the event loop */
+    return yieldTo(&AcceptCoroutine::act);
+
+  }
+
+  Action handleError(async::Error* error) override {
+    return retryAfterFailure(error->what());
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Server
+
 Server::Server(const std::shared_ptr<ConnectionProvider> &connectionProvider,
                const std::shared_ptr<ConnectionHandler> &connectionHandler)
     : m_status(STATUS_CREATED)
     , m_connectionProvider(connectionProvider)
+    , m_connectionProviders({connectionProvider})
     , m_connectionHandler(connectionHandler)
-    , m_threaded(false) {}
+    , m_threaded(false)
+    , m_async(false)
+{}
+
+Server::Server(const std::vector<std::shared_ptr<ConnectionProvider>>& connectionProviders,
+               const std::shared_ptr<ConnectionHandler>& connectionHandler)
+    : m_status(STATUS_CREATED)
+    , m_connectionProviders(connectionProviders)
+    , m_connectionHandler(connectionHandler)
+    , m_threaded(false)
+    , m_async(false)
+{
+  if(m_connectionProviders.empty()) {
+    throw std::runtime_error("[oatpp::network::server::Server()] Error. No connection providers.");
+  }
+  m_connectionProvider = m_connectionProviders[0];
+}
+
+void Server::acceptLoop(const std::shared_ptr<ConnectionProvider>& connectionProvider) {
+
+  std::shared_ptr<const std::unordered_map<oatpp::String, oatpp::String>> params;
+
+  while (getStatus() == STATUS_RUNNING) {
+
+    auto connectionHandle = connectionProvider->get();
+
+    if (connectionHandle) {
+      if (getStatus() == STATUS_RUNNING) {
+        m_connectionHandler->handleConnection(connectionHandle, params /* null params */);
+      } else {
+        OATPP_LOGd("[oatpp::network::server::acceptLoop()]", "Error. Server already stopped - closing connection...")
+      }
+    }
+  }
+
+}
+
+std::vector<std::thread> Server::startAcceptors() {
+  std::vector<std::thread> acceptors;
+  for(size_t i = 1; i < m_connectionProviders.size(); i ++) {
+    acceptors.emplace_back(&Server::acceptLoop, this, m_connectionProviders[i]);
+  }
+  return acceptors;
+}
+
+void Server::joinAcceptors(std::vector<std::thread>& acceptors) {
+  for(auto& acceptor : acceptors) {
+    acceptor.join();
+  }
+}
 
 // This isn't implemented as static since threading is dropped and therefore static isn't needed anymore.
 void Server::conditionalMainLoop() {
@@ -50,6 +188,8 @@ void Server::conditionalMainLoop() {
   setStatus(STATUS_STARTING, STATUS_RUNNING);
   std::shared_ptr<const std::unordered_map<oatpp::String, oatpp::String>> params;
 
+  auto acceptors = startAcceptors();
+
   while (getStatus() == STATUS_RUNNING) {
 
     if (m_condition()) {
@@ -72,26 +212,17 @@ void Server::conditionalMainLoop() {
       setStatus(STATUS_STOPPING);
     }
   }
+  joinAcceptors(acceptors);
   setStatus(STATUS_DONE);
 }
 
 void Server::mainLoop(Server *instance) {
 
   instance->setStatus(STATUS_STARTING, STATUS_RUNNING);
-  std::shared_ptr<const std::unordered_map<oatpp::String, oatpp::String>> params;
-
-  while (instance->getStatus() == STATUS_RUNNING) {
 
-    auto connectionHandle = instance->m_connectionProvider->get();
-
-    if (connectionHandle) {
-      if (instance->getStatus() == STATUS_RUNNING) {
-        instance->m_connectionHandler->handleConnection(connectionHandle, params /* null params */);
-      } else {
-        OATPP_LOGd("[oatpp::network::server::mainLoop()]", "Error. Server already stopped - closing connection...")
-      }
-    }
-  }
+  auto acceptors = instance->startAcceptors();
+  instance->acceptLoop(instance->m_connectionProvider);
+  joinAcceptors(acceptors);
 
   instance->setStatus(STATUS_DONE);
 
@@ -144,7 +275,38 @@ void Server::run(bool startAsNewThread) {
   }
 }
 
+void Server::runAsync(const std::shared_ptr<async::Executor>& executor) {
+  std::lock_guard<std::mutex> lg(m_mutex);
+  switch (getStatus()) {
+    case STATUS_STARTING:
+      throw std::runtime_error("[oatpp::network::server::runAsync()] Error. Server already starting");
+    case STATUS_RUNNING:
+      throw std::runtime_error("[oatpp::network::server::runAsync()] Error. Server already started");
+    default:
+      break;
+  }
+
+  m_threaded = false;
+  m_async = true;
+  setStatus(STATUS_CREATED, STATUS_STARTING);
+
+  m_asyncState = std::make_shared<AsyncAcceptState>();
+  m_asyncState->running = true;
+  m_asyncState->coroutines = static_cast<v_int32>(m_connectionProviders.size());
+  m_asyncState->connectionHandler = m_connectionHandler;
+  m_executor = executor;
+  setStatus(STATUS_STARTING, STATUS_RUNNING);
+
+  for(auto& provider : m_connectionProviders) {
+    executor->execute<AcceptCoroutine>(m_asyncState, provider);
+  }
+}
+
 void Server::stop() {
+  stop(true);
+}
+
+void Server::stop(bool waitForAcceptCoroutines) {
   std::lock_guard<std::mutex> lg(m_mutex);
   switch (getStatus()) {
     case STATUS_CREATED:
@@ -160,6 +322,30 @@ void Server::stop() {
   if (m_threaded && m_thread.joinable()) {
     m_thread.join();
   }
+
+  if (m_async && getStatus() != STATUS_DONE) {
+
+    m_asyncState->running = false;
+
+    /* accept-coroutines may be waiting for connections in the event loop - stop providers to wake them up */
+    for(auto& provider : m_connectionProviders) {
+      provider->stop();
+    }
+
+    /* nothing to wait for if the executor is gone - its coroutines are destroyed with it */
+    if(waitForAcceptCoroutines && !m_executor.expired()) {
+      auto deadline = std::chrono::steady_clock::now() + ASYNC_STOP_TIMEOUT;
+      while (m_asyncState->coroutines > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      if(m_asyncState->coroutines > 0) {
+        OATPP_LOGw("[oatpp::network::server::stop()]", "Accept-coroutines didn't finish in time. Was the executor stopped before the server?")
+      }
+    }
+
+    setStatus(STATUS_DONE);
+
+  }
 }
 
 bool Server::setStatus(v_int32 expectedStatus, v_int32 newStatus) {
@@ -176,7 +362,8 @@ v_int32 Server::getStatus() {
 }
 
 Server::~Server() {
-  stop();
+  /* accept-coroutines don't reference the server - don't wait for them here */
+  stop(false);
 }
 
 }}
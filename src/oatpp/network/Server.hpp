@@ -28,27 +28,66 @@
 #include "oatpp/network/ConnectionHandler.hpp"
 #include "oatpp/network/ConnectionProvider.hpp"
 
+#include "oatpp/async/Executor.hpp"
 #include "oatpp/Types.hpp"
 
 #include "oatpp/base/Countable.hpp"
 #include "oatpp/Environment.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <functional>
+#include <vector>
 
 namespace oatpp { namespace network {
 
 /**
  * Server calls &id:oatpp::network::ConnectionProvider::get; in the loop and passes obtained Connection
- * to &id:oatpp::network::ConnectionHandler;.
+ * to &id:oatpp::network::ConnectionHandler;. <br>
+ * Server may have multiple connection providers (ex.: accept-sockets sharing the same port with `SO_REUSEPORT`) -
+ * in this case each additional provider gets its own acceptor thread feeding the same &id:oatpp::network::ConnectionHandler;.
  */
 class Server : public base::Countable {
+private:
+
+  class AcceptCoroutine;
+
+  /*
+   * State shared with accept-coroutines. Coroutines never touch the Server itself,
+   * so the Server may be destroyed while they are still queued in a stopped executor.
+   */
+  struct AsyncAcceptState {
+    std::atomic<bool> running;
+    std::atomic<v_int32> coroutines;
+    std::shared_ptr<ConnectionHandler> connectionHandler;
+  };
+
+private:
+
+  /*
+   * Max time &l:Server::stop (); waits for accept-coroutines to finish.
+   */
+  static const std::chrono::milliseconds ASYNC_STOP_TIMEOUT;
+
+  /*
+   * Delay before an accept-coroutine retries after a failed accept (ex.: `EMFILE`).
+   * Doubled with each consecutive failure up to the max delay, reset on the next accepted connection.
+   */
+  static const std::chrono::milliseconds ACCEPT_RETRY_MIN_DELAY;
+  static const std::chrono::milliseconds ACCEPT_RETRY_MAX_DELAY;
+
 private:
 
   static void mainLoop(Server *instance);
   void conditionalMainLoop();
 
+  void acceptLoop(const std::shared_ptr<ConnectionProvider>& connectionProvider);
+  std::vector<std::thread> startAcceptors();
+  static void joinAcceptors(std::vector<std::thread>& acceptors);
+
+  void stop(bool waitForAcceptCoroutines);
+
   bool setStatus(v_int32 expectedStatus, v_int32 newStatus);
   void setStatus(v_int32 status);
 
@@ -60,9 +99,13 @@ private:
   std::mutex m_mutex;
 
   std::shared_ptr<ConnectionProvider> m_connectionProvider;
+  std::vector<std::shared_ptr<ConnectionProvider>> m_connectionProviders;
   std::shared_ptr<ConnectionHandler> m_connectionHandler;
 
   bool m_threaded;
+  bool m_async;
+  std::shared_ptr<AsyncAcceptState> m_asyncState;
+  std::weak_ptr<async::Executor> m_executor;
   
 public:
 
@@ -74,6 +117,15 @@ public:
   Server(const std::shared_ptr<ConnectionProvider>& connectionProvider,
          const std::shared_ptr<ConnectionHandler>& connectionHandler);
 
+  /**
+   * Constructor.
+   * @param connectionProviders - `std::vector` of &id:oatpp::network::ConnectionProvider;. <br>
+   * The first provider is served by the thread calling &l:Server::run ();, every other provider gets its own acceptor thread.
+   * @param connectionHandler - &id:oatpp::network::ConnectionHandler;.
+   */
+  Server(const std::vector<std::shared_ptr<ConnectionProvider>>& connectionProviders,
+         const std::shared_ptr<ConnectionHandler>& connectionHandler);
+
   virtual ~Server() override;
 
  public:
@@ -114,6 +166,17 @@ public:
     return std::make_shared<Server>(connectionProvider, connectionHandler);
   }
 
+  /**
+   * Create shared Server with multiple connection providers.
+   * @param connectionProviders - `std::vector` of &id:oatpp::network::ConnectionProvider;.
+   * @param connectionHandler - &id:oatpp::network::ConnectionHandler;.
+   * @return - `std::shared_ptr` to Server.
+   */
+  static std::shared_ptr<Server> createShared(const std::vector<std::shared_ptr<ConnectionProvider>>& connectionProviders,
+                                              const std::shared_ptr<ConnectionHandler>& connectionHandler){
+    return std::make_shared<Server>(connectionProviders, connectionHandler);
+  }
+
   /**
    * Call &id:oatpp::network::ConnectionProvider::getConnection; in the loop and passes obtained Connection
    * to &id:oatpp::network::ConnectionHandler;.
@@ -137,6 +200,19 @@ public:
    */
   void run(bool startAsNewThread);
 
+  /**
+   * Accept connections with &id:oatpp::network::ConnectionProvider::getAsync; - one accept-coroutine per connection provider
+   * is started on the `executor`, obtained connections are passed to &id:oatpp::network::ConnectionHandler;. <br>
+   * No acceptor threads are started - method returns right away. <br>
+   * Use with connection providers implementing `getAsync()`, such as &id:oatpp::network::tcp::server::ConnectionProvider;.
+   * &l:Server::stop (); stops connection providers in this mode and waits for accept-coroutines to finish -
+   * call it before the `executor` is stopped. If the `executor` is already gone it doesn't wait,
+   * otherwise the wait is bounded, so a stopped `executor` doesn't hang it forever. <br>
+   * Server destructor never waits for accept-coroutines.
+   * @param executor - &id:oatpp::async::Executor;.
+   */
+  void runAsync(const std::shared_ptr<async::Executor>& executor);
+
   /**
    * Break server loop.
    * Note: thread can still be blocked on the &l:Server::run (); call as it may be waiting for ConnectionProvider to provide connection.
@@ -46,6 +46,13 @@ ConnectionMonitor::ConnectionProxy::ConnectionProxy(const std::shared_ptr<Monito
                                                     const provider::ResourceHandle<data::stream::IOStream>& connectionHandle)
   : m_monitor(monitor)
   , m_connectionHandle(connectionHandle)
+  , m_totalRead(0)
+  , m_totalWrite(0)
+  , m_timestampLastRead(0)
+  , m_timestampLastWrite(0)
+  , m_lastReadSize(0)
+  , m_lastWriteSize(0)
+  , m_collectorsVersion(0)
 {
   m_stats.timestampCreated = oatpp::Environment::getMicroTickCount();
 }
@@ -69,17 +76,30 @@ ConnectionMonitor::ConnectionProxy::~ConnectionProxy() {
 
 }
 
+void ConnectionMonitor::ConnectionProxy::collectStats() {
+  m_stats.totalRead = m_totalRead.load(std::memory_order_relaxed);
+  m_stats.totalWrite = m_totalWrite.load(std::memory_order_relaxed);
+  m_stats.timestampLastRead = m_timestampLastRead.load(std::memory_order_relaxed);
+  m_stats.timestampLastWrite = m_timestampLastWrite.load(std::memory_order_relaxed);
+  m_stats.lastReadSize = m_lastReadSize.load(std::memory_order_relaxed);
+  m_stats.lastWriteSize = m_lastWriteSize.load(std::memory_order_relaxed);
+}
+
 v_io_size ConnectionMonitor::ConnectionProxy::read(void *buffer, v_buff_size count, async::Action& action) {
   auto res = m_connectionHandle.object->read(buffer, count, action);
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-  m_monitor->onConnectionRead(m_stats, res);
+  m_monitor->onConnectionRead(*this, res);
   return res;
 }
 
 v_io_size ConnectionMonitor::ConnectionProxy::write(const void *data, v_buff_size count, async::Action& action) {
   auto res = m_connectionHandle.object->write(data, count, action);
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-  m_monitor->onConnectionWrite(m_stats, res);
+  m_monitor->onConnectionWrite(*this, res);
+  return res;
+}
+
+v_io_size ConnectionMonitor::ConnectionProxy::writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) {
+  auto res = m_connectionHandle.object->writev(buffers, count, action);
+  m_monitor->onConnectionWrite(*this, res);
   return res;
 }
 
@@ -116,7 +136,16 @@ void ConnectionMonitor::Monitor::monitorTask(std::shared_ptr<Monitor> monitor) {
 
   while(monitor->m_running) {
 
+    std::vector<std::shared_ptr<MetricsChecker>> checkers;
+    bool hasCollectors;
+
     {
+      std::lock_guard<std::mutex> analysersLock(monitor->m_checkMutex);
+      checkers = monitor->m_metricsCheckers;
+      hasCollectors = monitor->m_hasCollectors.load(std::memory_order_relaxed);
+    }
+
+    if(!checkers.empty()) {
 
       std::lock_guard<std::mutex> lock(monitor->m_connectionsMutex);
 
@@ -125,10 +154,16 @@ void ConnectionMonitor::Monitor::monitorTask(std::shared_ptr<Monitor> monitor) {
       for(auto& caddr : monitor->m_connections) {
 
         auto connection = reinterpret_cast<ConnectionProxy*>(caddr);
-        std::lock_guard<std::mutex> dataLock(connection->m_statsMutex);
-        std::lock_guard<std::mutex> analysersLock(monitor->m_checkMutex);
 
-        for(auto& a : monitor->m_metricsCheckers) {
+        /* metricsData is touched by IO threads only when there are stat collectors */
+        std::unique_lock<std::mutex> dataLock(connection->m_statsMutex, std::defer_lock);
+        if(hasCollectors) {
+          dataLock.lock();
+        }
+
+        connection->collectStats();
+
+        for(auto& a : checkers) {
           bool res = a->check(connection->m_stats, currMicroTime);
           if(!res) {
             connection->invalidate();
@@ -165,6 +200,40 @@ void* ConnectionMonitor::Monitor::createOrGetMetricData(ConnectionStats& stats,
   return data;
 }
 
+void ConnectionMonitor::Monitor::updateCollectorsSnapshot() {
+  auto snapshot = std::make_shared<std::vector<std::shared_ptr<StatCollector>>>();
+  snapshot->reserve(m_statCollectors.size());
+  for(auto& pair : m_statCollectors) {
+    snapshot->push_back(pair.second);
+  }
+  m_collectorsSnapshot = snapshot;
+  m_hasCollectors.store(!snapshot->empty(), std::memory_order_release);
+  m_collectorsVersion.fetch_add(1, std::memory_order_release);
+}
+
+void ConnectionMonitor::Monitor::runCollectors(ConnectionProxy& connection, v_io_size ioResult, v_int64 timestamp, bool isRead) {
+
+  std::lock_guard<std::mutex> lock(connection.m_statsMutex);
+
+  auto version = m_collectorsVersion.load(std::memory_order_acquire);
+  if(connection.m_collectorsVersion != version) {
+    std::lock_guard<std::mutex> checkLock(m_checkMutex);
+    connection.m_collectors = m_collectorsSnapshot;
+    connection.m_collectorsVersion = m_collectorsVersion.load(std::memory_order_relaxed);
+  }
+
+  if(connection.m_collectors) {
+    for(auto& collector : *connection.m_collectors) {
+      if(isRead) {
+        collector->onRead(createOrGetMetricData(connection.m_stats, collector), ioResult, timestamp);
+      } else {
+        collector->onWrite(createOrGetMetricData(connection.m_stats, collector), ioResult, timestamp);
+      }
+    }
+  }
+
+}
+
 std::shared_ptr<ConnectionMonitor::Monitor> ConnectionMonitor::Monitor::createShared() {
   auto monitor = std::make_shared<Monitor>();
   std::thread t([monitor](){
@@ -183,13 +252,16 @@ void ConnectionMonitor::Monitor::freeConnectionStats(ConnectionStats& stats) {
 
   std::lock_guard<std::mutex> lock(m_checkMutex);
 
-  for(auto& metric : stats.metricsData) {
-    auto it = m_statCollectors.find(metric.first);
+  auto metric = stats.metricsData.begin();
+  while(metric != stats.metricsData.end()) {
+    auto it = m_statCollectors.find(metric->first);
     if(it != m_statCollectors.end()) {
-      it->second->deleteMetricData(metric.second);
+      it->second->deleteMetricData(metric->second);
+      metric = stats.metricsData.erase(metric);
     } else {
       OATPP_LOGe("[oatpp::network::ConnectionMonitor::Monitor::freeConnectionStats]",
-                 "Error. Can't free Metric data. Unknown Metric: name - '{}'", metric.first->c_str())
+                 "Error. Can't free Metric data. Unknown Metric: name - '{}'", metric->first->c_str())
+      ++ metric;
     }
   }
 
@@ -211,11 +283,13 @@ void ConnectionMonitor::Monitor::invalidateAll() {
 void ConnectionMonitor::Monitor::addStatCollector(const std::shared_ptr<StatCollector>& collector) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
   m_statCollectors.insert({collector->metricName(), collector});
+  updateCollectorsSnapshot();
 }
 
 void ConnectionMonitor::Monitor::removeStatCollector(const oatpp::String& metricName) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
   m_statCollectors.erase(metricName);
+  updateCollectorsSnapshot();
 }
 
 void ConnectionMonitor::Monitor::addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker) {
@@ -228,42 +302,39 @@ void ConnectionMonitor::Monitor::addMetricsChecker(const std::shared_ptr<Metrics
       m_statCollectors.insert({m, checker->createStatCollector(m)});
     }
   }
+  if(!metrics.empty()) {
+    updateCollectorsSnapshot();
+  }
 }
 
-void ConnectionMonitor::Monitor::onConnectionRead(ConnectionStats& stats, v_io_size readResult) {
+void ConnectionMonitor::Monitor::onConnectionRead(ConnectionProxy& connection, v_io_size readResult) {
 
   v_int64 currTimestamp = oatpp::Environment::getMicroTickCount();
 
   if(readResult > 0) {
-    stats.totalRead += readResult;
-    stats.lastReadSize = readResult;
-    stats.timestampLastRead = currTimestamp;
+    connection.m_totalRead.fetch_add(readResult, std::memory_order_relaxed);
+    connection.m_lastReadSize.store(readResult, std::memory_order_relaxed);
+    connection.m_timestampLastRead.store(currTimestamp, std::memory_order_relaxed);
   }
 
-  {
-    std::lock_guard<std::mutex> lock(m_checkMutex);
-    for(auto& pair : m_statCollectors) {
-      pair.second->onRead(createOrGetMetricData(stats, pair.second), readResult, currTimestamp);
-    }
+  if(m_hasCollectors.load(std::memory_order_acquire)) {
+    runCollectors(connection, readResult, currTimestamp, true);
   }
 
 }
 
-void ConnectionMonitor::Monitor::onConnectionWrite(ConnectionStats& stats, v_io_size writeResult) {
+void ConnectionMonitor::Monitor::onConnectionWrite(ConnectionProxy& connection, v_io_size writeResult) {
 
   v_int64 currTimestamp = oatpp::Environment::getMicroTickCount();
 
   if(writeResult > 0) {
-    stats.totalWrite += writeResult;
-    stats.lastWriteSize = writeResult;
-    stats.timestampLastWrite = currTimestamp;
+    connection.m_totalWrite.fetch_add(writeResult, std::memory_order_relaxed);
+    connection.m_lastWriteSize.store(writeResult, std::memory_order_relaxed);
+    connection.m_timestampLastWrite.store(currTimestamp, std::memory_order_relaxed);
   }
 
-  {
-    std::lock_guard<std::mutex> lock(m_checkMutex);
-    for(auto& pair : m_statCollectors) {
-      pair.second->onWrite(createOrGetMetricData(stats, pair.second), writeResult, currTimestamp);
-    }
+  if(m_hasCollectors.load(std::memory_order_acquire)) {
+    runCollectors(connection, writeResult, currTimestamp, false);
   }
 
 }
@@ -32,6 +32,7 @@
 
 #include <unordered_set>
 #include <condition_variable>
+#include <atomic>
 
 namespace oatpp { namespace network { namespace monitor {
 
@@ -58,8 +59,27 @@ private:
   private:
     std::shared_ptr<Monitor> m_monitor;
     provider::ResourceHandle<data::stream::IOStream> m_connectionHandle;
+  private:
+    /*
+     * IO counters. Updated with relaxed atomics on each IO call, collected into m_stats by the monitor thread.
+     */
+    std::atomic<v_io_size> m_totalRead;
+    std::atomic<v_io_size> m_totalWrite;
+    std::atomic<v_int64> m_timestampLastRead;
+    std::atomic<v_int64> m_timestampLastWrite;
+    std::atomic<v_io_size> m_lastReadSize;
+    std::atomic<v_io_size> m_lastWriteSize;
+  private:
+    /*
+     * Guards metricsData of m_stats and the collectors snapshot.
+     * Taken only when there are stat collectors registered.
+     */
     std::mutex m_statsMutex;
     ConnectionStats m_stats;
+    std::shared_ptr<const std::vector<std::shared_ptr<StatCollector>>> m_collectors;
+    v_uint64 m_collectorsVersion;
+  private:
+    void collectStats();
   public:
 
     ConnectionProxy(const std::shared_ptr<Monitor>& monitor,
@@ -69,6 +89,7 @@ private:
 
     v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
     v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+    v_io_size writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) override;
 
     void setInputStreamIOMode(data::stream::IOMode ioMode) override;
     data::stream::IOMode getInputStreamIOMode() override;
@@ -99,10 +120,20 @@ private:
     std::vector<std::shared_ptr<MetricsChecker>> m_metricsCheckers;
     std::unordered_map<oatpp::String, std::shared_ptr<StatCollector>> m_statCollectors;
 
+    /*
+     * Immutable snapshot of m_statCollectors shared with connections.
+     * Connections re-read it only when m_collectorsVersion changes.
+     */
+    std::shared_ptr<const std::vector<std::shared_ptr<StatCollector>>> m_collectorsSnapshot;
+    std::atomic<v_uint64> m_collectorsVersion {0};
+    std::atomic<bool> m_hasCollectors {false};
+
   private:
     static void monitorTask(std::shared_ptr<Monitor> monitor);
   private:
     static void* createOrGetMetricData(ConnectionStats& stats, const std::shared_ptr<StatCollector>& collector);
+    void updateCollectorsSnapshot();
+    void runCollectors(ConnectionProxy& connection, v_io_size ioResult, v_int64 timestamp, bool isRead);
   public:
 
     static std::shared_ptr<Monitor> createShared();
@@ -118,8 +149,8 @@ private:
 
     void addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker);
 
-    void onConnectionRead(ConnectionStats& stats, v_io_size readResult);
-    void onConnectionWrite(ConnectionStats& stats, v_io_size writeResult);
+    void onConnectionRead(ConnectionProxy& connection, v_io_size readResult);
+    void onConnectionWrite(ConnectionProxy& connection, v_io_size writeResult);
 
     void stop();
 
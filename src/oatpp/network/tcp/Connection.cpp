@@ -30,6 +30,12 @@
 #else
   #include <unistd.h>
   #include <sys/socket.h>
+  #include <sys/uio.h>
+  #include <csignal>
+  #if defined(__linux__)
+    #include <sys/sendfile.h>
+    #define OATPP_TCP_SENDFILE
+  #endif
 #endif
 
 #include <thread>
@@ -43,6 +49,15 @@ namespace oatpp { namespace network { namespace tcp {
 
 oatpp::data::stream::DefaultInitializedContext Connection::DEFAULT_CONTEXT(data::stream::StreamType::STREAM_INFINITE);
 
+namespace {
+
+/*
+ * Max number of buffers passed to a single vectored write. The rest is reported as a partial write.
+ */
+constexpr size_t MAX_IOV_COUNT = 64;
+
+}
+
 Connection::Connection(v_io_handle handle)
   : m_handle(handle)
 {
@@ -81,6 +96,154 @@ Connection::~Connection(){
 #pragma GCC diagnostic ignored "-Wlogical-op"
 #endif
 
+#if defined(OATPP_TCP_SENDFILE)
+
+namespace {
+
+/*
+ * There is no MSG_NOSIGNAL for sendfile(), and no SO_NOSIGPIPE on Linux.
+ * SIGPIPE is blocked in the calling thread for the duration of one sendfile() call, the signal raised by a broken pipe
+ * is discarded, and the previous signal mask is restored.
+ * The process-wide disposition of SIGPIPE is not changed.
+ */
+class SigPipeGuard {
+private:
+
+  static bool isPending() {
+    sigset_t pending;
+    sigemptyset(&pending);
+    return sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE) == 1;
+  }
+
+private:
+  sigset_t m_mask;
+  sigset_t m_oldMask;
+  bool m_wasBlocked;
+  bool m_wasPending;
+public:
+
+  SigPipeGuard() {
+    sigemptyset(&m_mask);
+    sigaddset(&m_mask, SIGPIPE);
+    sigemptyset(&m_oldMask);
+    pthread_sigmask(SIG_BLOCK, &m_mask, &m_oldMask);
+    m_wasBlocked = sigismember(&m_oldMask, SIGPIPE) == 1;
+    /* an unblocked SIGPIPE can't be pending - it is either delivered or ignored */
+    m_wasPending = m_wasBlocked && isPending();
+  }
+
+  ~SigPipeGuard() {
+    if(!m_wasBlocked) {
+      pthread_sigmask(SIG_SETMASK, &m_oldMask, nullptr);
+    }
+  }
+
+  /*
+   * Call on EPIPE - consume the SIGPIPE raised by this call, but not the one that was pending before.
+   */
+  void discard() {
+    if(m_wasPending || !isPending()) {
+      return;
+    }
+    timespec zero = {0, 0};
+    while(sigtimedwait(&m_mask, nullptr, &zero) == -1 && errno == EINTR) {}
+  }
+
+};
+
+}
+
+#endif
+
+bool Connection::isSendFileSupported() {
+#if defined(OATPP_TCP_SENDFILE)
+  return true;
+#else
+  return false;
+#endif
+}
+
+v_io_size Connection::sendFile(v_io_handle fileHandle, v_int64 offset, v_buff_size count, async::Action& action) {
+
+#if defined(OATPP_TCP_SENDFILE)
+
+  SigPipeGuard sigPipeGuard;
+
+  errno = 0;
+  off_t fileOffset = offset;
+  auto result = ::sendfile(m_handle, fileHandle, &fileOffset, static_cast<size_t>(count));
+
+  if(result < 0) {
+    auto e = errno;
+
+    if(e == EPIPE) {
+      sigPipeGuard.discard();
+    }
+
+    bool retry = ((e == EAGAIN) || (e == EWOULDBLOCK));
+
+    if(retry){
+      if(m_mode == data::stream::ASYNCHRONOUS) {
+        action = oatpp::async::Action::createIOWaitAction(m_handle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      return IOError::RETRY_WRITE;
+    }
+
+    if(e == EINTR) {
+      return IOError::RETRY_WRITE;
+    }
+
+    return IOError::BROKEN_PIPE; // Consider all other errors as a broken pipe.
+  }
+  return result;
+
+#else
+
+  (void) fileHandle;
+  (void) offset;
+  (void) count;
+  (void) action;
+  return IOError::BROKEN_PIPE;
+
+#endif
+
+}
+
+v_io_size Connection::writeMore(const void *buff, v_buff_size count, async::Action& action) {
+
+#if defined(MSG_MORE)
+
+  errno = 0;
+  auto result = ::send(m_handle, buff, static_cast<size_t>(count), MSG_MORE | MSG_NOSIGNAL);
+
+  if(result < 0) {
+    auto e = errno;
+
+    bool retry = ((e == EAGAIN) || (e == EWOULDBLOCK));
+
+    if(retry){
+      if(m_mode == data::stream::ASYNCHRONOUS) {
+        action = oatpp::async::Action::createIOWaitAction(m_handle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      return IOError::RETRY_WRITE;
+    }
+
+    if(e == EINTR) {
+      return IOError::RETRY_WRITE;
+    }
+
+    return IOError::BROKEN_PIPE; // Consider all other errors as a broken pipe.
+  }
+  return result;
+
+#else
+
+  return write(buff, count, action);
+
+#endif
+
+}
+
 v_io_size Connection::write(const void *buff, v_buff_size count, async::Action& action){
 
 #if defined(WIN32) || defined(_WIN32)
@@ -147,6 +310,97 @@ v_io_size Connection::write(const void *buff, v_buff_size count, async::Action&
 
 }
 
+v_io_size Connection::writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) {
+
+#if defined(WIN32) || defined(_WIN32)
+
+  WSABUF wsaBuffers[MAX_IOV_COUNT];
+  DWORD wsaCount = 0;
+
+  for(v_buff_size i = 0; i < count && wsaCount < MAX_IOV_COUNT; i ++) {
+    if(buffers[i].bytesLeft > 0) {
+      wsaBuffers[wsaCount].buf = (CHAR*) buffers[i].currBufferPtr;
+      wsaBuffers[wsaCount].len = (ULONG) buffers[i].bytesLeft;
+      wsaCount ++;
+    }
+  }
+
+  if(wsaCount == 0) {
+    return 0;
+  }
+
+  DWORD result = 0;
+  if(WSASend(m_handle, wsaBuffers, wsaCount, &result, 0, NULL, NULL) == SOCKET_ERROR) {
+
+    auto e = WSAGetLastError();
+
+    if(e == WSAEWOULDBLOCK){
+      if(m_mode == data::stream::ASYNCHRONOUS) {
+        action = oatpp::async::Action::createIOWaitAction(m_handle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      return IOError::RETRY_WRITE; // For async io. In case socket is non-blocking
+    } else if(e == WSAEINTR) {
+      return IOError::RETRY_WRITE;
+    } else {
+      return IOError::BROKEN_PIPE; // Consider all other errors as a broken pipe.
+    }
+  }
+  return (v_io_size) result;
+
+#else
+
+  iovec iov[MAX_IOV_COUNT];
+  size_t iovCount = 0;
+
+  for(v_buff_size i = 0; i < count && iovCount < MAX_IOV_COUNT; i ++) {
+    if(buffers[i].bytesLeft > 0) {
+      iov[iovCount].iov_base = const_cast<void*>(buffers[i].currBufferPtr);
+      iov[iovCount].iov_len = static_cast<size_t>(buffers[i].bytesLeft);
+      iovCount ++;
+    }
+  }
+
+  if(iovCount == 0) {
+    return 0;
+  }
+
+  msghdr message{};
+  message.msg_iov = iov;
+  message.msg_iovlen = iovCount;
+
+  errno = 0;
+  v_int32 flags = 0;
+
+#ifdef MSG_NOSIGNAL
+  flags |= MSG_NOSIGNAL;
+#endif
+
+  auto result = ::sendmsg(m_handle, &message, flags);
+
+  if(result < 0) {
+    auto e = errno;
+
+    bool retry = ((e == EAGAIN) || (e == EWOULDBLOCK));
+
+    if(retry){
+      if(m_mode == data::stream::ASYNCHRONOUS) {
+        action = oatpp::async::Action::createIOWaitAction(m_handle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      return IOError::RETRY_WRITE; // For async io. In case socket is non-blocking
+    }
+
+    if(e == EINTR) {
+      return IOError::RETRY_WRITE;
+    }
+
+    return IOError::BROKEN_PIPE; // Consider all other errors as a broken pipe.
+  }
+  return result;
+
+#endif
+
+}
+
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif
@@ -64,6 +64,17 @@ public:
    */
   v_io_size write(const void *buff, v_buff_size count, async::Action& action) override;
 
+  /**
+   * Implementation of &id:oatpp::data::stream::WriteCallback::writev;. <br>
+   * Writes all buffers with a single `sendmsg` (`WSASend` on Windows) call.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual amount of bytes written. See &id:oatpp::v_io_size;.
+   */
+  v_io_size writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) override;
+
   /**
    * Implementation of &id:oatpp::data::stream::IOStream::read;.
    * @param buff - buffer to read data to.
@@ -110,6 +121,41 @@ public:
    */
   oatpp::data::stream::Context& getInputStreamContext() override;
 
+  /**
+   * Check if &l:Connection::sendFile (); is supported on this platform.
+   * @return - `true` if supported.
+   */
+  static bool isSendFileSupported();
+
+  /**
+   * Send data from the file directly to the socket, without copying it through user space (`sendfile(2)`). <br>
+   * Follows &l:Connection::write (); conventions in regards to I/O errors and the async `action`. <br>
+   * There is no `MSG_NOSIGNAL` for `sendfile(2)` - `SIGPIPE` is blocked in the calling thread for the duration of the call,
+   * the signal raised by a broken pipe is discarded, and the previous signal mask is restored.
+   * The process-wide `SIGPIPE` disposition is not changed.
+   * @param fileHandle - file descriptor of the file opened for reading.
+   * @param offset - offset in the file to start sending from.
+   * @param count - max number of bytes to send.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes sent. See &id:oatpp::v_io_size;. <br>
+   * &id:oatpp::IOError::BROKEN_PIPE; - if not supported. See &l:Connection::isSendFileSupported ();.
+   */
+  v_io_size sendFile(v_io_handle fileHandle, v_int64 offset, v_buff_size count, async::Action& action);
+
+  /**
+   * Write data telling the kernel that more data follows (`MSG_MORE`). <br>
+   * Used to send headers before &l:Connection::sendFile (); - headers go out in the same tcp segment with the first
+   * bytes of the file instead of a separate small segment, which would make the file data wait for a delayed ACK. <br>
+   * Same as &l:Connection::write (); on platforms without `MSG_MORE`.
+   * @param buff - buffer containing data to write.
+   * @param count - bytes count you want to write.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual amount of bytes written. See &id:oatpp::v_io_size;.
+   */
+  v_io_size writeMore(const void *buff, v_buff_size count, async::Action& action);
+
   /**
    * Close socket handle.
    */
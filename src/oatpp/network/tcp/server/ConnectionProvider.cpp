@@ -28,6 +28,7 @@
 #include "oatpp/base/Log.hpp"
 
 #include <fcntl.h>
+#include <cerrno>
 
 #if defined(WIN32) || defined(_WIN32)
   #include <io.h>
@@ -71,6 +72,28 @@
 
 namespace oatpp { namespace network { namespace tcp { namespace server {
 
+namespace {
+
+oatpp::v_io_handle acceptHandle(oatpp::v_io_handle serverHandle, sockaddr* address, v_sock_size* addressSize) {
+#if defined(__linux__)
+  return ::accept4(serverHandle, address, addressSize, SOCK_CLOEXEC);
+#else
+  return ::accept(serverHandle, address, addressSize);
+#endif
+}
+
+bool isAcceptWouldBlock() {
+#if defined(WIN32) || defined(_WIN32)
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#elif defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+  return errno == EAGAIN || errno == EWOULDBLOCK;
+#else
+  return errno == EAGAIN;
+#endif
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ExtendedConnection
 
@@ -123,33 +146,141 @@ void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ConnectionProvider
 
-ConnectionProvider::ConnectionProvider(const network::Address& address, bool useExtendedConnections)
+ConnectionProvider::ConnectionProvider(const network::Address& address, bool useExtendedConnections, bool reusePort)
         : m_invalidator(std::make_shared<ConnectionInvalidator>())
         , m_address(address)
         , m_closed(false)
+        , m_asyncAccept(false)
+        , m_wakeupHandle(INVALID_IO_HANDLE)
+        , m_serverHandleClosed(false)
         , m_useExtendedConnections(useExtendedConnections)
+        , m_reusePort(reusePort)
 {
   setProperty(PROPERTY_HOST, m_address.host);
   setProperty(PROPERTY_PORT, oatpp::utils::Conversion::int32ToStr(m_address.port));
   m_serverHandle = instantiateServer();
 }
 
+std::vector<std::shared_ptr<ConnectionProvider>> ConnectionProvider::createReusePortGroup(const network::Address& address,
+                                                                                          v_int32 count,
+                                                                                          bool useExtendedConnections)
+{
+
+  std::vector<std::shared_ptr<ConnectionProvider>> result;
+  if(count <= 0) {
+    return result;
+  }
+
+  result.reserve(static_cast<size_t>(count));
+  result.push_back(createShared(address, useExtendedConnections, true));
+
+  /* in case of port = 0 bind the rest of providers to the port picked for the first one */
+  network::Address groupAddress = address;
+  groupAddress.port = static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(result[0]->getProperty(PROPERTY_PORT).toString()->c_str()));
+
+  for(v_int32 i = 1; i < count; i ++) {
+    result.push_back(createShared(groupAddress, useExtendedConnections, true));
+  }
+
+  return result;
+
+}
+
 void ConnectionProvider::setConnectionConfigurer(const std::shared_ptr<ConnectionConfigurer> &connectionConfigurer) {
   m_connectionConfigurer = connectionConfigurer;
 }
 
 ConnectionProvider::~ConnectionProvider() {
   stop();
+  closeServerHandle();
+}
+
+void ConnectionProvider::closeServerHandle() {
+  if(!m_serverHandleClosed) {
+    m_serverHandleClosed = true;
+#if defined(WIN32) || defined(_WIN32)
+    ::closesocket(m_serverHandle);
+#else
+    ::close(m_serverHandle);
+#endif
+  }
+  if(m_wakeupHandle != INVALID_IO_HANDLE) {
+#if defined(WIN32) || defined(_WIN32)
+    ::closesocket(m_wakeupHandle);
+#else
+    ::close(m_wakeupHandle);
+#endif
+    m_wakeupHandle = INVALID_IO_HANDLE;
+  }
+}
+
+void ConnectionProvider::wakeUpAsyncAccept() {
+
+  /* connect to the own accept-socket - a pending connection makes it readable for every poller */
+
+  sockaddr_storage address;
+  oatpp::v_sock_size addressSize = sizeof(address);
+  if(::getsockname(m_serverHandle, reinterpret_cast<sockaddr*>(&address), &addressSize) != 0) {
+    return;
+  }
+
+  if(address.ss_family == AF_INET) {
+    auto addr = reinterpret_cast<sockaddr_in*>(&address);
+    if(addr->sin_addr.s_addr == htonl(INADDR_ANY)) {
+      addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    }
+  } else if(address.ss_family == AF_INET6) {
+    auto addr = reinterpret_cast<sockaddr_in6*>(&address);
+    if(IN6_IS_ADDR_UNSPECIFIED(&addr->sin6_addr)) {
+      addr->sin6_addr = in6addr_loopback;
+    }
+  } else {
+    return;
+  }
+
+  oatpp::v_io_handle handle = ::socket(address.ss_family, SOCK_STREAM, 0);
+  if(handle == INVALID_IO_HANDLE) {
+    return;
+  }
+
+#if defined(WIN32) || defined(_WIN32)
+  u_long flags = 1;
+  ioctlsocket(handle, FIONBIO, &flags);
+#else
+  fcntl(handle, F_SETFL, O_NONBLOCK);
+#endif
+
+  /* non-blocking connect - "in progress" is fine, the handshake completes in the kernel */
+  ::connect(handle, reinterpret_cast<sockaddr*>(&address), addressSize);
+
+  /* keep it open until the accept-socket is closed, so the pending connection stays in the backlog */
+  m_wakeupHandle = handle;
+
 }
 
 void ConnectionProvider::stop() {
-  if(!m_closed) {
-    m_closed = true;
+
+  std::lock_guard<std::mutex> lock(m_acceptMutex);
+
+  if(!m_closed.exchange(true)) {
+
+    if(!m_asyncAccept) {
+      closeServerHandle();
+      return;
+    }
+
+    /*
+     * Accept-coroutines may be registered in the IOEventWorker with this handle.
+     * Closing it would silently drop it from the poller and coroutines would be stuck there forever -
+     * wake them up and shutdown instead. Handle is closed in the destructor.
+     */
+    wakeUpAsyncAccept();
 #if defined(WIN32) || defined(_WIN32)
-	  ::closesocket(m_serverHandle);
+    ::shutdown(m_serverHandle, SD_BOTH);
 #else
-	  ::close(m_serverHandle);
+    ::shutdown(m_serverHandle, SHUT_RDWR);
 #endif
+
   }
 }
 
@@ -202,6 +333,11 @@ oatpp::v_io_handle ConnectionProvider::instantiateServer(){
         }
       }
 
+      if (m_reusePort) {
+        OATPP_LOGw("[oatpp::network::tcp::server::ConnectionProvider::instantiateServer()]",
+                   "Warning. {} is not supported on this platform.", "SO_REUSEPORT")
+      }
+
       if (bind(serverHandle, currResult->ai_addr, (int) currResult->ai_addrlen) != SOCKET_ERROR &&
           listen(serverHandle, SOMAXCONN) != SOCKET_ERROR)
       {
@@ -285,6 +421,18 @@ oatpp::v_io_handle ConnectionProvider::instantiateServer(){
                    "Warning. Failed to set {} for accepting socket: {}", "SO_REUSEADDR", strerror(errno))
       }
 
+      if (m_reusePort) {
+#if defined(SO_REUSEPORT)
+        if (setsockopt(serverHandle, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(int)) != 0) {
+          OATPP_LOGw("[oatpp::network::tcp::server::ConnectionProvider::instantiateServer()]",
+                     "Warning. Failed to set {} for accepting socket: {}", "SO_REUSEPORT", strerror(errno))
+        }
+#else
+        OATPP_LOGw("[oatpp::network::tcp::server::ConnectionProvider::instantiateServer()]",
+                   "Warning. {} is not supported on this platform.", "SO_REUSEPORT")
+#endif
+      }
+
       if (bind(serverHandle, currResult->ai_addr, currResult->ai_addrlen) == 0 &&
           listen(serverHandle, 10000) == 0)
       {
@@ -342,7 +490,7 @@ void ConnectionProvider::prepareConnectionHandle(oatpp::v_io_handle handle) {
 
 provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getDefaultConnection() {
 
-  oatpp::v_io_handle handle = accept(m_serverHandle, nullptr, nullptr);
+  oatpp::v_io_handle handle = acceptHandle(m_serverHandle, nullptr, nullptr);
 
   if(!oatpp::isValidIOHandle(handle)) {
     return nullptr;
@@ -364,7 +512,7 @@ provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtended
 
   data::stream::Context::Properties properties;
 
-  oatpp::v_io_handle handle = accept(m_serverHandle, reinterpret_cast<sockaddr*>(&clientAddress), &clientAddressSize);
+  oatpp::v_io_handle handle = acceptHandle(m_serverHandle, reinterpret_cast<sockaddr*>(&clientAddress), &clientAddressSize);
 
   if(!oatpp::isValidIOHandle(handle)) {
     return nullptr;
@@ -412,35 +560,43 @@ provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::getExtended
 
 }
 
-provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionProvider::get() {
-
-  while(!m_closed) {
+void ConnectionProvider::waitForConnection() {
 
-    fd_set set;
-    timeval timeout;
-    FD_ZERO(&set);
-    FD_SET(m_serverHandle, &set);
+  fd_set set;
+  timeval timeout;
+  FD_ZERO(&set);
+  FD_SET(m_serverHandle, &set);
 
-    timeout.tv_sec = 1;
-    timeout.tv_usec = 0;
+  timeout.tv_sec = 1;
+  timeout.tv_usec = 0;
 
-    auto res = select(
+  select(
 #if defined(WIN32) || defined(_WIN32)
-      static_cast<int>(m_serverHandle + 1),
+    static_cast<int>(m_serverHandle + 1),
 #else
-      m_serverHandle + 1,
+    m_serverHandle + 1,
 #endif
-      &set,
-      nullptr,
-      nullptr,
-      &timeout);
+    &set,
+    nullptr,
+    nullptr,
+    &timeout);
 
-    if (res >= 0) {
-      break;
-    }
+}
+
+provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionProvider::get() {
+
+  if(m_closed) {
+    return nullptr;
+  }
 
+  /* accept-socket is non-blocking - try to accept first, wait only if there is no pending connection */
+  auto connection = m_useExtendedConnections ? getExtendedConnection() : getDefaultConnection();
+  if(connection || !isAcceptWouldBlock()) {
+    return connection;
   }
 
+  waitForConnection();
+
   if(m_useExtendedConnections) {
     return getExtendedConnection();
   }
@@ -449,4 +605,41 @@ provider::ResourceHandle<oatpp::data::stream::IOStream> ConnectionProvider::get(
 
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionProvider::AcceptCoroutine
+
+class ConnectionProvider::AcceptCoroutine : public oatpp::async::CoroutineWithResult<AcceptCoroutine, const provider::ResourceHandle<oatpp::data::stream::IOStream>&> {
+private:
+  ConnectionProvider* m_provider;
+public:
+
+  AcceptCoroutine(ConnectionProvider* provider)
+    : m_provider(provider)
+  {}
+
+  Action act() override {
+
+    if(m_provider->m_closed) {
+      return _return(nullptr);
+    }
+
+    auto connection = m_provider->m_useExtendedConnections ? m_provider->getExtendedConnection() : m_provider->getDefaultConnection();
+    if(connection || !isAcceptWouldBlock()) {
+      return _return(connection);
+    }
+
+    /* no pending connections - wait for the accept-socket to become readable and try again */
+    return ioWait(m_provider->m_serverHandle, oatpp::async::Action::IOEventType::IO_EVENT_READ);
+
+  }
+
+};
+
+oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<oatpp::data::stream::IOStream>&> ConnectionProvider::getAsync() {
+  /* synchronized with stop() - it must know whether the handle may be registered in the event loop */
+  std::lock_guard<std::mutex> lock(m_acceptMutex);
+  m_asyncAccept = true;
+  return AcceptCoroutine::startForResult(this);
+}
+
 }}}}
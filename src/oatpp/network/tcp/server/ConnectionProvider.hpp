@@ -32,6 +32,9 @@
 
 #include "oatpp/Types.hpp"
 
+#include <mutex>
+#include <vector>
+
 namespace oatpp { namespace network { namespace tcp { namespace server {
 
 /**
@@ -40,6 +43,8 @@ namespace oatpp { namespace network { namespace tcp { namespace server {
 class ConnectionProvider : public ServerConnectionProvider {
 private:
 
+  class AcceptCoroutine;
+
   class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
   public:
 
@@ -87,13 +92,21 @@ public:
 private:
   std::shared_ptr<ConnectionInvalidator> m_invalidator;
   network::Address m_address;
+  std::mutex m_acceptMutex;
   std::atomic<bool> m_closed;
+  std::atomic<bool> m_asyncAccept;
   oatpp::v_io_handle m_serverHandle;
+  oatpp::v_io_handle m_wakeupHandle;
+  bool m_serverHandleClosed;
   bool m_useExtendedConnections;
+  bool m_reusePort;
   std::shared_ptr<ConnectionConfigurer> m_connectionConfigurer;
 private:
   oatpp::v_io_handle instantiateServer();
+  void closeServerHandle();
+  void wakeUpAsyncAccept();
 private:
+  void waitForConnection();
   void prepareConnectionHandle(oatpp::v_io_handle handle);
   provider::ResourceHandle<data::stream::IOStream> getDefaultConnection();
   provider::ResourceHandle<data::stream::IOStream> getExtendedConnection();
@@ -104,8 +117,11 @@ public:
    * @param address - &id:oatpp::network::Address;.
    * @param useExtendedConnections - set `true` to use &l:ConnectionProvider::ExtendedConnection;.
    * `false` to use &id:oatpp::network::tcp::Connection;.
+   * @param reusePort - set `true` to set `SO_REUSEPORT` on the accept-socket, so that multiple providers
+   * can listen on the same port and the kernel balances incoming connections between them.
+   * Ignored (with warning) on platforms without `SO_REUSEPORT`.
    */
-  ConnectionProvider(const network::Address& address, bool useExtendedConnections = false);
+  ConnectionProvider(const network::Address& address, bool useExtendedConnections = false, bool reusePort = false);
 
 public:
 
@@ -114,12 +130,29 @@ public:
    * @param address - &id:oatpp::network::Address;.
    * @param useExtendedConnections - set `true` to use &l:ConnectionProvider::ExtendedConnection;.
    * `false` to use &id:oatpp::network::tcp::Connection;.
+   * @param reusePort - set `true` to set `SO_REUSEPORT` on the accept-socket.
    * @return - `std::shared_ptr` to ConnectionProvider.
    */
-  static std::shared_ptr<ConnectionProvider> createShared(const network::Address& address, bool useExtendedConnections = false){
-    return std::make_shared<ConnectionProvider>(address, useExtendedConnections);
+  static std::shared_ptr<ConnectionProvider> createShared(const network::Address& address,
+                                                          bool useExtendedConnections = false,
+                                                          bool reusePort = false)
+  {
+    return std::make_shared<ConnectionProvider>(address, useExtendedConnections, reusePort);
   }
 
+  /**
+   * Create group of ConnectionProviders listening on the same port with `SO_REUSEPORT`. <br>
+   * Pass them to &id:oatpp::network::Server; to accept connections with one acceptor thread per provider.
+   * If `address.port` is `0` all providers are bound to the port picked for the first one.
+   * @param address - &id:oatpp::network::Address;.
+   * @param count - number of providers (accept-sockets).
+   * @param useExtendedConnections - set `true` to use &l:ConnectionProvider::ExtendedConnection;.
+   * @return - `std::vector` of `std::shared_ptr` to ConnectionProvider.
+   */
+  static std::vector<std::shared_ptr<ConnectionProvider>> createReusePortGroup(const network::Address& address,
+                                                                              v_int32 count,
+                                                                              bool useExtendedConnections = false);
+
   /**
    * Set connection configurer.
    * @param connectionConfigurer
@@ -132,35 +165,31 @@ public:
   ~ConnectionProvider() override;
 
   /**
-   * Close accept-socket.
+   * Close accept-socket. <br>
+   * If &l:ConnectionProvider::getAsync (); was ever called the accept-socket is only shut down here,
+   * and the handle itself is closed in the destructor, after coroutines have left the event loop. <br>
+   * Shutting down a listening socket doesn't wake up kqueue and Windows waiters,
+   * so a connection to the own accept-socket is made as well to make it readable on all platforms.
    */
   void stop() override;
 
   /**
-   * Get incoming connection.
+   * Get incoming connection. <br>
+   * Tries to accept right away and waits for the accept-socket to become readable only if there is no pending connection,
+   * so pending connections are drained without extra syscalls.
    * @return &id:oatpp::data::stream::IOStream;.
    */
   provider::ResourceHandle<data::stream::IOStream> get() override;
 
   /**
-   * No need to implement this.<br>
-   * For Asynchronous IO in oatpp it is considered to be a good practice
-   * to accept connections in a seperate thread with the blocking accept()
-   * and then process connections in Asynchronous manner with non-blocking read/write.
-   * <br>
-   * *It may be implemented later*
+   * Get incoming connection in asynchronous manner. <br>
+   * Tries to accept right away and waits for the accept-socket readiness in the &id:oatpp::async::worker::IOEventWorker;
+   * only if there is no pending connection - no extra threads and no polling. <br>
+   * Result is `nullptr` if provider was stopped or if accept failed.
+   * Provider must outlive the returned coroutine.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
    */
-  oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override {
-    /*
-     *  No need to implement this.
-     *  For Asynchronous IO in oatpp it is considered to be a good practice
-     *  to accept connections in a seperate thread with the blocking accept()
-     *  and then process connections in Asynchronous manner with non-blocking read/write
-     *
-     *  It may be implemented later
-     */
-    throw std::runtime_error("[oatpp::network::tcp::server::ConnectionProvider::getAsync()]: Error. Not implemented.");
-  }
+  oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override;
 
   /**
    * Get address - &id:oatpp::network::Address;.
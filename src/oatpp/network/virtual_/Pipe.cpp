@@ -156,6 +156,81 @@ v_io_size Pipe::Writer::write(const void *data, v_buff_size count, async::Action
   
 }
 
+v_io_size Pipe::Writer::writeToFifo(const data::buffer::InlineWriteData* buffers, v_buff_size count) {
+
+  v_io_size progress = 0;
+
+  for(v_buff_size i = 0; i < count; i ++) {
+
+    auto size = buffers[i].bytesLeft;
+    if(size == 0) {
+      continue;
+    }
+
+    if(m_maxAvailableToWrtie > -1 && progress + size > m_maxAvailableToWrtie) {
+      size = m_maxAvailableToWrtie - progress;
+      if(size <= 0) {
+        break;
+      }
+    }
+
+    auto res = m_pipe->m_fifo.write(buffers[i].currBufferPtr, size);
+    if(res <= 0) {
+      break;
+    }
+
+    progress += res;
+    if(res < buffers[i].bytesLeft) {
+      break;
+    }
+
+  }
+
+  return progress;
+
+}
+
+v_io_size Pipe::Writer::writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) {
+
+  Pipe& pipe = *m_pipe;
+  oatpp::v_io_size result;
+
+  if(m_ioMode == oatpp::data::stream::IOMode::ASYNCHRONOUS) {
+
+    std::lock_guard<std::mutex> lock(pipe.m_mutex);
+
+    if(pipe.m_open) {
+      if (pipe.m_fifo.availableToWrite() > 0) {
+        result = writeToFifo(buffers, count);
+      } else {
+        action = async::Action::createWaitListAction(&m_waitList);
+        result = IOError::RETRY_WRITE;
+      }
+    } else {
+      result = IOError::BROKEN_PIPE;
+    }
+
+  } else {
+    std::unique_lock<std::mutex> lock(pipe.m_mutex);
+    while (pipe.m_fifo.availableToWrite() == 0 && pipe.m_open) {
+      pipe.m_conditionWrite.wait(lock);
+    }
+    if (pipe.m_open && pipe.m_fifo.availableToWrite() > 0) {
+      result = writeToFifo(buffers, count);
+    } else {
+      result = IOError::BROKEN_PIPE;
+    }
+  }
+
+  if(result > 0) {
+    pipe.m_conditionRead.notify_one();
+    pipe.m_reader.notifyWaitList();
+  }
+
+  return result;
+
+}
+
 void Pipe::Writer::notifyWaitList() {
   m_waitList.notifyAll();
 }
@@ -177,6 +177,10 @@ public:
 
     oatpp::async::CoroutineWaitList m_waitList;
     WaitListListener m_waitListListener;
+  private:
+
+    v_io_size writeToFifo(const data::buffer::InlineWriteData* buffers, v_buff_size count);
+
   protected:
     
     Writer(Pipe* pipe, oatpp::data::stream::IOMode ioMode = oatpp::data::stream::IOMode::BLOCKING)
@@ -209,6 +213,18 @@ public:
      */
     v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
 
+    /**
+     * Implements &id:oatpp::data::stream::WriteCallback::writev; method.
+     * Write data from all buffers to pipe at once - reader never sees data of the buffers separately
+     * if there is enough space in the pipe.
+     * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+     * @param count - number of buffers in the array.
+     * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+     * caller MUST return this action on coroutine iteration.
+     * @return - &id:oatpp::v_io_size;.
+     */
+    v_io_size writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) override;
+
     /**
      * Set OutputStream I/O mode.
      * @param ioMode
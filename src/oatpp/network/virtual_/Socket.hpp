@@ -88,6 +88,16 @@ public:
    */
   v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
 
+  /**
+   * Write data from all buffers to socket at once. See &id:oatpp::network::virtual_::Pipe::Writer::writev;.
+   * @param buffers - array of &id:oatpp::data::buffer::InlineWriteData;.
+   * @param count - number of buffers in the array.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written. &id:oatpp::v_io_size;.
+   */
+  v_io_size writev(const data::buffer::InlineWriteData* buffers, v_buff_size count, async::Action& action) override;
+
   /**
    * Set OutputStream I/O mode.
    * @param ioMode
@@ -0,0 +1,302 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CharScan.hpp"
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define OATPP_CHARSCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define OATPP_CHARSCAN_SSE2
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace oatpp { namespace utils {
+
+namespace {
+
+constexpr v_uint32 SECTION_END = ('\r' << 24) | ('\n' << 16) | ('\r' << 8) | ('\n');
+
+inline v_buff_size countTrailingZeros(v_uint32 mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<v_buff_size>(index);
+#else
+  return static_cast<v_buff_size>(__builtin_ctz(mask));
+#endif
+}
+
+#if defined(OATPP_CHARSCAN_AVX2)
+
+constexpr v_buff_size BLOCK_SIZE = 32;
+typedef __m256i Block;
+
+inline Block loadBlock(const v_char8* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+inline Block splat(char c) {
+  return _mm256_set1_epi8(c);
+}
+
+inline v_uint32 matchMask(const Block& block, const Block& c) {
+  return static_cast<v_uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, c)));
+}
+
+inline v_uint32 controlMask(const Block& block) {
+  const Block limit = _mm256_set1_epi8(0x1F);
+  return static_cast<v_uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(block, limit), limit)));
+}
+
+inline v_uint32 nonAsciiMask(const Block& block) {
+  return static_cast<v_uint32>(_mm256_movemask_epi8(block));
+}
+
+#elif defined(OATPP_CHARSCAN_SSE2)
+
+constexpr v_buff_size BLOCK_SIZE = 16;
+typedef __m128i Block;
+
+inline Block loadBlock(const v_char8* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline Block splat(char c) {
+  return _mm_set1_epi8(c);
+}
+
+inline v_uint32 matchMask(const Block& block, const Block& c) {
+  return static_cast<v_uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, c)));
+}
+
+inline v_uint32 controlMask(const Block& block) {
+  const Block limit = _mm_set1_epi8(0x1F);
+  return static_cast<v_uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(block, limit), limit)));
+}
+
+inline v_uint32 nonAsciiMask(const Block& block) {
+  return static_cast<v_uint32>(_mm_movemask_epi8(block));
+}
+
+#else
+
+/*
+ * Scalar fallback - "block" is a single byte.
+ */
+
+constexpr v_buff_size BLOCK_SIZE = 1;
+typedef v_char8 Block;
+
+inline Block loadBlock(const v_char8* p) {
+  return *p;
+}
+
+inline Block splat(char c) {
+  return static_cast<v_char8>(c);
+}
+
+inline v_uint32 matchMask(const Block& block, const Block& c) {
+  return block == c ? 1 : 0;
+}
+
+inline v_uint32 controlMask(const Block& block) {
+  return block < 0x20 ? 1 : 0;
+}
+
+inline v_uint32 nonAsciiMask(const Block& block) {
+  return block >= 0x80 ? 1 : 0;
+}
+
+#endif
+
+inline bool isSectionEndAt(const v_char8* p, v_buff_size newLinePos) {
+  return p[newLinePos - 1] == '\r' && p[newLinePos - 2] == '\n' && p[newLinePos - 3] == '\r';
+}
+
+}
+
+v_buff_size CharScan::findSectionEnd(const void* data, v_buff_size size, v_uint32& accumulator) {
+
+  auto p = reinterpret_cast<const v_char8*>(data);
+
+  /* section end may start in the previously scanned data */
+  v_buff_size head = size < 3 ? size : 3;
+  for(v_buff_size i = 0; i < head; i ++) {
+    accumulator = (accumulator << 8) | p[i];
+    if(accumulator == SECTION_END) {
+      return i + 1;
+    }
+  }
+
+  if(size <= 3) {
+    return -1;
+  }
+
+  v_buff_size i = 3;
+  const Block newLine = splat('\n');
+
+  for(; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+    v_uint32 mask = matchMask(loadBlock(p + i), newLine);
+    while(mask != 0) {
+      v_buff_size pos = i + countTrailingZeros(mask);
+      if(isSectionEndAt(p, pos)) {
+        return pos + 1;
+      }
+      mask &= mask - 1;
+    }
+  }
+
+  for(; i < size; i ++) {
+    if(p[i] == '\n' && isSectionEndAt(p, i)) {
+      return i + 1;
+    }
+  }
+
+  accumulator = (static_cast<v_uint32>(p[size - 4]) << 24) | (static_cast<v_uint32>(p[size - 3]) << 16) |
+                (static_cast<v_uint32>(p[size - 2]) << 8) | static_cast<v_uint32>(p[size - 1]);
+
+  return -1;
+
+}
+
+v_buff_size CharScan::findRN(const void* data, v_buff_size size) {
+
+  auto p = reinterpret_cast<const v_char8*>(data);
+  const Block carriageReturn = splat('\r');
+
+  v_buff_size i = 0;
+  for(; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+    v_uint32 mask = matchMask(loadBlock(p + i), carriageReturn);
+    while(mask != 0) {
+      v_buff_size pos = i + countTrailingZeros(mask);
+      if(pos + 1 < size && p[pos + 1] == '\n') {
+        return pos;
+      }
+      mask &= mask - 1;
+    }
+  }
+
+  for(; i + 1 < size; i ++) {
+    if(p[i] == '\r' && p[i + 1] == '\n') {
+      return i;
+    }
+  }
+
+  return -1;
+
+}
+
+v_buff_size CharScan::findChar(const void* data, v_buff_size size, char c) {
+
+  auto p = reinterpret_cast<const v_char8*>(data);
+  const Block target = splat(c);
+
+  v_buff_size i = 0;
+  for(; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+    v_uint32 mask = matchMask(loadBlock(p + i), target);
+    if(mask != 0) {
+      return i + countTrailingZeros(mask);
+    }
+  }
+
+  for(; i < size; i ++) {
+    if(p[i] == static_cast<v_char8>(c)) {
+      return i;
+    }
+  }
+
+  return -1;
+
+}
+
+v_buff_size CharScan::findCharOf(const void* data, v_buff_size size, char a, char b) {
+
+  auto p = reinterpret_cast<const v_char8*>(data);
+  const Block targetA = splat(a);
+  const Block targetB = splat(b);
+
+  v_buff_size i = 0;
+  for(; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+    auto block = loadBlock(p + i);
+    v_uint32 mask = matchMask(block, targetA) | matchMask(block, targetB);
+    if(mask != 0) {
+      return i + countTrailingZeros(mask);
+    }
+  }
+
+  for(; i < size; i ++) {
+    if(p[i] == static_cast<v_char8>(a) || p[i] == static_cast<v_char8>(b)) {
+      return i;
+    }
+  }
+
+  return -1;
+
+}
+
+v_buff_size CharScan::findJsonEscapable(const void* data, v_buff_size size, bool escapeSolidus) {
+
+  auto p = reinterpret_cast<const v_char8*>(data);
+  const Block quote = splat('"');
+  const Block backslash = splat('\\');
+  const Block solidus = splat(escapeSolidus ? '/' : '"');
+
+  v_buff_size i = 0;
+  for(; i + BLOCK_SIZE <= size; i += BLOCK_SIZE) {
+    auto block = loadBlock(p + i);
+    v_uint32 mask = controlMask(block) | nonAsciiMask(block) |
+                    matchMask(block, quote) | matchMask(block, backslash) | matchMask(block, solidus);
+    if(mask != 0) {
+      return i + countTrailingZeros(mask);
+    }
+  }
+
+  for(; i < size; i ++) {
+    v_char8 a = p[i];
+    if(a < 0x20 || a >= 0x80 || a == '"' || a == '\\' || (escapeSolidus && a == '/')) {
+      return i;
+    }
+  }
+
+  return -1;
+
+}
+
+const char* CharScan::getImplementationName() {
+#if defined(OATPP_CHARSCAN_AVX2)
+  return "AVX2";
+#elif defined(OATPP_CHARSCAN_SSE2)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
+
+}}
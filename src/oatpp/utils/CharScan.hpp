@@ -0,0 +1,99 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_utils_CharScan_hpp
+#define oatpp_utils_CharScan_hpp
+
+#include "oatpp/Environment.hpp"
+
+namespace oatpp { namespace utils {
+
+/**
+ * Vectorized search of characters in memory. <br>
+ * Uses AVX2 or SSE2 instructions when the target supports them (selected at compile time),
+ * falls back to the scalar loop otherwise.
+ */
+class CharScan {
+public:
+
+  /**
+   * Find end of HTTP headers section - `\r\n\r\n`. <br>
+   * The search can be resumed across multiple chunks of data by passing the same `accumulator` -
+   * it keeps the last 4 bytes seen. Initial value of `accumulator` should be `0`.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @param accumulator - in/out last 4 bytes of the previously scanned data.
+   * @return - position right after the section end or `-1` if not found.
+   */
+  static v_buff_size findSectionEnd(const void* data, v_buff_size size, v_uint32& accumulator);
+
+  /**
+   * Find position of `\r\n`.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @return - position of `\r` or `-1` if not found.
+   */
+  static v_buff_size findRN(const void* data, v_buff_size size);
+
+  /**
+   * Find position of the character.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @param c - character to find.
+   * @return - position of the character or `-1` if not found.
+   */
+  static v_buff_size findChar(const void* data, v_buff_size size, char c);
+
+  /**
+   * Find position of the first occurrence of any of two characters.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @param a - first character.
+   * @param b - second character.
+   * @return - position of the character found or `-1` if not found.
+   */
+  static v_buff_size findCharOf(const void* data, v_buff_size size, char a, char b);
+
+  /**
+   * Find position of the first character which can't be copied to a JSON string as-is: <br>
+   * control character (< 0x20), `"`, `\\`, non-ASCII byte (>= 0x80) and, if `escapeSolidus` is set, `/`.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @param escapeSolidus - treat `/` as the character to find.
+   * @return - position of the character found or `-1` if not found.
+   */
+  static v_buff_size findJsonEscapable(const void* data, v_buff_size size, bool escapeSolidus);
+
+  /**
+   * Get name of instruction set used - `"AVX2"`, `"SSE2"` or `"scalar"`.
+   * @return
+   */
+  static const char* getImplementationName();
+
+};
+
+}}
+
+#endif // oatpp_utils_CharScan_hpp
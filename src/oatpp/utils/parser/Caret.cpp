@@ -24,6 +24,8 @@
 
 #include "Caret.hpp"
 
+#include "oatpp/utils/CharScan.hpp"
+
 #include <cstdlib>
 #include <algorithm>
 
@@ -287,16 +289,18 @@ v_int64 Caret::StateSaveGuard::getSavedErrorCode() {
   }
   
   bool Caret::findRN() {
-    
-    while(m_pos < m_size){
-      if(m_data[m_pos] == '\r'){
-        if(m_pos + 1 < m_size && m_data[m_pos + 1] == '\n'){
-          return true;
-        }
-      }
-      m_pos ++;
+
+    if(m_pos >= m_size) {
+      return false;
     }
-    
+
+    auto pos = CharScan::findRN(&m_data[m_pos], m_size - m_pos);
+    if(pos >= 0) {
+      m_pos += pos;
+      return true;
+    }
+
+    m_pos = m_size;
     return false;
   }
   
@@ -25,6 +25,7 @@
 #include "./Http.hpp"
 
 #include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/CharScan.hpp"
 #include "oatpp/utils/Conversion.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http {
@@ -135,6 +136,18 @@ const char* const Header::ACCEPT_ENCODING = "Accept-Encoding";
 
 const char* const Header::EXPECT = "Expect";
 
+const char* const Header::ETAG = "ETag";
+const char* const Header::IF_NONE_MATCH = "If-None-Match";
+const char* const Header::CACHE_CONTROL = "Cache-Control";
+const char* const Header::VARY = "Vary";
+const char* const Header::SET_COOKIE = "Set-Cookie";
+const char* const Header::COOKIE = "Cookie";
+const char* const Header::LAST_MODIFIED = "Last-Modified";
+const char* const Header::IF_MODIFIED_SINCE = "If-Modified-Since";
+const char* const Header::ACCEPT_RANGES = "Accept-Ranges";
+const char* const Header::IF_RANGE = "If-Range";
+const char* const Header::RETRY_AFTER = "Retry-After";
+
 const char* const Range::UNIT_BYTES = "bytes";
 const char* const ContentRange::UNIT_BYTES = "bytes";
   
@@ -312,14 +325,11 @@ oatpp::String HeaderValueData::getTitleParamValue(const data::share::StringKeyLa
 oatpp::data::share::StringKeyLabelCI Parser::parseHeaderNameLabel(const std::shared_ptr<std::string>& headersText,
                                                                   oatpp::utils::parser::Caret& caret) {
   const char* data = caret.getData();
-  for(v_buff_size i = caret.getPosition(); i < caret.getDataSize(); i++) {
-    v_char8 a = static_cast<v_char8>(data[i]);
-    if(a == ':' || a == ' '){
-      oatpp::data::share::StringKeyLabelCI label(headersText, &data[caret.getPosition()], i - caret.getPosition());
-      caret.setPosition(i);
-      return label;
-      
-    }
+  auto pos = oatpp::utils::CharScan::findCharOf(caret.getCurrData(), caret.getDataSize() - caret.getPosition(), ':', ' ');
+  if(pos >= 0) {
+    oatpp::data::share::StringKeyLabelCI label(headersText, &data[caret.getPosition()], pos);
+    caret.setPosition(caret.getPosition() + pos);
+    return label;
   }
   return oatpp::data::share::StringKeyLabelCI(nullptr, nullptr, 0);
 }
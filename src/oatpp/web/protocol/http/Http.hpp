@@ -506,6 +506,17 @@ public:
   static const char* const CORS_MAX_AGE;        // Access-Control-Max-Age
   static const char* const ACCEPT_ENCODING;     // Accept-Encoding
   static const char* const EXPECT;              // Expect
+  static const char* const ETAG;                // ETag
+  static const char* const IF_NONE_MATCH;       // If-None-Match
+  static const char* const CACHE_CONTROL;       // Cache-Control
+  static const char* const VARY;                // Vary
+  static const char* const SET_COOKIE;          // Set-Cookie
+  static const char* const COOKIE;              // Cookie
+  static const char* const LAST_MODIFIED;       // Last-Modified
+  static const char* const IF_MODIFIED_SINCE;   // If-Modified-Since
+  static const char* const ACCEPT_RANGES;       // Accept-Ranges
+  static const char* const IF_RANGE;            // If-Range
+  static const char* const RETRY_AFTER;         // Retry-After
 };
   
 class Range {
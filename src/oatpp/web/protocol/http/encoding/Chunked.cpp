@@ -111,6 +111,144 @@ v_int32 EncoderChunked::iterate(data::buffer::InlineReadData& dataIn, data::buff
 
 }
 
+namespace {
+
+constexpr v_buff_size CHUNK_HEADER_MAX_SIZE = 18; // 16 hex digits + CRLF
+
+const char* const CHUNK_TRAILER = "\r\n";
+const char* const LAST_CHUNK = "0\r\n\r\n";
+
+v_buff_size writeChunkHeader(v_char8* header, v_buff_size chunkSize) {
+  static const char* const HEX = "0123456789ABCDEF";
+  v_char8 digits[16];
+  v_buff_size count = 0;
+  auto size = static_cast<v_uint64>(chunkSize);
+  do {
+    digits[count ++] = static_cast<v_char8>(HEX[size & 0x0F]);
+    size >>= 4;
+  } while(size > 0);
+  v_buff_size length = 0;
+  while(count > 0) {
+    header[length ++] = digits[-- count];
+  }
+  header[length ++] = '\r';
+  header[length ++] = '\n';
+  return length;
+}
+
+}
+
+v_io_size EncoderChunked::transfer(const base::ObjectHandle<data::stream::ReadCallback>& readCallback,
+                                   const base::ObjectHandle<data::stream::WriteCallback>& writeCallback,
+                                   void* buffer,
+                                   v_buff_size bufferSize)
+{
+
+  v_char8 chunkHeader[CHUNK_HEADER_MAX_SIZE];
+  v_io_size progress = 0;
+
+  while(true) {
+
+    v_io_size res = IOError::RETRY_READ;
+    while (res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+      res = readCallback->readSimple(buffer, bufferSize);
+    }
+
+    if(res == 0) {
+      break;
+    }
+
+    if(res < 0) {
+      /* do not write the last chunk - the body is incomplete and the peer must not take it as complete */
+      throw std::runtime_error("[oatpp::web::protocol::http::encoding::EncoderChunked::transfer()]: Error. Can't read body.");
+    }
+
+    progress += res;
+
+    auto headerSize = writeChunkHeader(chunkHeader, res);
+    data::buffer::InlineWriteData chunk[3] = {
+      {chunkHeader, headerSize},
+      {buffer, res},
+      {CHUNK_TRAILER, 2}
+    };
+
+    if(writeCallback->writevExactSizeDataSimple(chunk, 3) != headerSize + res + 2) {
+      return progress;
+    }
+
+  }
+
+  writeCallback->writeExactSizeDataSimple(LAST_CHUNK, 5);
+  return progress;
+
+}
+
+async::CoroutineStarter EncoderChunked::transferAsync(const base::ObjectHandle<data::stream::ReadCallback>& readCallback,
+                                                      const base::ObjectHandle<data::stream::WriteCallback>& writeCallback,
+                                                      const base::ObjectHandle<data::buffer::IOBuffer>& buffer)
+{
+
+  class TransferCoroutine : public oatpp::async::Coroutine<TransferCoroutine> {
+  private:
+    base::ObjectHandle<data::stream::ReadCallback> m_readCallback;
+    base::ObjectHandle<data::stream::WriteCallback> m_writeCallback;
+    base::ObjectHandle<data::buffer::IOBuffer> m_buffer;
+  private:
+    v_char8 m_chunkHeader[CHUNK_HEADER_MAX_SIZE];
+    data::buffer::InlineWriteData m_chunk[3];
+  public:
+
+    TransferCoroutine(const base::ObjectHandle<data::stream::ReadCallback>& readCallback,
+                      const base::ObjectHandle<data::stream::WriteCallback>& writeCallback,
+                      const base::ObjectHandle<data::buffer::IOBuffer>& buffer)
+      : m_readCallback(readCallback)
+      , m_writeCallback(writeCallback)
+      , m_buffer(buffer)
+    {}
+
+    Action act() override {
+
+      Action action;
+      auto res = m_readCallback->read(m_buffer->getData(), m_buffer->getSize(), action);
+
+      if(res > 0) {
+        m_chunk[0].set(m_chunkHeader, writeChunkHeader(m_chunkHeader, res));
+        m_chunk[1].set(m_buffer->getData(), res);
+        m_chunk[2].set(CHUNK_TRAILER, 2);
+        return yieldTo(&TransferCoroutine::writeChunk);
+      }
+
+      if(res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+        if(!action.isNone()) {
+          return action;
+        }
+        return repeat();
+      }
+
+      if(res < 0) {
+        /* do not write the last chunk - the body is incomplete and the peer must not take it as complete */
+        return error<AsyncIOError>("[oatpp::web::protocol::http::encoding::EncoderChunked::transferAsync()]: Error. Can't read body.", IOError::BROKEN_PIPE);
+      }
+
+      m_chunk[0].set(LAST_CHUNK, 5);
+      return yieldTo(&TransferCoroutine::writeLastChunk);
+
+    }
+
+    Action writeChunk() {
+      return m_writeCallback->writevExactSizeDataAsyncInline(m_chunk, 3, yieldTo(&TransferCoroutine::act));
+    }
+
+    Action writeLastChunk() {
+      return m_writeCallback->writeExactSizeDataAsyncInline(m_chunk[0], finish());
+    }
+
+  };
+
+  return TransferCoroutine::start(readCallback, writeCallback, buffer);
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // DecoderChunked
 
@@ -58,6 +58,34 @@ public:
    */
   v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
 
+  /**
+   * Transfer data from `readCallback` to `writeCallback` applying chunked encoding. <br>
+   * Unlike the &id:oatpp::data::stream::transfer; with the EncoderChunked processor, each chunk - header, data and trailing CRLF -
+   * is written with a single vectored write (&id:oatpp::data::stream::WriteCallback::writev;) directly from the `buffer`.
+   * @param readCallback - &id:oatpp::data::stream::ReadCallback;. Data is read until end-of-file.
+   * @param writeCallback - &id:oatpp::data::stream::WriteCallback;.
+   * @param buffer - buffer to read data to. One read - one chunk.
+   * @param bufferSize - size of the buffer.
+   * @return - amount of data read from the `readCallback`.
+   * @throws - `std::runtime_error` if `readCallback` returned an error. The last chunk is not written in this case.
+   */
+  static v_io_size transfer(const base::ObjectHandle<data::stream::ReadCallback>& readCallback,
+                            const base::ObjectHandle<data::stream::WriteCallback>& writeCallback,
+                            void* buffer,
+                            v_buff_size bufferSize);
+
+  /**
+   * Async version of &l:EncoderChunked::transfer ();.
+   * If `readCallback` returned an error, the coroutine fails with &id:oatpp::AsyncIOError; (&id:oatpp::IOError::BROKEN_PIPE;).
+   * @param readCallback - &id:oatpp::data::stream::ReadCallback;. Data is read until end-of-file.
+   * @param writeCallback - &id:oatpp::data::stream::WriteCallback;.
+   * @param buffer - &id:oatpp::data::buffer::IOBuffer; to read data to. One read - one chunk.
+   * @return - &id:oatpp::async::CoroutineStarter;.
+   */
+  static async::CoroutineStarter transferAsync(const base::ObjectHandle<data::stream::ReadCallback>& readCallback,
+                                               const base::ObjectHandle<data::stream::WriteCallback>& writeCallback,
+                                               const base::ObjectHandle<data::buffer::IOBuffer>& buffer);
+
 };
 
 /**
@@ -0,0 +1,461 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Deflate.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#if defined(OATPP_LINK_ZLIB)
+  #define ZLIB_CONST
+  #include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+#if defined(OATPP_LINK_ZLIB)
+
+namespace {
+
+constexpr v_buff_size OUT_BUFFER_SIZE = 16384;
+constexpr v_buff_size MAX_ZLIB_CHUNK = 1 << 30; // avail_in/avail_out are 32-bit
+
+v_buff_size clampChunk(v_buff_size size) {
+  return std::min(size, MAX_ZLIB_CHUNK);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// EncoderDeflate
+
+void EncoderDeflate::initStream(z_stream_s* stream, Format format, v_int32 compressionLevel) {
+  *stream = z_stream();
+  v_int32 windowBits = (format == Format::GZIP) ? 15 + 16 : 15;
+  if(deflateInit2(stream, compressionLevel, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw std::runtime_error("[oatpp::web::protocol::http::encoding::EncoderDeflate::initStream()]: Error. Can't init zlib deflate stream.");
+  }
+}
+
+EncoderDeflate::EncoderDeflate(Format format, v_int32 compressionLevel)
+  : m_stream(new z_stream())
+  , m_outBuffer(nullptr)
+  , m_finished(false)
+{
+  try {
+    initStream(m_stream, format, compressionLevel);
+  } catch (...) {
+    delete m_stream;
+    throw;
+  }
+  m_outBuffer = new v_char8[OUT_BUFFER_SIZE];
+}
+
+EncoderDeflate::~EncoderDeflate() {
+  deflateEnd(m_stream);
+  delete m_stream;
+  delete [] m_outBuffer;
+}
+
+v_io_size EncoderDeflate::suggestInputStreamReadSize() {
+  return OUT_BUFFER_SIZE;
+}
+
+v_int32 EncoderDeflate::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  bool eof = dataIn.currBufferPtr == nullptr;
+
+  if(!eof && dataIn.bytesLeft == 0) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  v_buff_size inSize = eof ? 0 : clampChunk(dataIn.bytesLeft);
+
+  m_stream->next_in = reinterpret_cast<const Bytef*>(dataIn.currBufferPtr);
+  m_stream->avail_in = static_cast<uInt>(inSize);
+  m_stream->next_out = m_outBuffer;
+  m_stream->avail_out = static_cast<uInt>(OUT_BUFFER_SIZE);
+
+  auto res = deflate(m_stream, eof ? Z_FINISH : Z_NO_FLUSH);
+
+  if(res == Z_STREAM_ERROR) {
+    return ERROR_STREAM;
+  }
+
+  if(!eof) {
+    dataIn.inc(inSize - static_cast<v_buff_size>(m_stream->avail_in));
+  }
+
+  if(res == Z_STREAM_END) {
+    m_finished = true;
+  }
+
+  v_buff_size produced = OUT_BUFFER_SIZE - static_cast<v_buff_size>(m_stream->avail_out);
+  if(produced > 0) {
+    dataOut.set(m_outBuffer, produced);
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  if(!eof && dataIn.bytesLeft == 0) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  return Error::OK;
+
+}
+
+oatpp::String EncoderDeflate::encode(const void* data, v_buff_size size, Format format, v_int32 compressionLevel) {
+
+  z_stream stream;
+  initStream(&stream, format, compressionLevel);
+
+  oatpp::String result(static_cast<v_buff_size>(deflateBound(&stream, static_cast<uLong>(size))));
+
+  auto in = reinterpret_cast<const Bytef*>(data);
+  auto out = reinterpret_cast<Bytef*>(&result->front());
+  v_buff_size inLeft = size;
+  v_buff_size outLeft = static_cast<v_buff_size>(result->size());
+
+  auto res = Z_OK;
+  while(res == Z_OK) {
+
+    v_buff_size inSize = clampChunk(inLeft);
+    v_buff_size outSize = clampChunk(outLeft);
+
+    stream.next_in = in;
+    stream.avail_in = static_cast<uInt>(inSize);
+    stream.next_out = out;
+    stream.avail_out = static_cast<uInt>(outSize);
+
+    res = deflate(&stream, inSize == inLeft ? Z_FINISH : Z_NO_FLUSH);
+
+    v_buff_size consumed = inSize - static_cast<v_buff_size>(stream.avail_in);
+    v_buff_size produced = outSize - static_cast<v_buff_size>(stream.avail_out);
+    in += consumed;
+    inLeft -= consumed;
+    out += produced;
+    outLeft -= produced;
+
+  }
+
+  deflateEnd(&stream);
+
+  if(res != Z_STREAM_END) {
+    throw std::runtime_error("[oatpp::web::protocol::http::encoding::EncoderDeflate::encode()]: Error. zlib deflate failed.");
+  }
+
+  result->resize(result->size() - static_cast<size_t>(outLeft));
+  result->shrink_to_fit();
+
+  return result;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DecoderDeflate
+
+DecoderDeflate::DecoderDeflate(v_int64 maxOutputSize)
+  : m_stream(new z_stream())
+  , m_outBuffer(nullptr)
+  , m_finished(false)
+  , m_maxOutputSize(maxOutputSize)
+  , m_outputSize(0)
+{
+  /* 15 + 32 - detect zlib or gzip header automatically */
+  if(inflateInit2(m_stream, 15 + 32) != Z_OK) {
+    delete m_stream;
+    throw std::runtime_error("[oatpp::web::protocol::http::encoding::DecoderDeflate::DecoderDeflate()]: Error. Can't init zlib inflate stream.");
+  }
+  m_outBuffer = new v_char8[OUT_BUFFER_SIZE];
+}
+
+DecoderDeflate::~DecoderDeflate() {
+  inflateEnd(m_stream);
+  delete m_stream;
+  delete [] m_outBuffer;
+}
+
+v_io_size DecoderDeflate::suggestInputStreamReadSize() {
+  return OUT_BUFFER_SIZE;
+}
+
+v_int32 DecoderDeflate::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  bool eof = dataIn.currBufferPtr == nullptr;
+
+  if(!eof && dataIn.bytesLeft == 0) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  v_buff_size inSize = eof ? 0 : clampChunk(dataIn.bytesLeft);
+
+  m_stream->next_in = reinterpret_cast<const Bytef*>(dataIn.currBufferPtr);
+  m_stream->avail_in = static_cast<uInt>(inSize);
+  m_stream->next_out = m_outBuffer;
+  m_stream->avail_out = static_cast<uInt>(OUT_BUFFER_SIZE);
+
+  auto res = inflate(m_stream, Z_NO_FLUSH);
+
+  switch(res) {
+    case Z_OK:
+    case Z_BUF_ERROR:
+      break;
+    case Z_STREAM_END:
+      m_finished = true;
+      break;
+    case Z_DATA_ERROR:
+    case Z_NEED_DICT:
+      throw HttpError(Status::CODE_400, "[oatpp::web::protocol::http::encoding::DecoderDeflate::iterate()]: Error. Corrupted data.");
+    default:
+      return ERROR_STREAM;
+  }
+
+  if(!eof) {
+    if(m_finished) {
+      dataIn.setEof(); // ignore data after the end of stream
+    } else {
+      dataIn.inc(inSize - static_cast<v_buff_size>(m_stream->avail_in));
+    }
+  }
+
+  v_buff_size produced = OUT_BUFFER_SIZE - static_cast<v_buff_size>(m_stream->avail_out);
+  if(produced > 0) {
+    m_outputSize += produced;
+    if(m_maxOutputSize > 0 && m_outputSize > m_maxOutputSize) {
+      throw HttpError(Status::CODE_413, "[oatpp::web::protocol::http::encoding::DecoderDeflate::iterate()]: Error. Decoded data exceeds max output size.");
+    }
+    dataOut.set(m_outBuffer, produced);
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  if(eof) {
+    throw HttpError(Status::CODE_400, "[oatpp::web::protocol::http::encoding::DecoderDeflate::iterate()]: Error. Data is truncated.");
+  }
+
+  if(dataIn.bytesLeft == 0) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  return Error::OK;
+
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Stubs - oatpp is built without zlib
+
+namespace {
+
+const char* const NO_ZLIB_ERROR = "[oatpp::web::protocol::http::encoding]: Error. oatpp is built without zlib. See OATPP_LINK_ZLIB cmake option.";
+
+}
+
+void EncoderDeflate::initStream(z_stream_s*, Format, v_int32) {
+  throw std::runtime_error(NO_ZLIB_ERROR);
+}
+
+EncoderDeflate::EncoderDeflate(Format format, v_int32 compressionLevel)
+  : m_stream(nullptr)
+  , m_outBuffer(nullptr)
+  , m_finished(false)
+{
+  initStream(m_stream, format, compressionLevel);
+}
+
+EncoderDeflate::~EncoderDeflate() = default;
+
+v_io_size EncoderDeflate::suggestInputStreamReadSize() {
+  return 0;
+}
+
+v_int32 EncoderDeflate::iterate(data::buffer::InlineReadData&, data::buffer::InlineReadData&) {
+  return ERROR_STREAM;
+}
+
+oatpp::String EncoderDeflate::encode(const void*, v_buff_size, Format, v_int32) {
+  throw std::runtime_error(NO_ZLIB_ERROR);
+}
+
+DecoderDeflate::DecoderDeflate(v_int64 maxOutputSize)
+  : m_stream(nullptr)
+  , m_outBuffer(nullptr)
+  , m_finished(false)
+  , m_maxOutputSize(maxOutputSize)
+  , m_outputSize(0)
+{
+  throw std::runtime_error(NO_ZLIB_ERROR);
+}
+
+DecoderDeflate::~DecoderDeflate() = default;
+
+v_io_size DecoderDeflate::suggestInputStreamReadSize() {
+  return 0;
+}
+
+v_int32 DecoderDeflate::iterate(data::buffer::InlineReadData&, data::buffer::InlineReadData&) {
+  return ERROR_STREAM;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateEncoderProvider
+
+DeflateEncoderProvider::DeflateEncoderProvider(EncoderDeflate::Format format, const Config& config)
+  : m_format(format)
+  , m_config(config)
+{
+  if(m_config.cacheMaxSize > 0) {
+    m_cache = std::make_shared<EncodedDataCache>(m_config.cacheMaxSize);
+  }
+}
+
+DeflateEncoderProvider::DeflateEncoderProvider()
+  : DeflateEncoderProvider(EncoderDeflate::Format::DEFLATE, Config())
+{}
+
+DeflateEncoderProvider::DeflateEncoderProvider(const Config& config)
+  : DeflateEncoderProvider(EncoderDeflate::Format::DEFLATE, config)
+{}
+
+oatpp::String DeflateEncoderProvider::getEncodingName() {
+  return "deflate";
+}
+
+std::shared_ptr<data::buffer::Processor> DeflateEncoderProvider::getProcessor() {
+  return std::make_shared<EncoderDeflate>(m_format, m_config.compressionLevel);
+}
+
+bool DeflateEncoderProvider::shouldEncode(v_int64 bodySize) {
+  return bodySize >= m_config.minBodySize;
+}
+
+oatpp::String DeflateEncoderProvider::encodeKnownData(const void* data, v_buff_size size, bool immutable) {
+
+  /* only immutable bodies are worth hashing and copying - others won't be sent again */
+  bool useCache = m_cache && immutable;
+
+  if(useCache) {
+    auto encoded = m_cache->get(data, size);
+    if(encoded) {
+      return encoded;
+    }
+  }
+
+  auto encoded = EncoderDeflate::encode(data, size, m_format, m_config.compressionLevel);
+
+  if(useCache) {
+    m_cache->put(data, size, encoded);
+  }
+
+  return encoded;
+
+}
+
+std::shared_ptr<EncodedDataCache> DeflateEncoderProvider::getCache() const {
+  return m_cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// GzipEncoderProvider
+
+GzipEncoderProvider::GzipEncoderProvider()
+  : DeflateEncoderProvider(EncoderDeflate::Format::GZIP, Config())
+{}
+
+GzipEncoderProvider::GzipEncoderProvider(const Config& config)
+  : DeflateEncoderProvider(EncoderDeflate::Format::GZIP, config)
+{}
+
+oatpp::String GzipEncoderProvider::getEncodingName() {
+  return "gzip";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateDecoderProvider
+
+DeflateDecoderProvider::DeflateDecoderProvider()
+  : DeflateDecoderProvider(Config())
+{}
+
+DeflateDecoderProvider::DeflateDecoderProvider(const Config& config)
+  : m_config(config)
+{}
+
+oatpp::String DeflateDecoderProvider::getEncodingName() {
+  return "deflate";
+}
+
+std::shared_ptr<data::buffer::Processor> DeflateDecoderProvider::getProcessor() {
+  return std::make_shared<DecoderDeflate>(m_config.maxOutputSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// GzipDecoderProvider
+
+GzipDecoderProvider::GzipDecoderProvider()
+  : DeflateDecoderProvider(Config())
+{}
+
+GzipDecoderProvider::GzipDecoderProvider(const Config& config)
+  : DeflateDecoderProvider(config)
+{}
+
+oatpp::String GzipDecoderProvider::getEncodingName() {
+  return "gzip";
+}
+
+}}}}}
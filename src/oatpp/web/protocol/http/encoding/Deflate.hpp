@@ -0,0 +1,362 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_encoding_Deflate_hpp
+#define oatpp_web_protocol_http_encoding_Deflate_hpp
+
+#include "EncoderProvider.hpp"
+#include "EncodedDataCache.hpp"
+
+struct z_stream_s;
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+/**
+ * Deflate-encoding (zlib) buffer processor. &id:oatpp::data::buffer::Processor;. <br>
+ * Produces either "deflate" (zlib format) or "gzip" (gzip format) encoded data. <br>
+ * *Available only if oatpp was built with zlib - `OATPP_LINK_ZLIB` cmake option.*
+ */
+class EncoderDeflate : public data::buffer::Processor {
+public:
+  static constexpr v_int32 ERROR_STREAM = 100;
+public:
+
+  /**
+   * Output format.
+   */
+  enum class Format : v_int32 {
+
+    /**
+     * zlib format - "deflate" content-encoding.
+     */
+    DEFLATE = 0,
+
+    /**
+     * gzip format - "gzip" content-encoding.
+     */
+    GZIP = 1
+
+  };
+
+  /**
+   * Default compression level - zlib's `Z_DEFAULT_COMPRESSION`.
+   */
+  static constexpr v_int32 DEFAULT_COMPRESSION_LEVEL = -1;
+
+private:
+  static void initStream(z_stream_s* stream, Format format, v_int32 compressionLevel);
+private:
+  z_stream_s* m_stream;
+  v_char8* m_outBuffer;
+  bool m_finished;
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:EncoderDeflate::Format;.
+   * @param compressionLevel - compression level `0..9` or &l:EncoderDeflate::DEFAULT_COMPRESSION_LEVEL;.
+   */
+  EncoderDeflate(Format format, v_int32 compressionLevel = DEFAULT_COMPRESSION_LEVEL);
+
+  EncoderDeflate(const EncoderDeflate&) = delete;
+  EncoderDeflate& operator=(const EncoderDeflate&) = delete;
+
+  /**
+   * Destructor.
+   */
+  ~EncoderDeflate() override;
+
+  /**
+   * If the client is using the input stream to read data and add it to the processor,
+   * the client MAY ask the processor for a suggested read size.
+   * @return - suggested read size.
+   */
+  v_io_size suggestInputStreamReadSize() override;
+
+  /**
+   * Process data.
+   * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+   * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+   * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+   * @return - &l:Processor::Error;.
+   */
+  v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
+
+  /**
+   * Encode data at once.
+   * @param data - pointer to data.
+   * @param size - size of data.
+   * @param format - &l:EncoderDeflate::Format;.
+   * @param compressionLevel - compression level `0..9` or &l:EncoderDeflate::DEFAULT_COMPRESSION_LEVEL;.
+   * @return - encoded data.
+   */
+  static oatpp::String encode(const void* data, v_buff_size size, Format format, v_int32 compressionLevel = DEFAULT_COMPRESSION_LEVEL);
+
+};
+
+/**
+ * Deflate-decoding (zlib) buffer processor. &id:oatpp::data::buffer::Processor;. <br>
+ * Decodes both "deflate" (zlib format) and "gzip" (gzip format) data - the format is detected automatically. <br>
+ * `iterate` throws &id:oatpp::web::protocol::http::HttpError; - `400` on corrupted or truncated data, `413` once decoded
+ * size exceeds the limit (a small compressed body may expand to gigabytes). Processor error codes are taken for the end of data
+ * by the sync transfer - the exception makes body reading fail in both sync and async modes. <br>
+ * *Available only if oatpp was built with zlib - `OATPP_LINK_ZLIB` cmake option.*
+ */
+class DecoderDeflate : public data::buffer::Processor {
+public:
+  static constexpr v_int32 ERROR_STREAM = 100;
+public:
+
+  /**
+   * Default max size of decoded data - 64 MB.
+   */
+  static constexpr v_int64 DEFAULT_MAX_OUTPUT_SIZE = 64 * 1024 * 1024;
+
+private:
+  z_stream_s* m_stream;
+  v_char8* m_outBuffer;
+  bool m_finished;
+  v_int64 m_maxOutputSize;
+  v_int64 m_outputSize;
+public:
+
+  /**
+   * Constructor.
+   * @param maxOutputSize - max size of decoded data. `0` - no limit.
+   */
+  DecoderDeflate(v_int64 maxOutputSize = DEFAULT_MAX_OUTPUT_SIZE);
+
+  DecoderDeflate(const DecoderDeflate&) = delete;
+  DecoderDeflate& operator=(const DecoderDeflate&) = delete;
+
+  /**
+   * Destructor.
+   */
+  ~DecoderDeflate() override;
+
+  /**
+   * If the client is using the input stream to read data and add it to the processor,
+   * the client MAY ask the processor for a suggested read size.
+   * @return - suggested read size.
+   */
+  v_io_size suggestInputStreamReadSize() override;
+
+  /**
+   * Process data.
+   * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+   * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+   * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+   * @return - &l:Processor::Error;.
+   */
+  v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
+
+};
+
+/**
+ * EncoderProvider for "deflate" encoding.
+ */
+class DeflateEncoderProvider : public EncoderProvider {
+public:
+
+  /**
+   * Provider config.
+   */
+  struct Config {
+
+    /**
+     * Compression level `0..9` or &l:EncoderDeflate::DEFAULT_COMPRESSION_LEVEL;.
+     */
+    v_int32 compressionLevel = EncoderDeflate::DEFAULT_COMPRESSION_LEVEL;
+
+    /**
+     * Bodies of known size smaller than this are sent without encoding.
+     */
+    v_int64 minBodySize = 256;
+
+    /**
+     * Max size of the cache of encoded in-memory bodies (original + encoded data) in bytes. <br>
+     * `0` - cache is disabled. Only immutable bodies are cached (&id:oatpp::web::protocol::http::outgoing::Body::isImmutable;),
+     * other bodies are encoded every time without touching the cache.
+     * See &id:oatpp::web::protocol::http::encoding::EncodedDataCache;.
+     */
+    v_buff_size cacheMaxSize = 0;
+
+  };
+
+private:
+  EncoderDeflate::Format m_format;
+  Config m_config;
+  std::shared_ptr<EncodedDataCache> m_cache;
+protected:
+  DeflateEncoderProvider(EncoderDeflate::Format format, const Config& config);
+public:
+
+  /**
+   * Constructor. Default config.
+   */
+  DeflateEncoderProvider();
+
+  /**
+   * Constructor.
+   * @param config - &l:DeflateEncoderProvider::Config;.
+   */
+  DeflateEncoderProvider(const Config& config);
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::web::protocol::http::encoding::EncoderDeflate;.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+  /**
+   * Check if body is larger than &l:DeflateEncoderProvider::Config::minBodySize;.
+   * @param bodySize
+   * @return
+   */
+  bool shouldEncode(v_int64 bodySize) override;
+
+  /**
+   * Encode the whole body at once. Encoded form of the immutable body is taken from/put to cache if cache is enabled.
+   * @param data - pointer to body data.
+   * @param size - size of body data.
+   * @param immutable - `true` if the body is immutable.
+   * @return - encoded data.
+   */
+  oatpp::String encodeKnownData(const void* data, v_buff_size size, bool immutable) override;
+
+  /**
+   * Get cache of encoded bodies.
+   * @return - &id:oatpp::web::protocol::http::encoding::EncodedDataCache; or `nullptr` if cache is disabled.
+   */
+  std::shared_ptr<EncodedDataCache> getCache() const;
+
+};
+
+/**
+ * EncoderProvider for "gzip" encoding.
+ */
+class GzipEncoderProvider : public DeflateEncoderProvider {
+public:
+
+  /**
+   * Constructor. Default config.
+   */
+  GzipEncoderProvider();
+
+  /**
+   * Constructor.
+   * @param config - &l:DeflateEncoderProvider::Config;.
+   */
+  GzipEncoderProvider(const Config& config);
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+};
+
+/**
+ * EncoderProvider for "deflate" decoding.
+ */
+class DeflateDecoderProvider : public EncoderProvider {
+public:
+
+  /**
+   * Provider config.
+   */
+  struct Config {
+
+    /**
+     * Max size of the decoded body. Reading a body which decodes to more data fails. `0` - no limit.
+     */
+    v_int64 maxOutputSize = DecoderDeflate::DEFAULT_MAX_OUTPUT_SIZE;
+
+  };
+
+private:
+  Config m_config;
+public:
+
+  /**
+   * Constructor. Default config.
+   */
+  DeflateDecoderProvider();
+
+  /**
+   * Constructor.
+   * @param config - &l:DeflateDecoderProvider::Config;.
+   */
+  DeflateDecoderProvider(const Config& config);
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::web::protocol::http::encoding::DecoderDeflate;.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+};
+
+/**
+ * EncoderProvider for "gzip" decoding.
+ */
+class GzipDecoderProvider : public DeflateDecoderProvider {
+public:
+
+  /**
+   * Constructor. Default config.
+   */
+  GzipDecoderProvider();
+
+  /**
+   * Constructor.
+   * @param config - &l:DeflateDecoderProvider::Config;.
+   */
+  GzipDecoderProvider(const Config& config);
+
+  /**
+   * Get encoding name.
+   * @return
+   */
+  oatpp::String getEncodingName() override;
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_encoding_Deflate_hpp
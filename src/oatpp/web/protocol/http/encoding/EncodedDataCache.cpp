@@ -0,0 +1,118 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "EncodedDataCache.hpp"
+
+#include <cstring>
+#include <string_view>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+v_buff_size EncodedDataCache::hashData(const void* data, v_buff_size size) {
+  return static_cast<v_buff_size>(
+    std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), static_cast<size_t>(size)))
+  );
+}
+
+v_buff_size EncodedDataCache::getEntryCost(const Entry& entry) {
+  return static_cast<v_buff_size>(entry.data->size() + entry.encoded->size());
+}
+
+EncodedDataCache::EncodedDataCache(v_buff_size maxSize)
+  : m_maxSize(maxSize)
+  , m_currSize(0)
+{}
+
+void EncodedDataCache::evict() {
+  while(m_currSize > m_maxSize && !m_entries.empty()) {
+    auto it = std::prev(m_entries.end());
+    auto range = m_index.equal_range(it->hash);
+    for(auto i = range.first; i != range.second; i ++) {
+      if(i->second == it) {
+        m_index.erase(i);
+        break;
+      }
+    }
+    m_currSize -= getEntryCost(*it);
+    m_entries.erase(it);
+  }
+}
+
+oatpp::String EncodedDataCache::get(const void* data, v_buff_size size) {
+
+  auto hash = hashData(data, size);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto range = m_index.equal_range(hash);
+  for(auto i = range.first; i != range.second; i ++) {
+    auto it = i->second;
+    if(static_cast<v_buff_size>(it->data->size()) == size && std::memcmp(it->data->data(), data, static_cast<size_t>(size)) == 0) {
+      m_entries.splice(m_entries.begin(), m_entries, it);
+      return it->encoded;
+    }
+  }
+
+  return nullptr;
+
+}
+
+void EncodedDataCache::put(const void* data, v_buff_size size, const oatpp::String& encoded) {
+
+  if(!encoded || size + static_cast<v_buff_size>(encoded->size()) > m_maxSize) {
+    return;
+  }
+
+  auto hash = hashData(data, size);
+  oatpp::String copy(reinterpret_cast<const char*>(data), size);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto range = m_index.equal_range(hash);
+  for(auto i = range.first; i != range.second; i ++) {
+    if(i->second->data == copy) {
+      return; // already cached by a concurrent request
+    }
+  }
+
+  m_entries.push_front({hash, copy, encoded});
+  m_index.insert({hash, m_entries.begin()});
+  m_currSize += getEntryCost(m_entries.front());
+
+  evict();
+
+}
+
+v_buff_size EncodedDataCache::getSize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_currSize;
+}
+
+v_buff_size EncodedDataCache::getEntriesCount() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<v_buff_size>(m_entries.size());
+}
+
+}}}}}
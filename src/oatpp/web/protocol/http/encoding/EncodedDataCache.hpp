@@ -0,0 +1,106 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_encoding_EncodedDataCache_hpp
+#define oatpp_web_protocol_http_encoding_EncodedDataCache_hpp
+
+#include "oatpp/Types.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+/**
+ * Bounded LRU cache of encoded forms of in-memory bodies. <br>
+ * Entries are keyed by the body content - lookup hashes the body and compares it byte-by-byte with the cached original,
+ * so identical responses (ex.: the same large static payload) are encoded only once. <br>
+ * Encoder providers put only immutable bodies here - see &id:oatpp::web::protocol::http::outgoing::Body::isImmutable;.
+ * Thread-safe.
+ */
+class EncodedDataCache {
+private:
+
+  struct Entry {
+    v_buff_size hash;
+    oatpp::String data;
+    oatpp::String encoded;
+  };
+
+private:
+  static v_buff_size hashData(const void* data, v_buff_size size);
+  static v_buff_size getEntryCost(const Entry& entry);
+private:
+  v_buff_size m_maxSize;
+  v_buff_size m_currSize;
+  std::list<Entry> m_entries;
+  std::unordered_multimap<v_buff_size, std::list<Entry>::iterator> m_index;
+  std::mutex m_mutex;
+private:
+  void evict();
+public:
+
+  /**
+   * Constructor.
+   * @param maxSize - max total size of cached data (original + encoded) in bytes.
+   */
+  EncodedDataCache(v_buff_size maxSize);
+
+  /**
+   * Get encoded form of the data.
+   * @param data - pointer to original data.
+   * @param size - size of original data.
+   * @return - encoded data or `nullptr` if not cached.
+   */
+  oatpp::String get(const void* data, v_buff_size size);
+
+  /**
+   * Put encoded form of the data to cache. <br>
+   * Least recently used entries are evicted to fit the max cache size.
+   * Data larger than the cache itself is not cached.
+   * @param data - pointer to original data.
+   * @param size - size of original data.
+   * @param encoded - encoded data.
+   */
+  void put(const void* data, v_buff_size size, const oatpp::String& encoded);
+
+  /**
+   * Get total size of cached data (original + encoded) in bytes.
+   * @return
+   */
+  v_buff_size getSize();
+
+  /**
+   * Get number of cached entries.
+   * @return
+   */
+  v_buff_size getEntriesCount();
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_encoding_EncodedDataCache_hpp
@@ -53,6 +53,36 @@ public:
    */
   virtual std::shared_ptr<data::buffer::Processor> getProcessor() = 0;
 
+  /**
+   * Check if the body of known size should be encoded at all. <br>
+   * If `false` is returned the body is sent as is - without `Content-Encoding`.
+   * Default implementation always returns `true`.
+   * @param bodySize - size of the body in bytes.
+   * @return - `true` if the body should be encoded.
+   */
+  virtual bool shouldEncode(v_int64 bodySize) {
+    (void) bodySize;
+    return true;
+  }
+
+  /**
+   * Encode the whole body at once. <br>
+   * Called for bodies which data is fully in memory - &id:oatpp::web::protocol::http::outgoing::Body::getKnownData;.
+   * The encoded body is then sent with `Content-Length` instead of the chunked transfer-encoding. <br>
+   * Default implementation returns `nullptr` - the body is encoded by the &l:EncoderProvider::getProcessor (); on the fly.
+   * @param data - pointer to body data.
+   * @param size - size of body data.
+   * @param immutable - `true` if the body is immutable (&id:oatpp::web::protocol::http::outgoing::Body::isImmutable;) -
+   * the encoded form may be cached and reused for the same data. Mutable bodies must not be cached.
+   * @return - encoded data or `nullptr`.
+   */
+  virtual oatpp::String encodeKnownData(const void* data, v_buff_size size, bool immutable) {
+    (void) data;
+    (void) size;
+    (void) immutable;
+    return nullptr;
+  }
+
 };
 
 }}}}}
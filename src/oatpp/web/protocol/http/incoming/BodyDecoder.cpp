@@ -26,6 +26,57 @@
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace incoming {
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BodyDecoder::ReaderCallback
+
+BodyDecoder::ReaderCallback::ReaderCallback(const std::shared_ptr<data::mapping::ObjectReader>& reader)
+  : m_reader(reader)
+  , m_discarded(0)
+  , m_discardLimitExceeded(false)
+{}
+
+v_io_size BodyDecoder::ReaderCallback::write(const void *data, v_buff_size count, async::Action& action) {
+
+  if(!m_reader->hasError()) {
+    auto res = m_reader->write(data, count, action);
+    if(!m_reader->hasError()) {
+      return res;
+    }
+  }
+
+  /* keep the connection in sync - skip the rest of the malformed body */
+  if(m_discarded + count > READER_DISCARD_MAX_SIZE) {
+    m_discardLimitExceeded = true;
+    return IOError::BROKEN_PIPE;
+  }
+  m_discarded += count;
+  return count;
+
+}
+
+bool BodyDecoder::ReaderCallback::hasError() const {
+  return m_reader->hasError();
+}
+
+oatpp::Void BodyDecoder::ReaderCallback::finish() {
+
+  data::mapping::ErrorStack errorStack;
+  auto result = m_reader->finish(errorStack);
+
+  if(errorStack.empty()) {
+    return result;
+  }
+
+  if(m_discardLimitExceeded) {
+    throw HttpError(Status::CODE_400,
+                    "[oatpp::web::protocol::http::incoming::BodyDecoder::ReaderCallback::finish()]: Error. "
+                    "Malformed body is too large to be skipped. " + errorStack.stacktrace());
+  }
+
+  throw data::mapping::MappingError(std::move(errorStack));
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // BodyDecoder
 
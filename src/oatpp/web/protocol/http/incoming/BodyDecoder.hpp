@@ -39,6 +39,39 @@ namespace oatpp { namespace web { namespace protocol { namespace http { namespac
  * You may extend this class in order to customize body-decoding process.
  */
 class BodyDecoder {
+public:
+
+  /**
+   * Max number of body bytes discarded after the incremental reader failed. <br>
+   * The rest of the body is read and discarded so that the next request on a keep-alive connection starts at
+   * the right position. If more than this is left, decoding fails with &id:oatpp::web::protocol::http::HttpError; `400`
+   * instead of &id:oatpp::data::mapping::MappingError; - it is meant to reach the error handler, which closes the connection.
+   */
+  static constexpr v_buff_size READER_DISCARD_MAX_SIZE = 256 * 1024;
+
+private:
+
+  /*
+   * Feeds body to the object reader. Once the reader failed, discards the rest of the body
+   * up to READER_DISCARD_MAX_SIZE bytes.
+   */
+  class ReaderCallback : public data::stream::WriteCallback {
+  private:
+    std::shared_ptr<data::mapping::ObjectReader> m_reader;
+    v_buff_size m_discarded;
+    bool m_discardLimitExceeded;
+  public:
+    ReaderCallback(const std::shared_ptr<data::mapping::ObjectReader>& reader);
+    v_io_size write(const void *data, v_buff_size count, async::Action& action) override;
+    bool hasError() const;
+
+    /*
+     * Finish reading. Throws MappingError if the body is malformed,
+     * or HttpError if the rest of the malformed body was too large to be discarded.
+     */
+    oatpp::Void finish();
+  };
+
 private:
   
   template<class Wrapper>
@@ -49,6 +82,7 @@ private:
     std::shared_ptr<data::stream::InputStream> m_bodyStream;
     std::shared_ptr<data::stream::IOStream> m_connection;
     std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+    std::shared_ptr<ReaderCallback> m_reader;
     std::shared_ptr<data::stream::BufferOutputStream> m_outputStream;
   public:
     
@@ -62,13 +96,26 @@ private:
       , m_bodyStream(bodyStream)
       , m_connection(connection)
       , m_objectMapper(objectMapper)
-      , m_outputStream(std::make_shared<data::stream::BufferOutputStream>())
-    {}
+    {
+      auto reader = objectMapper->createReader(Wrapper::Class::getType());
+      if(reader) {
+        m_reader = std::make_shared<ReaderCallback>(reader);
+      }
+    }
     
     oatpp::async::Action act() override {
+      if(m_reader) {
+        return m_decoder->decodeAsync(m_headers, m_bodyStream, m_reader, m_connection)
+          .next(this->yieldTo(&ToDtoDecoder::onRead));
+      }
+      m_outputStream = std::make_shared<data::stream::BufferOutputStream>();
       return m_decoder->decodeAsync(m_headers, m_bodyStream, m_outputStream, m_connection)
         .next(this->yieldTo(&ToDtoDecoder::onDecoded));
     }
+
+    oatpp::async::Action onRead() {
+      return this->_return(m_reader->finish().template cast<Wrapper>());
+    }
     
     oatpp::async::Action onDecoded() {
       auto body = m_outputStream->toString();
@@ -79,6 +126,14 @@ private:
       }
       return this->_return(dto);
     }
+
+    oatpp::async::Action handleError(oatpp::async::Error* error) override {
+      /* too much body left after the reader failed - report the reader's error instead of the transfer error */
+      if(m_reader && m_reader->hasError() && error->is<AsyncIOError>()) {
+        return this->yieldTo(&ToDtoDecoder::onRead);
+      }
+      return error;
+    }
     
   };
   
@@ -131,7 +186,10 @@ public:
   }
 
   /**
-   * Read body stream, decode, and deserialize it as DTO Object (see [Data Transfer Object (DTO)](https://oatpp.io/docs/components/dto/)).
+   * Read body stream, decode, and deserialize it as DTO Object (see [Data Transfer Object (DTO)](https://oatpp.io/docs/components/dto/)). <br>
+   * If the mapper supports incremental reading (see &id:oatpp::data::mapping::ObjectMapper::createReader;) the body is
+   * deserialized chunk by chunk as it is decoded - without buffering the whole body. If the body is malformed, the rest of it
+   * is discarded - up to &l:BodyDecoder::READER_DISCARD_MAX_SIZE; bytes.
    * @tparam Wrapper - ObjectWrapper type.
    * @param headers - Headers map. &id:oatpp::web::protocol::http::Headers;.
    * @param bodyStream - pointer to &id:oatpp::data::stream::InputStream;.
@@ -145,7 +203,13 @@ public:
                       data::stream::IOStream* connection,
                       data::mapping::ObjectMapper* objectMapper) const
   {
-    return objectMapper->readFromString<Wrapper>(decodeToString(headers, bodyStream, connection));
+    auto reader = objectMapper->createReader(Wrapper::Class::getType());
+    if(!reader) {
+      return objectMapper->readFromString<Wrapper>(decodeToString(headers, bodyStream, connection));
+    }
+    ReaderCallback callback(reader);
+    decode(headers, bodyStream, &callback, connection);
+    return callback.finish().template cast<Wrapper>();
   }
 
   /**
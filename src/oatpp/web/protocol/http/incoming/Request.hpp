@@ -259,14 +259,14 @@ public:
   oatpp::String readBodyToString() const;
 
   /**
-   * Transfer body to String and parse it as DTO
+   * Read body and deserialize it as DTO. See &id:oatpp::web::protocol::http::incoming::BodyDecoder::decodeToDto;.
    * @tparam Wrapper - ObjectWrapper type.
    * @param objectMapper
    * @return DTO
    */
   template<class Wrapper>
   Wrapper readBodyToDto(const base::ObjectHandle<data::mapping::ObjectMapper>& objectMapper) const {
-    return objectMapper->readFromString<Wrapper>(m_bodyDecoder->decodeToString(m_headers, m_bodyStream.get(), m_connection.get()));
+    return m_bodyDecoder->decodeToDto<Wrapper>(m_headers, m_bodyStream.get(), m_connection.get(), objectMapper.get());
   }
   
   // Async
@@ -293,7 +293,7 @@ public:
   async::CoroutineStarterForResult<const oatpp::String&> readBodyToStringAsync() const;
 
   /**
-   * Transfer body to String and parse it as DTO
+   * Read body and deserialize it as DTO. See &id:oatpp::web::protocol::http::incoming::BodyDecoder::decodeToDto;.
    * @tparam Wrapper - DTO `ObjectWrapper`.
    * @param objectMapper
    * @return - &id:oatpp::async::CoroutineStarterForResult;.
@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 #include "RequestHeadersReader.hpp"
+#include "oatpp/utils/CharScan.hpp"
 #include "oatpp/base/Log.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace incoming {
@@ -47,14 +48,11 @@ v_io_size RequestHeadersReader::readHeadersSectionIterative(ReadHeadersIteration
 
     m_bufferStream->setCurrentPosition(m_bufferStream->getCurrentPosition() + res);
 
-    for(v_buff_size i = 0; i < res; i ++) {
-      iteration.accumulator <<= 8;
-      iteration.accumulator |= bufferData[i];
-      if(iteration.accumulator == SECTION_END) {
-        stream->commitReadOffset(i + 1);
-        iteration.done = true;
-        return res;
-      }
+    auto sectionEnd = utils::CharScan::findSectionEnd(bufferData, res, iteration.accumulator);
+    if(sectionEnd > 0) {
+      stream->commitReadOffset(sectionEnd);
+      iteration.done = true;
+      return res;
     }
 
     stream->commitReadOffset(res);
@@ -65,18 +63,67 @@ v_io_size RequestHeadersReader::readHeadersSectionIterative(ReadHeadersIteration
   
 }
   
+v_io_size RequestHeadersReader::readHeadersSectionOnce(data::stream::InputStreamBufferedProxy* stream, bool canReadStream) {
+
+  if(!m_inProgress) {
+    m_bufferStream->setCurrentPosition(0);
+    m_iteration = ReadHeadersIteration();
+    m_inProgress = true;
+  }
+
+  async::Action action;
+
+  while(!m_iteration.done) {
+
+    if(stream->availableToRead() == 0) {
+      if(!canReadStream) {
+        return IOError::RETRY_READ;
+      }
+      canReadStream = false;
+    }
+
+    auto res = readHeadersSectionIterative(m_iteration, stream, action);
+
+    if(!action.isNone()) {
+      OATPP_LOGe("[oatpp::web::protocol::http::incoming::RequestHeadersReader::readHeadersSectionOnce]", "Error. Async action is unexpected.")
+      throw std::runtime_error("[oatpp::web::protocol::http::incoming::RequestHeadersReader::readHeadersSectionOnce]: Error. Async action is unexpected.");
+    }
+
+    if(res > 0) {
+      continue;
+    } else if(res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+      return IOError::RETRY_READ;
+    }
+
+    m_inProgress = false;
+    return res;
+
+  }
+
+  return m_bufferStream->getCurrentPosition();
+
+}
+
 RequestHeadersReader::Result RequestHeadersReader::readHeaders(data::stream::InputStreamBufferedProxy* stream,
                                                                http::HttpError::Info& error) {
 
-  m_bufferStream->setCurrentPosition(0);
+  /* continue the section partially (or fully) read by readHeadersSectionOnce() */
+  if(!m_inProgress) {
+    m_bufferStream->setCurrentPosition(0);
+    m_iteration = ReadHeadersIteration();
+  }
+  m_inProgress = false;
 
   RequestHeadersReader::Result result;
-  ReadHeadersIteration iteration;
   async::Action action;
 
-  while(!iteration.done) {
+  if(m_iteration.done) {
+    error.ioStatus = m_bufferStream->getCurrentPosition();
+  }
+
+  while(!m_iteration.done) {
 
-    error.ioStatus = readHeadersSectionIterative(iteration, stream, action);
+    error.ioStatus = readHeadersSectionIterative(m_iteration, stream, action);
 
     if(!action.isNone()) {
       OATPP_LOGe("[oatpp::web::protocol::http::incoming::RequestHeadersReader::readHeaders]", "Error. Async action is unexpected.")
@@ -95,10 +142,9 @@ RequestHeadersReader::Result RequestHeadersReader::readHeaders(data::stream::Inp
   
   if(error.ioStatus > 0) {
     oatpp::utils::parser::Caret caret (reinterpret_cast<const char*>(m_bufferStream->getData()), m_bufferStream->getCurrentPosition());
-    http::Status status;
-    http::Parser::parseRequestStartingLine(result.startingLine, nullptr, caret, status);
-    if(status.code == 0) {
-      http::Parser::parseHeaders(result.headers, nullptr, caret, status);
+    http::Parser::parseRequestStartingLine(result.startingLine, nullptr, caret, error.status);
+    if(error.status.code == 0) {
+      http::Parser::parseHeaders(result.headers, nullptr, caret, error.status);
     }
   }
   
@@ -41,8 +41,6 @@ public:
    * Convenience typedef for &id:oatpp::async::Action;.
    */
   typedef oatpp::async::Action Action;
-private:
-  static constexpr v_uint32 SECTION_END = ('\r' << 24) | ('\n' << 16) | ('\r' << 8) | ('\n');
 public:
 
   /**
@@ -76,6 +74,8 @@ private:
   oatpp::data::stream::BufferOutputStream* m_bufferStream;
   v_buff_size m_readChunkSize;
   v_buff_size m_maxHeadersSize;
+  ReadHeadersIteration m_iteration;
+  bool m_inProgress;
 public:
 
   /**
@@ -89,6 +89,7 @@ public:
     : m_bufferStream(bufferStream)
     , m_readChunkSize(readChunkSize)
     , m_maxHeadersSize(maxHeadersSize)
+    , m_inProgress(false)
   {}
 
   /**
@@ -99,6 +100,25 @@ public:
    */
   Result readHeaders(data::stream::InputStreamBufferedProxy* stream, http::HttpError::Info& error);
 
+  /**
+   * Read headers section making at most one read from the underlying stream - data already buffered in the `stream` goes first. <br>
+   * Progress is kept in the reader, so the call can be repeated once the stream is readable again.
+   * When the whole section is read - call &l:RequestHeadersReader::readHeaders (); to parse it.
+   * @param stream - &id:oatpp::data::stream::InputStreamBufferedProxy;.
+   * @param canReadStream - `false` to use buffered data only.
+   * @return - `> 0` when the whole headers section is read. &id:oatpp::IOError::RETRY_READ; if more data is needed.
+   * Other values - read error.
+   */
+  v_io_size readHeadersSectionOnce(data::stream::InputStreamBufferedProxy* stream, bool canReadStream);
+
+  /**
+   * Check if the headers section is partially read by &l:RequestHeadersReader::readHeadersSectionOnce ();.
+   * @return
+   */
+  bool isReadingHeaders() const {
+    return m_inProgress;
+  }
+
   /**
    * Read and parse http headers from stream in asynchronous manner.
    * @param stream - `std::shared_ptr` to &id:oatpp::data::stream::InputStreamBufferedProxy;.
@@ -25,6 +25,7 @@
 #include "ResponseHeadersReader.hpp"
 
 #include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/CharScan.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace incoming {
 
@@ -49,15 +50,12 @@ v_io_size ResponseHeadersReader::readHeadersSectionIterative(ReadHeadersIteratio
 
     bufferStream->writeSimple(bufferData, res);
 
-    for(v_buff_size i = 0; i < res; i ++) {
-      iteration.accumulator <<= 8;
-      iteration.accumulator |= bufferData[i];
-      if(iteration.accumulator == SECTION_END) {
-        result.bufferPosStart = i + 1;
-        result.bufferPosEnd = res;
-        iteration.done = true;
-        return res;
-      }
+    auto sectionEnd = utils::CharScan::findSectionEnd(bufferData, res, iteration.accumulator);
+    if(sectionEnd > 0) {
+      result.bufferPosStart = sectionEnd;
+      result.bufferPosEnd = res;
+      iteration.done = true;
+      return res;
     }
 
   }
@@ -70,6 +70,17 @@ public:
    * @return - &id:oatpp::v_io_size;.
    */
   virtual v_int64 getKnownSize() = 0;
+
+  /**
+   * Check if the body content never changes - the same data is sent with every response using this body. <br>
+   * Encoded forms of immutable bodies may be cached by content encoders. See
+   * &id:oatpp::web::protocol::http::encoding::EncoderProvider::encodeKnownData;. <br>
+   * Default implementation returns `false`.
+   * @return
+   */
+  virtual bool isImmutable() {
+    return false;
+  }
   
 };
   
@@ -26,15 +26,17 @@
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
 
-BufferBody::BufferBody(const oatpp::String &buffer, const data::share::StringKeyLabel &contentType)
+BufferBody::BufferBody(const oatpp::String &buffer, const data::share::StringKeyLabel &contentType, bool immutable)
   : m_buffer(buffer ? buffer : "")
   , m_contentType(contentType)
   , m_inlineData(reinterpret_cast<void*>(m_buffer->data()), static_cast<v_buff_size>(m_buffer->size()))
+  , m_immutable(immutable)
 {}
 
 std::shared_ptr<BufferBody> BufferBody::createShared(const oatpp::String &buffer,
-                                                     const data::share::StringKeyLabel &contentType) {
-  return std::make_shared<BufferBody>(buffer, contentType);
+                                                     const data::share::StringKeyLabel &contentType,
+                                                     bool immutable) {
+  return std::make_shared<BufferBody>(buffer, contentType, immutable);
 }
 
 v_io_size BufferBody::read(void *buffer, v_buff_size count, async::Action &action) {
@@ -74,4 +76,8 @@ v_int64 BufferBody::getKnownSize() {
   return static_cast<v_int64>(m_buffer->size());
 }
 
+bool BufferBody::isImmutable() {
+  return m_immutable;
+}
+
 }}}}}
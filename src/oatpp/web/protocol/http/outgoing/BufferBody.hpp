@@ -39,18 +39,22 @@ private:
   oatpp::String m_buffer;
   oatpp::data::share::StringKeyLabel m_contentType;
   data::buffer::InlineReadData m_inlineData;
+  bool m_immutable;
 public:
-  BufferBody(const oatpp::String& buffer, const data::share::StringKeyLabel& contentType);
+  BufferBody(const oatpp::String& buffer, const data::share::StringKeyLabel& contentType, bool immutable = false);
 public:
 
   /**
    * Create shared BufferBody.
    * @param buffer - &id:oatpp::String;.
    * @param contentType - type of the content.
+   * @param immutable - `true` if the same buffer is sent again and again (ex.: static content) -
+   * its encoded form may be cached. See &l:BufferBody::isImmutable ();.
    * @return - `std::shared_ptr` to BufferBody.
    */
   static std::shared_ptr<BufferBody> createShared(const oatpp::String& buffer,
-                                                  const data::share::StringKeyLabel& contentType = data::share::StringKeyLabel());
+                                                  const data::share::StringKeyLabel& contentType = data::share::StringKeyLabel(),
+                                                  bool immutable = false);
 
   /**
    * Read operation callback.
@@ -79,6 +83,12 @@ public:
    * @return - `v_buff_size`.
    */
   v_int64 getKnownSize() override;
+
+  /**
+   * Check if the body is marked immutable on creation.
+   * @return
+   */
+  bool isImmutable() override;
   
 };
   
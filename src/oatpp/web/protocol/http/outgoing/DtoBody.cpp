@@ -0,0 +1,95 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DtoBody.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+DtoBody::DtoBody(const oatpp::Void& dto, const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper)
+  : m_dto(dto)
+  , m_objectMapper(objectMapper)
+  , m_writer(objectMapper->createWriter(dto))
+{}
+
+std::shared_ptr<DtoBody> DtoBody::createShared(const oatpp::Void& dto, const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper) {
+  return std::make_shared<DtoBody>(dto, objectMapper);
+}
+
+v_io_size DtoBody::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  if(m_writer) {
+    auto res = m_writer->read(buffer, count, action);
+    if(res < 0 && m_writer->hasError()) {
+      OATPP_LOGe("[oatpp::web::protocol::http::outgoing::DtoBody::read()]", "Error. Can't serialize DTO:\n{}", m_writer->getErrorStack().stacktrace()->c_str())
+    }
+    return res;
+  }
+
+  /* mapper can't write incrementally - serialize everything on the first read */
+  if(!m_buffer) {
+    data::mapping::ErrorStack errorStack;
+    data::stream::BufferOutputStream stream;
+    m_objectMapper->write(&stream, m_dto, errorStack);
+    if(!errorStack.empty()) {
+      OATPP_LOGe("[oatpp::web::protocol::http::outgoing::DtoBody::read()]", "Error. Can't serialize DTO:\n{}", errorStack.stacktrace()->c_str())
+      return IOError::BROKEN_PIPE;
+    }
+    m_buffer = stream.toString();
+    m_inlineData.set(m_buffer->data(), static_cast<v_buff_size>(m_buffer->size()));
+  }
+
+  v_buff_size desiredToRead = m_inlineData.bytesLeft;
+  if(desiredToRead > count) {
+    desiredToRead = count;
+  }
+
+  std::memcpy(buffer, m_inlineData.currBufferPtr, static_cast<size_t>(desiredToRead));
+  m_inlineData.inc(desiredToRead);
+
+  return desiredToRead;
+
+}
+
+void DtoBody::declareHeaders(Headers& headers) {
+  const auto& contentType = m_objectMapper->getInfo().httpContentType;
+  if(contentType) {
+    headers.putIfNotExists(Header::CONTENT_TYPE, contentType);
+  }
+}
+
+p_char8 DtoBody::getKnownData() {
+  return nullptr;
+}
+
+v_int64 DtoBody::getKnownSize() {
+  return -1;
+}
+
+}}}}}
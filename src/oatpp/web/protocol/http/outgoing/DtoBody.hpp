@@ -0,0 +1,101 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_outgoing_DtoBody_hpp
+#define oatpp_web_protocol_http_outgoing_DtoBody_hpp
+
+#include "./Body.hpp"
+#include "oatpp/data/mapping/ObjectMapper.hpp"
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+/**
+ * Implementation of &id:oatpp::web::protocol::http::outgoing::Body; class.
+ * Serializes DTO on demand - as the body is read. <br>
+ * If the object mapper supports incremental writing (see &id:oatpp::data::mapping::ObjectMapper::createWriter;),
+ * memory used is bounded by the size of the read buffer (plus the largest non-container value).
+ * Otherwise the DTO is serialized at once on the first read. <br>
+ * Body size is unknown - the body is sent with the chunked transfer-encoding.
+ * If serialization fails the error is logged and `read` returns &id:oatpp::IOError::BROKEN_PIPE;.
+ * The response is then left incomplete - with or without content encoding the last chunk is not sent.
+ */
+class DtoBody : public oatpp::base::Countable, public Body {
+private:
+  oatpp::Void m_dto;
+  std::shared_ptr<data::mapping::ObjectMapper> m_objectMapper;
+  std::shared_ptr<data::mapping::ObjectWriter> m_writer;
+  oatpp::String m_buffer;
+  data::buffer::InlineReadData m_inlineData;
+public:
+
+  /**
+   * Constructor.
+   * @param dto - DTO to serialize.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper;.
+   */
+  DtoBody(const oatpp::Void& dto, const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper);
+public:
+
+  /**
+   * Create shared DtoBody.
+   * @param dto - DTO to serialize.
+   * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper;.
+   * @return - `std::shared_ptr` to DtoBody.
+   */
+  static std::shared_ptr<DtoBody> createShared(const oatpp::Void& dto, const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Read operation callback. Serializes next portion of the DTO.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Declare `Content-Type` header of the object mapper.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Pointer to the body known data.
+   * @return - `nullptr`.
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Return known size of the body.
+   * @return - `-1`.
+   */
+  v_int64 getKnownSize() override;
+
+};
+
+}}}}}
+
+#endif /* oatpp_web_protocol_http_outgoing_DtoBody_hpp */
@@ -0,0 +1,295 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "FileBody.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <io.h>
+  #include <windows.h>
+#else
+  #include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FileBody::File
+
+namespace {
+
+#if defined(WIN32) || defined(_WIN32)
+  typedef struct _stat64 FileInfo;
+#else
+  typedef struct stat FileInfo;
+#endif
+
+bool statHandle(int handle, FileInfo& info) {
+#if defined(WIN32) || defined(_WIN32)
+  return ::_fstat64(handle, &info) == 0;
+#else
+  return ::fstat(handle, &info) == 0;
+#endif
+}
+
+void closeHandle(int handle) {
+#if defined(WIN32) || defined(_WIN32)
+  ::_close(handle);
+#else
+  ::close(handle);
+#endif
+}
+
+/*
+ * Positional read - doesn't use the file position, so one handle can be read by concurrent bodies.
+ * Returns the number of bytes read, 0 at the end of file, or -1 on error.
+ */
+v_int64 readAt(int handle, void* buffer, v_int64 count, v_int64 offset) {
+#if defined(WIN32) || defined(_WIN32)
+  auto fileHandle = reinterpret_cast<HANDLE>(::_get_osfhandle(handle));
+  if(fileHandle == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  OVERLAPPED overlapped;
+  std::memset(&overlapped, 0, sizeof(overlapped));
+  overlapped.Offset = static_cast<DWORD>(static_cast<v_uint64>(offset) & 0xFFFFFFFF);
+  overlapped.OffsetHigh = static_cast<DWORD>(static_cast<v_uint64>(offset) >> 32);
+  DWORD bytesRead = 0;
+  DWORD toRead = static_cast<DWORD>(count > 0x7FFFFFFF ? 0x7FFFFFFF : count);
+  if(!::ReadFile(fileHandle, buffer, toRead, &bytesRead, &overlapped)) {
+    return ::GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+  }
+  return static_cast<v_int64>(bytesRead);
+#else
+  return ::pread(handle, buffer, static_cast<size_t>(count), offset);
+#endif
+}
+
+/*
+ * Read exactly `size` bytes from the beginning of the file.
+ */
+bool readFully(int handle, p_char8 buffer, v_int64 size) {
+
+  v_int64 position = 0;
+  while(position < size) {
+    auto res = readAt(handle, buffer + position, size - position, position);
+    if(res <= 0) {
+      return false; // error or file was truncated
+    }
+    position += res;
+  }
+
+  return true;
+
+}
+
+}
+
+FileBody::File::File(const oatpp::String& filename, bool load)
+  : m_filename(filename)
+  , m_handle(-1)
+  , m_size(0)
+  , m_modifiedTime(0)
+  , m_data(nullptr)
+{
+
+  if(!m_filename) {
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::File::File()]: Error. Filename is null.");
+  }
+
+#if defined(WIN32) || defined(_WIN32)
+  m_handle = ::_open(m_filename->c_str(), _O_RDONLY | _O_BINARY);
+#else
+  m_handle = ::open(m_filename->c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+
+  FileInfo info;
+  if(m_handle < 0 || !statHandle(m_handle, info)) {
+    if(m_handle >= 0) {
+      closeHandle(m_handle);
+    }
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::File::File()]: Error. Can't open file '" + *m_filename + "'.");
+  }
+
+  m_size = info.st_size;
+  m_modifiedTime = info.st_mtime;
+
+  if(load && m_size > 0) {
+    /* The copy is kept only if the file was not modified while it was read. Otherwise the body is read from the file. */
+    m_buffer.reset(new v_char8[static_cast<size_t>(m_size)]);
+    FileInfo after;
+    if(readFully(m_handle, m_buffer.get(), m_size) && statHandle(m_handle, after) &&
+       after.st_size == info.st_size && after.st_mtime == info.st_mtime)
+    {
+      m_data = m_buffer.get();
+    } else {
+      m_buffer.reset();
+    }
+  }
+
+}
+
+FileBody::File::~File() {
+  closeHandle(m_handle);
+}
+
+std::shared_ptr<FileBody::File> FileBody::File::open(const oatpp::String& filename, bool load) {
+  return std::make_shared<File>(filename, load);
+}
+
+v_io_handle FileBody::File::getHandle() const {
+  return static_cast<v_io_handle>(m_handle);
+}
+
+v_int64 FileBody::File::getSize() const {
+  return m_size;
+}
+
+v_int64 FileBody::File::getModifiedTime() const {
+  return m_modifiedTime;
+}
+
+p_char8 FileBody::File::getData() const {
+  return m_data;
+}
+
+oatpp::String FileBody::File::getFilename() const {
+  return m_filename;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FileBody
+
+FileBody::FileBody(const oatpp::String& filename, const data::share::StringKeyLabel& contentType)
+  : m_file(File::open(filename))
+  , m_contentType(contentType)
+  , m_offset(0)
+  , m_size(m_file->getSize())
+  , m_position(0)
+{}
+
+FileBody::FileBody(const std::shared_ptr<File>& file, v_int64 offset, v_int64 size, const data::share::StringKeyLabel& contentType)
+  : m_file(file)
+  , m_contentType(contentType)
+  , m_offset(offset)
+  , m_size(size)
+  , m_position(0)
+{
+  if(!m_file) {
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::FileBody()]: Error. File is null.");
+  }
+  if(m_offset < 0 || m_size < 0 || m_offset + m_size > m_file->getSize()) {
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::FileBody::FileBody()]: Error. Range is out of file bounds.");
+  }
+}
+
+std::shared_ptr<FileBody> FileBody::createShared(const oatpp::String& filename,
+                                                 const data::share::StringKeyLabel& contentType) {
+  return std::make_shared<FileBody>(filename, contentType);
+}
+
+std::shared_ptr<FileBody> FileBody::createShared(const std::shared_ptr<File>& file,
+                                                 v_int64 offset,
+                                                 v_int64 size,
+                                                 const data::share::StringKeyLabel& contentType) {
+  return std::make_shared<FileBody>(file, offset, size, contentType);
+}
+
+v_io_size FileBody::read(void *buffer, v_buff_size count, async::Action& action) {
+
+  (void) action;
+
+  v_int64 desiredToRead = m_size - m_position;
+  if(desiredToRead <= 0) {
+    return 0;
+  }
+  if(desiredToRead > count) {
+    desiredToRead = count;
+  }
+
+  if(m_file->getData() != nullptr) {
+    std::memcpy(buffer, m_file->getData() + m_offset + m_position, static_cast<size_t>(desiredToRead));
+    m_position += desiredToRead;
+    return desiredToRead;
+  }
+
+#if defined(WIN32) || defined(_WIN32)
+  auto handle = static_cast<int>(m_file->getHandle());
+#else
+  auto handle = m_file->getHandle();
+#endif
+  auto result = readAt(handle, buffer, desiredToRead, m_offset + m_position);
+
+  if(result < 0) {
+    return IOError::BROKEN_PIPE;
+  }
+
+  m_position += result;
+  return result;
+
+}
+
+void FileBody::rewind() {
+  m_position = 0;
+}
+
+void FileBody::declareHeaders(Headers& headers) {
+  if (m_contentType) {
+    headers.putIfNotExists(Header::CONTENT_TYPE, m_contentType);
+  }
+}
+
+p_char8 FileBody::getKnownData() {
+  if(m_file->getData() != nullptr) {
+    return m_file->getData() + m_offset;
+  }
+  return nullptr;
+}
+
+v_int64 FileBody::getKnownSize() {
+  return m_size;
+}
+
+v_io_handle FileBody::getFileHandle() const {
+  return m_file->getHandle();
+}
+
+v_int64 FileBody::getFileOffset() const {
+  return m_offset;
+}
+
+std::shared_ptr<FileBody::File> FileBody::getFile() const {
+  return m_file;
+}
+
+oatpp::String FileBody::getFilename() const {
+  return m_file->getFilename();
+}
+
+}}}}}
@@ -0,0 +1,228 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_outgoing_FileBody_hpp
+#define oatpp_web_protocol_http_outgoing_FileBody_hpp
+
+#include "./Body.hpp"
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#include <memory>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
+
+/**
+ * Implementation of &id:oatpp::web::protocol::http::outgoing::Body; class.
+ * Uses file (or a byte range of file) as data source for http body. <br>
+ * When the response is sent directly to &id:oatpp::network::tcp::Connection; the file is streamed to the socket
+ * with &id:oatpp::network::tcp::Connection::sendFile; - bytes are not copied through user space.
+ * If the file is loaded into memory, the copy is exposed as body known data and is written together with headers.
+ * Otherwise (content-encoding, connection proxies, unsupported platform) the body is read as a regular stream.
+ */
+class FileBody : public oatpp::base::Countable, public Body {
+public:
+
+  /**
+   * Open file shared between bodies. <br>
+   * Holds file descriptor, size and modification time as of the moment the file was opened,
+   * and - optionally - an immutable in-memory copy of the whole file. <br>
+   * The copy is a snapshot - it stays consistent with the size and modification time even if the file is modified
+   * or truncated in place afterwards.
+   */
+  class File : public oatpp::base::Countable {
+  private:
+    oatpp::String m_filename;
+    int m_handle;
+    v_int64 m_size;
+    v_int64 m_modifiedTime;
+    std::unique_ptr<v_char8[]> m_buffer;
+    p_char8 m_data;
+  public:
+
+    /**
+     * Constructor.
+     * @param filename - path to the file.
+     * @param load - read the whole file into memory. The file is not loaded if it is modified while being read.
+     * @throws - `std::runtime_error` if the file can't be opened.
+     */
+    File(const oatpp::String& filename, bool load);
+
+    /**
+     * Non-virtual destructor. Closes file.
+     */
+    ~File();
+
+    /**
+     * Create shared File.
+     * @param filename - path to the file.
+     * @param load - read the whole file into memory.
+     * @return - `std::shared_ptr` to File.
+     */
+    static std::shared_ptr<File> open(const oatpp::String& filename, bool load = false);
+
+    /**
+     * Get file handle (file descriptor).
+     * @return - &id:oatpp::v_io_handle;.
+     */
+    v_io_handle getHandle() const;
+
+    /**
+     * Size of the file as of the moment it was opened.
+     * @return - size in bytes.
+     */
+    v_int64 getSize() const;
+
+    /**
+     * Modification time of the file as of the moment it was opened.
+     * @return - seconds since epoch.
+     */
+    v_int64 getModifiedTime() const;
+
+    /**
+     * Pointer to the in-memory copy of the file.
+     * @return - pointer to data or `nullptr` if the file is not loaded.
+     */
+    p_char8 getData() const;
+
+    /**
+     * Get file name.
+     * @return - &id:oatpp::String;.
+     */
+    oatpp::String getFilename() const;
+
+  };
+
+private:
+  std::shared_ptr<File> m_file;
+  oatpp::data::share::StringKeyLabel m_contentType;
+  v_int64 m_offset;
+  v_int64 m_size;
+  v_int64 m_position;
+public:
+
+  /**
+   * Constructor.
+   * @param filename - path to the file.
+   * @param contentType - type of the content.
+   * @throws - `std::runtime_error` if the file can't be opened.
+   */
+  FileBody(const oatpp::String& filename, const data::share::StringKeyLabel& contentType);
+
+  /**
+   * Constructor. Body is a byte range of an already open file.
+   * @param file - &l:FileBody::File;.
+   * @param offset - offset of the first byte of the body in the file.
+   * @param size - size of the body in bytes.
+   * @param contentType - type of the content.
+   * @throws - `std::runtime_error` if the range is out of the file bounds.
+   */
+  FileBody(const std::shared_ptr<File>& file, v_int64 offset, v_int64 size, const data::share::StringKeyLabel& contentType);
+
+  /**
+   * Create shared FileBody.
+   * @param filename - path to the file.
+   * @param contentType - type of the content.
+   * @return - `std::shared_ptr` to FileBody.
+   */
+  static std::shared_ptr<FileBody> createShared(const oatpp::String& filename,
+                                                const data::share::StringKeyLabel& contentType = data::share::StringKeyLabel());
+
+  /**
+   * Create shared FileBody for the whole file or its byte range.
+   * @param file - &l:FileBody::File;.
+   * @param offset - offset of the first byte of the body in the file.
+   * @param size - size of the body in bytes.
+   * @param contentType - type of the content.
+   * @return - `std::shared_ptr` to FileBody.
+   */
+  static std::shared_ptr<FileBody> createShared(const std::shared_ptr<File>& file,
+                                                v_int64 offset,
+                                                v_int64 size,
+                                                const data::share::StringKeyLabel& contentType = data::share::StringKeyLabel());
+
+  /**
+   * Read operation callback.
+   * @param buffer - pointer to buffer.
+   * @param count - size of the buffer in bytes.
+   * @param action - async specific action. If action is NOT &id:oatpp::async::Action::TYPE_NONE;, then
+   * caller MUST return this action on coroutine iteration.
+   * @return - actual number of bytes written to buffer. 0 - to indicate end-of-file.
+   */
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override;
+
+  /**
+   * Move read position back to the beginning of the body. <br>
+   * Called by &id:oatpp::web::protocol::http::outgoing::Response; before the body is sent,
+   * so the same response can be sent more than once.
+   */
+  void rewind();
+
+  /**
+   * Declare `Content-Type` header if content type is specified.
+   * @param headers - &id:oatpp::web::protocol::http::Headers;.
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Pointer to the body known data.
+   * @return - pointer into the in-memory copy of the file or `nullptr` if the file is not loaded.
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Size of the body (whole file or range, as of the moment the file was opened).
+   * @return - &id:oatpp::v_io_size;.
+   */
+  v_int64 getKnownSize() override;
+
+  /**
+   * Get file handle (file descriptor).
+   * @return - &id:oatpp::v_io_handle;.
+   */
+  v_io_handle getFileHandle() const;
+
+  /**
+   * Offset of the first byte of the body in the file.
+   * @return - offset in bytes.
+   */
+  v_int64 getFileOffset() const;
+
+  /**
+   * Get file.
+   * @return - &l:FileBody::File;.
+   */
+  std::shared_ptr<File> getFile() const;
+
+  /**
+   * Get file name.
+   * @return - &id:oatpp::String;.
+   */
+  oatpp::String getFilename() const;
+
+};
+
+}}}}}
+
+#endif /* oatpp_web_protocol_http_outgoing_FileBody_hpp */
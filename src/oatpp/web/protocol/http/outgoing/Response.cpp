@@ -23,12 +23,251 @@
  ***************************************************************************/
 
 #include "./Response.hpp"
+#include "./FileBody.hpp"
 
 #include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
 #include "oatpp/utils/Conversion.hpp"
+#include "oatpp/utils/String.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
 
+namespace {
+
+/*
+ * Zero-copy path: file body written directly to the tcp socket.
+ * Memory-mapped files are written together with headers instead. Empty files have nothing to send after headers.
+ */
+bool canSendFile(Body* body, data::stream::OutputStream* stream, FileBody*& fileBody, network::tcp::Connection*& connection) {
+  if(!network::tcp::Connection::isSendFileSupported()) {
+    return false;
+  }
+  fileBody = dynamic_cast<FileBody*>(body);
+  if(fileBody == nullptr || fileBody->getKnownData() != nullptr || fileBody->getKnownSize() == 0) {
+    return false;
+  }
+  connection = dynamic_cast<network::tcp::Connection*>(stream);
+  return connection != nullptr;
+}
+
+/*
+ * File body keeps its read position - start from the beginning every time the response is sent.
+ */
+void rewindBody(Body* body) {
+  auto fileBody = dynamic_cast<FileBody*>(body);
+  if(fileBody != nullptr) {
+    fileBody->rewind();
+  }
+}
+
+/*
+ * Content-encoded response depends on the request Accept-Encoding - tell shared caches.
+ */
+void addVaryAcceptEncoding(Headers& headers) {
+
+  auto vary = headers.getAsMemoryLabel<data::share::StringKeyLabel>(Header::VARY);
+  if(!vary) {
+    headers.put_LockFree(Header::VARY, Header::ACCEPT_ENCODING);
+    return;
+  }
+
+  std::string_view list(reinterpret_cast<const char*>(vary.getData()), static_cast<size_t>(vary.getSize()));
+  std::string_view token(Header::ACCEPT_ENCODING);
+
+  while(!list.empty()) {
+    auto pos = list.find(',');
+    auto item = list.substr(0, pos);
+    while(!item.empty() && (item.front() == ' ' || item.front() == '\t')) item.remove_prefix(1);
+    while(!item.empty() && (item.back() == ' ' || item.back() == '\t')) item.remove_suffix(1);
+    if(item == "*" ||
+       (item.size() == token.size() &&
+        utils::String::compareCI_ASCII(item.data(), static_cast<v_buff_size>(item.size()),
+                                       token.data(), static_cast<v_buff_size>(token.size())) == 0))
+    {
+      return;
+    }
+    if(pos == std::string_view::npos) break;
+    list.remove_prefix(pos + 1);
+  }
+
+  headers.put_LockFree(Header::VARY, oatpp::String(vary.std_str() + ", " + Header::ACCEPT_ENCODING));
+
+}
+
+/*
+ * Bodies below the provider's size threshold are sent as is - returns nullptr.
+ * In-memory bodies are encoded at once to be sent with Content-Length - encodedBody is set.
+ */
+http::encoding::EncoderProvider* resolveContentEncoding(Body* body,
+                                                        http::encoding::EncoderProvider* provider,
+                                                        oatpp::String& encodedBody)
+{
+  auto bodySize = body->getKnownSize();
+  if(bodySize >= 0) {
+    if(!provider->shouldEncode(bodySize)) {
+      return nullptr;
+    }
+    if(body->getKnownData() != nullptr) {
+      encodedBody = provider->encodeKnownData(body->getKnownData(), bodySize, body->isImmutable());
+    }
+  }
+  return provider;
+}
+
+/*
+ * Body reader for the content-encoded transfer.
+ * data::stream::transfer() takes a read error for the end of body - the encoder would then finish the stream
+ * and the last chunk would be written. Throw instead, so that the peer never gets a truncated body as complete.
+ * In the async transfer the exception becomes the coroutine error.
+ */
+class EncodedBodyReader : public data::stream::ReadCallback {
+private:
+  std::shared_ptr<Body> m_body;
+public:
+
+  EncodedBodyReader(const std::shared_ptr<Body>& body)
+    : m_body(body)
+  {}
+
+  v_io_size read(void *buffer, v_buff_size count, async::Action& action) override {
+    auto res = m_body->read(buffer, count, action);
+    if(res < 0 && res != IOError::RETRY_READ && res != IOError::RETRY_WRITE) {
+      throw std::runtime_error("[oatpp::web::protocol::http::outgoing::EncodedBodyReader::read()]: Error. Can't read body.");
+    }
+    return res;
+  }
+
+};
+
+/*
+ * Headers are sent with Connection::writeMore() - they go out in one tcp segment with the first bytes of the file.
+ */
+bool sendHeaders(data::stream::BufferOutputStream* headers, network::tcp::Connection* connection) {
+
+  v_buff_size offset = 0;
+  v_buff_size size = headers->getCurrentPosition();
+
+  while(offset < size) {
+    async::Action action;
+    auto res = connection->writeMore(headers->getData() + offset, size - offset, action);
+    if(res > 0) {
+      offset += res;
+    } else if(res != IOError::RETRY_WRITE) {
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+/*
+ * Once the headers are on the wire the peer waits for Content-Length bytes.
+ * Throw on failure so that the connection gets closed instead of being reused out of sync.
+ */
+void sendFile(data::stream::BufferOutputStream* headers, FileBody* fileBody, network::tcp::Connection* connection) {
+
+  if(!sendHeaders(headers, connection)) {
+    throw std::runtime_error("[oatpp::web::protocol::http::outgoing::sendFile()]: Error. Failed to send headers.");
+  }
+
+  v_int64 offset = fileBody->getFileOffset();
+  v_int64 size = offset + fileBody->getKnownSize();
+
+  while(offset < size) {
+    async::Action action;
+    auto res = connection->sendFile(fileBody->getFileHandle(), offset, size - offset, action);
+    if(res > 0) {
+      offset += res;
+    } else if(res != IOError::RETRY_WRITE) {
+      /* broken pipe or file truncated */
+      throw std::runtime_error("[oatpp::web::protocol::http::outgoing::sendFile()]: Error. Failed to send file.");
+    }
+  }
+
+}
+
+class SendFileCoroutine : public oatpp::async::Coroutine<SendFileCoroutine> {
+private:
+  std::shared_ptr<Body> m_body;
+  std::shared_ptr<data::stream::OutputStream> m_stream;
+  std::shared_ptr<data::stream::BufferOutputStream> m_headers;
+  FileBody* m_fileBody;
+  network::tcp::Connection* m_connection;
+  v_buff_size m_headersOffset;
+  v_int64 m_offset;
+  v_int64 m_size;
+public:
+
+  SendFileCoroutine(const std::shared_ptr<Body>& body,
+                    const std::shared_ptr<data::stream::OutputStream>& stream,
+                    const std::shared_ptr<data::stream::BufferOutputStream>& headers,
+                    FileBody* fileBody,
+                    network::tcp::Connection* connection)
+    : m_body(body)
+    , m_stream(stream)
+    , m_headers(headers)
+    , m_fileBody(fileBody)
+    , m_connection(connection)
+    , m_headersOffset(0)
+    , m_offset(fileBody->getFileOffset())
+    , m_size(m_offset + fileBody->getKnownSize())
+  {}
+
+  Action act() override {
+
+    if(m_headersOffset >= m_headers->getCurrentPosition()) {
+      return yieldTo(&SendFileCoroutine::sendFile);
+    }
+
+    async::Action action;
+    auto res = m_connection->writeMore(m_headers->getData() + m_headersOffset, m_headers->getCurrentPosition() - m_headersOffset, action);
+
+    if(res > 0) {
+      m_headersOffset += res;
+      return repeat();
+    }
+
+    if(res == IOError::RETRY_WRITE) {
+      if(!action.isNone()) {
+        return action;
+      }
+      return repeat();
+    }
+
+    return error<AsyncIOError>("[oatpp::web::protocol::http::outgoing::SendFileCoroutine::act()]: Error. Failed to send headers.", IOError::BROKEN_PIPE);
+
+  }
+
+  Action sendFile() {
+
+    if(m_offset >= m_size) {
+      return finish();
+    }
+
+    async::Action action;
+    auto res = m_connection->sendFile(m_fileBody->getFileHandle(), m_offset, m_size - m_offset, action);
+
+    if(res > 0) {
+      m_offset += res;
+      return repeat();
+    }
+
+    if(res == IOError::RETRY_WRITE) {
+      if(!action.isNone()) {
+        return action;
+      }
+      return repeat();
+    }
+
+    return error<AsyncIOError>("[oatpp::web::protocol::http::outgoing::SendFileCoroutine::sendFile()]: Error. Failed to send file.", IOError::BROKEN_PIPE);
+
+  }
+
+};
+
+}
+
 Response::Response(const Status& status,
                    const std::shared_ptr<Body>& body)
   : m_status(status)
@@ -111,11 +350,17 @@ void Response::send(data::stream::OutputStream* stream,
 {
 
   v_int64 bodySize = -1;
+  oatpp::String encodedBody;
 
   if(m_body){
 
+    rewindBody(m_body.get());
     m_body->declareHeaders(m_headers);
 
+    if(contentEncoderProvider != nullptr) {
+      contentEncoderProvider = resolveContentEncoding(m_body.get(), contentEncoderProvider, encodedBody);
+    }
+
     if(contentEncoderProvider == nullptr) {
 
       bodySize = m_body->getKnownSize();
@@ -126,9 +371,14 @@ void Response::send(data::stream::OutputStream* stream,
         m_headers.put_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
       }
 
+    } else if(encodedBody) {
+      m_headers.put_LockFree(Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(encodedBody->size())));
+      m_headers.put_LockFree(Header::CONTENT_ENCODING, contentEncoderProvider->getEncodingName());
+      addVaryAcceptEncoding(m_headers);
     } else {
       m_headers.put_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
       m_headers.put_LockFree(Header::CONTENT_ENCODING, contentEncoderProvider->getEncodingName());
+      addVaryAcceptEncoding(m_headers);
     }
 
   } else {
@@ -153,31 +403,45 @@ void Response::send(data::stream::OutputStream* stream,
 
       if (bodySize >= 0) {
 
-        if(m_body->getKnownData() == nullptr) {
+        FileBody* fileBody;
+        network::tcp::Connection* connection;
+
+        if(canSendFile(m_body.get(), stream, fileBody, connection)) {
+          sendFile(headersWriteBuffer, fileBody, connection);
+        } else if(m_body->getKnownData() == nullptr) {
           headersWriteBuffer->flushToStream(stream);
           /* Reuse headers buffer */
           /* Transfer without chunked encoder */
           data::stream::transfer(m_body, stream, 0, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity());
-        } else { 
-          if (bodySize + headersWriteBuffer->getCurrentPosition() < headersWriteBuffer->getCapacity()) {
-            headersWriteBuffer->writeSimple(m_body->getKnownData(), bodySize);
-            headersWriteBuffer->flushToStream(stream);
-          } else {
-            headersWriteBuffer->flushToStream(stream);
-            stream->writeExactSizeDataSimple(m_body->getKnownData(), bodySize);
-          }
+        } else if(bodySize + headersWriteBuffer->getCurrentPosition() < headersWriteBuffer->getCapacity()) {
+          /* Small body - copy it to the headers buffer and send everything with one write */
+          headersWriteBuffer->writeSimple(m_body->getKnownData(), bodySize);
+          headersWriteBuffer->flushToStream(stream);
+        } else {
+          /* Headers and body in one vectored write - body is not copied */
+          data::buffer::InlineWriteData message[2] = {
+            {headersWriteBuffer->getData(), headersWriteBuffer->getCurrentPosition()},
+            {m_body->getKnownData(), bodySize}
+          };
+          stream->writevExactSizeDataSimple(message, 2);
         }
       } else {
 
         headersWriteBuffer->flushToStream(stream);
 
-        http::encoding::EncoderChunked chunkedEncoder;
-
         /* Reuse headers buffer */
-        data::stream::transfer(m_body, stream, 0, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity(), &chunkedEncoder);
+        http::encoding::EncoderChunked::transfer(m_body, stream, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity());
 
       }
 
+    } else if(encodedBody) {
+
+      data::buffer::InlineWriteData message[2] = {
+        {headersWriteBuffer->getData(), headersWriteBuffer->getCurrentPosition()},
+        {encodedBody->data(), static_cast<v_buff_size>(encodedBody->size())}
+      };
+      stream->writevExactSizeDataSimple(message, 2);
+
     } else {
 
       headersWriteBuffer->flushToStream(stream);
@@ -191,7 +455,8 @@ void Response::send(data::stream::OutputStream* stream,
       });
 
       /* Reuse headers buffer */
-      data::stream::transfer(m_body, stream, 0, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity(), &pipeline);
+      EncodedBodyReader reader(m_body);
+      data::stream::transfer(&reader, stream, 0, headersWriteBuffer->getData(), headersWriteBuffer->getCapacity(), &pipeline);
 
     }
 
@@ -213,6 +478,8 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
     std::shared_ptr<data::stream::OutputStream> m_stream;
     std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersWriteBuffer;
     std::shared_ptr<http::encoding::EncoderProvider> m_contentEncoderProvider;
+    oatpp::String m_encodedBody;
+    data::buffer::InlineWriteData m_message[2];
   public:
 
     SendAsyncCoroutine(const std::shared_ptr<Response>& _this,
@@ -231,8 +498,15 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
 
       if(m_this->m_body){
 
+        rewindBody(m_this->m_body.get());
         m_this->m_body->declareHeaders(m_this->m_headers);
 
+        if(m_contentEncoderProvider &&
+           resolveContentEncoding(m_this->m_body.get(), m_contentEncoderProvider.get(), m_encodedBody) == nullptr)
+        {
+          m_contentEncoderProvider.reset();
+        }
+
         if(!m_contentEncoderProvider) {
 
           bodySize = m_this->m_body->getKnownSize();
@@ -243,9 +517,14 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
             m_this->m_headers.putIfNotExists_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
           }
 
+        } else if(m_encodedBody) {
+          m_this->m_headers.putIfNotExists_LockFree(Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(m_encodedBody->size())));
+          m_this->m_headers.putIfNotExists_LockFree(Header::CONTENT_ENCODING, m_contentEncoderProvider->getEncodingName());
+          addVaryAcceptEncoding(m_this->m_headers);
         } else {
           m_this->m_headers.putIfNotExists_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
           m_this->m_headers.putIfNotExists_LockFree(Header::CONTENT_ENCODING, m_contentEncoderProvider->getEncodingName());
+          addVaryAcceptEncoding(m_this->m_headers);
         }
 
       } else {
@@ -270,28 +549,51 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
 
           if (bodySize >= 0) {
 
-            if (bodySize + m_headersWriteBuffer->getCurrentPosition() < m_headersWriteBuffer->getCapacity()) {
+            FileBody* fileBody;
+            network::tcp::Connection* connection;
 
-              m_headersWriteBuffer->writeSimple(m_this->m_body->getKnownData(), bodySize);
+            if(canSendFile(m_this->m_body.get(), m_stream.get(), fileBody, connection)) {
+
+              return SendFileCoroutine::start(m_this->m_body, m_stream, m_headersWriteBuffer, fileBody, connection)
+                .next(finish());
+
+            } else if(m_this->m_body->getKnownData() == nullptr) {
+
+              /* Transfer without chunked encoder */
               return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
+                .next(data::stream::transferAsync(m_this->m_body, m_stream, 0, data::buffer::IOBuffer::createShared()))
                 .next(finish());
 
-            } else {
+            } else if(bodySize + m_headersWriteBuffer->getCurrentPosition() < m_headersWriteBuffer->getCapacity()) {
 
+              /* Small body - copy it to the headers buffer and send everything with one write */
+              m_headersWriteBuffer->writeSimple(m_this->m_body->getKnownData(), bodySize);
               return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
-                .next(m_stream->writeExactSizeDataAsync(m_this->m_body->getKnownData(), bodySize))
                 .next(finish());
+
+            } else {
+
+              /* Headers and body in one vectored write - body is not copied */
+              m_message[0].set(m_headersWriteBuffer->getData(), m_headersWriteBuffer->getCurrentPosition());
+              m_message[1].set(m_this->m_body->getKnownData(), bodySize);
+              return yieldTo(&SendAsyncCoroutine::writeMessage);
+
             }
 
           } else {
 
-            auto chunkedEncoder = std::make_shared<http::encoding::EncoderChunked>();
             return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
-              .next(data::stream::transferAsync(m_this->m_body, m_stream, 0, data::buffer::IOBuffer::createShared(), chunkedEncoder))
+              .next(http::encoding::EncoderChunked::transferAsync(m_this->m_body, m_stream, data::buffer::IOBuffer::createShared()))
               .next(finish());
 
           }
 
+        } else if(m_encodedBody) {
+
+          m_message[0].set(m_headersWriteBuffer->getData(), m_headersWriteBuffer->getCurrentPosition());
+          m_message[1].set(m_encodedBody->data(), static_cast<v_buff_size>(m_encodedBody->size()));
+          return yieldTo(&SendAsyncCoroutine::writeMessage);
+
         } else {
 
           auto chunkedEncoder = std::make_shared<http::encoding::EncoderChunked>();
@@ -303,7 +605,7 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
           }));
 
           return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
-            .next(data::stream::transferAsync(m_this->m_body, m_stream, 0, data::buffer::IOBuffer::createShared(), pipeline)
+            .next(data::stream::transferAsync(std::make_shared<EncodedBodyReader>(m_this->m_body), m_stream, 0, data::buffer::IOBuffer::createShared(), pipeline)
             . next(finish()));
 
         }
@@ -316,6 +618,10 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
 
     }
 
+    Action writeMessage() {
+      return m_stream->writevExactSizeDataAsyncInline(m_message, 2, finish());
+    }
+
   };
 
   return SendAsyncCoroutine::start(_this, stream, headersWriteBuffer, contentEncoder);
@@ -25,6 +25,7 @@
 #include "./ResponseFactory.hpp"
 
 #include "./BufferBody.hpp"
+#include "./DtoBody.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
 
@@ -41,7 +42,11 @@ ResponseFactory::createResponse(const Status& status, const oatpp::String& text)
 std::shared_ptr<Response>
 ResponseFactory::createResponse(const Status& status,
                                 const oatpp::Void& dto,
-                                const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper) {
+                                const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper,
+                                bool streamBody) {
+  if(streamBody) {
+    return Response::createShared(status, DtoBody::createShared(dto, objectMapper));
+  }
   return Response::createShared(status, BufferBody::createShared(
     objectMapper->writeToString(dto),
     objectMapper->getInfo().httpContentType
@@ -54,15 +54,19 @@ public:
   static std::shared_ptr<Response> createResponse(const Status& status, const oatpp::String& text);
 
   /**
-   * Create &id:oatpp::web::protocol::http::outgoing::Response; with &id:oatpp::web::protocol::http::outgoing::DtoBody;.
+   * Create &id:oatpp::web::protocol::http::outgoing::Response; with DTO body. <br>
+   * By default DTO is serialized right away to &id:oatpp::web::protocol::http::outgoing::BufferBody;.
+   * If `streamBody` is `true` - DTO is serialized on demand, as the body is sent, by &id:oatpp::web::protocol::http::outgoing::DtoBody;.
    * @param status - &id:oatpp::web::protocol::http::Status;.
    * @param dto - see [Data Transfer Object (DTO)](https://oatpp.io/docs/components/dto/).
    * @param objectMapper - &id:oatpp::data::mapping::ObjectMapper;.
+   * @param streamBody - serialize DTO on demand and send it with the chunked transfer-encoding.
    * @return - `std::shared_ptr` to &id:oatpp::web::protocol::http::outgoing::Response;.
    */
   static std::shared_ptr<Response> createResponse(const Status& status,
                                                   const oatpp::Void& dto,
-                                                  const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper);
+                                                  const std::shared_ptr<data::mapping::ObjectMapper>& objectMapper,
+                                                  bool streamBody = false);
   
 };
   
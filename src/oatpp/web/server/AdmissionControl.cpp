@@ -0,0 +1,163 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AdmissionControl.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+namespace oatpp { namespace web { namespace server {
+
+AdmissionControl::AdmissionControl()
+  : AdmissionControl(Config())
+{}
+
+AdmissionControl::AdmissionControl(const Config& config)
+  : m_config(config)
+  , m_connections(0)
+  , m_inFlightRequests(0)
+  , m_queueLatency(0)
+  , m_lastSampleTime(0)
+  , m_admittedConnections(0)
+  , m_shedConnections(0)
+  , m_shedRequests(0)
+{
+  if(m_config.policy == Policy::RESPOND_503) {
+    const auto& status = protocol::http::Status::CODE_503;
+    data::stream::BufferOutputStream stream(256);
+    stream << "HTTP/1.1 " << status.code << " " << status.description << "\r\n"
+           << protocol::http::Header::SERVER << ": " << protocol::http::Header::Value::SERVER << "\r\n"
+           << protocol::http::Header::RETRY_AFTER << ": " << m_config.retryAfter << "\r\n"
+           << protocol::http::Header::CONTENT_LENGTH << ": 0\r\n"
+           << protocol::http::Header::CONNECTION << ": " << protocol::http::Header::Value::CONNECTION_CLOSE << "\r\n"
+           << "\r\n";
+    m_rejectMessage = stream.toString();
+  }
+}
+
+v_int64 AdmissionControl::now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool AdmissionControl::isOverloaded() const {
+  if(m_config.maxQueueLatency.count() <= 0 || m_queueLatency.load() <= m_config.maxQueueLatency.count()) {
+    return false;
+  }
+  return now() - m_lastSampleTime.load() < m_config.latencyWindow.count();
+}
+
+bool AdmissionControl::admitConnection() {
+
+  if(isOverloaded()) {
+    m_shedConnections ++;
+    return false;
+  }
+
+  auto connections = ++ m_connections;
+  if(m_config.maxConnections > 0 && connections > m_config.maxConnections) {
+    -- m_connections;
+    m_shedConnections ++;
+    return false;
+  }
+
+  m_admittedConnections ++;
+  return true;
+
+}
+
+void AdmissionControl::onConnectionEnd() {
+  -- m_connections;
+}
+
+bool AdmissionControl::admitRequest() {
+
+  if(isOverloaded()) {
+    m_shedRequests ++;
+    return false;
+  }
+
+  auto requests = ++ m_inFlightRequests;
+  if(m_config.maxInFlightRequests > 0 && requests > m_config.maxInFlightRequests) {
+    -- m_inFlightRequests;
+    m_shedRequests ++;
+    return false;
+  }
+
+  return true;
+
+}
+
+void AdmissionControl::onRequestEnd() {
+  -- m_inFlightRequests;
+}
+
+void AdmissionControl::addQueueLatencySample(const std::chrono::duration<v_int64, std::micro>& latency) {
+
+  auto sample = latency.count();
+  auto time = now();
+
+  /* stale estimate is replaced - not averaged */
+  bool stale = time - m_lastSampleTime.load() >= m_config.latencyWindow.count();
+
+  v_int64 current = m_queueLatency.load();
+  v_int64 next;
+  do {
+    next = stale ? sample : current + (sample - current) / 8;
+  } while(!m_queueLatency.compare_exchange_weak(current, next));
+
+  m_lastSampleTime.store(time);
+
+}
+
+std::shared_ptr<protocol::http::outgoing::Response> AdmissionControl::createRejectResponse() const {
+  if(m_config.policy != Policy::RESPOND_503) {
+    return nullptr;
+  }
+  auto response = protocol::http::outgoing::Response::createShared(protocol::http::Status::CODE_503, nullptr);
+  response->putHeader(protocol::http::Header::RETRY_AFTER, utils::Conversion::int32ToStr(m_config.retryAfter));
+  response->putHeader(protocol::http::Header::CONNECTION, protocol::http::Header::Value::CONNECTION_CLOSE);
+  return response;
+}
+
+oatpp::String AdmissionControl::getRejectMessage() const {
+  return m_rejectMessage;
+}
+
+const AdmissionControl::Config& AdmissionControl::getConfig() const {
+  return m_config;
+}
+
+AdmissionControl::Metrics AdmissionControl::getMetrics() const {
+  Metrics metrics;
+  metrics.connections = m_connections.load();
+  metrics.inFlightRequests = m_inFlightRequests.load();
+  metrics.queueLatency = m_queueLatency.load();
+  metrics.admittedConnections = m_admittedConnections.load();
+  metrics.shedConnections = m_shedConnections.load();
+  metrics.shedRequests = m_shedRequests.load();
+  return metrics;
+}
+
+}}}
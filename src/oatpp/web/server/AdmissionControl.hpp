@@ -0,0 +1,221 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_server_AdmissionControl_hpp
+#define oatpp_web_server_AdmissionControl_hpp
+
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace oatpp { namespace web { namespace server {
+
+/**
+ * Admission control and load shedding for &id:oatpp::web::server::AsyncHttpConnectionHandler;. <br>
+ * Limits the number of connections and in-flight requests and sheds load while the executor queue latency
+ * (time from connection submission to the start of its coroutine) stays above the threshold.
+ * Shed connections and requests either get a fast `503 Service Unavailable` with `Retry-After` or are closed right away. <br>
+ * Thread-safe.
+ */
+class AdmissionControl {
+public:
+
+  /**
+   * What to do with shed connections and requests.
+   */
+  enum class Policy : v_int32 {
+
+    /**
+     * Respond with `503 Service Unavailable` and `Retry-After`, then close the connection.
+     */
+    RESPOND_503 = 0,
+
+    /**
+     * Close the connection without a response.
+     */
+    CLOSE = 1
+
+  };
+
+  /**
+   * Admission control config. `0` - limit is disabled.
+   */
+  struct Config {
+
+    /**
+     * Max number of connections served at once.
+     */
+    v_int64 maxConnections = 0;
+
+    /**
+     * Max number of requests being processed at once - from the moment request headers are parsed until the response is sent.
+     */
+    v_int64 maxInFlightRequests = 0;
+
+    /**
+     * Shed new connections and requests while the average executor queue latency is above this value.
+     */
+    std::chrono::duration<v_int64, std::micro> maxQueueLatency = std::chrono::microseconds(0);
+
+    /**
+     * Queue latency estimate is trusted for this long after the last sample.
+     * With no fresh samples shedding by latency stops - new connections are admitted and probe the queue again.
+     */
+    std::chrono::duration<v_int64, std::micro> latencyWindow = std::chrono::seconds(1);
+
+    /**
+     * &l:AdmissionControl::Policy;.
+     */
+    Policy policy = Policy::RESPOND_503;
+
+    /**
+     * Value of the `Retry-After` header in seconds.
+     */
+    v_int32 retryAfter = 1;
+
+  };
+
+  /**
+   * Admission control metrics snapshot.
+   */
+  struct Metrics {
+
+    /**
+     * Number of connections served.
+     */
+    v_int64 connections;
+
+    /**
+     * Number of requests being processed.
+     */
+    v_int64 inFlightRequests;
+
+    /**
+     * Average executor queue latency in microseconds.
+     */
+    v_int64 queueLatency;
+
+    /**
+     * Total number of admitted connections.
+     */
+    v_int64 admittedConnections;
+
+    /**
+     * Total number of shed connections.
+     */
+    v_int64 shedConnections;
+
+    /**
+     * Total number of shed requests.
+     */
+    v_int64 shedRequests;
+
+  };
+
+private:
+  static v_int64 now();
+private:
+  bool isOverloaded() const;
+private:
+  Config m_config;
+  oatpp::String m_rejectMessage;
+  std::atomic<v_int64> m_connections;
+  std::atomic<v_int64> m_inFlightRequests;
+  std::atomic<v_int64> m_queueLatency;
+  std::atomic<v_int64> m_lastSampleTime;
+  std::atomic<v_int64> m_admittedConnections;
+  std::atomic<v_int64> m_shedConnections;
+  std::atomic<v_int64> m_shedRequests;
+public:
+
+  /**
+   * Constructor. Default config - no limits.
+   */
+  AdmissionControl();
+
+  /**
+   * Constructor.
+   * @param config - &l:AdmissionControl::Config;.
+   */
+  AdmissionControl(const Config& config);
+
+  /**
+   * Admit new connection. Admitted connection MUST be reported with &l:AdmissionControl::onConnectionEnd (); when done.
+   * @return - `true` if admitted. `false` if the connection should be shed.
+   */
+  bool admitConnection();
+
+  /**
+   * Report that admitted connection is done.
+   */
+  void onConnectionEnd();
+
+  /**
+   * Admit new request. Admitted request MUST be reported with &l:AdmissionControl::onRequestEnd (); when done.
+   * @return - `true` if admitted. `false` if the request should be shed.
+   */
+  bool admitRequest();
+
+  /**
+   * Report that admitted request is done.
+   */
+  void onRequestEnd();
+
+  /**
+   * Add queue latency sample. The estimate is an exponentially weighted moving average of samples.
+   * @param latency - time from task submission to the start of its coroutine.
+   */
+  void addQueueLatencySample(const std::chrono::duration<v_int64, std::micro>& latency);
+
+  /**
+   * Create response for shed requests.
+   * @return - `503` response with `Retry-After` and `Connection: close`. `nullptr` for &l:AdmissionControl::Policy::CLOSE;.
+   */
+  std::shared_ptr<protocol::http::outgoing::Response> createRejectResponse() const;
+
+  /**
+   * Serialized response for shed connections - written before the request is read.
+   * @return - raw `503` response message. `nullptr` for &l:AdmissionControl::Policy::CLOSE;.
+   */
+  oatpp::String getRejectMessage() const;
+
+  /**
+   * Get config.
+   * @return - &l:AdmissionControl::Config;.
+   */
+  const Config& getConfig() const;
+
+  /**
+   * Get metrics snapshot.
+   * @return - &l:AdmissionControl::Metrics;.
+   */
+  Metrics getMetrics() const;
+
+};
+
+}}}
+
+#endif // oatpp_web_server_AdmissionControl_hpp
@@ -28,8 +28,19 @@ namespace oatpp { namespace web { namespace server {
 
 void AsyncHttpConnectionHandler::onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) {
 
+  auto key = reinterpret_cast<v_uint64>(connection.object.get());
+
   std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
-  m_connections.insert({reinterpret_cast<v_uint64>(connection.object.get()), connection});
+  m_connections.insert({key, connection});
+
+  /* executor queue latency - from submission to the coroutine start */
+  auto it = m_admissions.find(key);
+  if(it != m_admissions.end() && !it->second.started) {
+    it->second.started = true;
+    it->second.control->addQueueLatencySample(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - it->second.submittedAt)
+    );
+  }
 
   if(!m_continue.load()) {
     connection.invalidator->invalidate(connection.object);
@@ -38,8 +49,102 @@ void AsyncHttpConnectionHandler::onTaskStart(const provider::ResourceHandle<data
 }
 
 void AsyncHttpConnectionHandler::onTaskEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) {
+
+  auto key = reinterpret_cast<v_uint64>(connection.object.get());
+  std::shared_ptr<AdmissionControl> admissionControl;
+
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+    auto it = m_admissions.find(key);
+    if(it != m_admissions.end()) {
+      admissionControl = it->second.control;
+      m_admissions.erase(it);
+      m_admissionsCount.store(m_admissions.size());
+    }
+    m_connections.erase(key);
+  }
+
+  if(admissionControl) {
+    admissionControl->onConnectionEnd();
+  }
+
+}
+
+bool AsyncHttpConnectionHandler::onRequestStart(const provider::ResourceHandle<data::stream::IOStream>& connection,
+                                                const std::shared_ptr<protocol::http::incoming::Request>& request,
+                                                std::shared_ptr<protocol::http::outgoing::Response>& response)
+{
+
+  (void) request;
+
+  /* no connection was admitted by admission control - nothing to track */
+  if(m_admissionsCount.load() == 0) {
+    return true;
+  }
+
+  auto key = reinterpret_cast<v_uint64>(connection.object.get());
+  std::shared_ptr<AdmissionControl> admissionControl;
+
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+    auto it = m_admissions.find(key);
+    if(it == m_admissions.end()) {
+      return true; // connection was accepted without admission control
+    }
+    admissionControl = it->second.control;
+  }
+
+  if(!admissionControl->admitRequest()) {
+    response = admissionControl->createRejectResponse();
+    return false;
+  }
+
   std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
-  m_connections.erase(reinterpret_cast<v_uint64>(connection.object.get()));
+  auto it = m_admissions.find(key);
+  if(it != m_admissions.end()) {
+    it->second.requestAdmitted = true;
+  }
+  return true;
+
+}
+
+void AsyncHttpConnectionHandler::onRequestEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) {
+
+  if(m_admissionsCount.load() == 0) {
+    return;
+  }
+
+  auto key = reinterpret_cast<v_uint64>(connection.object.get());
+  std::shared_ptr<AdmissionControl> admissionControl;
+
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+    auto it = m_admissions.find(key);
+    if(it == m_admissions.end() || !it->second.requestAdmitted) {
+      return;
+    }
+    it->second.requestAdmitted = false;
+    admissionControl = it->second.control;
+  }
+
+  admissionControl->onRequestEnd();
+
+}
+
+void AsyncHttpConnectionHandler::rejectConnection(const provider::ResourceHandle<IOStream>& connection,
+                                                  const std::shared_ptr<AdmissionControl>& admissionControl)
+{
+
+  auto message = admissionControl->getRejectMessage();
+  if(message) {
+    /* single non-blocking attempt - the acceptor is never blocked by a shed connection */
+    connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+    async::Action action;
+    connection.object->write(message->data(), static_cast<v_buff_size>(message->size()), action);
+  }
+
+  connection.invalidator->invalidate(connection.object);
+
 }
 
 void AsyncHttpConnectionHandler::invalidateAllConnections() {
@@ -55,11 +160,26 @@ v_uint64 AsyncHttpConnectionHandler::getConnectionsCount() {
   return m_connections.size();
 }
 
+AsyncHttpConnectionHandler::Metrics AsyncHttpConnectionHandler::getMetrics() {
+  Metrics metrics;
+  metrics.connections = static_cast<v_int64>(getConnectionsCount());
+  metrics.executorTasks = m_executor->getTasksCount();
+  metrics.processors = m_executor->getProcessorsStats();
+  auto admissionControl = getAdmissionControl();
+  if(admissionControl) {
+    metrics.admission = admissionControl->getMetrics();
+  } else {
+    metrics.admission = AdmissionControl::Metrics{0, 0, 0, 0, 0, 0};
+  }
+  return metrics;
+}
+
 AsyncHttpConnectionHandler::AsyncHttpConnectionHandler(const std::shared_ptr<HttpProcessor::Components>& components,
                                                        v_int32 threadCount)
   : m_executor(std::make_shared<oatpp::async::Executor>(threadCount))
   , m_components(components)
   , m_continue(true)
+  , m_admissionsCount(0)
 {
   m_executor->detach();
 }
@@ -69,6 +189,7 @@ AsyncHttpConnectionHandler::AsyncHttpConnectionHandler(const std::shared_ptr<Htt
   : m_executor(executor)
   , m_components(components)
   , m_continue(true)
+  , m_admissionsCount(0)
 {}
 
 std::shared_ptr<AsyncHttpConnectionHandler> AsyncHttpConnectionHandler::createShared(const std::shared_ptr<HttpRouter>& router, v_int32 threadCount){
@@ -102,6 +223,16 @@ void AsyncHttpConnectionHandler::addResponseInterceptor(const std::shared_ptr<in
   m_components->responseInterceptors.push_back(interceptor);
 }
 
+void AsyncHttpConnectionHandler::setAdmissionControl(const std::shared_ptr<AdmissionControl>& admissionControl) {
+  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+  m_admissionControl = admissionControl;
+}
+
+std::shared_ptr<AdmissionControl> AsyncHttpConnectionHandler::getAdmissionControl() const {
+  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+  return m_admissionControl;
+}
+
 void AsyncHttpConnectionHandler::handleConnection(const provider::ResourceHandle<IOStream>& connection,
                                                   const std::shared_ptr<const ParameterMap>& params)
 {
@@ -110,9 +241,21 @@ void AsyncHttpConnectionHandler::handleConnection(const provider::ResourceHandle
 
   if (m_continue.load()) {
 
+    auto admissionControl = getAdmissionControl();
+    if(admissionControl && !admissionControl->admitConnection()) {
+      rejectConnection(connection, admissionControl);
+      return;
+    }
+
     connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
     connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
 
+    if(admissionControl) {
+      std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+      m_admissions[reinterpret_cast<v_uint64>(connection.object.get())] = Admission{admissionControl, std::chrono::steady_clock::now(), false, false};
+      m_admissionsCount.store(m_admissions.size());
+    }
+
     m_executor->execute<HttpProcessor::Coroutine>(m_components, connection, this);
 
   }
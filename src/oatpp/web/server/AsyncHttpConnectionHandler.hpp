@@ -26,10 +26,12 @@
 #define oatpp_web_server_AsyncHttpConnectionHandler_hpp
 
 #include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/web/server/AdmissionControl.hpp"
 #include "oatpp/network/ConnectionHandler.hpp"
 #include "oatpp/async/Executor.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
 
+#include <chrono>
 #include <unordered_map>
 
 namespace oatpp { namespace web { namespace server {
@@ -38,19 +40,71 @@ namespace oatpp { namespace web { namespace server {
  * Asynchronous &id:oatpp::network::ConnectionHandler; for handling http communication.
  */
 class AsyncHttpConnectionHandler : public base::Countable, public network::ConnectionHandler, public HttpProcessor::TaskProcessingListener {
+public:
+
+  /**
+   * Connection handler metrics snapshot.
+   */
+  struct Metrics {
+
+    /**
+     * Number of connections served.
+     */
+    v_int64 connections;
+
+    /**
+     * Number of not finished executor tasks. See &id:oatpp::async::Executor::getTasksCount;.
+     */
+    v_int32 executorTasks;
+
+    /**
+     * Stats of executor processors. See &id:oatpp::async::Executor::getProcessorsStats;.
+     */
+    std::vector<oatpp::async::Processor::Stats> processors;
+
+    /**
+     * Admission control metrics. All zeros if admission control is not set.
+     */
+    AdmissionControl::Metrics admission;
+
+  };
+
 protected:
 
   void onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) override;
   void onTaskEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) override;
 
+  bool onRequestStart(const provider::ResourceHandle<data::stream::IOStream>& connection,
+                      const std::shared_ptr<protocol::http::incoming::Request>& request,
+                      std::shared_ptr<protocol::http::outgoing::Response>& response) override;
+  void onRequestEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) override;
+
   void invalidateAllConnections();
 
+private:
+
+  /*
+   * Admission of a connection. Holds the admission control the connection was admitted by,
+   * so that the connection and its requests are reported to the same instance even if admission control is replaced.
+   */
+  struct Admission {
+    std::shared_ptr<AdmissionControl> control;
+    std::chrono::steady_clock::time_point submittedAt;
+    bool started;
+    bool requestAdmitted;
+  };
+
+private:
+  void rejectConnection(const provider::ResourceHandle<IOStream>& connection, const std::shared_ptr<AdmissionControl>& admissionControl);
 private:
   std::shared_ptr<oatpp::async::Executor> m_executor;
   std::shared_ptr<HttpProcessor::Components> m_components;
+  std::shared_ptr<AdmissionControl> m_admissionControl;
   std::atomic_bool m_continue;
   std::unordered_map<v_uint64, provider::ResourceHandle<data::stream::IOStream>> m_connections;
-  oatpp::concurrency::SpinLock m_connectionsLock;
+  std::unordered_map<v_uint64, Admission> m_admissions;
+  std::atomic<v_uint64> m_admissionsCount; // size of m_admissions - lets requests skip the lock without admission control
+  mutable oatpp::concurrency::SpinLock m_connectionsLock;
 public:
 
   /**
@@ -139,6 +193,20 @@ public:
    */
   void addResponseInterceptor(const std::shared_ptr<interceptor::ResponseInterceptor>& interceptor);
 
+  /**
+   * Set admission control. Connections and requests over the limits are shed instead of being queued to the executor. <br>
+   * Thread-safe. Applies to connections accepted after the call - connections accepted before are neither counted nor limited,
+   * connections admitted by the previous admission control are reported to it until they are closed.
+   * @param admissionControl - &id:oatpp::web::server::AdmissionControl;. `nullptr` - admit everything.
+   */
+  void setAdmissionControl(const std::shared_ptr<AdmissionControl>& admissionControl);
+
+  /**
+   * Get admission control.
+   * @return - &id:oatpp::web::server::AdmissionControl;. `nullptr` if not set.
+   */
+  std::shared_ptr<AdmissionControl> getAdmissionControl() const;
+
   
   void handleConnection(const provider::ResourceHandle<IOStream>& connection,
                         const std::shared_ptr<const ParameterMap>& params) override;
@@ -153,6 +221,12 @@ public:
    * @return
    */
   v_uint64 getConnectionsCount();
+
+  /**
+   * Get metrics snapshot.
+   * @return - &l:AsyncHttpConnectionHandler::Metrics;.
+   */
+  Metrics getMetrics();
   
 };
   
@@ -27,6 +27,8 @@
 #include "oatpp/web/protocol/http/incoming/Request.hpp"
 #include "oatpp/web/protocol/http/Http.hpp"
 
+#include "oatpp/network/tcp/Connection.hpp"
+
 #include "oatpp/concurrency/Utils.hpp"
 
 #include "oatpp/data/buffer/IOBuffer.hpp"
@@ -71,10 +73,33 @@ HttpConnectionHandler::HttpConnectionHandler(const std::shared_ptr<HttpProcessor
   , m_continue(true)
 {}
 
+HttpConnectionHandler::HttpConnectionHandler(const std::shared_ptr<HttpProcessor::Components>& components,
+                                             const HttpWorkerPool::Config& poolConfig)
+  : m_components(components)
+  , m_workerPool(std::make_shared<HttpWorkerPool>(poolConfig))
+  , m_continue(true)
+{}
+
+HttpConnectionHandler::~HttpConnectionHandler() {
+  if(m_workerPool) {
+    stop();
+  }
+}
+
 std::shared_ptr<HttpConnectionHandler> HttpConnectionHandler::createShared(const std::shared_ptr<HttpRouter>& router){
   return std::make_shared<HttpConnectionHandler>(router);
 }
 
+std::shared_ptr<HttpConnectionHandler> HttpConnectionHandler::createShared(const std::shared_ptr<HttpRouter>& router,
+                                                                           const HttpWorkerPool::Config& poolConfig)
+{
+  return std::make_shared<HttpConnectionHandler>(router, poolConfig);
+}
+
+std::shared_ptr<HttpWorkerPool> HttpConnectionHandler::getWorkerPool() const {
+  return m_workerPool;
+}
+
 void HttpConnectionHandler::setErrorHandler(const std::shared_ptr<handler::ErrorHandler>& errorHandler){
   m_components->errorHandler = errorHandler;
   if(!m_components->errorHandler) {
@@ -101,6 +126,14 @@ void HttpConnectionHandler::handleConnection(const provider::ResourceHandle<data
     connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
     connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
 
+    if(m_workerPool) {
+      /* only plain tcp connections can be parked in the poller while idle */
+      auto tcpConnection = std::dynamic_pointer_cast<network::tcp::Connection>(connection.object);
+      v_io_handle handle = tcpConnection ? tcpConnection->getHandle() : INVALID_IO_HANDLE;
+      m_workerPool->submit(HttpProcessor::Task(m_components, connection, this), handle);
+      return;
+    }
+
     /* Create working thread */
     std::thread thread(&HttpProcessor::Task::run, std::move(HttpProcessor::Task(m_components, connection, this)));
 
@@ -130,6 +163,10 @@ void HttpConnectionHandler::stop() {
   while(getConnectionsCount() > 0) {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
   }
+
+  if(m_workerPool) {
+    m_workerPool->stop();
+  }
 }
 
 }}}
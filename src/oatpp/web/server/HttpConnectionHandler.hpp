@@ -26,6 +26,7 @@
 #define oatpp_web_server_HttpConnectionHandler_hpp
 
 #include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/web/server/HttpWorkerPool.hpp"
 #include "oatpp/network/ConnectionHandler.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
 
@@ -35,7 +36,8 @@ namespace oatpp { namespace web { namespace server {
 
 /**
  * Simple ConnectionHandler (&id:oatpp::network::ConnectionHandler;) for handling HTTP communication. <br>
- * Will create one thread per each connection to handle communication.
+ * Will create one thread per each connection to handle communication. <br>
+ * Or, if constructed with &id:oatpp::web::server::HttpWorkerPool::Config;, will serve connections with a fixed pool of worker threads.
  */
 class HttpConnectionHandler : public base::Countable, public network::ConnectionHandler, public HttpProcessor::TaskProcessingListener {
 protected:
@@ -47,6 +49,7 @@ protected:
 
 private:
   std::shared_ptr<HttpProcessor::Components> m_components;
+  std::shared_ptr<HttpWorkerPool> m_workerPool;
   std::atomic_bool m_continue;
   std::unordered_map<v_uint64, provider::ResourceHandle<data::stream::IOStream>> m_connections;
   oatpp::concurrency::SpinLock m_connectionsLock;
@@ -76,6 +79,29 @@ public:
     : HttpConnectionHandler(std::make_shared<HttpProcessor::Components>(router, config))
   {}
 
+  /**
+   * Constructor. Serve connections with a fixed pool of worker threads instead of one thread per connection.
+   * @param components - &id:oatpp::web::server::HttpProcessor::Components;.
+   * @param poolConfig - &id:oatpp::web::server::HttpWorkerPool::Config;.
+   */
+  HttpConnectionHandler(const std::shared_ptr<HttpProcessor::Components>& components,
+                        const HttpWorkerPool::Config& poolConfig);
+
+  /**
+   * Constructor. Serve connections with a fixed pool of worker threads instead of one thread per connection.
+   * @param router - &id:oatpp::web::server::HttpRouter; to route incoming requests.
+   * @param poolConfig - &id:oatpp::web::server::HttpWorkerPool::Config;.
+   */
+  HttpConnectionHandler(const std::shared_ptr<HttpRouter>& router,
+                        const HttpWorkerPool::Config& poolConfig)
+    : HttpConnectionHandler(std::make_shared<HttpProcessor::Components>(router), poolConfig)
+  {}
+
+  /**
+   * Virtual destructor. Stops the worker pool if any.
+   */
+  ~HttpConnectionHandler() override;
+
 public:
 
   /**
@@ -85,6 +111,15 @@ public:
    */
   static std::shared_ptr<HttpConnectionHandler> createShared(const std::shared_ptr<HttpRouter>& router);
 
+  /**
+   * Create shared HttpConnectionHandler serving connections with a fixed pool of worker threads.
+   * @param router - &id:oatpp::web::server::HttpRouter; to route incoming requests.
+   * @param poolConfig - &id:oatpp::web::server::HttpWorkerPool::Config;.
+   * @return - `std::shared_ptr` to HttpConnectionHandler.
+   */
+  static std::shared_ptr<HttpConnectionHandler> createShared(const std::shared_ptr<HttpRouter>& router,
+                                                             const HttpWorkerPool::Config& poolConfig);
+
   /**
    * Set root error handler for all requests coming through this Connection Handler.
    * All unhandled errors will be handled by this error handler.
@@ -123,6 +158,12 @@ public:
    * @return
    */
   v_uint64 getConnectionsCount();
+
+  /**
+   * Get worker pool.
+   * @return - &id:oatpp::web::server::HttpWorkerPool;. `nullptr` in thread-per-connection mode.
+   */
+  std::shared_ptr<HttpWorkerPool> getWorkerPool() const;
   
 };
   
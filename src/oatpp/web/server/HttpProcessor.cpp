@@ -27,9 +27,100 @@
 #include "oatpp/web/server/HttpServerError.hpp"
 #include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/data/buffer/BufferPool.hpp"
+#include "oatpp/utils/CharScan.hpp"
+
+#include <cstring>
 
 namespace oatpp { namespace web { namespace server {
 
+namespace {
+
+/*
+ * Client is pipelining - the headers section of the next request is already in the buffer.
+ */
+bool hasPipelinedRequest(data::stream::InputStreamBufferedProxy* inStream) {
+
+  /* Most requests fit the short peek - only look further when they don't */
+  constexpr v_buff_size SHORT_PEEK_SIZE = 256;
+  constexpr v_buff_size PEEK_SIZE = 4096;
+
+  auto available = inStream->availableToRead();
+  if(available < 4) {
+    return false;
+  }
+
+  v_char8 buffer[PEEK_SIZE];
+  async::Action action;
+  v_buff_size peekSize = available < SHORT_PEEK_SIZE ? available : SHORT_PEEK_SIZE;
+
+  while(true) {
+
+    auto size = inStream->peek(buffer, peekSize, action);
+    if(size <= 0) {
+      return false;
+    }
+
+    v_uint32 accumulator = 0;
+    if(utils::CharScan::findSectionEnd(buffer, size, accumulator) > 0) {
+      return true;
+    }
+
+    if(size < peekSize || peekSize == PEEK_SIZE || available <= peekSize) {
+      return false;
+    }
+    peekSize = available < PEEK_SIZE ? available : PEEK_SIZE;
+
+  }
+
+}
+
+/*
+ * Create buffered proxy over the connection with the buffer leased from the pool.
+ * `data` - bytes already read from the connection.
+ */
+std::shared_ptr<data::stream::InputStreamBufferedProxy> createInStream(const std::shared_ptr<data::stream::IOStream>& connection,
+                                                                       v_buff_size bufferSize,
+                                                                       const void* data,
+                                                                       v_io_size size)
+{
+  auto buffer = data::buffer::BufferPool::getBuffer(bufferSize);
+  if(size > 0) {
+    std::memcpy(&(*buffer)[0], data, static_cast<size_t>(size));
+  }
+  return data::stream::InputStreamBufferedProxy::createShared(connection, buffer, 0, size, size > 0);
+}
+
+/*
+ * Max size of the data read to the stack while the connection holds no buffers.
+ */
+constexpr v_buff_size IDLE_READ_SIZE = 4096;
+
+v_buff_size getIdleReadSize(v_buff_size inBufferSize) {
+  return inBufferSize < IDLE_READ_SIZE ? inBufferSize : IDLE_READ_SIZE;
+}
+
+/*
+ * Only responses of known limited size can be held in the pipeline buffer.
+ */
+bool canBufferResponse(const std::shared_ptr<protocol::http::outgoing::Response>& response,
+                       protocol::http::encoding::EncoderProvider* contentEncoderProvider,
+                       HttpProcessor::ConnectionState connectionState,
+                       v_buff_size maxSize)
+{
+  if(maxSize <= 0 || contentEncoderProvider != nullptr || connectionState == HttpProcessor::ConnectionState::DELEGATED) {
+    return false;
+  }
+  auto body = response->getBody();
+  if(!body) {
+    return true;
+  }
+  auto size = body->getKnownSize();
+  return size >= 0 && size <= maxSize;
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Components
 
@@ -76,12 +167,25 @@ HttpProcessor::ProcessingResources::ProcessingResources(const std::shared_ptr<Co
                                                         const provider::ResourceHandle<oatpp::data::stream::IOStream>& pConnection)
   : components(pComponents)
   , connection(pConnection)
-  , headersInBuffer(components->config->headersInBufferInitial)
-  , headersOutBuffer(components->config->headersOutBufferInitial)
-  , headersReader(&headersInBuffer, components->config->headersReaderChunkSize, components->config->headersReaderMaxSize)
-  , inStream(data::stream::InputStreamBufferedProxy::createShared(connection.object, std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0)))
+  , headersReader(nullptr)
 {}
 
+void HttpProcessor::ProcessingResources::acquireBuffers(const void* data, v_io_size size) {
+  const auto& config = components->config;
+  headersInBuffer = data::buffer::BufferPool::getOutputStream(config->headersInBufferInitial);
+  headersOutBuffer = data::buffer::BufferPool::getOutputStream(config->headersOutBufferInitial);
+  headersReader = RequestHeadersReader(headersInBuffer.get(), config->headersReaderChunkSize, config->headersReaderMaxSize);
+  inStream = createInStream(connection.object, config->inBufferSize, data, size);
+}
+
+void HttpProcessor::ProcessingResources::releaseBuffers() {
+  headersReader = RequestHeadersReader(nullptr);
+  headersInBuffer.reset();
+  headersOutBuffer.reset();
+  inStream.reset();
+  pipelineOutBuffer.reset();
+}
+
 std::shared_ptr<protocol::http::outgoing::Response>
 HttpProcessor::processNextRequest(ProcessingResources& resources,
                                   const std::shared_ptr<protocol::http::incoming::Request>& request,
@@ -108,7 +212,8 @@ HttpProcessor::processNextRequest(ProcessingResources& resources,
         ss << "No mapping for HTTP-method: '" << request->getStartingLine().method.toString()
            << "', URL: '" << request->getStartingLine().path.toString() << "'";
 
-        throw oatpp::web::protocol::http::HttpError(protocol::http::Status::CODE_404, ss.toString());
+        connectionState = ConnectionState::CLOSING;
+        return resources.components->errorHandler->handleServerError(request, protocol::http::Status::CODE_404, ss.toString());
       }
 
       request->setPathVariables(route.getMatchMap());
@@ -126,23 +231,84 @@ HttpProcessor::processNextRequest(ProcessingResources& resources,
 
 }
 
+v_io_size HttpProcessor::readRequestHeaders(ProcessingResources& resources,
+                                            RequestHeadersReader::Result& headersReadResult,
+                                            protocol::http::HttpError::Info& error,
+                                            bool readOnce,
+                                            bool canReadStream)
+{
+
+  const auto& config = resources.components->config;
+
+  if(config->releaseBuffersWhenIdle && resources.inStream && resources.inStream->availableToRead() == 0 &&
+     !resources.headersReader.isReadingHeaders() &&
+     !(resources.pipelineOutBuffer && resources.pipelineOutBuffer->getCurrentPosition() > 0))
+  {
+    resources.releaseBuffers();
+  }
+
+  if(!resources.inStream) {
+    if(readOnce && !canReadStream) {
+      return IOError::RETRY_READ;
+    }
+    if(config->releaseBuffersWhenIdle) {
+      /* wait for the next request without holding buffers */
+      v_char8 buffer[IDLE_READ_SIZE];
+      v_io_size res;
+      do {
+        res = resources.connection.object->readSimple(buffer, getIdleReadSize(config->inBufferSize));
+      } while(!readOnce && (res == IOError::RETRY_READ || res == IOError::RETRY_WRITE));
+      if(res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+        return IOError::RETRY_READ;
+      }
+      if(res <= 0) {
+        return res;
+      }
+      resources.acquireBuffers(buffer, res);
+      canReadStream = false;
+    } else {
+      resources.acquireBuffers(nullptr, 0);
+    }
+  }
+
+  if(readOnce) {
+    auto res = resources.headersReader.readHeadersSectionOnce(resources.inStream.get(), canReadStream);
+    if(res <= 0) {
+      return res;
+    }
+  }
+
+  headersReadResult = resources.headersReader.readHeaders(resources.inStream.get(), error);
+  return error.ioStatus;
+
+}
+
 HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResources& resources) {
 
+  RequestHeadersReader::Result headersReadResult;
   oatpp::web::protocol::http::HttpError::Info error;
-  auto headersReadResult = resources.headersReader.readHeaders(resources.inStream.get(), error);
 
-  if(error.ioStatus <= 0) {
+  if(readRequestHeaders(resources, headersReadResult, error, false, true) <= 0) {
     return ConnectionState::DEAD;
   }
 
+  return processRequest(resources, headersReadResult, error);
+
+}
+
+HttpProcessor::ConnectionState HttpProcessor::processRequest(ProcessingResources& resources,
+                                                             const RequestHeadersReader::Result& headersReadResult,
+                                                             const protocol::http::HttpError::Info& error)
+{
+
+  const auto& config = resources.components->config;
+
   ConnectionState connectionState = ConnectionState::ALIVE;
   std::shared_ptr<protocol::http::incoming::Request> request;
   std::shared_ptr<protocol::http::outgoing::Response> response;
 
   if(error.status.code != 0) {
-    HttpServerError httpError(nullptr, "Invalid Request Headers");
-    auto ePtr = std::make_exception_ptr(httpError);
-    response = resources.components->errorHandler->handleError(ePtr);
+    response = resources.components->errorHandler->handleServerError(nullptr, error.status, "Invalid Request Headers");
     connectionState = ConnectionState::CLOSING;
   } else {
 
@@ -160,7 +326,10 @@ HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResou
         for (auto &interceptor: resources.components->responseInterceptors) {
           response = interceptor->intercept(request, response);
           if (!response) {
-            throw protocol::http::HttpError(protocol::http::Status::CODE_500, "Response Interceptor returned an Invalid Response - 'null'");
+            response = resources.components->errorHandler->handleServerError(request, protocol::http::Status::CODE_500,
+                                                                             "Response Interceptor returned an Invalid Response - 'null'");
+            connectionState = ConnectionState::CLOSING;
+            break;
           }
         }
 
@@ -197,7 +366,33 @@ HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResou
   auto contentEncoderProvider =
     protocol::http::utils::CommunicationUtils::selectEncoder(request, resources.components->contentEncodingProviders);
 
-  response->send(resources.connection.object.get(), &resources.headersOutBuffer, contentEncoderProvider.get());
+  auto& pipelineBuffer = resources.pipelineOutBuffer;
+  auto pipelineMaxSize = config->pipelineOutBufferMaxSize;
+  bool hasBufferedResponses = pipelineBuffer && pipelineBuffer->getCurrentPosition() > 0;
+  bool pipelined = connectionState == ConnectionState::ALIVE && hasPipelinedRequest(resources.inStream.get());
+
+  if(canBufferResponse(response, contentEncoderProvider.get(), connectionState, pipelineMaxSize) &&
+     (pipelined || hasBufferedResponses))
+  {
+    /*
+     * Coalesce responses to pipelined requests - flush them together.
+     * The buffered response waits for the next handler to return - see Config::pipelineOutBufferMaxSize.
+     */
+    if(!pipelineBuffer) {
+      pipelineBuffer = data::buffer::BufferPool::getOutputStream(pipelineMaxSize);
+    }
+    response->send(pipelineBuffer.get(), resources.headersOutBuffer.get(), nullptr);
+    if(!pipelined || pipelineBuffer->getCurrentPosition() >= pipelineMaxSize) {
+      pipelineBuffer->flushToStream(resources.connection.object.get());
+      pipelineBuffer->setCurrentPosition(0);
+    }
+  } else {
+    if(hasBufferedResponses) {
+      pipelineBuffer->flushToStream(resources.connection.object.get());
+      pipelineBuffer->setCurrentPosition(0);
+    }
+    response->send(resources.connection.object.get(), resources.headersOutBuffer.get(), contentEncoderProvider.get());
+  }
 
   /* Delegate connection handling to another handler only after the response is sent to the client */
   if(connectionState == ConnectionState::DELEGATED) {
@@ -232,11 +427,13 @@ HttpProcessor::Task::Task(HttpProcessor::Task &&other)
   : m_components(std::move(other.m_components))
   , m_connection(std::move(other.m_connection))
   , m_taskListener(other.m_taskListener)
+  , m_resources(std::move(other.m_resources))
 {
   other.m_taskListener = nullptr;
 }
 
 HttpProcessor::Task::~Task() {
+  m_resources.reset();
   if (m_taskListener != nullptr) {
     m_taskListener->onTaskEnd(m_connection);
   }
@@ -246,6 +443,7 @@ HttpProcessor::Task &HttpProcessor::Task::operator=(HttpProcessor::Task &&other)
   m_components = std::move(other.m_components);
   m_connection = std::move(other.m_connection);
   m_taskListener = other.m_taskListener;
+  m_resources = std::move(other.m_resources);
   other.m_taskListener = nullptr;
   return *this;
 }
@@ -272,6 +470,52 @@ void HttpProcessor::Task::run(){
 
 }
 
+bool HttpProcessor::Task::runUntilIdle() {
+
+  if(!m_resources) {
+    m_connection.object->initContexts();
+    m_resources.reset(new ProcessingResources(m_components, m_connection));
+  }
+
+  ConnectionState connectionState;
+
+  /* the connection is known to be readable only once per call */
+  bool canReadStream = true;
+
+  try {
+
+    do {
+
+      RequestHeadersReader::Result headersReadResult;
+      oatpp::web::protocol::http::HttpError::Info error;
+
+      auto res = readRequestHeaders(*m_resources, headersReadResult, error, true, canReadStream);
+      canReadStream = false;
+
+      if(res == IOError::RETRY_READ) {
+        /* headers are not complete - wait for the rest without holding the thread */
+        return true;
+      }
+      if(res <= 0) {
+        return false;
+      }
+
+      connectionState = HttpProcessor::processRequest(*m_resources, headersReadResult, error);
+
+    } while (connectionState == ConnectionState::ALIVE && m_resources->inStream->availableToRead() > 0);
+
+  } catch (std::exception& e) {
+    OATPP_LOGe("[oatpp::web::server::HttpProcessor::Task::runUntilIdle()]", "Error. {}", e.what())
+    return false;
+  } catch (...) {
+    OATPP_LOGe("[oatpp::web::server::HttpProcessor::Task::runUntilIdle()]", "Error. Unknown error.")
+    return false;
+  }
+
+  return connectionState == ConnectionState::ALIVE;
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // HttpProcessor::Coroutine
 
@@ -280,18 +524,20 @@ HttpProcessor::Coroutine::Coroutine(const std::shared_ptr<Components>& component
                                     TaskProcessingListener* taskListener)
   : m_components(components)
   , m_connection(connection)
-  , m_headersInBuffer(components->config->headersInBufferInitial)
-  , m_headersReader(&m_headersInBuffer, components->config->headersReaderChunkSize, components->config->headersReaderMaxSize)
-  , m_headersOutBuffer(std::make_shared<oatpp::data::stream::BufferOutputStream>(components->config->headersOutBufferInitial))
-  , m_inStream(data::stream::InputStreamBufferedProxy::createShared(m_connection.object, std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0)))
+  , m_headersReader(nullptr)
   , m_connectionState(ConnectionState::ALIVE)
   , m_taskListener(taskListener)
   , m_shouldInterceptResponse(false)
+  , m_pipelined(false)
+  , m_requestStarted(false)
 {
   m_taskListener->onTaskStart(m_connection);
 }
 
 HttpProcessor::Coroutine::~Coroutine() {
+  if(m_requestStarted) {
+    m_taskListener->onRequestEnd(m_connection);
+  }
   m_taskListener->onTaskEnd(m_connection);
 }
 
@@ -299,7 +545,66 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::act() {
   return m_connection.object->initContextsAsync().next(yieldTo(&HttpProcessor::Coroutine::parseHeaders));
 }
 
+void HttpProcessor::Coroutine::acquireBuffers(const void* data, v_io_size size) {
+  const auto& config = m_components->config;
+  m_headersInBuffer = data::buffer::BufferPool::getOutputStream(config->headersInBufferInitial);
+  m_headersOutBuffer = data::buffer::BufferPool::getOutputStream(config->headersOutBufferInitial);
+  m_headersReader = RequestHeadersReader(m_headersInBuffer.get(), config->headersReaderChunkSize, config->headersReaderMaxSize);
+  m_inStream = createInStream(m_connection.object, config->inBufferSize, data, size);
+}
+
+void HttpProcessor::Coroutine::releaseBuffers() {
+  /* request and response may still reference the connection buffers */
+  m_currentRequest.reset();
+  m_currentResponse.reset();
+  m_headersReader = RequestHeadersReader(nullptr);
+  m_headersInBuffer.reset();
+  m_headersOutBuffer.reset();
+  m_inStream.reset();
+  m_pipelineOutBuffer.reset();
+}
+
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::waitForRequest() {
+
+  v_char8 buffer[IDLE_READ_SIZE];
+  async::Action action;
+  auto res = m_connection.object->read(buffer, getIdleReadSize(m_components->config->inBufferSize), action);
+
+  if(!action.isNone()) {
+    return action;
+  }
+
+  if(res > 0) {
+    acquireBuffers(buffer, res);
+    return yieldTo(&HttpProcessor::Coroutine::parseHeaders);
+  }
+
+  if(res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+    return repeat();
+  }
+
+  return finish();
+
+}
+
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::parseHeaders() {
+
+  const auto& config = m_components->config;
+
+  if(config->releaseBuffersWhenIdle && m_inStream && m_inStream->availableToRead() == 0 &&
+     !(m_pipelineOutBuffer && m_pipelineOutBuffer->getCurrentPosition() > 0))
+  {
+    releaseBuffers();
+  }
+
+  if(!m_inStream) {
+    if(config->releaseBuffersWhenIdle) {
+      /* wait for the next request without holding buffers */
+      return yieldTo(&HttpProcessor::Coroutine::waitForRequest);
+    }
+    acquireBuffers(nullptr, 0);
+  }
+
   m_shouldInterceptResponse = true;
   return m_headersReader.readHeadersAsync(m_inStream).callbackTo(&HttpProcessor::Coroutine::onHeadersParsed);
 }
@@ -312,6 +617,19 @@ oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHead
                                                                      m_inStream,
                                                                      m_components->bodyDecoder);
 
+  std::shared_ptr<protocol::http::outgoing::Response> rejectResponse;
+  if(!m_taskListener->onRequestStart(m_connection, m_currentRequest, rejectResponse)) {
+    if(!rejectResponse) {
+      return finish();
+    }
+    /* shed request - skip interceptors and close the connection after the response */
+    m_currentResponse = rejectResponse;
+    m_connectionState = ConnectionState::CLOSING;
+    m_shouldInterceptResponse = false;
+    return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
+  }
+  m_requestStarted = true;
+
   for(auto& interceptor : m_components->requestInterceptors) {
     m_currentResponse = interceptor->intercept(m_currentRequest);
     if(m_currentResponse) {
@@ -319,18 +637,16 @@ oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHead
     }
   }
 
-  m_currentRoute = m_components->router->getRoute(headersReadResult.startingLine.method.toString(), headersReadResult.startingLine.path.toString());
+  m_currentRoute = m_components->router->getRoute(headersReadResult.startingLine.method, headersReadResult.startingLine.path);
 
   if(!m_currentRoute) {
 
     data::stream::BufferOutputStream ss;
     ss << "No mapping for HTTP-method: '" << headersReadResult.startingLine.method.toString()
        << "', URL: '" << headersReadResult.startingLine.path.toString() << "'";
-    throw oatpp::web::protocol::http::HttpError(protocol::http::Status::CODE_404, ss.toString());
-//    auto eptr = std::make_exception_ptr(error);
-//    m_currentResponse = m_components->errorHandler->handleError(eptr);
-//    m_connectionState = ConnectionState::CLOSING;
-//    return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
+    m_currentResponse = m_components->errorHandler->handleServerError(m_currentRequest, protocol::http::Status::CODE_404, ss.toString());
+    m_connectionState = ConnectionState::CLOSING;
+    return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
   }
 
   m_currentRequest->setPathVariables(m_currentRoute.getMatchMap());
@@ -350,15 +666,20 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponse(const std:
   
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponseFormed() {
 
+  /* error response before the first request was read */
+  if(!m_inStream) {
+    acquireBuffers(nullptr, 0);
+  }
+
   if(m_shouldInterceptResponse) {
     m_shouldInterceptResponse = false;
     for (auto &interceptor: m_components->responseInterceptors) {
       m_currentResponse = interceptor->intercept(m_currentRequest, m_currentResponse);
       if (!m_currentResponse) {
-        throw oatpp::web::protocol::http::HttpError(protocol::http::Status::CODE_500,
-                                                    "Response Interceptor returned an Invalid Response - 'null'");
-        //auto eptr = std::make_exception_ptr(error);
-        //m_currentResponse = m_components->errorHandler->handleError(eptr);
+        m_currentResponse = m_components->errorHandler->handleServerError(m_currentRequest, protocol::http::Status::CODE_500,
+                                                                          "Response Interceptor returned an Invalid Response - 'null'");
+        m_connectionState = ConnectionState::CLOSING;
+        break;
       }
     }
   }
@@ -386,13 +707,55 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponseFormed() {
   auto contentEncoderProvider =
     protocol::http::utils::CommunicationUtils::selectEncoder(m_currentRequest, m_components->contentEncodingProviders);
 
+  auto pipelineMaxSize = m_components->config->pipelineOutBufferMaxSize;
+  bool hasBufferedResponses = m_pipelineOutBuffer && m_pipelineOutBuffer->getCurrentPosition() > 0;
+  m_pipelined = m_connectionState == ConnectionState::ALIVE && hasPipelinedRequest(m_inStream.get());
+
+  if(canBufferResponse(m_currentResponse, contentEncoderProvider.get(), m_connectionState, pipelineMaxSize) &&
+     (m_pipelined || hasBufferedResponses))
+  {
+    /*
+     * Coalesce responses to pipelined requests - flush them together.
+     * The buffered response waits for the next handler to return - see Config::pipelineOutBufferMaxSize.
+     */
+    if(!m_pipelineOutBuffer) {
+      m_pipelineOutBuffer = data::buffer::BufferPool::getOutputStream(pipelineMaxSize);
+    }
+    return protocol::http::outgoing::Response::sendAsync(m_currentResponse, m_pipelineOutBuffer, m_headersOutBuffer, nullptr)
+           .next(yieldTo(&HttpProcessor::Coroutine::onResponseBuffered));
+  }
+
+  if(hasBufferedResponses) {
+    return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_pipelineOutBuffer, m_connection.object)
+           .next(protocol::http::outgoing::Response::sendAsync(m_currentResponse, m_connection.object, m_headersOutBuffer, contentEncoderProvider))
+           .next(yieldTo(&HttpProcessor::Coroutine::onPipelineFlushed));
+  }
+
   return protocol::http::outgoing::Response::sendAsync(m_currentResponse, m_connection.object, m_headersOutBuffer, contentEncoderProvider)
          .next(yieldTo(&HttpProcessor::Coroutine::onRequestDone));
 
 }
+
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponseBuffered() {
+  if(!m_pipelined || m_pipelineOutBuffer->getCurrentPosition() >= m_components->config->pipelineOutBufferMaxSize) {
+    return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_pipelineOutBuffer, m_connection.object)
+           .next(yieldTo(&HttpProcessor::Coroutine::onPipelineFlushed));
+  }
+  return yieldTo(&HttpProcessor::Coroutine::onRequestDone);
+}
+
+HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onPipelineFlushed() {
+  m_pipelineOutBuffer->setCurrentPosition(0);
+  return yieldTo(&HttpProcessor::Coroutine::onRequestDone);
+}
   
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onRequestDone() {
 
+  if(m_requestStarted) {
+    m_requestStarted = false;
+    m_taskListener->onRequestEnd(m_connection);
+  }
+
   switch (m_connectionState) {
     case ConnectionState::ALIVE:
       return yieldTo(&HttpProcessor::Coroutine::parseHeaders);
@@ -453,6 +816,8 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::handleError(Error* er
       ePtr = std::current_exception();
       m_currentResponse = m_components->errorHandler->handleError(ePtr);
       if (m_currentResponse != nullptr) {
+        /* same as the simple API - the request body may be left partially read */
+        m_connectionState = ConnectionState::CLOSING;
         return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
       }
     }
@@ -40,6 +40,7 @@
 #include "oatpp/web/protocol/http/utils/CommunicationUtils.hpp"
 
 #include "oatpp/data/stream/StreamBufferedProxy.hpp"
+#include "oatpp/data/buffer/IOBuffer.hpp"
 #include "oatpp/async/Processor.hpp"
 
 namespace oatpp { namespace web { namespace server {
@@ -63,6 +64,11 @@ public:
    */
   struct Config {
 
+    /**
+     * Size of the buffer used to read data from the connection.
+     */
+    v_buff_size inBufferSize = data::buffer::IOBuffer::BUFFER_SIZE;
+
     /**
      * Buffer used to read headers in request. Initial size of the buffer.
      */
@@ -83,6 +89,23 @@ public:
      */
     v_buff_size headersReaderMaxSize = 4096;
 
+    /**
+     * Max amount of data held in the buffer where responses to pipelined requests are accumulated. <br>
+     * While the next complete request is already buffered, responses of known size are written to this buffer
+     * and are flushed to the connection together - once there are no more buffered requests or the buffer is full. <br>
+     * Responses with a body larger than this value are never buffered. `0` - disable response coalescing. <br>
+     * *Note:* a buffered response waits at least until the handler of the next pipelined request returns -
+     * a slow handler delays the responses buffered before it. Set `0` if pipelined requests may hit slow endpoints.
+     */
+    v_buff_size pipelineOutBufferMaxSize = 65536;
+
+    /**
+     * Return connection buffers to the &id:oatpp::data::buffer::BufferPool; while keep-alive connection waits for the next request. <br>
+     * Idle connection then holds no buffers - the first bytes of the next request are read to the stack
+     * and the buffers are leased again. Costs an extra copy of these bytes per request.
+     */
+    bool releaseBuffersWhenIdle = false;
+
   };
 
 public:
@@ -166,12 +189,19 @@ private:
     ProcessingResources(const std::shared_ptr<Components>& pComponents,
                         const provider::ResourceHandle<oatpp::data::stream::IOStream>& pConnection);
 
+    /*
+     * Lease buffers from the pool. `data` - beginning of the next request already read from the connection.
+     */
+    void acquireBuffers(const void* data, v_io_size size);
+    void releaseBuffers();
+
     std::shared_ptr<Components> components;
     provider::ResourceHandle<oatpp::data::stream::IOStream> connection;
-    oatpp::data::stream::BufferOutputStream headersInBuffer;
-    oatpp::data::stream::BufferOutputStream headersOutBuffer;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> headersInBuffer;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> headersOutBuffer;
     RequestHeadersReader headersReader;
     std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> inStream;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> pipelineOutBuffer;
 
   };
 
@@ -180,6 +210,19 @@ private:
   processNextRequest(ProcessingResources& resources,
                      const std::shared_ptr<protocol::http::incoming::Request>& request,
                      ConnectionState& connectionState);
+
+  /*
+   * Acquire buffers and read request headers. `readOnce` - make at most one read from the connection
+   * (none if `canReadStream` is `false`), return `IOError::RETRY_READ` if headers are not complete yet.
+   */
+  static v_io_size readRequestHeaders(ProcessingResources& resources,
+                                      RequestHeadersReader::Result& headersReadResult,
+                                      protocol::http::HttpError::Info& error,
+                                      bool readOnce,
+                                      bool canReadStream);
+  static ConnectionState processRequest(ProcessingResources& resources,
+                                        const RequestHeadersReader::Result& headersReadResult,
+                                        const protocol::http::HttpError::Info& error);
   static ConnectionState processNextRequest(ProcessingResources& resources);
 
 public:
@@ -191,6 +234,34 @@ public:
   public:
     virtual void onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) = 0;
     virtual void onTaskEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) = 0;
+
+    /**
+     * Called by &l:HttpProcessor::Coroutine; when request headers are parsed - before interceptors and routing. <br>
+     * Default implementation admits all requests.
+     * @param connection - connection the request was received on.
+     * @param request - &id:oatpp::web::protocol::http::incoming::Request;.
+     * @param response - [out] response to send instead of processing the rejected request. The connection is closed after it.
+     * If not set, the connection of the rejected request is closed right away.
+     * @return - `true` to process the request. `false` to reject it.
+     */
+    virtual bool onRequestStart(const provider::ResourceHandle<data::stream::IOStream>& connection,
+                                const std::shared_ptr<protocol::http::incoming::Request>& request,
+                                std::shared_ptr<protocol::http::outgoing::Response>& response)
+    {
+      (void) connection;
+      (void) request;
+      (void) response;
+      return true;
+    }
+
+    /**
+     * Called by &l:HttpProcessor::Coroutine; when the admitted request is done - the response is sent or the connection is dropped.
+     * @param connection - connection the request was received on.
+     */
+    virtual void onRequestEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) {
+      (void) connection;
+    }
+
   };
 
 public:
@@ -205,6 +276,7 @@ public:
     std::shared_ptr<Components> m_components;
     provider::ResourceHandle<oatpp::data::stream::IOStream> m_connection;
     TaskProcessingListener* m_taskListener;
+    std::unique_ptr<ProcessingResources> m_resources;
   public:
 
     /**
@@ -243,6 +315,15 @@ public:
      */
     void run();
 
+    /**
+     * Serve requests until the connection gets idle - the next request is not buffered yet. <br>
+     * Used by worker pools to wait for the connection to become readable without holding a thread.
+     * Request headers are read with at most one read from the connection per call - partially received headers
+     * don't keep the thread waiting for the rest. Processing resources are kept between the calls.
+     * @return - `true` if connection is alive and waiting for the next request. `false` if the task is done.
+     */
+    bool runUntilIdle();
+
   };
   
 public:
@@ -254,10 +335,11 @@ public:
   private:
     std::shared_ptr<Components> m_components;
     provider::ResourceHandle<oatpp::data::stream::IOStream> m_connection;
-    oatpp::data::stream::BufferOutputStream m_headersInBuffer;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersInBuffer;
     RequestHeadersReader m_headersReader;
     std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersOutBuffer;
     std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> m_inStream;
+    std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_pipelineOutBuffer;
     ConnectionState m_connectionState;
   private:
     oatpp::web::server::HttpRouter::BranchRouter::Route m_currentRoute;
@@ -266,6 +348,14 @@ public:
     TaskProcessingListener* m_taskListener;
   private:
     bool m_shouldInterceptResponse;
+    bool m_pipelined;
+    bool m_requestStarted;
+  private:
+    void acquireBuffers(const void* data, v_io_size size);
+    void releaseBuffers();
+    Action waitForRequest();
+    Action onResponseBuffered();
+    Action onPipelineFlushed();
   public:
 
     /**
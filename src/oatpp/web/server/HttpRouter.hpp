@@ -101,7 +101,7 @@ public:
   typename BranchRouter::Route getRoute(const StringKeyLabel& method, const StringKeyLabel& path){
     auto it = m_branchMap.find(method);
     if(it != m_branchMap.end()) {
-      return m_branchMap[method]->getRoute(path);
+      return it->second->getRoute(path);
     }
     return typename BranchRouter::Route();
   }
@@ -0,0 +1,397 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HttpWorkerPool.hpp"
+
+#include "oatpp/concurrency/Utils.hpp"
+#include "oatpp/base/Log.hpp"
+
+#if defined(__linux__)
+  #include <unistd.h>
+  #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+  #include <cstring>
+  #include <cerrno>
+#endif
+
+namespace oatpp { namespace web { namespace server {
+
+HttpWorkerPool::HttpWorkerPool(const Config& config)
+  : m_config(config)
+  , m_running(true)
+  , m_connections(0)
+  , m_maxQueueDepth(0)
+  , m_parkedConnections(0)
+  , m_busyWorkers(0)
+  , m_backpressureWaits(0)
+  , m_pollerHandle(INVALID_IO_HANDLE)
+  , m_wakeupTrigger(INVALID_IO_HANDLE)
+{
+
+  if(m_config.workersCount < 1) {
+    throw std::runtime_error("[oatpp::web::server::HttpWorkerPool::HttpWorkerPool()]: Error. Invalid workersCount.");
+  }
+
+  initPoller();
+
+  if(isParkingSupported()) {
+    m_poller = std::thread(&HttpWorkerPool::pollerLoop, this);
+  }
+
+  /* Get hardware concurrency -1 in order to have 1cpu free of workers. */
+  v_int32 concurrency = oatpp::concurrency::Utils::getHardwareConcurrency();
+  if (concurrency > 1) {
+    concurrency -= 1;
+  }
+
+  m_workers.reserve(static_cast<size_t>(m_config.workersCount));
+  for(v_int32 i = 0; i < m_config.workersCount; i ++) {
+    m_workers.emplace_back(&HttpWorkerPool::workerLoop, this);
+    /* Set thread affinity group CPUs [0..cpu_count - 1]. Leave one cpu free of workers */
+    oatpp::concurrency::Utils::setThreadAffinityToCpuRange(m_workers.back().native_handle(),
+                                                           0,
+                                                           concurrency - 1 /* -1 because 0-based index */);
+  }
+
+}
+
+HttpWorkerPool::~HttpWorkerPool() {
+  stop();
+}
+
+void HttpWorkerPool::workerLoop() {
+
+  while(true) {
+
+    Entry* entry = popEntry();
+    if(entry == nullptr) {
+      break;
+    }
+
+    ++ m_busyWorkers;
+
+    bool alive = entry->task.runUntilIdle();
+    while(alive && !park(entry)) {
+      /* connection can't be parked - keep serving it in this worker */
+      alive = entry->task.runUntilIdle();
+    }
+
+    -- m_busyWorkers;
+
+    /* if parked - entry belongs to the poller now, don't touch it */
+    if(!alive) {
+      release(entry);
+    }
+
+  }
+
+}
+
+void HttpWorkerPool::pushEntry(Entry* entry) {
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_queue.push_back(entry);
+    auto depth = static_cast<v_int64>(m_queue.size());
+    if(depth > m_maxQueueDepth.load(std::memory_order_relaxed)) {
+      m_maxQueueDepth.store(depth, std::memory_order_relaxed);
+    }
+  }
+  m_queueCondition.notify_one();
+}
+
+HttpWorkerPool::Entry* HttpWorkerPool::popEntry() {
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  m_queueCondition.wait(lock, [this]{
+    return !m_queue.empty() || !m_running;
+  });
+  if(m_queue.empty()) {
+    return nullptr;
+  }
+  auto entry = m_queue.front();
+  m_queue.pop_front();
+  return entry;
+}
+
+void HttpWorkerPool::release(Entry* entry) {
+
+#if defined(__linux__)
+  if(entry->registered) {
+    ::epoll_ctl(m_pollerHandle, EPOLL_CTL_DEL, entry->handle, nullptr);
+  }
+#endif
+
+  {
+    std::lock_guard<std::mutex> lock(m_capacityMutex);
+    m_entries.erase(entry);
+  }
+
+  delete entry;
+
+  {
+    std::lock_guard<std::mutex> lock(m_capacityMutex);
+    -- m_connections;
+  }
+  m_capacityCondition.notify_one();
+
+}
+
+bool HttpWorkerPool::submit(HttpProcessor::Task&& task, v_io_handle handle) {
+
+  Entry* entry;
+
+  {
+    std::unique_lock<std::mutex> lock(m_capacityMutex);
+    if(m_running && m_connections.load() >= m_config.maxConnections) {
+      ++ m_backpressureWaits;
+      m_capacityCondition.wait(lock, [this]{
+        return !m_running || m_connections.load() < m_config.maxConnections;
+      });
+    }
+    if(!m_running) {
+      return false;
+    }
+    ++ m_connections;
+    entry = new Entry(std::move(task), handle);
+    m_entries.insert(entry);
+  }
+
+  /* wait for the first request without holding a worker */
+  if(!park(entry)) {
+    pushEntry(entry);
+  }
+
+  return true;
+
+}
+
+void HttpWorkerPool::stop() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_capacityMutex);
+    m_running = false;
+  }
+  m_capacityCondition.notify_all();
+
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+  }
+  m_queueCondition.notify_all();
+
+  wakeupPoller();
+
+  for(auto& worker : m_workers) {
+    if(worker.joinable()) {
+      worker.join();
+    }
+  }
+
+  if(m_poller.joinable()) {
+    m_poller.join();
+  }
+
+  /* workers have drained the queue - release idle connections parked in the poller */
+  std::vector<Entry*> entries;
+  {
+    std::lock_guard<std::mutex> lock(m_capacityMutex);
+    entries.assign(m_entries.begin(), m_entries.end());
+  }
+  m_queue.clear();
+  m_parkedConnections = 0;
+
+  for(auto entry : entries) {
+    release(entry);
+  }
+
+  closePoller();
+
+}
+
+HttpWorkerPool::Metrics HttpWorkerPool::getMetrics() {
+
+  Metrics metrics;
+
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    metrics.queueDepth = static_cast<v_int64>(m_queue.size());
+  }
+
+  metrics.connections = m_connections.load();
+  metrics.maxQueueDepth = m_maxQueueDepth.load();
+  metrics.parkedConnections = m_parkedConnections.load();
+  metrics.busyWorkers = m_busyWorkers.load();
+  metrics.backpressureWaits = m_backpressureWaits.load();
+
+  return metrics;
+
+}
+
+#if defined(__linux__)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// epoll based poller
+
+bool HttpWorkerPool::isParkingSupported() {
+  return true;
+}
+
+void HttpWorkerPool::initPoller() {
+
+  m_pollerHandle = ::epoll_create1(EPOLL_CLOEXEC);
+  if(m_pollerHandle == -1) {
+    OATPP_LOGe("[oatpp::web::server::HttpWorkerPool::initPoller()]", "Error. Call to ::epoll_create1() failed. errno={}", errno)
+    throw std::runtime_error("[oatpp::web::server::HttpWorkerPool::initPoller()]: Error. Call to ::epoll_create1() failed.");
+  }
+
+  m_wakeupTrigger = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if(m_wakeupTrigger == -1) {
+    OATPP_LOGe("[oatpp::web::server::HttpWorkerPool::initPoller()]", "Error. Call to ::eventfd() failed. errno={}", errno)
+    closePoller();
+    throw std::runtime_error("[oatpp::web::server::HttpWorkerPool::initPoller()]: Error. Call to ::eventfd() failed.");
+  }
+
+  epoll_event event;
+  std::memset(&event, 0, sizeof(epoll_event));
+  event.data.ptr = this;
+  event.events = EPOLLIN;
+
+  if(::epoll_ctl(m_pollerHandle, EPOLL_CTL_ADD, m_wakeupTrigger, &event) == -1) {
+    OATPP_LOGe("[oatpp::web::server::HttpWorkerPool::initPoller()]", "Error. Call to ::epoll_ctl() failed. errno={}", errno)
+    closePoller();
+    throw std::runtime_error("[oatpp::web::server::HttpWorkerPool::initPoller()]: Error. Call to ::epoll_ctl() failed.");
+  }
+
+}
+
+void HttpWorkerPool::wakeupPoller() {
+  if(m_wakeupTrigger != INVALID_IO_HANDLE) {
+    eventfd_write(m_wakeupTrigger, 1);
+  }
+}
+
+void HttpWorkerPool::closePoller() {
+  if(m_wakeupTrigger != INVALID_IO_HANDLE) {
+    ::close(m_wakeupTrigger);
+    m_wakeupTrigger = INVALID_IO_HANDLE;
+  }
+  if(m_pollerHandle != INVALID_IO_HANDLE) {
+    ::close(m_pollerHandle);
+    m_pollerHandle = INVALID_IO_HANDLE;
+  }
+}
+
+bool HttpWorkerPool::park(Entry* entry) {
+
+  if(entry->handle == INVALID_IO_HANDLE) {
+    return false;
+  }
+
+  epoll_event event;
+  std::memset(&event, 0, sizeof(epoll_event));
+  event.data.ptr = entry;
+  event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+
+  /* entry may be picked up by another worker as soon as it's armed - update it before epoll_ctl */
+  bool wasRegistered = entry->registered;
+  entry->registered = true;
+  ++ m_parkedConnections;
+
+  if(::epoll_ctl(m_pollerHandle, wasRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, entry->handle, &event) == -1) {
+    -- m_parkedConnections;
+    entry->registered = wasRegistered;
+    return false;
+  }
+
+  return true;
+
+}
+
+void HttpWorkerPool::pollerLoop() {
+
+  static constexpr v_int32 MAX_EVENTS = 256;
+  epoll_event events[MAX_EVENTS];
+
+  while(m_running) {
+
+    auto eventsCount = ::epoll_wait(m_pollerHandle, events, MAX_EVENTS, -1);
+
+    if(eventsCount < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      OATPP_LOGe("[oatpp::web::server::HttpWorkerPool::pollerLoop()]", "Error. Call to ::epoll_wait() failed. errno={}", errno)
+      break;
+    }
+
+    for(v_int32 i = 0; i < eventsCount; i ++) {
+
+      void* dataPtr = events[i].data.ptr;
+
+      if(dataPtr == this) {
+        eventfd_t value;
+        eventfd_read(m_wakeupTrigger, &value);
+      } else {
+        -- m_parkedConnections;
+        pushEntry(static_cast<Entry*>(dataPtr));
+      }
+
+    }
+
+  }
+
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// no poller - connections stay with their workers
+
+bool HttpWorkerPool::isParkingSupported() {
+  return false;
+}
+
+void HttpWorkerPool::initPoller() {
+  // DO NOTHING
+}
+
+void HttpWorkerPool::wakeupPoller() {
+  // DO NOTHING
+}
+
+void HttpWorkerPool::closePoller() {
+  // DO NOTHING
+}
+
+bool HttpWorkerPool::park(Entry* entry) {
+  (void) entry;
+  return false;
+}
+
+void HttpWorkerPool::pollerLoop() {
+  // DO NOTHING
+}
+
+#endif
+
+}}}
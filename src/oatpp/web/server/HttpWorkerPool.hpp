@@ -0,0 +1,208 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_server_HttpWorkerPool_hpp
+#define oatpp_web_server_HttpWorkerPool_hpp
+
+#include "oatpp/web/server/HttpProcessor.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace oatpp { namespace web { namespace server {
+
+/**
+ * Fixed set of worker threads serving &id:oatpp::web::server::HttpProcessor::Task;s pulled from a queue. <br>
+ * Between requests idle keep-alive connections are parked in the poller (epoll) and put back to the queue
+ * once readable - so idle connections don't pin worker threads. <br>
+ * Connections which can't be parked (not a &id:oatpp::network::tcp::Connection;, or no epoll on the platform)
+ * stay with their worker until done.
+ */
+class HttpWorkerPool {
+public:
+
+  /**
+   * Worker pool config.
+   */
+  struct Config {
+
+    /**
+     * Number of worker threads.
+     */
+    v_int32 workersCount = 4;
+
+    /**
+     * Maximum number of connections served by the pool at once. <br>
+     * When limit is reached &l:HttpWorkerPool::submit (); blocks until one of the connections is done -
+     * backpressure is propagated to the acceptor and to the listen backlog.
+     */
+    v_int64 maxConnections = 10000;
+
+  };
+
+  /**
+   * Worker pool metrics snapshot.
+   */
+  struct Metrics {
+
+    /**
+     * Number of connections served by the pool.
+     */
+    v_int64 connections;
+
+    /**
+     * Number of ready tasks waiting in the queue for a free worker.
+     */
+    v_int64 queueDepth;
+
+    /**
+     * Maximum observed queue depth.
+     */
+    v_int64 maxQueueDepth;
+
+    /**
+     * Number of idle connections parked in the poller.
+     */
+    v_int64 parkedConnections;
+
+    /**
+     * Number of workers busy with a task.
+     */
+    v_int64 busyWorkers;
+
+    /**
+     * How many times &l:HttpWorkerPool::submit (); had to wait because of the &l:HttpWorkerPool::Config::maxConnections; limit.
+     */
+    v_int64 backpressureWaits;
+
+  };
+
+private:
+
+  struct Entry {
+
+    Entry(HttpProcessor::Task&& pTask, v_io_handle pHandle)
+      : task(std::move(pTask))
+      , handle(pHandle)
+      , registered(false)
+    {}
+
+    HttpProcessor::Task task;
+    v_io_handle handle;
+    bool registered;
+
+  };
+
+private:
+
+  void workerLoop();
+  void pollerLoop();
+
+  void pushEntry(Entry* entry);
+  Entry* popEntry();
+  bool park(Entry* entry);
+  void release(Entry* entry);
+
+  void initPoller();
+  void wakeupPoller();
+  void closePoller();
+
+private:
+  Config m_config;
+  std::atomic<bool> m_running;
+
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  std::deque<Entry*> m_queue;
+
+  std::mutex m_capacityMutex;
+  std::condition_variable m_capacityCondition;
+
+  /* all entries of the pool - queued, served, and parked. Guarded by m_capacityMutex */
+  std::unordered_set<Entry*> m_entries;
+
+  std::atomic<v_int64> m_connections;
+  std::atomic<v_int64> m_maxQueueDepth;
+  std::atomic<v_int64> m_parkedConnections;
+  std::atomic<v_int64> m_busyWorkers;
+  std::atomic<v_int64> m_backpressureWaits;
+
+  v_io_handle m_pollerHandle;
+  v_io_handle m_wakeupTrigger;
+
+  std::vector<std::thread> m_workers;
+  std::thread m_poller;
+public:
+
+  /**
+   * Constructor. Starts worker threads and the poller.
+   * @param config - &l:HttpWorkerPool::Config;.
+   */
+  HttpWorkerPool(const Config& config);
+
+  /**
+   * Non-virtual destructor. Calls &l:HttpWorkerPool::stop ();.
+   */
+  ~HttpWorkerPool();
+
+  /**
+   * Submit connection serving task. <br>
+   * Blocks while the pool is at the &l:HttpWorkerPool::Config::maxConnections; limit.
+   * @param task - &id:oatpp::web::server::HttpProcessor::Task;.
+   * @param handle - handle to wait for readability on while the connection is idle.
+   * Pass `INVALID_IO_HANDLE` if the connection can't be parked.
+   * @return - `true` if task was accepted. `false` if pool is stopped - task is destroyed in this case.
+   */
+  bool submit(HttpProcessor::Task&& task, v_io_handle handle);
+
+  /**
+   * Stop worker threads and the poller and wait for them to exit. <br>
+   * Workers finish their current tasks and serve the connections still in the queue before they exit. <br>
+   * Idle connections parked in the poller are released - their tasks are destroyed without serving the next request.
+   */
+  void stop();
+
+  /**
+   * Get metrics snapshot.
+   * @return - &l:HttpWorkerPool::Metrics;.
+   */
+  Metrics getMetrics();
+
+  /**
+   * Check if idle connections can be parked on this platform.
+   * @return
+   */
+  static bool isParkingSupported();
+
+};
+
+}}}
+
+#endif // oatpp_web_server_HttpWorkerPool_hpp
@@ -89,6 +89,14 @@ const std::shared_ptr<mime::ContentMappers>& ApiController::getContentMappers()
   return m_contentMappers;
 }
 
+void ApiController::setStreamDtoResponses(bool streamDtoResponses) {
+  m_streamDtoResponses = streamDtoResponses;
+}
+
+bool ApiController::getStreamDtoResponses() const {
+  return m_streamDtoResponses;
+}
+
 // Helper methods
 
 std::shared_ptr<ApiController::OutgoingResponse> ApiController::createResponse(const Status& status, const oatpp::String& str) const {
@@ -102,11 +110,11 @@ std::shared_ptr<ApiController::OutgoingResponse> ApiController::createResponse(c
 std::shared_ptr<ApiController::OutgoingResponse> ApiController::createDtoResponse(const Status& status,
                                                                                   const oatpp::Void& dto,
                                                                                   const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper) const {
-  return ResponseFactory::createResponse(status, dto, objectMapper);
+  return ResponseFactory::createResponse(status, dto, objectMapper, m_streamDtoResponses);
 }
 
 std::shared_ptr<ApiController::OutgoingResponse> ApiController::createDtoResponse(const Status& status, const oatpp::Void& dto) const {
-  return ResponseFactory::createResponse(status, dto, m_contentMappers->getDefaultMapper());
+  return ResponseFactory::createResponse(status, dto, m_contentMappers->getDefaultMapper(), m_streamDtoResponses);
 }
 
 std::shared_ptr<ApiController::OutgoingResponse> ApiController::createDtoResponse(const Status& status,
@@ -115,7 +123,7 @@ std::shared_ptr<ApiController::OutgoingResponse> ApiController::createDtoRespons
 {
   auto mapper = m_contentMappers->selectMapper(acceptableContentTypes);
   if(mapper) {
-    return ResponseFactory::createResponse(status, dto, mapper);
+    return ResponseFactory::createResponse(status, dto, mapper, m_streamDtoResponses);
   }
   throw std::runtime_error("[ApiController::createDtoResponse()]: Unsupported content-type");
 }
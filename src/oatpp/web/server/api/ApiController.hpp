@@ -379,6 +379,7 @@ protected:
   std::shared_ptr<handler::ErrorHandler> m_errorHandler;
   std::shared_ptr<handler::AuthorizationHandler> m_defaultAuthorizationHandler;
   std::shared_ptr<mime::ContentMappers> m_contentMappers;
+  bool m_streamDtoResponses;
   std::unordered_map<std::string, std::shared_ptr<Endpoint::Info>> m_endpointInfo;
   std::unordered_map<std::string, std::shared_ptr<RequestHandler>> m_endpointHandlers;
   const oatpp::String m_routerPrefix;
@@ -386,6 +387,7 @@ public:
 
   ApiController(const std::shared_ptr<mime::ContentMappers>& contentMappers, const oatpp::String &routerPrefix = nullptr)
     : m_contentMappers(contentMappers)
+    , m_streamDtoResponses(false)
     , m_routerPrefix(routerPrefix)
   {
 
@@ -393,6 +395,7 @@ public:
 
   ApiController(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& defaultObjectMapper, const oatpp::String &routerPrefix = nullptr)
     : m_contentMappers(std::make_shared<mime::ContentMappers>())
+    , m_streamDtoResponses(false)
     , m_routerPrefix(routerPrefix)
   {
     m_contentMappers->setDefaultMapper(defaultObjectMapper);
@@ -451,6 +454,21 @@ public:
    * @return
    */
   const std::shared_ptr<mime::ContentMappers>& getContentMappers() const;
+
+  /**
+   * Stream DTO responses created by `createDtoResponse` - serialize DTO on demand as the body is sent
+   * (see &id:oatpp::web::protocol::http::outgoing::DtoBody;) instead of serializing it to a buffer upfront. <br>
+   * Memory is bounded by the transfer buffer size, but the body is sent with the chunked transfer-encoding and
+   * a serialization error can't be reported with an error response - the connection is dropped instead. Default - `false`.
+   * @param streamDtoResponses
+   */
+  void setStreamDtoResponses(bool streamDtoResponses);
+
+  /**
+   * Check if DTO responses are streamed. See &l:ApiController::setStreamDtoResponses ();.
+   * @return
+   */
+  bool getStreamDtoResponses() const;
   
   // Helper methods
   
@@ -28,6 +28,22 @@
 
 namespace oatpp { namespace web { namespace server { namespace handler {
 
+std::shared_ptr<protocol::http::outgoing::Response>
+ErrorHandler::handleServerError(const std::shared_ptr<protocol::http::incoming::Request>& request,
+                                const protocol::http::Status& status,
+                                const oatpp::String& message)
+{
+  try {
+    try {
+      throw protocol::http::HttpError(status, message);
+    } catch (...) {
+      std::throw_with_nested(HttpServerError(request, "Error processing request"));
+    }
+  } catch (...) {
+    return handleError(std::current_exception());
+  }
+}
+
 void DefaultErrorHandler::unwrapErrorStack(HttpServerErrorStacktrace& stacktrace, const std::exception& e) {
 
   stacktrace.stack.emplace_front(e.what());
@@ -69,6 +85,22 @@ std::shared_ptr<protocol::http::outgoing::Response> DefaultErrorHandler::handleE
 
 }
 
+std::shared_ptr<protocol::http::outgoing::Response>
+DefaultErrorHandler::handleServerError(const std::shared_ptr<protocol::http::incoming::Request>& request,
+                                       const protocol::http::Status& status,
+                                       const oatpp::String& message)
+{
+
+  HttpServerErrorStacktrace stacktrace;
+  stacktrace.request = request;
+  stacktrace.status = status;
+  stacktrace.stack.emplace_back(message);
+  stacktrace.stack.emplace_back("Error processing request");
+
+  return renderError(stacktrace);
+
+}
+
 std::shared_ptr<protocol::http::outgoing::Response> DefaultErrorHandler::renderError(const HttpServerErrorStacktrace& stacktrace) {
 
   data::stream::BufferOutputStream stream;
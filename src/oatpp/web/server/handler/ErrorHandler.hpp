@@ -54,6 +54,21 @@ public:
    */
   virtual std::shared_ptr<protocol::http::outgoing::Response> handleError(const std::exception_ptr& exceptionPtr) = 0;
 
+  /**
+   * Handle error detected by the server itself - request to unmapped URL, invalid request headers, etc. <br>
+   * &id:oatpp::web::server::HttpProcessor; reports such errors by value, without throwing. <br>
+   * Default implementation creates the same error as the one thrown for user code -
+   * &id:oatpp::web::server::HttpServerError; with nested &id:oatpp::web::protocol::http::HttpError; -
+   * and passes it to &l:ErrorHandler::handleError ();. Override it to avoid the exception overhead.
+   * @param request - request which caused the error. May be `nullptr`.
+   * @param status - &id:oatpp::web::protocol::http::Status;.
+   * @param message - error message.
+   * @return - std::shared_ptr to &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  virtual std::shared_ptr<protocol::http::outgoing::Response> handleServerError(const std::shared_ptr<protocol::http::incoming::Request>& request,
+                                                                                const protocol::http::Status& status,
+                                                                                const oatpp::String& message);
+
 };
 
 /**
@@ -80,6 +95,17 @@ public:
 
   std::shared_ptr<protocol::http::outgoing::Response> handleError(const std::exception_ptr& error) override;
 
+  /**
+   * Render the server error without creating an exception.
+   * @param request
+   * @param status
+   * @param message
+   * @return
+   */
+  std::shared_ptr<protocol::http::outgoing::Response> handleServerError(const std::shared_ptr<protocol::http::incoming::Request>& request,
+                                                                        const protocol::http::Status& status,
+                                                                        const oatpp::String& message) override;
+
   /**
    * Reimplement this method for custom error rendering.
    * Render error method.
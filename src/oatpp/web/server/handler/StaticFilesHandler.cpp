@@ -0,0 +1,497 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "StaticFilesHandler.hpp"
+
+#include "oatpp/web/server/interceptor/ResponseCache.hpp"
+#include "oatpp/encoding/Url.hpp"
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/utils/String.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <sys/stat.h>
+#include <cstring>
+
+namespace oatpp { namespace web { namespace server { namespace handler {
+
+namespace {
+
+const char* const DAY_NAMES[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+const char* const MONTH_NAMES[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+struct ContentTypeMapping {
+  const char* extension;
+  const char* contentType;
+};
+
+const ContentTypeMapping CONTENT_TYPES[] = {
+  {"html", "text/html; charset=utf-8"},
+  {"htm", "text/html; charset=utf-8"},
+  {"css", "text/css; charset=utf-8"},
+  {"js", "text/javascript; charset=utf-8"},
+  {"mjs", "text/javascript; charset=utf-8"},
+  {"json", "application/json"},
+  {"map", "application/json"},
+  {"txt", "text/plain; charset=utf-8"},
+  {"xml", "application/xml"},
+  {"svg", "image/svg+xml"},
+  {"png", "image/png"},
+  {"jpg", "image/jpeg"},
+  {"jpeg", "image/jpeg"},
+  {"gif", "image/gif"},
+  {"webp", "image/webp"},
+  {"ico", "image/x-icon"},
+  {"woff", "font/woff"},
+  {"woff2", "font/woff2"},
+  {"wasm", "application/wasm"},
+  {"pdf", "application/pdf"},
+  {"mp4", "video/mp4"},
+  {"webm", "video/webm"},
+  {"mp3", "audio/mpeg"}
+};
+
+/*
+ * Regular files only.
+ */
+bool statFile(const oatpp::String& filename, v_int64& size, v_int64& modifiedTime) {
+#if defined(WIN32) || defined(_WIN32)
+  struct _stat64 info;
+  if(::_stat64(filename->c_str(), &info) != 0 || (info.st_mode & _S_IFREG) == 0) {
+    return false;
+  }
+#else
+  struct stat info;
+  if(::stat(filename->c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+#endif
+  size = info.st_size;
+  modifiedTime = info.st_mtime;
+  return true;
+}
+
+/*
+ * Days since 1970-01-01 from proleptic Gregorian date and back.
+ */
+v_int64 daysFromCivil(v_int64 y, v_int64 m, v_int64 d) {
+  y -= m <= 2 ? 1 : 0;
+  const v_int64 era = (y >= 0 ? y : y - 399) / 400;
+  const v_int64 yoe = y - era * 400;
+  const v_int64 doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  const v_int64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+void civilFromDays(v_int64 days, v_int64& y, v_int64& m, v_int64& d) {
+  days += 719468;
+  const v_int64 era = (days >= 0 ? days : days - 146096) / 146097;
+  const v_int64 doe = days - era * 146097;
+  const v_int64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const v_int64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const v_int64 mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+}
+
+void writeTwoDigits(data::stream::BufferOutputStream& stream, v_int64 value) {
+  v_char8 digits[2] = {static_cast<v_char8>('0' + value / 10), static_cast<v_char8>('0' + value % 10)};
+  stream.writeSimple(digits, 2);
+}
+
+/*
+ * IMF-fixdate. Ex.: `Sun, 06 Nov 1994 08:49:37 GMT`.
+ */
+oatpp::String formatHttpDate(v_int64 seconds) {
+
+  if(seconds < 0) {
+    seconds = 0;
+  }
+
+  v_int64 days = seconds / 86400;
+  v_int64 secondOfDay = seconds % 86400;
+  v_int64 y, m, d;
+  civilFromDays(days, y, m, d);
+
+  data::stream::BufferOutputStream stream(32);
+  stream.writeSimple(DAY_NAMES[(days + 4) % 7], 3);
+  stream.writeSimple(", ", 2);
+  writeTwoDigits(stream, d);
+  stream.writeSimple(" ", 1);
+  stream.writeSimple(MONTH_NAMES[m - 1], 3);
+  stream.writeSimple(" ", 1);
+  stream.writeAsString(y);
+  stream.writeSimple(" ", 1);
+  writeTwoDigits(stream, secondOfDay / 3600);
+  stream.writeSimple(":", 1);
+  writeTwoDigits(stream, secondOfDay / 60 % 60);
+  stream.writeSimple(":", 1);
+  writeTwoDigits(stream, secondOfDay % 60);
+  stream.writeSimple(" GMT", 4);
+  return stream.toString();
+
+}
+
+bool parseDigits(const char* data, v_int32 count, v_int64& result) {
+  result = 0;
+  for(v_int32 i = 0; i < count; i ++) {
+    if(data[i] < '0' || data[i] > '9') {
+      return false;
+    }
+    result = result * 10 + (data[i] - '0');
+  }
+  return true;
+}
+
+/*
+ * Only IMF-fixdate is accepted - obsolete formats are ignored as allowed by RFC 9110.
+ */
+bool parseHttpDate(const oatpp::data::share::StringKeyLabel& date, v_int64& seconds) {
+
+  if(date.getSize() != 29) {
+    return false;
+  }
+
+  auto data = reinterpret_cast<const char*>(date.getData());
+  if(data[3] != ',' || data[4] != ' ' || data[7] != ' ' || data[11] != ' ' || data[16] != ' ' ||
+     data[19] != ':' || data[22] != ':' || std::memcmp(&data[25], " GMT", 4) != 0)
+  {
+    return false;
+  }
+
+  v_int64 month = 0;
+  for(v_int64 i = 0; i < 12; i ++) {
+    if(std::memcmp(&data[8], MONTH_NAMES[i], 3) == 0) {
+      month = i + 1;
+      break;
+    }
+  }
+
+  v_int64 d, y, hh, mm, ss;
+  if(month == 0 ||
+     !parseDigits(&data[5], 2, d) || !parseDigits(&data[12], 4, y) ||
+     !parseDigits(&data[17], 2, hh) || !parseDigits(&data[20], 2, mm) || !parseDigits(&data[23], 2, ss))
+  {
+    return false;
+  }
+
+  seconds = daysFromCivil(y, month, d) * 86400 + hh * 3600 + mm * 60 + ss;
+  return true;
+
+}
+
+class ResponseCoroutine : public oatpp::async::CoroutineWithResult<ResponseCoroutine, const std::shared_ptr<protocol::http::outgoing::Response>&> {
+private:
+  std::shared_ptr<protocol::http::outgoing::Response> m_response;
+public:
+
+  ResponseCoroutine(const std::shared_ptr<protocol::http::outgoing::Response>& response)
+    : m_response(response)
+  {}
+
+  Action act() override {
+    return _return(m_response);
+  }
+
+};
+
+}
+
+StaticFilesHandler::StaticFilesHandler(const oatpp::String& root)
+  : StaticFilesHandler(root, Config())
+{}
+
+StaticFilesHandler::StaticFilesHandler(const oatpp::String& root, const Config& config)
+  : m_root(root)
+  , m_config(config)
+{
+  if(!m_root) {
+    throw std::runtime_error("[oatpp::web::server::handler::StaticFilesHandler::StaticFilesHandler()]: Error. Root is null.");
+  }
+  while(m_root->size() > 1 && m_root->back() == '/') {
+    m_root = m_root->substr(0, m_root->size() - 1);
+  }
+}
+
+const char* StaticFilesHandler::getContentType(const oatpp::String& filename) {
+
+  auto dot = filename->find_last_of("./");
+  if(dot != std::string::npos && filename->at(dot) == '.') {
+    auto extension = filename->data() + dot + 1;
+    auto extensionSize = static_cast<v_buff_size>(filename->size() - dot - 1);
+    for(auto& mapping : CONTENT_TYPES) {
+      if(utils::String::compareCI_ASCII(extension, extensionSize,
+                                        mapping.extension, static_cast<v_buff_size>(std::strlen(mapping.extension))) == 0)
+      {
+        return mapping.contentType;
+      }
+    }
+  }
+
+  return "application/octet-stream";
+
+}
+
+bool StaticFilesHandler::isPathSafe(const oatpp::String& path) {
+
+  if(path->empty()) {
+    return false;
+  }
+
+  v_buff_size segmentStart = 0;
+  auto size = static_cast<v_buff_size>(path->size());
+  for(v_buff_size i = 0; i <= size; i ++) {
+    char c = i < size ? path->at(static_cast<size_t>(i)) : '/';
+    if(c == '\\' || c == '\0') {
+      return false;
+    }
+    if(c == '/') {
+      if(i - segmentStart == 2 && path->at(static_cast<size_t>(segmentStart)) == '.' && path->at(static_cast<size_t>(segmentStart + 1)) == '.') {
+        return false;
+      }
+      segmentStart = i + 1;
+    }
+  }
+
+  return true;
+
+}
+
+std::shared_ptr<StaticFilesHandler::Resource> StaticFilesHandler::openResource(const oatpp::String& filename, bool load) {
+
+  auto resource = std::make_shared<Resource>();
+  resource->file = protocol::http::outgoing::FileBody::File::open(filename, load);
+  resource->contentType = getContentType(filename);
+
+  data::stream::BufferOutputStream stream(64);
+  stream.writeSimple("\"", 1);
+  stream.writeAsString(resource->file->getModifiedTime());
+  stream.writeSimple("-", 1);
+  stream.writeAsString(resource->file->getSize());
+  stream.writeSimple("\"", 1);
+  resource->etag = stream.toString();
+
+  resource->lastModified = formatHttpDate(resource->file->getModifiedTime());
+
+  return resource;
+
+}
+
+std::shared_ptr<StaticFilesHandler::Resource> StaticFilesHandler::getResource(const oatpp::String& filename) {
+
+  auto now = std::chrono::steady_clock::now();
+  std::shared_ptr<Resource> cached;
+
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_map.find(*filename);
+    if(it != m_map.end()) {
+      m_list.splice(m_list.begin(), m_list, it->second);
+      if(now - it->second->validatedAt < m_config.revalidateInterval) {
+        return it->second->resource;
+      }
+      cached = it->second->resource;
+    }
+  }
+
+  v_int64 size;
+  v_int64 modifiedTime;
+  bool exists = statFile(filename, size, modifiedTime);
+
+  if(cached && exists && size == cached->file->getSize() && modifiedTime == cached->file->getModifiedTime()) {
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_map.find(*filename);
+    if(it != m_map.end() && it->second->resource == cached) {
+      it->second->validatedAt = now;
+    }
+    return cached;
+  }
+
+  std::shared_ptr<Resource> resource;
+  if(exists) {
+    try {
+      resource = openResource(filename, size <= m_config.inMemoryMaxSize);
+    } catch (const std::runtime_error&) {
+      // removed in between
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  auto it = m_map.find(*filename);
+  if(it != m_map.end()) {
+    if(!resource) {
+      m_list.erase(it->second);
+      m_map.erase(it);
+      return nullptr;
+    }
+    it->second->resource = resource;
+    it->second->validatedAt = now;
+    return resource;
+  }
+
+  if(!resource) {
+    return nullptr;
+  }
+
+  m_list.push_front(Item{nullptr, resource, now});
+  auto inserted = m_map.insert({*filename, m_list.begin()});
+  m_list.front().path = &inserted.first->first;
+
+  while(static_cast<v_int64>(m_list.size()) > m_config.maxOpenFiles && !m_list.empty()) {
+    m_map.erase(*m_list.back().path);
+    m_list.pop_back();
+  }
+
+  return resource;
+
+}
+
+void StaticFilesHandler::putHeaders(OutgoingResponse& response, const Resource& resource) const {
+  response.putHeader_Unsafe(Header::ETAG, resource.etag);
+  response.putHeader_Unsafe(Header::LAST_MODIFIED, resource.lastModified);
+  response.putHeader_Unsafe(Header::ACCEPT_RANGES, protocol::http::Range::UNIT_BYTES);
+  if(m_config.cacheControl) {
+    response.putHeader_Unsafe(Header::CACHE_CONTROL, m_config.cacheControl);
+  }
+}
+
+std::shared_ptr<StaticFilesHandler::OutgoingResponse>
+StaticFilesHandler::createRangeResponse(const std::shared_ptr<IncomingRequest>& request,
+                                        const std::shared_ptr<Resource>& resource)
+{
+
+  auto rangeHeader = request->getHeader(Header::RANGE);
+  if(!rangeHeader) {
+    return nullptr;
+  }
+
+  auto ifRange = request->getHeaders().getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(Header::IF_RANGE);
+  if(ifRange && ifRange != resource->etag && ifRange != resource->lastModified) {
+    return nullptr;
+  }
+
+  std::vector<protocol::http::Range> ranges;
+  protocol::http::Range::parseAll(ranges, rangeHeader);
+  if(ranges.size() != 1 || ranges[0].units != protocol::http::Range::UNIT_BYTES) {
+    return nullptr;
+  }
+
+  v_int64 fileSize = resource->file->getSize();
+  v_int64 start = ranges[0].start;
+  v_int64 end = ranges[0].end;
+
+  if(start < 0) {
+    start = end < fileSize ? fileSize - end : 0;
+    end = fileSize - 1;
+  } else if(end < 0 || end >= fileSize) {
+    end = fileSize - 1;
+  } else if(end < start) {
+    return nullptr;
+  }
+
+  if(start >= fileSize || end < start) {
+    auto response = OutgoingResponse::createShared(Status::CODE_416, nullptr);
+    response->putHeader(Header::CONTENT_RANGE, "bytes */" + utils::Conversion::int64ToStr(fileSize));
+    return response;
+  }
+
+  auto body = protocol::http::outgoing::FileBody::createShared(resource->file, start, end - start + 1, resource->contentType);
+  auto response = OutgoingResponse::createShared(Status::CODE_206, body);
+  putHeaders(*response, *resource);
+  response->putHeader(Header::CONTENT_RANGE,
+                      protocol::http::ContentRange(protocol::http::ContentRange::UNIT_BYTES, start, end, fileSize, true).toString());
+  return response;
+
+}
+
+std::shared_ptr<StaticFilesHandler::OutgoingResponse> StaticFilesHandler::handle(const std::shared_ptr<IncomingRequest>& request) {
+
+  auto path = request->getPathTail();
+  if(!path) {
+    throw HttpError(Status::CODE_404, "File not found.", {});
+  }
+
+  auto queryStart = path->find('?');
+  if(queryStart != std::string::npos) {
+    path = path->substr(0, queryStart);
+  }
+
+  path = encoding::Url::decode(path);
+  if(!isPathSafe(path)) {
+    throw HttpError(Status::CODE_400, "Invalid path.", {});
+  }
+
+  auto resource = getResource(m_root + "/" + path);
+  if(!resource) {
+    throw HttpError(Status::CODE_404, "File not found.", {});
+  }
+
+  auto& headers = request->getHeaders();
+  auto ifNoneMatch = headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(Header::IF_NONE_MATCH);
+  bool notModified;
+  if(ifNoneMatch) {
+    notModified = interceptor::ResponseCache::matchETag(ifNoneMatch, resource->etag);
+  } else {
+    v_int64 since;
+    auto ifModifiedSince = headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(Header::IF_MODIFIED_SINCE);
+    notModified = ifModifiedSince && parseHttpDate(ifModifiedSince, since) && resource->file->getModifiedTime() <= since;
+  }
+
+  if(notModified) {
+    auto response = OutgoingResponse::createShared(Status::CODE_304, nullptr);
+    putHeaders(*response, *resource);
+    return response;
+  }
+
+  auto response = createRangeResponse(request, resource);
+  if(response) {
+    return response;
+  }
+
+  auto body = protocol::http::outgoing::FileBody::createShared(resource->file, 0, resource->file->getSize(), resource->contentType);
+  response = OutgoingResponse::createShared(Status::CODE_200, body);
+  putHeaders(*response, *resource);
+  return response;
+
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<StaticFilesHandler::OutgoingResponse>&>
+StaticFilesHandler::handleAsync(const std::shared_ptr<IncomingRequest>& request) {
+  return ResponseCoroutine::startForResult(handle(request));
+}
+
+void StaticFilesHandler::clear() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_map.clear();
+  m_list.clear();
+}
+
+v_int64 StaticFilesHandler::getOpenFilesCount() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return static_cast<v_int64>(m_list.size());
+}
+
+}}}}
@@ -0,0 +1,165 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_server_handler_StaticFilesHandler_hpp
+#define oatpp_web_server_handler_StaticFilesHandler_hpp
+
+#include "oatpp/web/server/HttpRequestHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/FileBody.hpp"
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace web { namespace server { namespace handler {
+
+/**
+ * Request handler serving files of a directory. <br>
+ * Route it with a tail pattern (a route ending with `*`) - the path tail is resolved against the root directory. Paths containing `..` segments, backslashes or `NUL` are rejected. <br>
+ * Supports conditional requests (`If-None-Match`, `If-Modified-Since`) and single byte-range requests (`Range`, `If-Range`).
+ * Multiple-range requests are answered with the full file. <br>
+ * Open files together with their metadata are kept in an LRU cache and are revalidated with `stat` at most once per
+ * &l:StaticFilesHandler::Config::revalidateInterval;. Small files are read into memory and sent together with headers,
+ * large files are sent with `sendfile` where supported.
+ */
+class StaticFilesHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  /**
+   * Handler config.
+   */
+  struct Config {
+
+    /**
+     * Files up to this size are read into memory when opened. `0` - don't load files. <br>
+     * The in-memory copy is a snapshot - files modified in place are re-read on revalidation.
+     */
+    v_int64 inMemoryMaxSize = 1024 * 1024;
+
+    /**
+     * Max number of open files kept in cache.
+     */
+    v_int32 maxOpenFiles = 256;
+
+    /**
+     * Cached file metadata is trusted for this long before the file is checked for modifications again.
+     */
+    std::chrono::duration<v_int64, std::micro> revalidateInterval = std::chrono::seconds(1);
+
+    /**
+     * Value of the `Cache-Control` header added to responses. `nullptr` - don't add the header.
+     */
+    oatpp::String cacheControl;
+
+  };
+
+private:
+
+  struct Resource {
+    std::shared_ptr<oatpp::web::protocol::http::outgoing::FileBody::File> file;
+    const char* contentType;
+    oatpp::String etag;
+    oatpp::String lastModified;
+  };
+
+  struct Item {
+    const std::string* path;
+    std::shared_ptr<Resource> resource;
+    std::chrono::steady_clock::time_point validatedAt;
+  };
+
+private:
+  static bool isPathSafe(const oatpp::String& path);
+  static std::shared_ptr<Resource> openResource(const oatpp::String& filename, bool load);
+private:
+  std::shared_ptr<Resource> getResource(const oatpp::String& filename);
+  std::shared_ptr<OutgoingResponse> createRangeResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                        const std::shared_ptr<Resource>& resource);
+  void putHeaders(OutgoingResponse& response, const Resource& resource) const;
+private:
+  oatpp::String m_root;
+  Config m_config;
+  std::mutex m_lock;
+  std::list<Item> m_list;
+  std::unordered_map<std::string, std::list<Item>::iterator> m_map;
+public:
+
+  /**
+   * Constructor.
+   * @param root - path to the directory to serve.
+   */
+  StaticFilesHandler(const oatpp::String& root);
+
+  /**
+   * Constructor.
+   * @param root - path to the directory to serve.
+   * @param config - &l:StaticFilesHandler::Config;.
+   */
+  StaticFilesHandler(const oatpp::String& root, const Config& config);
+
+  /**
+   * Get content type by file extension.
+   * @param filename - file name.
+   * @return - content type. `application/octet-stream` if extension is unknown.
+   */
+  static const char* getContentType(const oatpp::String& filename);
+
+  /**
+   * Serve file.
+   * @param request - &id:oatpp::web::protocol::http::incoming::Request;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   * @throws - &id:oatpp::web::protocol::http::HttpError; 404 if file not found.
+   */
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override;
+
+  /**
+   * Serve file in Asynchronous manner. <br>
+   * File metadata is taken from cache - `stat` and `open` happen only on cache miss or revalidation. <br>
+   * *Note:* on cache miss and on revalidation the file is stat-ed, opened and (if small) read on the executor thread -
+   * these are blocking calls. Use it with files on local disks, and keep &l:StaticFilesHandler::Config::revalidateInterval;
+   * large enough to make misses rare.
+   * @param request - &id:oatpp::web::protocol::http::incoming::Request;.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override;
+
+  /**
+   * Drop all cached files.
+   */
+  void clear();
+
+  /**
+   * Get number of open files in cache.
+   * @return - number of open files.
+   */
+  v_int64 getOpenFilesCount();
+
+};
+
+}}}}
+
+#endif // oatpp_web_server_handler_StaticFilesHandler_hpp
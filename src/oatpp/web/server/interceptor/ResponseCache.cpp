@@ -0,0 +1,419 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResponseCache.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/utils/String.hpp"
+#include "oatpp/Environment.hpp"
+
+#include <cstdio>
+#include <string_view>
+
+namespace oatpp { namespace web { namespace server { namespace interceptor {
+
+namespace {
+
+/* Marks responses created from cache so that they are not stored again */
+const char* const CACHED_RESPONSE_BUNDLE_KEY = "oatpp::web::server::interceptor::ResponseCache::cached";
+
+std::string_view toStringView(const data::share::MemoryLabel& label) {
+  return std::string_view(reinterpret_cast<const char*>(label.getData()), static_cast<size_t>(label.getSize()));
+}
+
+std::string_view trim(std::string_view token) {
+  while(!token.empty() && (token.front() == ' ' || token.front() == '\t')) token.remove_prefix(1);
+  while(!token.empty() && (token.back() == ' ' || token.back() == '\t')) token.remove_suffix(1);
+  return token;
+}
+
+std::string_view stripWeak(std::string_view etag) {
+  if(etag.size() >= 2 && etag[0] == 'W' && etag[1] == '/') {
+    etag.remove_prefix(2);
+  }
+  return etag;
+}
+
+bool listContainsToken(std::string_view list, std::string_view token) {
+  while(!list.empty()) {
+    auto pos = list.find(',');
+    auto item = trim(list.substr(0, pos));
+    if(item.size() == token.size() &&
+       utils::String::compareCI_ASCII(item.data(), static_cast<v_buff_size>(item.size()),
+                                      token.data(), static_cast<v_buff_size>(token.size())) == 0)
+    {
+      return true;
+    }
+    if(pos == std::string_view::npos) break;
+    list.remove_prefix(pos + 1);
+  }
+  return false;
+}
+
+/*
+ * Requests carrying credentials or asking not to be stored are neither served from cache nor stored.
+ */
+bool isCacheableRequest(const std::shared_ptr<protocol::http::incoming::Request>& request) {
+
+  const auto& headers = request->getHeaders();
+
+  if(headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::AUTHORIZATION) ||
+     headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::COOKIE))
+  {
+    return false;
+  }
+
+  auto cacheControl = headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::CACHE_CONTROL);
+  if(cacheControl && listContainsToken(toStringView(cacheControl), "no-store")) {
+    return false;
+  }
+
+  return true;
+
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ResponseCache
+
+ResponseCache::ResponseCache()
+  : ResponseCache(Config())
+{}
+
+ResponseCache::ResponseCache(const Config& config)
+  : m_config(config)
+  , m_hits(0)
+  , m_misses(0)
+  , m_notModified(0)
+{
+  if(m_config.shardsCount < 1) {
+    m_config.shardsCount = 1;
+  }
+  m_shardMaxSize = m_config.maxSize / m_config.shardsCount;
+  m_shards.reserve(static_cast<size_t>(m_config.shardsCount));
+  for(v_int32 i = 0; i < m_config.shardsCount; i ++) {
+    m_shards.emplace_back(new Shard());
+  }
+}
+
+const ResponseCache::Config& ResponseCache::getConfig() const {
+  return m_config;
+}
+
+v_buff_size ResponseCache::getEntryCost(const std::string& key, const Entry& entry) {
+  v_buff_size cost = static_cast<v_buff_size>(sizeof(Entry) + key.size() + entry.body->size());
+  for(auto& pair : entry.headers.getAll_Unsafe()) {
+    cost += pair.first.getSize() + pair.second.getSize();
+  }
+  return cost;
+}
+
+ResponseCache::Shard& ResponseCache::getShard(const std::string& key) {
+  auto hash = std::hash<std::string>{}(key);
+  return *m_shards[hash % m_shards.size()];
+}
+
+void ResponseCache::removeItem(Shard& shard, ItemList::iterator it) {
+  shard.size -= it->cost;
+  shard.index.erase(*it->key);
+  shard.items.erase(it);
+}
+
+oatpp::String ResponseCache::generateETag(const void* data, v_buff_size size) {
+  auto hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), static_cast<size_t>(size)));
+  char buffer[48];
+  auto length = std::snprintf(buffer, sizeof(buffer), "\"%016llx-%llx\"",
+                              static_cast<unsigned long long>(hash), static_cast<unsigned long long>(size));
+  return oatpp::String(buffer, length);
+}
+
+bool ResponseCache::matchETag(const oatpp::data::share::StringKeyLabel& ifNoneMatch, const oatpp::String& etag) {
+
+  if(!ifNoneMatch || !etag) {
+    return false;
+  }
+
+  auto tag = stripWeak(std::string_view(etag->data(), etag->size()));
+  auto list = toStringView(ifNoneMatch);
+
+  while(!list.empty()) {
+    auto pos = list.find(',');
+    auto item = trim(list.substr(0, pos));
+    if(item == "*" || stripWeak(item) == tag) {
+      return true;
+    }
+    if(pos == std::string_view::npos) break;
+    list.remove_prefix(pos + 1);
+  }
+
+  return false;
+
+}
+
+std::string ResponseCache::getKey(const std::shared_ptr<IncomingRequest>& request) const {
+
+  const auto& line = request->getStartingLine();
+
+  std::string key;
+  key.reserve(static_cast<size_t>(line.method.getSize() + line.path.getSize() + 1));
+  key.append(toStringView(line.method));
+  key.push_back(' ');
+  key.append(toStringView(line.path));
+
+  for(auto& header : m_config.varyHeaders) {
+    auto value = request->getHeaders().getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(header);
+    key.push_back('\n');
+    if(value) {
+      key.append(toStringView(value));
+    }
+  }
+
+  return key;
+
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::get(const std::string& key) {
+
+  auto& shard = getShard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.index.find(key);
+  if(it == shard.index.end()) {
+    m_misses ++;
+    return nullptr;
+  }
+
+  auto item = it->second;
+  if(item->entry->expiresAt <= oatpp::Environment::getMicroTickCount()) {
+    removeItem(shard, item);
+    m_misses ++;
+    return nullptr;
+  }
+
+  shard.items.splice(shard.items.begin(), shard.items, item);
+  m_hits ++;
+  return item->entry;
+
+}
+
+void ResponseCache::put(const std::string& key, const std::shared_ptr<const Entry>& entry) {
+
+  auto cost = getEntryCost(key, *entry);
+  if(cost > m_shardMaxSize) {
+    return;
+  }
+
+  auto& shard = getShard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.index.find(key);
+  if(it != shard.index.end()) {
+    removeItem(shard, it->second);
+  }
+
+  shard.items.push_front({nullptr, entry, cost});
+  auto inserted = shard.index.insert({key, shard.items.begin()});
+  shard.items.front().key = &inserted.first->first;
+  shard.size += cost;
+
+  while(shard.size > m_shardMaxSize) {
+    removeItem(shard, std::prev(shard.items.end()));
+  }
+
+}
+
+void ResponseCache::clear() {
+  for(auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->index.clear();
+    shard->items.clear();
+    shard->size = 0;
+  }
+}
+
+std::shared_ptr<ResponseCache::OutgoingResponse> ResponseCache::createResponse(const Entry& entry) {
+  auto response = OutgoingResponse::createShared(entry.status, protocol::http::outgoing::BufferBody::createShared(entry.body, data::share::StringKeyLabel(), true));
+  for(auto& pair : entry.headers.getAll_Unsafe()) {
+    response->putHeader_Unsafe(pair.first, pair.second);
+  }
+  response->putBundleData(CACHED_RESPONSE_BUNDLE_KEY, oatpp::Boolean(true));
+  return response;
+}
+
+std::shared_ptr<ResponseCache::OutgoingResponse> ResponseCache::createNotModifiedResponse(const Entry& entry) {
+  m_notModified ++;
+  auto response = OutgoingResponse::createShared(protocol::http::Status::CODE_304, nullptr);
+  response->putHeader_Unsafe(protocol::http::Header::ETAG, entry.etag);
+  auto cacheControl = entry.headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::CACHE_CONTROL);
+  if(cacheControl) {
+    response->putHeader_Unsafe(protocol::http::Header::CACHE_CONTROL, cacheControl);
+  }
+  response->putBundleData(CACHED_RESPONSE_BUNDLE_KEY, oatpp::Boolean(true));
+  return response;
+}
+
+v_int64 ResponseCache::getHitsCount() const {
+  return m_hits;
+}
+
+v_int64 ResponseCache::getMissesCount() const {
+  return m_misses;
+}
+
+v_int64 ResponseCache::getNotModifiedCount() const {
+  return m_notModified;
+}
+
+v_int64 ResponseCache::getEntriesCount() {
+  v_int64 result = 0;
+  for(auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result += static_cast<v_int64>(shard->items.size());
+  }
+  return result;
+}
+
+v_buff_size ResponseCache::getSize() {
+  v_buff_size result = 0;
+  for(auto& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result += shard->size;
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ResponseCacheRequestInterceptor
+
+ResponseCacheRequestInterceptor::ResponseCacheRequestInterceptor(const std::shared_ptr<ResponseCache>& cache)
+  : m_cache(cache)
+{}
+
+std::shared_ptr<protocol::http::outgoing::Response> ResponseCacheRequestInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+
+  if(request->getStartingLine().method != "GET" || !isCacheableRequest(request)) {
+    return nullptr;
+  }
+
+  auto entry = m_cache->get(m_cache->getKey(request));
+  if(!entry) {
+    return nullptr;
+  }
+
+  auto ifNoneMatch = request->getHeaders().getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::IF_NONE_MATCH);
+  if(ResponseCache::matchETag(ifNoneMatch, entry->etag)) {
+    return m_cache->createNotModifiedResponse(*entry);
+  }
+
+  return ResponseCache::createResponse(*entry);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ResponseCacheResponseInterceptor
+
+ResponseCacheResponseInterceptor::ResponseCacheResponseInterceptor(const std::shared_ptr<ResponseCache>& cache)
+  : m_cache(cache)
+{}
+
+std::shared_ptr<protocol::http::outgoing::Response> ResponseCacheResponseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                                                                const std::shared_ptr<OutgoingResponse>& response)
+{
+
+  if(response->getStatus().code != 200 || request->getStartingLine().method != "GET") {
+    return response;
+  }
+
+  const auto& bundle = response->getBundle().getAll();
+  if(!bundle.empty() && bundle.find(CACHED_RESPONSE_BUNDLE_KEY) != bundle.end()) {
+    return response;
+  }
+
+  auto body = response->getBody();
+  if(!body || body->getKnownData() == nullptr || body->getKnownSize() > m_cache->getConfig().maxEntrySize) {
+    return response;
+  }
+
+  if(!isCacheableRequest(request)) {
+    return response;
+  }
+
+  const auto& headers = response->getHeaders();
+  if(headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::SET_COOKIE)) {
+    return response;
+  }
+
+  auto cacheControl = headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::CACHE_CONTROL);
+  if(cacheControl && (listContainsToken(toStringView(cacheControl), "no-store") || listContainsToken(toStringView(cacheControl), "private"))) {
+    return response;
+  }
+
+  auto vary = headers.getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::VARY);
+  if(vary) {
+    auto list = toStringView(vary);
+    while(!list.empty()) {
+      auto pos = list.find(',');
+      auto item = trim(list.substr(0, pos));
+      bool configured = false;
+      for(auto& header : m_cache->getConfig().varyHeaders) {
+        configured = configured || listContainsToken(item, std::string_view(header->data(), header->size()));
+      }
+      if(!item.empty() && !configured) {
+        return response; // the response varies on a header which is not a part of the cache key
+      }
+      if(pos == std::string_view::npos) break;
+      list.remove_prefix(pos + 1);
+    }
+  }
+
+  v_buff_size size = body->getKnownSize();
+  auto etag = response->getHeader(protocol::http::Header::ETAG);
+  if(!etag) {
+    etag = ResponseCache::generateETag(body->getKnownData(), size);
+    response->putHeader(protocol::http::Header::ETAG, etag);
+  }
+
+  auto entry = std::make_shared<ResponseCache::Entry>();
+  entry->status = response->getStatus();
+  entry->headers = headers;
+  body->declareHeaders(entry->headers);
+  entry->headers.getAll(); // capture headers to own memory
+  entry->body = oatpp::String(reinterpret_cast<const char*>(body->getKnownData()), size);
+  entry->etag = etag;
+  entry->expiresAt = oatpp::Environment::getMicroTickCount() + m_cache->getConfig().ttl.count();
+
+  m_cache->put(m_cache->getKey(request), entry);
+
+  auto ifNoneMatch = request->getHeaders().getAsMemoryLabel_Unsafe<data::share::StringKeyLabel>(protocol::http::Header::IF_NONE_MATCH);
+  if(ResponseCache::matchETag(ifNoneMatch, etag)) {
+    return m_cache->createNotModifiedResponse(*entry);
+  }
+
+  return response;
+
+}
+
+}}}}
@@ -0,0 +1,297 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_server_interceptor_ResponseCache_hpp
+#define oatpp_web_server_interceptor_ResponseCache_hpp
+
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace web { namespace server { namespace interceptor {
+
+/**
+ * Sharded LRU cache of responses to `GET` requests. <br>
+ * Responses are keyed by method, path with query and values of the configured `Vary` headers. <br>
+ * Used by &l:ResponseCacheRequestInterceptor; and &l:ResponseCacheResponseInterceptor;. Thread-safe.
+ */
+class ResponseCache {
+public:
+  typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+public:
+
+  /**
+   * Cache config.
+   */
+  struct Config {
+
+    /**
+     * Number of shards. Each shard has its own lock and LRU list.
+     */
+    v_int32 shardsCount = 16;
+
+    /**
+     * Max total size of cached responses in bytes. Split evenly between shards.
+     */
+    v_buff_size maxSize = 64 * 1024 * 1024;
+
+    /**
+     * Responses with a body larger than this are not cached.
+     */
+    v_buff_size maxEntrySize = 1024 * 1024;
+
+    /**
+     * Time to live of a cached response.
+     */
+    std::chrono::duration<v_int64, std::micro> ttl = std::chrono::seconds(60);
+
+    /**
+     * Request headers which values are part of the cache key. Ex.: `{"Accept-Language"}`. <br>
+     * Responses declaring `Vary` with any other header are not cached.
+     */
+    std::vector<oatpp::String> varyHeaders;
+
+  };
+
+  /**
+   * Cached response.
+   */
+  struct Entry {
+
+    /**
+     * Response status.
+     */
+    protocol::http::Status status;
+
+    /**
+     * Response headers including `ETag` and headers declared by the body.
+     */
+    protocol::http::Headers headers;
+
+    /**
+     * Response body.
+     */
+    oatpp::String body;
+
+    /**
+     * Strong ETag of the response.
+     */
+    oatpp::String etag;
+
+    /**
+     * Expiration time - &id:oatpp::Environment::getMicroTickCount;.
+     */
+    v_int64 expiresAt;
+
+  };
+
+private:
+
+  struct Item {
+    const std::string* key; // key of the index node
+    std::shared_ptr<const Entry> entry;
+    v_buff_size cost;
+  };
+
+  typedef std::list<Item> ItemList;
+
+  struct Shard {
+    std::mutex mutex;
+    ItemList items;
+    std::unordered_map<std::string, ItemList::iterator> index;
+    v_buff_size size = 0;
+  };
+
+private:
+  static v_buff_size getEntryCost(const std::string& key, const Entry& entry);
+private:
+  Config m_config;
+  v_buff_size m_shardMaxSize;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  std::atomic<v_int64> m_hits;
+  std::atomic<v_int64> m_misses;
+  std::atomic<v_int64> m_notModified;
+private:
+  Shard& getShard(const std::string& key);
+  void removeItem(Shard& shard, ItemList::iterator it);
+public:
+
+  /**
+   * Constructor. Default config.
+   */
+  ResponseCache();
+
+  /**
+   * Constructor.
+   * @param config - &l:ResponseCache::Config;.
+   */
+  ResponseCache(const Config& config);
+
+  /**
+   * Get config.
+   * @return - &l:ResponseCache::Config;.
+   */
+  const Config& getConfig() const;
+
+  /**
+   * Generate strong ETag for the body.
+   * @param data - body data.
+   * @param size - body size.
+   * @return - quoted ETag value.
+   */
+  static oatpp::String generateETag(const void* data, v_buff_size size);
+
+  /**
+   * Check if `If-None-Match` header value matches the ETag. Uses weak comparison as required for `If-None-Match`.
+   * @param ifNoneMatch - value of `If-None-Match` header.
+   * @param etag - ETag.
+   * @return - `true` if matches.
+   */
+  static bool matchETag(const oatpp::data::share::StringKeyLabel& ifNoneMatch, const oatpp::String& etag);
+
+  /**
+   * Get cache key for the request.
+   * @param request - &id:oatpp::web::protocol::http::incoming::Request;.
+   * @return - cache key.
+   */
+  std::string getKey(const std::shared_ptr<IncomingRequest>& request) const;
+
+  /**
+   * Get cached response. Expired entry is removed. Counts hit or miss.
+   * @param key - cache key.
+   * @return - &l:ResponseCache::Entry; or `nullptr`.
+   */
+  std::shared_ptr<const Entry> get(const std::string& key);
+
+  /**
+   * Put response to cache. Least recently used entries are evicted to fit the shard size.
+   * @param key - cache key.
+   * @param entry - &l:ResponseCache::Entry;.
+   */
+  void put(const std::string& key, const std::shared_ptr<const Entry>& entry);
+
+  /**
+   * Remove all entries.
+   */
+  void clear();
+
+  /**
+   * Create response from the cached entry.
+   * @param entry - &l:ResponseCache::Entry;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  static std::shared_ptr<OutgoingResponse> createResponse(const Entry& entry);
+
+  /**
+   * Create `304 Not Modified` response for the cached entry.
+   * @param entry - &l:ResponseCache::Entry;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response;.
+   */
+  std::shared_ptr<OutgoingResponse> createNotModifiedResponse(const Entry& entry);
+
+  /**
+   * Number of requests served from cache.
+   * @return
+   */
+  v_int64 getHitsCount() const;
+
+  /**
+   * Number of cacheable requests not found in cache.
+   * @return
+   */
+  v_int64 getMissesCount() const;
+
+  /**
+   * Number of `304 Not Modified` responses.
+   * @return
+   */
+  v_int64 getNotModifiedCount() const;
+
+  /**
+   * Number of cached responses.
+   * @return
+   */
+  v_int64 getEntriesCount();
+
+  /**
+   * Total size of cached responses in bytes.
+   * @return
+   */
+  v_buff_size getSize();
+
+};
+
+/**
+ * Serves cached responses before routing. <br>
+ * Returns `304 Not Modified` if request `If-None-Match` matches ETag of the cached response. <br>
+ * Requests with `Authorization` or `Cookie` header or with `Cache-Control: no-store` are passed through. <br>
+ * *Note:* request interceptors run in the order they are added - add this interceptor after authentication
+ * and other access-control interceptors, otherwise cached responses are served before access is checked.
+ */
+class ResponseCacheRequestInterceptor : public RequestInterceptor {
+private:
+  std::shared_ptr<ResponseCache> m_cache;
+public:
+
+  /**
+   * Constructor.
+   * @param cache - &l:ResponseCache;.
+   */
+  ResponseCacheRequestInterceptor(const std::shared_ptr<ResponseCache>& cache);
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+
+};
+
+/**
+ * Stores `200 OK` responses to `GET` requests with in-memory bodies (ex.: &id:oatpp::web::protocol::http::outgoing::BufferBody;). <br>
+ * Adds strong `ETag` header if the response has none. <br>
+ * Responses with `Cache-Control: no-store/private`, `Set-Cookie` and responses to requests with `Authorization` or `Cookie` are not cached.
+ */
+class ResponseCacheResponseInterceptor : public ResponseInterceptor {
+private:
+  std::shared_ptr<ResponseCache> m_cache;
+public:
+
+  /**
+   * Constructor.
+   * @param cache - &l:ResponseCache;.
+   */
+  ResponseCacheResponseInterceptor(const std::shared_ptr<ResponseCache>& cache);
+
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                              const std::shared_ptr<OutgoingResponse>& response) override;
+
+};
+
+}}}}
+
+#endif // oatpp_web_server_interceptor_ResponseCache_hpp
@@ -28,20 +28,194 @@
 #include "oatpp/data/share/MemoryLabel.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
 
+#include <array>
 #include <list>
+#include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
 namespace oatpp { namespace web { namespace url { namespace mapping {
-  
+
+class PatternTree;
+
 class Pattern : public base::Countable{
+  friend PatternTree;
 private:
   typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
 public:
   
   class MatchMap {
     friend Pattern;
+    friend PatternTree;
   public:
-    typedef std::unordered_map<StringKeyLabel, StringKeyLabel> Variables;
+
+    /**
+     * Path variables resolved by the pattern. <br>
+     * Stores up to &l:Pattern::MatchMap::Variables::INLINE_CAPACITY; variables inline (no heap allocations),
+     * spills to the heap for patterns with more captures. Lookup is a linear scan - patterns rarely have more than a few variables. <br>
+     * Keeps the subset of `std::unordered_map` API used to read variables - `at`, `count`, `find`, `operator[]`, `size`, `empty` and iteration.
+     */
+    class Variables {
+    public:
+      typedef std::pair<StringKeyLabel, StringKeyLabel> Pair;
+      typedef StringKeyLabel key_type;
+      typedef StringKeyLabel mapped_type;
+      typedef Pair value_type;
+      typedef size_t size_type;
+      typedef Pair* iterator;
+      typedef const Pair* const_iterator;
+      static constexpr v_buff_size INLINE_CAPACITY = 4;
+    private:
+      std::array<Pair, INLINE_CAPACITY> m_inline;
+      std::vector<Pair> m_overflow;
+      v_buff_size m_size;
+      bool m_spilled;
+    private:
+
+      Pair* data() {
+        return m_spilled ? m_overflow.data() : m_inline.data();
+      }
+
+      const Pair* data() const {
+        return m_spilled ? m_overflow.data() : m_inline.data();
+      }
+
+    public:
+
+      Variables()
+        : m_size(0)
+        , m_spilled(false)
+      {}
+
+      /**
+       * Reserve space for variables. Does nothing if `capacity` fits the inline storage.
+       * @param capacity
+       */
+      void reserve(v_buff_size capacity) {
+        if(capacity > INLINE_CAPACITY && !m_spilled) {
+          m_overflow.reserve(static_cast<size_t>(capacity));
+          for(v_buff_size i = 0; i < m_size; i ++) {
+            m_overflow.push_back(std::move(m_inline[static_cast<size_t>(i)]));
+            m_inline[static_cast<size_t>(i)] = Pair();
+          }
+          m_spilled = true;
+        }
+      }
+
+      /**
+       * Get variable value by name, insert empty value if variable doesn't exist.
+       * @param key - variable name.
+       * @return - reference to the variable value.
+       */
+      StringKeyLabel& operator[](const StringKeyLabel& key) {
+        auto it = find(key);
+        if(it != end()) {
+          return it->second;
+        }
+        if(!m_spilled) {
+          if(m_size < INLINE_CAPACITY) {
+            auto& pair = m_inline[static_cast<size_t>(m_size ++)];
+            pair.first = key;
+            return pair.second;
+          }
+          reserve(INLINE_CAPACITY * 2);
+        }
+        m_overflow.push_back({key, nullptr});
+        m_size ++;
+        return m_overflow.back().second;
+      }
+
+      Pair* find(const StringKeyLabel& key) {
+        auto p = data();
+        for(v_buff_size i = 0; i < m_size; i ++) {
+          if(p[i].first == key) {
+            return &p[i];
+          }
+        }
+        return end();
+      }
+
+      const Pair* find(const StringKeyLabel& key) const {
+        auto p = data();
+        for(v_buff_size i = 0; i < m_size; i ++) {
+          if(p[i].first == key) {
+            return &p[i];
+          }
+        }
+        return end();
+      }
+
+      /**
+       * Get variable value by name.
+       * @param key - variable name.
+       * @return - reference to the variable value.
+       * @throws - `std::out_of_range` if variable doesn't exist.
+       */
+      StringKeyLabel& at(const StringKeyLabel& key) {
+        auto it = find(key);
+        if(it == end()) {
+          throw std::out_of_range("[oatpp::web::url::mapping::Pattern::MatchMap::Variables::at()]: Error. No such variable.");
+        }
+        return it->second;
+      }
+
+      /**
+       * Get variable value by name.
+       * @param key - variable name.
+       * @return - reference to the variable value.
+       * @throws - `std::out_of_range` if variable doesn't exist.
+       */
+      const StringKeyLabel& at(const StringKeyLabel& key) const {
+        auto it = find(key);
+        if(it == end()) {
+          throw std::out_of_range("[oatpp::web::url::mapping::Pattern::MatchMap::Variables::at()]: Error. No such variable.");
+        }
+        return it->second;
+      }
+
+      /**
+       * Count variables with the name.
+       * @param key - variable name.
+       * @return - `1` if variable exists, `0` otherwise.
+       */
+      size_type count(const StringKeyLabel& key) const {
+        return find(key) != end() ? 1 : 0;
+      }
+
+      Pair* begin() {
+        return data();
+      }
+
+      Pair* end() {
+        return data() + m_size;
+      }
+
+      const Pair* begin() const {
+        return data();
+      }
+
+      const Pair* end() const {
+        return data() + m_size;
+      }
+
+      const Pair* cbegin() const {
+        return data();
+      }
+
+      const Pair* cend() const {
+        return data() + m_size;
+      }
+
+      v_buff_size size() const {
+        return m_size;
+      }
+
+      bool empty() const {
+        return m_size == 0;
+      }
+
+    };
+
   private:
     Variables m_variables;
     StringKeyLabel m_tail;
@@ -0,0 +1,223 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "PatternTree.hpp"
+
+namespace oatpp { namespace web { namespace url { namespace mapping {
+
+PatternTree::PatternTree()
+  : m_root(0)
+  , m_maxVariables(0)
+{}
+
+v_int64 PatternTree::add(const std::shared_ptr<Pattern>& pattern) {
+
+  auto index = static_cast<v_int64>(m_variableNames.size());
+  m_variableNames.emplace_back();
+  auto& names = m_variableNames.back();
+
+  Node* node = &m_root;
+
+  if(pattern) {
+    for(const std::shared_ptr<Pattern::Part>& part : *pattern->m_parts) {
+
+      if(part->function == Pattern::Part::FUNCTION_CONST) {
+        auto& child = node->constChildren[StringKeyLabel(part->text)];
+        if(!child) {
+          child = std::make_unique<Node>(index);
+        }
+        node = child.get();
+      } else if(part->function == Pattern::Part::FUNCTION_VAR) {
+        names.emplace_back(part->text);
+        if(!node->varChild) {
+          node->varChild = std::make_unique<Node>(index);
+        }
+        node = node->varChild.get();
+      } else if(part->function == Pattern::Part::FUNCTION_ANY_END) {
+        if(node->tailIndex == NO_MATCH) {
+          node->tailIndex = index;
+        }
+        node = nullptr;
+        break;
+      }
+
+    }
+  }
+
+  if(node != nullptr && node->endIndex == NO_MATCH) {
+    node->endIndex = index;
+  }
+
+  if(static_cast<v_int32>(names.size()) > m_maxVariables) {
+    m_maxVariables = static_cast<v_int32>(names.size());
+  }
+
+  return index;
+
+}
+
+void PatternTree::record(Search& search, v_int64 index, v_int32 depth, v_buff_size tailPosition) const {
+  search.bestIndex = index;
+  search.bestTail = tailPosition;
+  for(v_int32 i = 0; i < depth; i ++) {
+    search.bestCaptures[i] = search.captures[i];
+  }
+}
+
+const PatternTree::Node* PatternTree::findConst(const Search& search, const Node* node, v_buff_size position, v_buff_size end) const {
+  if(node->constChildren.empty()) {
+    return nullptr;
+  }
+  auto it = node->constChildren.find(StringKeyLabel(nullptr, search.data + position, end - position));
+  if(it != node->constChildren.end() && it->second->minIndex < search.bestIndex) {
+    return it->second.get();
+  }
+  return nullptr;
+}
+
+void PatternTree::visit(Search& search, const Node* node, v_buff_size position, v_int32 depth, bool childrenOnly) const {
+
+  while(position < search.size && search.data[position] == '/') {
+    position ++;
+  }
+
+  if(!childrenOnly) {
+
+    if(position == search.size && node->endIndex != NO_MATCH && node->endIndex < search.bestIndex) {
+      record(search, node->endIndex, depth, -1);
+    }
+
+    if(node->tailIndex != NO_MATCH && node->tailIndex < search.bestIndex) {
+      record(search, node->tailIndex, depth, position < search.size ? position : -1);
+    }
+
+  }
+
+  if(position == search.size) {
+    return;
+  }
+
+  /*
+   * Const segment followed by '?' matches only if the pattern ends here, or is followed by the tail.
+   * The query is then captured as the tail.
+   */
+
+  v_buff_size segmentEnd = position;
+  v_buff_size queryPosition = -1;
+
+  while(segmentEnd < search.size && search.data[segmentEnd] != '/') {
+    if(search.data[segmentEnd] == '?') {
+      if(queryPosition == -1) {
+        queryPosition = segmentEnd;
+      }
+      auto child = findConst(search, node, position, segmentEnd);
+      if(child != nullptr) {
+        if(child->endIndex != NO_MATCH && child->endIndex < search.bestIndex) {
+          record(search, child->endIndex, depth, segmentEnd);
+        }
+        if(child->tailIndex != NO_MATCH && child->tailIndex < search.bestIndex) {
+          record(search, child->tailIndex, depth, segmentEnd);
+        }
+      }
+    }
+    segmentEnd ++;
+  }
+
+  auto child = findConst(search, node, position, segmentEnd);
+  if(child != nullptr) {
+    visit(search, child, segmentEnd, depth, false);
+  }
+
+  const Node* varNode = node->varChild.get();
+  if(varNode == nullptr || varNode->minIndex >= search.bestIndex) {
+    return;
+  }
+
+  if(queryPosition != -1) {
+
+    search.captures[depth] = {position, queryPosition - position};
+    if(varNode->endIndex != NO_MATCH && varNode->endIndex < search.bestIndex) {
+      record(search, varNode->endIndex, depth + 1, queryPosition);
+    }
+    if(varNode->tailIndex != NO_MATCH && varNode->tailIndex < search.bestIndex) {
+      record(search, varNode->tailIndex, depth + 1, queryPosition);
+    }
+
+    /* pattern continues after the variable - variable value spans till the next '/' */
+    search.captures[depth] = {position, segmentEnd - position};
+    visit(search, varNode, segmentEnd, depth + 1, true);
+
+  } else {
+    search.captures[depth] = {position, segmentEnd - position};
+    visit(search, varNode, segmentEnd, depth + 1, false);
+  }
+
+}
+
+v_int64 PatternTree::match(const StringKeyLabel& url, Pattern::MatchMap& matchMap) const {
+
+  /* patterns with a few variables are matched without heap allocations */
+  Capture inlineCaptures[INLINE_CAPTURES * 2];
+  std::vector<Capture> heapCaptures;
+  Capture* captures = inlineCaptures;
+  if(m_maxVariables > INLINE_CAPTURES) {
+    heapCaptures.resize(static_cast<size_t>(m_maxVariables) * 2);
+    captures = heapCaptures.data();
+  }
+
+  Search search;
+  search.data = reinterpret_cast<const char*>(url.getData());
+  search.size = url.getSize();
+  search.captures = captures;
+  search.bestCaptures = captures + m_maxVariables;
+  search.bestIndex = static_cast<v_int64>(m_variableNames.size());
+  search.bestTail = -1;
+
+  visit(search, &m_root, 0, 0, false);
+
+  if(search.bestIndex == static_cast<v_int64>(m_variableNames.size())) {
+    return NO_MATCH;
+  }
+
+  const auto& names = m_variableNames[static_cast<size_t>(search.bestIndex)];
+  matchMap.m_variables.reserve(static_cast<v_buff_size>(names.size()));
+  for(size_t i = 0; i < names.size(); i ++) {
+    const auto& capture = search.bestCaptures[i];
+    matchMap.m_variables[names[i]] = StringKeyLabel(url.getMemoryHandle(), search.data + capture.position, capture.size);
+  }
+
+  if(search.bestTail != -1) {
+    matchMap.m_tail = StringKeyLabel(url.getMemoryHandle(), search.data + search.bestTail, search.size - search.bestTail);
+  }
+
+  return search.bestIndex;
+
+}
+
+v_int64 PatternTree::size() const {
+  return static_cast<v_int64>(m_variableNames.size());
+}
+
+}}}}
@@ -0,0 +1,141 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_url_mapping_PatternTree_hpp
+#define oatpp_web_url_mapping_PatternTree_hpp
+
+#include "./Pattern.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace web { namespace url { namespace mapping {
+
+/**
+ * Radix tree of &id:oatpp::web::url::mapping::Pattern;s. <br>
+ * Patterns are indexed in the order they were added. Const segments are stored in per-node hash maps,
+ * `{var}` captures and `*` tails are stored as dedicated branches, so a path is resolved in a single walk
+ * instead of matching every pattern one by one. <br>
+ * Precedence is the same as for sequential matching with &id:oatpp::web::url::mapping::Pattern::match; -
+ * if several patterns match the path, the one added first wins.
+ */
+class PatternTree {
+private:
+  typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
+private:
+
+  struct Node {
+
+    Node(v_int64 pMinIndex)
+      : endIndex(NO_MATCH)
+      , tailIndex(NO_MATCH)
+      , minIndex(pMinIndex)
+    {}
+
+    std::unordered_map<StringKeyLabel, std::unique_ptr<Node>> constChildren;
+    std::unique_ptr<Node> varChild;
+
+    /*
+     * Index of the first pattern ending at this node.
+     */
+    v_int64 endIndex;
+
+    /*
+     * Index of the first pattern having `*` tail right after this node.
+     */
+    v_int64 tailIndex;
+
+    /*
+     * Smallest pattern index in this node's subtree.
+     */
+    v_int64 minIndex;
+
+  };
+
+  static constexpr v_int32 INLINE_CAPTURES = 16;
+
+  struct Capture {
+    v_buff_size position;
+    v_buff_size size;
+  };
+
+  struct Search {
+    const char* data;
+    v_buff_size size;
+    Capture* captures;
+    Capture* bestCaptures;
+    v_int64 bestIndex;
+    v_buff_size bestTail;
+  };
+
+private:
+  void record(Search& search, v_int64 index, v_int32 depth, v_buff_size tailPosition) const;
+  const Node* findConst(const Search& search, const Node* node, v_buff_size position, v_buff_size end) const;
+  void visit(Search& search, const Node* node, v_buff_size position, v_int32 depth, bool childrenOnly) const;
+private:
+  Node m_root;
+  std::vector<std::vector<StringKeyLabel>> m_variableNames;
+  v_int32 m_maxVariables;
+public:
+
+  /**
+   * Index returned by &l:PatternTree::match (); when no pattern matches.
+   */
+  static constexpr v_int64 NO_MATCH = -1;
+
+public:
+
+  /**
+   * Default constructor.
+   */
+  PatternTree();
+
+  /**
+   * Add pattern to the tree.
+   * @param pattern - &id:oatpp::web::url::mapping::Pattern;.
+   * @return - index of the added pattern.
+   */
+  v_int64 add(const std::shared_ptr<Pattern>& pattern);
+
+  /**
+   * Match url against all patterns added.
+   * @param url - url.
+   * @param matchMap - &id:oatpp::web::url::mapping::Pattern::MatchMap; to put resolved path variables and tail to.
+   * @return - index of the matched pattern or &l:PatternTree::NO_MATCH;.
+   */
+  v_int64 match(const StringKeyLabel& url, Pattern::MatchMap& matchMap) const;
+
+  /**
+   * Get number of patterns added.
+   * @return
+   */
+  v_int64 size() const;
+
+};
+
+}}}}
+
+#endif /* oatpp_web_url_mapping_PatternTree_hpp */
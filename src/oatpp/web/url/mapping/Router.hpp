@@ -25,18 +25,20 @@
 #ifndef oatpp_web_url_mapping_Router_hpp
 #define oatpp_web_url_mapping_Router_hpp
 
-#include "./Pattern.hpp"
+#include "./PatternTree.hpp"
 
 #include "oatpp/Types.hpp"
 #include "oatpp/base/Log.hpp"
 
 #include <utility>
-#include <list>
+#include <vector>
 
 namespace oatpp { namespace web { namespace url { namespace mapping {
 
 /**
- * Class responsible to map "Path" to "Route" by "Path-Pattern".
+ * Class responsible to map "Path" to "Route" by "Path-Pattern". <br>
+ * Patterns are compiled into &id:oatpp::web::url::mapping::PatternTree; at &l:Router::route (); time,
+ * so resolving a path doesn't depend on the number of routes. If multiple patterns match the path - the one routed first wins.
  * @tparam Endpoint - endpoint of the route.
  */
 template<typename Endpoint>
@@ -79,7 +81,7 @@ public:
     Route(const Endpoint& endpoint, Pattern::MatchMap&& matchMap)
       : m_valid(true)
       , m_endpoint(endpoint)
-      , m_matchMap(matchMap)
+      , m_matchMap(std::move(matchMap))
     {}
 
     /**
@@ -111,7 +113,8 @@ public:
   };
   
 private:
-  std::list<Pair> m_endpointsByPattern;
+  std::vector<Pair> m_endpointsByPattern;
+  PatternTree m_tree;
 public:
   
   static std::shared_ptr<Router> createShared(){
@@ -126,6 +129,7 @@ public:
   void route(const oatpp::String& pathPattern, const Endpoint& endpoint) {
     auto pattern = Pattern::parse(pathPattern);
     m_endpointsByPattern.push_back({pattern, endpoint});
+    m_tree.add(pattern);
   }
 
   /**
@@ -135,11 +139,10 @@ public:
    */
   Route getRoute(const StringKeyLabel& path) const {
 
-    for(auto& pair : m_endpointsByPattern) {
-      Pattern::MatchMap matchMap;
-      if(pair.first->match(path, matchMap)) {
-        return Route(pair.second, std::move(matchMap));
-      }
+    Pattern::MatchMap matchMap;
+    auto index = m_tree.match(path, matchMap);
+    if(index != PatternTree::NO_MATCH) {
+      return Route(m_endpointsByPattern[static_cast<size_t>(index)].second, std::move(matchMap));
     }
 
     return Route();
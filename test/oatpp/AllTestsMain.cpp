@@ -5,11 +5,22 @@
 #include "oatpp/web/FullAsyncClientTest.hpp"
 #include "oatpp/web/PipelineTest.hpp"
 #include "oatpp/web/PipelineAsyncTest.hpp"
+#include "oatpp/web/PipelinePerfTest.hpp"
+#include "oatpp/web/NotFoundPerfTest.hpp"
 #include "oatpp/web/protocol/http/encoding/ChunkedTest.hpp"
+#include "oatpp/web/protocol/http/encoding/DeflateTest.hpp"
+#include "oatpp/web/protocol/http/FileBodyTest.hpp"
+#include "oatpp/web/protocol/http/DtoBodyTest.hpp"
+#include "oatpp/web/protocol/http/HeadersPerfTest.hpp"
 #include "oatpp/web/server/api/ApiControllerTest.hpp"
 #include "oatpp/web/server/handler/AuthorizationHandlerTest.hpp"
+#include "oatpp/web/server/handler/StaticFilesHandlerTest.hpp"
+#include "oatpp/web/server/HttpRouterPerfTest.hpp"
 #include "oatpp/web/server/HttpRouterTest.hpp"
 #include "oatpp/web/server/ServerStopTest.hpp"
+#include "oatpp/web/server/HttpWorkerPoolTest.hpp"
+#include "oatpp/web/server/AdmissionControlTest.hpp"
+#include "oatpp/web/server/interceptor/ResponseCacheTest.hpp"
 #include "oatpp/web/mime/multipart/StatefulParserTest.hpp"
 #include "oatpp/web/mime/ContentMappersTest.hpp"
 
@@ -18,6 +29,7 @@
 #include "oatpp/network/UrlTest.hpp"
 #include "oatpp/network/ConnectionPoolTest.hpp"
 #include "oatpp/network/monitor/ConnectionMonitorTest.hpp"
+#include "oatpp/network/tcp/AcceptPerfTest.hpp"
 
 #include "oatpp/json/DeserializerTest.hpp"
 #include "oatpp/json/DTOMapperPerfTest.hpp"
@@ -25,6 +37,11 @@
 #include "oatpp/json/EnumTest.hpp"
 #include "oatpp/json/BooleanTest.hpp"
 #include "oatpp/json/UnorderedSetTest.hpp"
+#include "oatpp/json/UtilsTest.hpp"
+#include "oatpp/json/ObjectSerializerTest.hpp"
+#include "oatpp/json/ObjectDeserializerTest.hpp"
+#include "oatpp/json/ObjectReaderTest.hpp"
+#include "oatpp/json/ObjectWriterTest.hpp"
 
 #include "oatpp/encoding/Base64Test.hpp"
 #include "oatpp/encoding/HexTest.hpp"
@@ -32,10 +49,15 @@
 #include "oatpp/encoding/UrlTest.hpp"
 
 #include "oatpp/utils/parser/CaretTest.hpp"
+#include "oatpp/utils/CharScanTest.hpp"
 #include "oatpp/provider/PoolTest.hpp"
 #include "oatpp/provider/PoolTemplateTest.hpp"
 #include "oatpp/async/ConditionVariableTest.hpp"
+#include "oatpp/async/FramePoolPerfTest.hpp"
+#include "oatpp/async/IOWorkerPerfTest.hpp"
 #include "oatpp/async/LockTest.hpp"
+#include "oatpp/async/TimerPerfTest.hpp"
+#include "oatpp/async/WorkStealingPerfTest.hpp"
 
 #include "oatpp/data/type/UnorderedMapTest.hpp"
 #include "oatpp/data/type/PairListTest.hpp"
@@ -64,6 +86,7 @@
 #include "oatpp/data/share/LazyStringMapTest.hpp"
 #include "oatpp/data/share/StringTemplateTest.hpp"
 #include "oatpp/data/share/MemoryLabelTest.hpp"
+#include "oatpp/data/buffer/BufferPoolPerfTest.hpp"
 #include "oatpp/data/buffer/ProcessorTest.hpp"
 
 #include "oatpp/base/CommandLineArgumentsTest.hpp"
@@ -115,6 +138,7 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::data::share::StringTemplateTest);
 
   OATPP_RUN_TEST(oatpp::data::buffer::ProcessorTest);
+  OATPP_RUN_TEST(oatpp::data::buffer::BufferPoolPerfTest);
   OATPP_RUN_TEST(oatpp::data::stream::BufferStreamTest);
 
   OATPP_RUN_TEST(oatpp::data::mapping::TreeTest);
@@ -145,8 +169,13 @@ void runTests() {
 
   OATPP_RUN_TEST(oatpp::async::ConditionVariableTest);
   OATPP_RUN_TEST(oatpp::async::LockTest);
+  OATPP_RUN_TEST(oatpp::async::FramePoolPerfTest);
+  OATPP_RUN_TEST(oatpp::async::WorkStealingPerfTest);
+  OATPP_RUN_TEST(oatpp::async::TimerPerfTest);
+  OATPP_RUN_TEST(oatpp::async::IOWorkerPerfTest);
 
   OATPP_RUN_TEST(oatpp::utils::parser::CaretTest);
+  OATPP_RUN_TEST(oatpp::utils::CharScanTest);
 
   OATPP_RUN_TEST(oatpp::provider::PoolTest);
   OATPP_RUN_TEST(oatpp::provider::PoolTemplateTest);
@@ -155,12 +184,17 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::json::BooleanTest);
 
   OATPP_RUN_TEST(oatpp::json::UnorderedSetTest);
+  OATPP_RUN_TEST(oatpp::json::UtilsTest);
 
   OATPP_RUN_TEST(oatpp::json::DeserializerTest);
 
   OATPP_RUN_TEST(oatpp::json::DTOMapperPerfTest);
 
   OATPP_RUN_TEST(oatpp::json::DTOMapperTest);
+  OATPP_RUN_TEST(oatpp::json::ObjectSerializerTest);
+  OATPP_RUN_TEST(oatpp::json::ObjectDeserializerTest);
+  OATPP_RUN_TEST(oatpp::json::ObjectReaderTest);
+  OATPP_RUN_TEST(oatpp::json::ObjectWriterTest);
   OATPP_RUN_TEST(oatpp::test::encoding::Base64Test);
   OATPP_RUN_TEST(oatpp::encoding::HexTest);
   OATPP_RUN_TEST(oatpp::test::encoding::UnicodeTest);
@@ -169,17 +203,24 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::test::network::UrlTest);
   OATPP_RUN_TEST(oatpp::test::network::ConnectionPoolTest);
   OATPP_RUN_TEST(oatpp::test::network::monitor::ConnectionMonitorTest);
+  OATPP_RUN_TEST(oatpp::test::network::tcp::AcceptPerfTest);
   OATPP_RUN_TEST(oatpp::test::network::virtual_::PipeTest);
   OATPP_RUN_TEST(oatpp::test::network::virtual_::InterfaceTest);
 
   OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::ChunkedTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::DeflateTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::HeadersPerfTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::FileBodyTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::DtoBodyTest);
 
   OATPP_RUN_TEST(oatpp::test::web::mime::multipart::StatefulParserTest);
   OATPP_RUN_TEST(oatpp::web::mime::ContentMappersTest);
 
   OATPP_RUN_TEST(oatpp::test::web::server::HttpRouterTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::HttpRouterPerfTest);
   OATPP_RUN_TEST(oatpp::test::web::server::api::ApiControllerTest);
   OATPP_RUN_TEST(oatpp::test::web::server::handler::AuthorizationHandlerTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::handler::StaticFilesHandlerTest);
 
   {
 
@@ -191,6 +232,10 @@ void runTests() {
 
   }
 
+  OATPP_RUN_TEST(oatpp::test::web::server::HttpWorkerPoolTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::AdmissionControlTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::interceptor::ResponseCacheTest);
+
   {
 
     oatpp::test::web::PipelineTest test_virtual(0, 3000);
@@ -211,6 +256,15 @@ void runTests() {
 
   }
 
+  {
+
+    oatpp::test::web::PipelinePerfTest test(3000);
+    test.run();
+
+  }
+
+  OATPP_RUN_TEST(oatpp::test::web::NotFoundPerfTest);
+
   {
 
     oatpp::test::web::FullTest test_virtual(0, 1000);
@@ -229,6 +283,9 @@ void runTests() {
     oatpp::test::web::FullAsyncTest test_port(8000, 5);
     test_port.run();
 
+    oatpp::test::web::FullAsyncTest test_port_uring(8000, 5, oatpp::async::Executor::IO_WORKER_TYPE_URING);
+    test_port_uring.run();
+
   }
 
   {
@@ -0,0 +1,182 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "FramePoolPerfTest.hpp"
+
+#include "oatpp/async/utils/FramePool.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<IncomingRequest> m_request;
+    public:
+
+      HelloCoroutine(const std::shared_ptr<IncomingRequest>& request)
+        : m_request(request)
+      {}
+
+      Action act() override {
+        return m_request->readBodyToStringAsync().callbackTo(&HelloCoroutine::onBody);
+      }
+
+      Action onBody(const oatpp::String& body) {
+        (void) body;
+        return _return(OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello")));
+      }
+
+    };
+
+    return HelloCoroutine::startForResult(request);
+
+  }
+
+};
+
+void runMicroBenchmark(v_int32 iterations) {
+
+  const std::size_t sizes[] = {48, 96, 160, 256, 400};
+  std::vector<void*> ptrs(5 * 8);
+
+  {
+    oatpp::test::PerformanceChecker checker("::operator new/delete");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      for(std::size_t j = 0; j < ptrs.size(); j ++) {
+        ptrs[j] = ::operator new(sizes[j % 5]);
+      }
+      for(std::size_t j = 0; j < ptrs.size(); j ++) {
+        ::operator delete(ptrs[j]);
+      }
+    }
+  }
+
+  {
+    oatpp::test::PerformanceChecker checker("FramePool allocate/deallocate");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      for(std::size_t j = 0; j < ptrs.size(); j ++) {
+        ptrs[j] = oatpp::async::utils::FramePool::allocate(sizes[j % 5]);
+      }
+      for(std::size_t j = 0; j < ptrs.size(); j ++) {
+        oatpp::async::utils::FramePool::deallocate(ptrs[j], sizes[j % 5]);
+      }
+    }
+  }
+
+}
+
+void runTrafficBenchmark(v_int32 warmupRequests, v_int32 requests) {
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("POST", "/", std::make_shared<HelloHandler>());
+
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  auto connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+  auto connection = requestExecutor.getConnection();
+
+  auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello Server");
+
+  auto doRequest = [&]{
+    auto response = requestExecutor.execute("POST", "/", oatpp::web::protocol::http::Headers({}), body, connection);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString() == "Hello")
+  };
+
+  for(v_int32 i = 0; i < warmupRequests; i ++) {
+    doRequest();
+  }
+
+  auto allocationsBefore = oatpp::async::utils::FramePool::getSystemAllocationsCount();
+
+  {
+    oatpp::test::PerformanceChecker checker("Async requests");
+    for(v_int32 i = 0; i < requests; i ++) {
+      doRequest();
+    }
+  }
+
+  auto allocations = oatpp::async::utils::FramePool::getSystemAllocationsCount() - allocationsBefore;
+  OATPP_LOGd("FramePoolPerfTest", "requests={}, frame system allocations={}", requests, allocations)
+
+#if !defined(OATPP_DISABLE_POOL_ALLOCATIONS) && !defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  /* in steady state coroutine frames and handles are reused */
+  OATPP_ASSERT(allocations < requests / 10)
+#endif
+
+  requestExecutor.invalidateConnection(connection);
+  connection.reset();
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+}
+
+void FramePoolPerfTest::onRun() {
+  runMicroBenchmark(100000);
+  runTrafficBenchmark(500, 5000);
+}
+
+}}
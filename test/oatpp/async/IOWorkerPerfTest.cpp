@@ -0,0 +1,145 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "IOWorkerPerfTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/worker/IOUringWorker.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<IncomingRequest> m_request;
+    public:
+
+      HelloCoroutine(const std::shared_ptr<IncomingRequest>& request)
+        : m_request(request)
+      {}
+
+      Action act() override {
+        return _return(OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello")));
+      }
+
+    };
+
+    return HelloCoroutine::startForResult(request);
+
+  }
+
+};
+
+void runBenchmark(const char* tag, v_int32 ioWorkerType, v_int32 clientsCount, v_int32 requestsPerClient) {
+
+  auto serverConnectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
+    {"127.0.0.1", 0, oatpp::network::Address::IP_4}
+  );
+  auto port = serverConnectionProvider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+  );
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/", std::make_shared<HelloHandler>());
+
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1, ioWorkerType);
+  auto connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  {
+    oatpp::test::PerformanceChecker checker(tag);
+
+    std::vector<std::thread> clients;
+    for(v_int32 c = 0; c < clientsCount; c ++) {
+      clients.emplace_back([clientConnectionProvider, requestsPerClient] {
+        oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+        auto connection = requestExecutor.getConnection();
+        for(v_int32 i = 0; i < requestsPerClient; i ++) {
+          auto response = requestExecutor.execute("GET", "/", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+          OATPP_ASSERT(response->getStatusCode() == 200)
+          OATPP_ASSERT(response->readBodyToString() == "Hello")
+        }
+        requestExecutor.invalidateConnection(connection);
+      });
+    }
+
+    for(auto& client : clients) {
+      client.join();
+    }
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+}
+
+void IOWorkerPerfTest::onRun() {
+
+  runBenchmark("Async server, epoll", oatpp::async::Executor::IO_WORKER_TYPE_EVENT, 8, 1000);
+
+  if(oatpp::async::worker::IOUringWorker::isSupported()) {
+    runBenchmark("Async server, io_uring", oatpp::async::Executor::IO_WORKER_TYPE_URING, 8, 1000);
+  } else {
+    OATPP_LOGw("IOWorkerPerfTest", "io_uring is not supported by the system - skipping")
+  }
+
+}
+
+}}
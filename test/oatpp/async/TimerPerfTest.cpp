@@ -0,0 +1,112 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "TimerPerfTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+struct TimerStats {
+  std::atomic<v_int32> fired{0};
+  std::atomic<v_int64> latenessSum{0};
+  std::atomic<v_int64> latenessMax{0};
+};
+
+class TimerCoroutine : public oatpp::async::Coroutine<TimerCoroutine> {
+private:
+  TimerStats* m_stats;
+  v_int64 m_delay;
+  v_int64 m_timePoint;
+public:
+
+  TimerCoroutine(TimerStats* stats, v_int64 delayMicroseconds)
+    : m_stats(stats)
+    , m_delay(delayMicroseconds)
+    , m_timePoint(0)
+  {}
+
+  Action act() override {
+    if(m_timePoint == 0) {
+      m_timePoint = oatpp::Environment::getMicroTickCount() + m_delay;
+      return Action::createWaitRepeatAction(m_timePoint);
+    }
+    v_int64 lateness = oatpp::Environment::getMicroTickCount() - m_timePoint;
+    m_stats->latenessSum += lateness;
+    v_int64 max = m_stats->latenessMax.load();
+    while(lateness > max && !m_stats->latenessMax.compare_exchange_weak(max, lateness)) {}
+    ++ m_stats->fired;
+    return finish();
+  }
+
+};
+
+void runTimers(const char* tag, v_int32 timersCount, v_int64 minDelay, v_int64 delaySpread, v_int64 maxAllowedLateness) {
+
+  oatpp::async::Executor executor(1, 1, 1);
+  TimerStats stats;
+
+  {
+    oatpp::test::PerformanceChecker checker(tag);
+
+    for(v_int32 i = 0; i < timersCount; i ++) {
+      executor.execute<TimerCoroutine>(&stats, minDelay + (static_cast<v_int64>(i) * 7919) % delaySpread);
+    }
+
+    while(stats.fired.load() < timersCount) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  OATPP_LOGd("TimerPerfTest", "{}: timers={}, avg lateness={}(micro), max lateness={}(micro)",
+             tag, timersCount, stats.latenessSum.load() / timersCount, stats.latenessMax.load())
+
+  if(maxAllowedLateness > 0) {
+    OATPP_ASSERT(stats.latenessMax.load() < maxAllowedLateness)
+  }
+
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+
+}
+
+}
+
+void TimerPerfTest::onRun() {
+  /* precision - timers on an idle executor fire with sub-millisecond lateness */
+  runTimers("Precision, 100 timers", 100, 1000, 10000, 50000);
+  /* scale - 1M pending timers, delays exceed the time it takes to schedule them all */
+  runTimers("Scale, 1M timers", 1000000, 2000000, 1000000, 0);
+}
+
+}}
@@ -0,0 +1,123 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "WorkStealingPerfTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+class SkewedCoroutine : public oatpp::async::Coroutine<SkewedCoroutine> {
+private:
+  std::atomic<v_int32>* m_counter;
+  v_int32 m_steps;
+  std::chrono::microseconds m_stepCost;
+public:
+
+  SkewedCoroutine(std::atomic<v_int32>* counter, v_int32 steps, v_int64 stepCostMicroseconds)
+    : m_counter(counter)
+    , m_steps(steps)
+    , m_stepCost(stepCostMicroseconds)
+  {}
+
+  Action act() override {
+    if(m_steps == 0) {
+      ++ (*m_counter);
+      return finish();
+    }
+    -- m_steps;
+    /* burn CPU - emulate a heavy step which doesn't give the processor thread away */
+    auto end = std::chrono::steady_clock::now() + m_stepCost;
+    while(std::chrono::steady_clock::now() < end) {}
+    return repeat();
+  }
+
+};
+
+void runSkewedLoad(bool workStealing, v_int32 coroutinesCount, v_int32 heavySteps, v_int64 stepCostMicroseconds) {
+
+  const v_int32 processorsCount = 4;
+
+  oatpp::async::Executor executor(processorsCount, 1, 1, oatpp::async::Executor::VALUE_SUGGESTED, workStealing);
+  std::atomic<v_int32> counter(0);
+
+  {
+    oatpp::test::PerformanceChecker checker(workStealing ? "Skewed load, work-stealing" : "Skewed load, no work-stealing");
+
+    /* executor balances submissions round-robin - every heavy coroutine lands on the same processor */
+    for(v_int32 i = 0; i < coroutinesCount; i ++) {
+      if(i % processorsCount == 0) {
+        executor.execute<SkewedCoroutine>(&counter, heavySteps, stepCostMicroseconds);
+      } else {
+        executor.execute<SkewedCoroutine>(&counter, 0, 0);
+      }
+    }
+
+    while(counter.load() < coroutinesCount) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  v_int64 stolen = 0;
+  v_int64 given = 0;
+  auto stats = executor.getProcessorsStats();
+  OATPP_ASSERT(stats.size() == processorsCount)
+  for(size_t i = 0; i < stats.size(); i ++) {
+    auto& s = stats[i];
+    OATPP_LOGd("WorkStealingPerfTest", "processor[{}]: maxQueueDepth={}, stolen={}, given={}", i, s.maxQueueDepth, s.stolenTasks, s.givenTasks)
+    stolen += s.stolenTasks;
+    given += s.givenTasks;
+  }
+
+  OATPP_ASSERT(stolen == given)
+  if(workStealing) {
+    OATPP_ASSERT(stolen > 0)
+  } else {
+    OATPP_ASSERT(stolen == 0)
+  }
+
+  executor.waitTasksFinished();
+  OATPP_ASSERT(executor.getTasksCount() == 0)
+
+  executor.stop();
+  executor.join();
+
+}
+
+}
+
+void WorkStealingPerfTest::onRun() {
+  runSkewedLoad(false, 256, 20, 50);
+  runSkewedLoad(true, 256, 20, 50);
+}
+
+}}
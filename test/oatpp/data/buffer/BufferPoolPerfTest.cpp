@@ -0,0 +1,302 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BufferPoolPerfTest.hpp"
+
+#include "oatpp/data/buffer/BufferPool.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace data { namespace buffer {
+
+namespace {
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request->readBodyToString();
+    return OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello"));
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<IncomingRequest> m_request;
+    public:
+
+      HelloCoroutine(const std::shared_ptr<IncomingRequest>& request)
+        : m_request(request)
+      {}
+
+      Action act() override {
+        return m_request->readBodyToStringAsync().callbackTo(&HelloCoroutine::onBody);
+      }
+
+      Action onBody(const oatpp::String& body) {
+        (void) body;
+        return _return(OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello")));
+      }
+
+    };
+
+    return HelloCoroutine::startForResult(request);
+
+  }
+
+};
+
+void testLeases() {
+
+  {
+    auto buffer = BufferPool::getBuffer(100);
+    OATPP_ASSERT(static_cast<v_buff_size>(buffer->size()) >= 100)
+    auto stream = BufferPool::getOutputStream(3000);
+    OATPP_ASSERT(stream->getCapacity() >= 3000)
+    OATPP_ASSERT(stream->getCurrentPosition() == 0)
+    *stream << "Hello World!";
+  }
+
+  {
+    auto stream = BufferPool::getOutputStream(3000);
+    OATPP_ASSERT(stream->getCapacity() >= 3000)
+    OATPP_ASSERT(stream->getCurrentPosition() == 0)
+  }
+
+  {
+    auto buffer = BufferPool::getBuffer(BufferPool::MAX_POOLED_SIZE + 1);
+    OATPP_ASSERT(static_cast<v_buff_size>(buffer->size()) == BufferPool::MAX_POOLED_SIZE + 1)
+  }
+
+#if !defined(OATPP_DISABLE_POOL_ALLOCATIONS) && !defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  {
+    const void* data;
+    {
+      auto buffer = BufferPool::getBuffer(4096);
+      OATPP_ASSERT(buffer->size() == 4096)
+      data = buffer->data();
+    }
+    auto buffer = BufferPool::getBuffer(4000);
+    OATPP_ASSERT(buffer->size() == 4096)
+    OATPP_ASSERT(buffer->data() == data)
+  }
+#endif
+
+}
+
+void runMicroBenchmark(v_int32 iterations) {
+
+  std::vector<std::shared_ptr<std::string>> buffers(16);
+  std::vector<std::shared_ptr<oatpp::data::stream::BufferOutputStream>> streams(32);
+
+  {
+    oatpp::test::PerformanceChecker checker("std::make_shared buffers and streams");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      for(std::size_t j = 0; j < buffers.size(); j ++) {
+        buffers[j] = std::make_shared<std::string>(4096, 0);
+        streams[j * 2] = std::make_shared<oatpp::data::stream::BufferOutputStream>(2048);
+        streams[j * 2 + 1] = std::make_shared<oatpp::data::stream::BufferOutputStream>(2048);
+      }
+      for(std::size_t j = 0; j < buffers.size(); j ++) {
+        buffers[j].reset();
+        streams[j * 2].reset();
+        streams[j * 2 + 1].reset();
+      }
+    }
+  }
+
+  {
+    oatpp::test::PerformanceChecker checker("BufferPool buffers and streams");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      for(std::size_t j = 0; j < buffers.size(); j ++) {
+        buffers[j] = BufferPool::getBuffer(4096);
+        streams[j * 2] = BufferPool::getOutputStream(2048);
+        streams[j * 2 + 1] = BufferPool::getOutputStream(2048);
+      }
+      for(std::size_t j = 0; j < buffers.size(); j ++) {
+        buffers[j].reset();
+        streams[j * 2].reset();
+        streams[j * 2 + 1].reset();
+      }
+    }
+  }
+
+}
+
+/*
+ * New connection for every request - buffers of finished connection threads are reused by the new ones.
+ */
+void runChurnBenchmark(v_int32 warmupConnections, v_int32 connections) {
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("POST", "/", std::make_shared<HelloHandler>());
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+  auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello Server");
+
+  oatpp::web::protocol::http::Headers headers;
+  headers.put("Connection", "close");
+
+  auto doRequest = [&]{
+    auto connection = requestExecutor.getConnection();
+    auto response = requestExecutor.execute("POST", "/", headers, body, connection);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString() == "Hello")
+    requestExecutor.invalidateConnection(connection);
+  };
+
+  for(v_int32 i = 0; i < warmupConnections; i ++) {
+    doRequest();
+  }
+
+  auto allocationsBefore = BufferPool::getSystemAllocationsCount();
+
+  {
+    oatpp::test::PerformanceChecker checker("Sync connections churn");
+    for(v_int32 i = 0; i < connections; i ++) {
+      doRequest();
+    }
+  }
+
+  auto allocations = BufferPool::getSystemAllocationsCount() - allocationsBefore;
+  OATPP_LOGd("BufferPoolPerfTest", "connections={}, buffer system allocations={}", connections, allocations)
+
+#if !defined(OATPP_DISABLE_POOL_ALLOCATIONS) && !defined(OATPP_COMPAT_BUILD_NO_THREAD_LOCAL)
+  /* in steady state connection buffers are reused */
+  OATPP_ASSERT(allocations < connections / 10)
+#endif
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+}
+
+/*
+ * Keep-alive connections which return their buffers to the pool between requests.
+ */
+void runIdleConnectionsTest(bool async, v_int32 connectionsCount, v_int32 roundsCount) {
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("POST", "/", std::make_shared<HelloHandler>());
+
+  auto config = std::make_shared<oatpp::web::server::HttpProcessor::Config>();
+  config->releaseBuffersWhenIdle = true;
+  auto components = std::make_shared<oatpp::web::server::HttpProcessor::Components>(router, config);
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(components, executor);
+  } else {
+    connectionHandler = std::make_shared<oatpp::web::server::HttpConnectionHandler>(components);
+  }
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+  auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello Server");
+
+  std::vector<std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle>> connections;
+  for(v_int32 i = 0; i < connectionsCount; i ++) {
+    connections.push_back(requestExecutor.getConnection());
+  }
+
+  {
+    oatpp::test::PerformanceChecker checker(async ? "Async idle connections" : "Sync idle connections");
+    for(v_int32 round = 0; round < roundsCount; round ++) {
+      for(auto& connection : connections) {
+        auto response = requestExecutor.execute("POST", "/", oatpp::web::protocol::http::Headers({}), body, connection);
+        OATPP_ASSERT(response->getStatusCode() == 200)
+        OATPP_ASSERT(response->readBodyToString() == "Hello")
+      }
+    }
+  }
+
+  for(auto& connection : connections) {
+    requestExecutor.invalidateConnection(connection);
+  }
+  connections.clear();
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+}
+
+}
+
+void BufferPoolPerfTest::onRun() {
+  testLeases();
+  runMicroBenchmark(100000);
+  runChurnBenchmark(200, 2000);
+  runIdleConnectionsTest(false, 20, 50);
+  runIdleConnectionsTest(true, 20, 50);
+}
+
+}}}
@@ -28,8 +28,27 @@
 #include "oatpp/utils/Conversion.hpp"
 #include "oatpp/utils/Binary.hpp"
 
+#include <cstring>
+
 namespace oatpp { namespace data { namespace stream {
 
+namespace {
+
+class CountingWriteCallback : public WriteCallback {
+public:
+  BufferOutputStream stream;
+  v_int32 writesCount = 0;
+public:
+
+  v_io_size write(const void *data, v_buff_size count, async::Action& action) override {
+    ++ writesCount;
+    return stream.write(data, count, action);
+  }
+
+};
+
+}
+
 void BufferStreamTest::onRun() {
 
   {
@@ -142,6 +161,58 @@ void BufferStreamTest::onRun() {
 
   }
 
+  { // vectored write - default implementation
+
+    BufferOutputStream stream(0);
+
+    data::buffer::InlineWriteData buffers[4] = {
+      {"Hello", 5},
+      {nullptr, 0},
+      {" ", 1},
+      {"World!", 6}
+    };
+
+    auto res = stream.writevExactSizeDataSimple(buffers, 4);
+
+    OATPP_ASSERT(res == 12)
+    OATPP_ASSERT(stream.toString() == "Hello World!")
+    for(auto& buffer : buffers) {
+      OATPP_ASSERT(buffer.bytesLeft == 0)
+    }
+
+  }
+
+  { // vectored write - default implementation coalesces small buffers
+
+    CountingWriteCallback callback;
+
+    data::buffer::InlineWriteData buffers[3] = {
+      {"Hello", 5},
+      {" ", 1},
+      {"World!", 6}
+    };
+
+    OATPP_ASSERT(callback.writevExactSizeDataSimple(buffers, 3) == 12)
+    OATPP_ASSERT(callback.writesCount == 1)
+    OATPP_ASSERT(callback.stream.toString() == "Hello World!")
+
+    /* large buffer is written as is, after the small ones */
+    oatpp::String large(10000);
+    std::memset(large->data(), 'x', large->size());
+
+    CountingWriteCallback largeCallback;
+    data::buffer::InlineWriteData largeBuffers[3] = {
+      {"Hello", 5},
+      {" ", 1},
+      {large->data(), static_cast<v_buff_size>(large->size())}
+    };
+
+    OATPP_ASSERT(largeCallback.writevExactSizeDataSimple(largeBuffers, 3) == 10006)
+    OATPP_ASSERT(largeCallback.writesCount == 2)
+    OATPP_ASSERT(largeCallback.stream.toString() == "Hello " + *large)
+
+  }
+
 }
 
 }}}
@@ -0,0 +1,472 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectDeserializerTest.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace json {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 1, "red"),
+  VALUE(GREEN, 2, "green")
+);
+
+class Child : public oatpp::DTO {
+
+  DTO_INIT(Child, DTO)
+
+  DTO_FIELD(String, name, "child-name");
+  DTO_FIELD(Int32, value);
+  DTO_FIELD(List<Object<Child>>, children);
+
+};
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(String, type);
+  DTO_FIELD(Any, payload);
+
+  DTO_FIELD_TYPE_SELECTOR(payload) {
+    if(type == "child") return Object<Child>::Class::getType();
+    if(type == "int") return Int32::Class::getType();
+    return Void::Class::getType();
+  }
+
+};
+
+class Root : public oatpp::DTO {
+
+  DTO_INIT(Root, DTO)
+
+  DTO_FIELD(String, str, "str-qualified");
+  DTO_FIELD(String, escaped);
+  DTO_FIELD(String, nullStr);
+
+  DTO_FIELD(Int8, i8);
+  DTO_FIELD(UInt8, u8);
+  DTO_FIELD(Int16, i16);
+  DTO_FIELD(UInt16, u16);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(UInt32, u32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(UInt64, u64);
+  DTO_FIELD(Float32, f32);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, b);
+
+  DTO_FIELD(Enum<Color>::AsString, colorStr);
+  DTO_FIELD(Enum<Color>::AsNumber, colorNum);
+  DTO_FIELD(Enum<Color>::AsString, nullColor);
+
+  DTO_FIELD_INFO(requiredStr) {
+    info->required = true;
+  }
+  DTO_FIELD(String, requiredStr);
+
+  DTO_FIELD(List<String>, list);
+  DTO_FIELD(Vector<Object<Child>>, children);
+  DTO_FIELD(UnorderedSet<Int32>, set);
+  DTO_FIELD(Fields<String>, fields);
+  DTO_FIELD(UnorderedFields<List<Int32>>, unorderedFields);
+  DTO_FIELD(List<Object<Item>>, items);
+
+  DTO_FIELD(Any, any);
+  DTO_FIELD(Any, anyNull);
+  DTO_FIELD(Tree, tree);
+  DTO_FIELD(Tree, treeNull);
+
+  DTO_FIELD(Object<Child>, child);
+  DTO_FIELD(Object<Child>, nullChild);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Root> createRoot() {
+
+  auto root = Root::createShared();
+
+  root->str = "Hello";
+  root->escaped = "quote\" backslash\\ tab\t new-line\n unicode-\xD0\x96";
+  root->i8 = -8;
+  root->u8 = 8;
+  root->i16 = -16;
+  root->u16 = 16;
+  root->i32 = -32;
+  root->u32 = 32;
+  root->i64 = -64;
+  root->u64 = 64;
+  root->f32 = 0.5f;
+  root->f64 = 1.25;
+  root->b = true;
+  root->colorStr = Color::RED;
+  root->colorNum = Color::GREEN;
+  root->requiredStr = "required";
+
+  root->list = {"a", nullptr, "c"};
+  root->children = {Child::createShared(), nullptr, Child::createShared()};
+  root->children[0]->name = "first";
+  root->children[0]->value = 1;
+  root->children[0]->children = {Child::createShared()};
+  root->set = {1};
+  root->fields = {{"k1", "v1"}, {"k2", nullptr}};
+  root->unorderedFields = {{"x", {1, 2}}, {"y", nullptr}};
+
+  root->items = {Item::createShared(), Item::createShared()};
+  root->items[0]->type = "child";
+  root->items[0]->payload = Child::createShared();
+  root->items[1]->type = "int";
+  root->items[1]->payload = oatpp::Int32(7);
+
+  root->any = oatpp::String("any-string");
+
+  root->tree = oatpp::Tree({});
+  root->tree["a"] = 1;
+  root->tree["b"].setNull();
+  root->tree["c"].setVector(2);
+  root->tree["c"][0] = "x";
+  root->tree["c"][1].setNull();
+
+  root->child = Child::createShared();
+
+  return root;
+
+}
+
+struct ReadResult {
+  oatpp::String json;
+  oatpp::String errors;
+  oatpp::String exception;
+  bool caretError;
+};
+
+oatpp::Void readViaTree(const oatpp::json::ObjectMapper& mapper, utils::parser::Caret& caret,
+                        const oatpp::Type* type, data::mapping::ErrorStack& errorStack)
+{
+
+  data::mapping::Tree tree;
+
+  oatpp::json::Deserializer::State state;
+  state.caret = &caret;
+  state.tree = &tree;
+  state.config = &mapper.deserializerConfig().json;
+  oatpp::json::Deserializer::deserialize(state);
+  if(!state.errorStack.empty()) {
+    errorStack = std::move(state.errorStack);
+    return nullptr;
+  }
+
+  data::mapping::TreeToObjectMapper::State mapperState;
+  mapperState.config = &mapper.deserializerConfig().mapper;
+  mapperState.tree = &tree;
+  auto result = mapper.treeToObjectMapper().map(mapperState, type);
+  if(!mapperState.errorStack.empty()) {
+    errorStack = std::move(mapperState.errorStack);
+    return nullptr;
+  }
+  return result;
+
+}
+
+ReadResult read(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, const oatpp::Type* type, bool viaTree) {
+
+  oatpp::json::ObjectMapper writer;
+
+  ReadResult result;
+  utils::parser::Caret caret(json);
+  data::mapping::ErrorStack errorStack;
+
+  try {
+    auto value = viaTree ? readViaTree(mapper, caret, type, errorStack) : mapper.read(caret, type, errorStack);
+    if(!errorStack.empty()) {
+      result.errors = errorStack.stacktrace();
+    } else if(!caret.hasError()) {
+      result.json = writer.writeToString(value);
+    }
+  } catch (std::exception& e) {
+    result.exception = e.what();
+  }
+
+  result.caretError = caret.hasError();
+  return result;
+
+}
+
+void assertSameResult(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, const oatpp::Type* type, bool exact) {
+
+  auto treeResult = read(mapper, json, type, true);
+  auto directResult = read(mapper, json, type, false);
+
+  bool same;
+  if(exact) {
+    same = treeResult.json == directResult.json &&
+           treeResult.errors == directResult.errors &&
+           treeResult.exception == directResult.exception &&
+           treeResult.caretError == directResult.caretError;
+  } else {
+    /* malformed document of mismatching type - the first error in document order is reported */
+    same = (treeResult.json == nullptr || treeResult.caretError) && (directResult.json == nullptr || directResult.caretError);
+  }
+
+  if(!same) {
+    OATPP_LOGe("TEST[oatpp::json::ObjectDeserializerTest]", "input:  '{}', type='{}'", json->c_str(), type->classId.name)
+    OATPP_LOGe("TEST[oatpp::json::ObjectDeserializerTest]", "tree:   json='{}', errors='{}', exception='{}'",
+               treeResult.json ? treeResult.json->c_str() : "",
+               treeResult.errors ? treeResult.errors->c_str() : "",
+               treeResult.exception ? treeResult.exception->c_str() : "")
+    OATPP_LOGe("TEST[oatpp::json::ObjectDeserializerTest]", "direct: json='{}', errors='{}', exception='{}'",
+               directResult.json ? directResult.json->c_str() : "",
+               directResult.errors ? directResult.errors->c_str() : "",
+               directResult.exception ? directResult.exception->c_str() : "")
+  }
+
+  OATPP_ASSERT(same)
+
+}
+
+/*
+ * Malformed documents are compared exactly for Object<Root> only - they are well-typed for it up to the syntax error.
+ */
+void assertSameResult(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, bool wellFormed) {
+
+  assertSameResult(mapper, json, oatpp::Object<Root>::Class::getType(), true);
+  assertSameResult(mapper, json, oatpp::Vector<oatpp::Object<Root>>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Fields<oatpp::Any>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::UnorderedFields<oatpp::String>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::List<oatpp::Int32>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Int32::Class::getType(), true);
+  assertSameResult(mapper, json, oatpp::String::Class::getType(), true);
+  assertSameResult(mapper, json, oatpp::Enum<Color>::AsString::Class::getType(), true);
+  assertSameResult(mapper, json, oatpp::Tree::Class::getType(), true);
+  assertSameResult(mapper, json, oatpp::Any::Class::getType(), true);
+
+}
+
+const char* const WELL_FORMED_DOCUMENTS[] = {
+  R"({"str-qualified":"a","str":"b","i32":"12","u8":"7","b":"true","f64":"1.5","colorStr":"RED","colorNum":1,"requiredStr":"r",)"
+  R"("unknown":{"x":[1,2,{"y":null}]},"items":[{"payload":{"child-name":"n","value":3},"type":"child"},{"type":"int","payload":5}]})",
+  R"({"requiredStr":"a","i32":1,"i32":2,"fields":{"k":"1","j":"2","k":"3"},"list":["x"],"list":["y","z"],"unorderedFields":{"a":[1],"a":[2]}})",
+  R"( { "requiredStr" : "a" , "list" : [ "x" , "y" , ] , "children" : [ { "value" : 1 } , null ] } )",
+  R"({"requiredStr":"a","list":["x" "y"] "i32":5})",
+  R"({"requiredStr":null})",
+  R"({"colorStr":"BLUE","requiredStr":"x"})",
+  R"({"colorNum":"1","requiredStr":"x"})",
+  R"({"i32":"abc","requiredStr":"x"})",
+  R"({"i32":1.5,"f32":2,"b":1,"u8":true,"requiredStr":"x"})",
+  R"({"children":[{"value":1},{"value":"x"}],"requiredStr":"x"})",
+  R"({"list":{"a":"1","b":"2"},"requiredStr":"x"})",
+  R"({"fields":[1],"requiredStr":"x"})",
+  R"({"child":[1,2],"requiredStr":"x"})",
+  R"({"child":5,"requiredStr":"x"})",
+  R"({"items":[{"type":"int","payload":"x"}],"requiredStr":"x"})",
+  R"({"tree":{"a":[1,{"b":null}]},"any":{"a":[1,2]},"anyNull":null,"requiredStr":"x"})",
+  R"({"a":"1","b":"2"})",
+  R"({})",
+  R"([{"requiredStr":"x"},null,{"requiredStr":"y","i32":"3"}])",
+  R"([1,2,3])",
+  R"([])",
+  R"(null)",
+  R"("red")",
+  R"("RED")",
+  R"(12)",
+  R"(-1.5)",
+  R"(true)",
+};
+
+const char* const MALFORMED_DOCUMENTS[] = {
+  R"({"requiredStr":"x")",
+  R"({"requiredStr" "x"})",
+  R"({requiredStr:"x"})",
+  R"({"children":[{"value":1},{"value":2]})",
+  R"({"nullStr":"broken})",
+  R"({"i32":"broken})",
+  R"({"b":tru})",
+  R"({"nullStr":nul})",
+  R"({"i32":@})",
+  R"({"tree":{"b":{"c":[1,2,{"d":}]}}})",
+  R"({"list":["a","b)",
+  R"([null,null)",
+  R"([{"requiredStr":"x"},{"requiredStr":"y")",
+  R"("unterminated)",
+  R"(nul)",
+  R"(@)",
+  R"()",
+
+};
+
+}
+
+void ObjectDeserializerTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Same result as tree deserializer - all config combinations...")
+
+    oatpp::json::ObjectMapper writer;
+    auto qualifiedJson = writer.writeToString(createRoot());
+    writer.serializerConfig().mapper.useUnqualifiedFieldNames = true;
+    writer.serializerConfig().mapper.useUnqualifiedEnumNames = true;
+    auto unqualifiedJson = writer.writeToString(createRoot());
+
+    for(v_int32 flags = 0; flags < 16; flags ++) {
+
+      oatpp::json::ObjectMapper mapper;
+      auto& config = mapper.deserializerConfig();
+      config.mapper.allowUnknownFields = (flags & 1) != 0;
+      config.mapper.allowLexicalCasting = (flags & 2) != 0;
+      config.mapper.useUnqualifiedFieldNames = (flags & 4) != 0;
+      config.mapper.useUnqualifiedEnumNames = (flags & 8) != 0;
+
+      assertSameResult(mapper, qualifiedJson, true);
+      assertSameResult(mapper, unqualifiedJson, true);
+
+      for(auto document : WELL_FORMED_DOCUMENTS) {
+        assertSameResult(mapper, document, true);
+      }
+
+      for(auto document : MALFORMED_DOCUMENTS) {
+        assertSameResult(mapper, document, false);
+      }
+
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Round trip...")
+
+    oatpp::json::ObjectMapper mapper;
+    auto original = createRoot();
+    original->unorderedFields = {{"x", {1, 2}}}; // single entry - to have stable order
+    auto json = mapper.writeToString(original);
+    auto root = mapper.readFromString<oatpp::Object<Root>>(json);
+    OATPP_ASSERT(mapper.writeToString(root) == json)
+    OATPP_ASSERT(root->items[0]->payload.getStoredType() == oatpp::Object<Child>::Class::getType())
+    OATPP_ASSERT(root->items[1]->payload.retrieve<oatpp::Int32>() == 7)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Errors...")
+
+    oatpp::json::ObjectMapper mapper;
+    mapper.deserializerConfig().mapper.allowUnknownFields = false;
+
+    bool thrown = false;
+    try {
+      mapper.readFromString<oatpp::Object<Root>>(R"({"requiredStr":"x","children":[{"value":1},{"unknown":2}]})");
+    } catch (const data::mapping::MappingError& e) {
+      OATPP_LOGd(TAG, "error='{}'", e.what())
+      OATPP_ASSERT(e.errorStack().stacktrace() ==
+        "[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: Error. Unknown field 'unknown'\n"
+        "[oatpp::data::mapping::TreeToObjectMapper::mapCollection()]: index=1\n"
+        "[oatpp::data::mapping::TreeToObjectMapper::mapObject()]: field='children'\n")
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Custom tree mapper method is respected...")
+
+    oatpp::json::ObjectMapper mapper;
+    mapper.treeToObjectMapper().setMapperMethod(data::type::__class::Int32::CLASS_ID,
+      [](const data::mapping::TreeToObjectMapper* treeMapper, data::mapping::TreeToObjectMapper::State& state, const oatpp::Type* type) {
+        (void) treeMapper;
+        (void) type;
+        if(state.tree->isString()) {
+          return oatpp::Void(oatpp::Int32(static_cast<v_int32>(state.tree->getString()->size())));
+        }
+        return oatpp::Void(oatpp::Int32(-1));
+      });
+
+    auto child = mapper.readFromString<oatpp::Object<Child>>(R"({"value":"four","children":[{"value":1}]})");
+    OATPP_ASSERT(child->value == 4)
+    OATPP_ASSERT(child->children[0]->value == -1)
+
+    for(auto document : WELL_FORMED_DOCUMENTS) {
+      assertSameResult(mapper, document, true);
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark - large nested payload...")
+
+    oatpp::json::ObjectMapper mapper;
+
+    oatpp::List<oatpp::Object<Root>> list({});
+    for(v_int32 i = 0; i < 10000; i ++) {
+      auto root = createRoot();
+      root->unorderedFields = {{"x", {1, 2}}};
+      list->push_back(root);
+    }
+    auto json = mapper.writeToString(list);
+    OATPP_LOGd(TAG, "json size={}", json->size())
+
+    data::mapping::ErrorStack errorStack;
+    oatpp::Void treeResult;
+    oatpp::Void directResult;
+
+    {
+      oatpp::test::PerformanceChecker checker("Tree path");
+      utils::parser::Caret caret(json);
+      treeResult = readViaTree(mapper, caret, list.getValueType(), errorStack);
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Direct path");
+      utils::parser::Caret caret(json);
+      directResult = mapper.read(caret, list.getValueType(), errorStack);
+    }
+
+    OATPP_ASSERT(errorStack.empty())
+    OATPP_ASSERT(mapper.writeToString(treeResult) == json)
+    OATPP_ASSERT(mapper.writeToString(directResult) == json)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
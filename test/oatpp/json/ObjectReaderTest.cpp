@@ -0,0 +1,760 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectReaderTest.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
+#include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace json {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 1, "red"),
+  VALUE(GREEN, 2, "green")
+);
+
+class Child : public oatpp::DTO {
+
+  DTO_INIT(Child, DTO)
+
+  DTO_FIELD(String, name, "child-name");
+  DTO_FIELD(Int32, value);
+  DTO_FIELD(List<Object<Child>>, children);
+
+};
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(String, type);
+  DTO_FIELD(Any, payload);
+
+  DTO_FIELD_TYPE_SELECTOR(payload) {
+    if(type == "child") return Object<Child>::Class::getType();
+    if(type == "int") return Int32::Class::getType();
+    return Void::Class::getType();
+  }
+
+};
+
+class Root : public oatpp::DTO {
+
+  DTO_INIT(Root, DTO)
+
+  DTO_FIELD(String, str, "str-qualified");
+  DTO_FIELD(String, escaped);
+  DTO_FIELD(String, nullStr);
+
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(UInt8, u8);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, b);
+
+  DTO_FIELD(Enum<Color>::AsString, colorStr);
+  DTO_FIELD(Enum<Color>::AsNumber, colorNum);
+
+  DTO_FIELD_INFO(requiredStr) {
+    info->required = true;
+  }
+  DTO_FIELD(String, requiredStr);
+
+  DTO_FIELD(List<String>, list);
+  DTO_FIELD(Vector<Object<Child>>, children);
+  DTO_FIELD(UnorderedSet<Int32>, set);
+  DTO_FIELD(Fields<String>, fields);
+  DTO_FIELD(UnorderedFields<List<Int32>>, unorderedFields);
+  DTO_FIELD(List<Object<Item>>, items);
+
+  DTO_FIELD(Any, any);
+  DTO_FIELD(Tree, tree);
+
+  DTO_FIELD(Object<Child>, child);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Root> createRoot() {
+
+  auto root = Root::createShared();
+
+  root->str = "Hello";
+  root->escaped = "quote\" backslash\\ tab\t new-line\n unicode-\xD0\x96";
+  root->i32 = -32;
+  root->u8 = 8;
+  root->i64 = -64;
+  root->f64 = 1.25;
+  root->b = true;
+  root->colorStr = Color::RED;
+  root->colorNum = Color::GREEN;
+  root->requiredStr = "required";
+
+  root->list = {"a", nullptr, "c"};
+  root->children = {Child::createShared(), nullptr, Child::createShared()};
+  root->children[0]->name = "first";
+  root->children[0]->value = 1;
+  root->children[0]->children = {Child::createShared()};
+  root->set = {1};
+  root->fields = {{"k1", "v1"}, {"k2", nullptr}};
+  root->unorderedFields = {{"x", {1, 2}}};
+
+  root->items = {Item::createShared(), Item::createShared()};
+  root->items[0]->type = "child";
+  root->items[0]->payload = Child::createShared();
+  root->items[1]->type = "int";
+  root->items[1]->payload = oatpp::Int32(7);
+
+  root->any = oatpp::String("any-string");
+
+  root->tree = oatpp::Tree({});
+  root->tree["a"] = 1;
+  root->tree["b"].setNull();
+  root->tree["c"].setVector(2);
+  root->tree["c"][0] = "x";
+  root->tree["c"][1].setNull();
+
+  root->child = Child::createShared();
+
+  return root;
+
+}
+
+struct ReadResult {
+  oatpp::String json;
+  oatpp::String errors;
+  oatpp::String exception;
+  bool failed;
+};
+
+ReadResult readWhole(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, const oatpp::Type* type) {
+
+  oatpp::json::ObjectMapper writer;
+
+  ReadResult result;
+  utils::parser::Caret caret(json);
+  data::mapping::ErrorStack errorStack;
+
+  try {
+    auto value = mapper.read(caret, type, errorStack);
+    if(!errorStack.empty()) {
+      result.errors = errorStack.stacktrace();
+    } else if(!caret.hasError()) {
+      result.json = writer.writeToString(value);
+    }
+  } catch (std::exception& e) {
+    result.exception = e.what();
+  }
+
+  result.failed = !errorStack.empty() || caret.hasError() || result.exception != nullptr;
+  return result;
+
+}
+
+ReadResult readChunked(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, const oatpp::Type* type, v_buff_size chunkSize) {
+
+  oatpp::json::ObjectMapper writer;
+
+  ReadResult result;
+  data::mapping::ErrorStack errorStack;
+
+  try {
+
+    auto reader = mapper.createReader(type);
+
+    v_buff_size pos = 0;
+    while(pos < static_cast<v_buff_size>(json->size())) {
+      auto size = std::min(chunkSize, static_cast<v_buff_size>(json->size()) - pos);
+      if(reader->writeSimple(json->data() + pos, size) <= 0) {
+        break;
+      }
+      pos += size;
+    }
+
+    auto value = reader->finish(errorStack);
+    if(!errorStack.empty()) {
+      result.errors = errorStack.stacktrace();
+    } else {
+      result.json = writer.writeToString(value);
+    }
+
+  } catch (std::exception& e) {
+    result.exception = e.what();
+  }
+
+  result.failed = !errorStack.empty() || result.exception != nullptr;
+  return result;
+
+}
+
+void assertSameResult(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, const oatpp::Type* type, bool wellFormed) {
+
+  auto expected = readWhole(mapper, json, type);
+
+  for(v_buff_size chunkSize : {1, 2, 7, 64, 1 << 20}) {
+
+    auto actual = readChunked(mapper, json, type, chunkSize);
+
+    bool same;
+    if(wellFormed) {
+      same = expected.json == actual.json && expected.errors == actual.errors &&
+             expected.exception == actual.exception && expected.failed == actual.failed;
+    } else {
+      /* syntax errors are reported in reader's own format */
+      same = expected.failed && actual.failed;
+    }
+
+    if(!same) {
+      OATPP_LOGe("TEST[oatpp::json::ObjectReaderTest]", "input:  '{}', type='{}', chunk={}", json->c_str(), type->classId.name, chunkSize)
+      OATPP_LOGe("TEST[oatpp::json::ObjectReaderTest]", "whole:   json='{}', errors='{}', exception='{}'",
+                 expected.json ? expected.json->c_str() : "",
+                 expected.errors ? expected.errors->c_str() : "",
+                 expected.exception ? expected.exception->c_str() : "")
+      OATPP_LOGe("TEST[oatpp::json::ObjectReaderTest]", "chunked: json='{}', errors='{}', exception='{}'",
+                 actual.json ? actual.json->c_str() : "",
+                 actual.errors ? actual.errors->c_str() : "",
+                 actual.exception ? actual.exception->c_str() : "")
+    }
+
+    OATPP_ASSERT(same)
+
+  }
+
+}
+
+void assertSameResult(const oatpp::json::ObjectMapper& mapper, const oatpp::String& json, bool wellFormed) {
+  assertSameResult(mapper, json, oatpp::Object<Root>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Vector<oatpp::Object<Root>>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Fields<oatpp::Any>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::List<oatpp::Int32>::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::String::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Enum<Color>::AsString::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Tree::Class::getType(), wellFormed);
+  assertSameResult(mapper, json, oatpp::Any::Class::getType(), wellFormed);
+}
+
+const char* const WELL_FORMED_DOCUMENTS[] = {
+  R"({"str-qualified":"a","str":"b","i32":"12","u8":"7","b":"true","f64":"1.5","colorStr":"RED","colorNum":1,"requiredStr":"r",)"
+  R"("unknown":{"x":[1,2,{"y":null}]},"items":[{"payload":{"child-name":"n","value":3},"type":"child"},{"type":"int","payload":5}]})",
+  R"({"requiredStr":"a","i32":1,"i32":2,"fields":{"k":"1","j":"2","k":"3"},"list":["x"],"list":["y","z"],"unorderedFields":{"a":[1],"a":[2]}})",
+  R"( { "requiredStr" : "a" , "list" : [ "x" , "y" ] , "children" : [ { "value" : 1 } , null ] } )",
+  R"({"requiredStr":"a","list":["x" "y"] "i32":5})",
+  R"({"requiredStr":null})",
+  R"({"colorStr":"BLUE","requiredStr":"x"})",
+  R"({"i32":"abc","requiredStr":"x"})",
+  R"({"i32":1.5,"f64":2,"b":1,"u8":true,"i64":-9.5e3,"requiredStr":"x"})",
+  R"({"children":[{"value":1},{"value":"x"}],"requiredStr":"x"})",
+  R"({"list":{"a":"1","b":"2"},"requiredStr":"x"})",
+  R"({"child":[1,2],"requiredStr":"x"})",
+  R"({"items":[{"type":"int","payload":"x"}],"requiredStr":"x"})",
+  R"({"tree":{"a":[1,{"b":null}],"e":"Ж\n"},"any":{"a":[1,2]},"requiredStr":"x"})",
+  R"({})",
+  R"([{"requiredStr":"x"},null,{"requiredStr":"y","i32":"3"}])",
+  R"([1,2,3])",
+  R"([])",
+  R"(null)",
+  R"("red")",
+  R"(12)",
+  R"(-1.5)",
+  R"(true)",
+  R"({"requiredStr":"x"} trailing)",
+};
+
+const char* const MALFORMED_DOCUMENTS[] = {
+  R"({"requiredStr":"x")",
+  R"({"requiredStr" "x"})",
+  R"({requiredStr:"x"})",
+  R"({"children":[{"value":1},{"value":2]})",
+  R"({"nullStr":"broken})",
+  R"({"b":tru})",
+  R"({"i32":@})",
+  R"({"i32":1-2})",
+  R"({"tree":{"b":{"c":[1,2,{"d":}]}}})",
+  R"({"list":["a","b)",
+  R"([null,null)",
+  R"("unterminated)",
+  R"(nul)",
+  R"(@)",
+  R"()",
+};
+
+class ReadCoroutine : public oatpp::async::Coroutine<ReadCoroutine> {
+private:
+  std::shared_ptr<web::protocol::http::incoming::BodyDecoder> m_decoder;
+  web::protocol::http::Headers m_headers;
+  std::shared_ptr<data::stream::InputStream> m_body;
+  std::shared_ptr<oatpp::json::ObjectMapper> m_mapper;
+  oatpp::Object<Root>* m_result;
+  oatpp::String* m_error;
+public:
+
+  ReadCoroutine(const std::shared_ptr<web::protocol::http::incoming::BodyDecoder>& decoder,
+                const web::protocol::http::Headers& headers,
+                const std::shared_ptr<data::stream::InputStream>& body,
+                const std::shared_ptr<oatpp::json::ObjectMapper>& mapper,
+                oatpp::Object<Root>* result,
+                oatpp::String* error)
+    : m_decoder(decoder)
+    , m_headers(headers)
+    , m_body(body)
+    , m_mapper(mapper)
+    , m_result(result)
+    , m_error(error)
+  {}
+
+  oatpp::async::Action act() override {
+    return m_decoder->decodeToDtoAsync<oatpp::Object<Root>>(m_headers, m_body, nullptr, m_mapper)
+      .callbackTo(&ReadCoroutine::onResult);
+  }
+
+  oatpp::async::Action onResult(const oatpp::Object<Root>& result) {
+    *m_result = result;
+    return finish();
+  }
+
+  oatpp::async::Action handleError(oatpp::async::Error* error) override {
+    try {
+      std::rethrow_exception(error->getExceptionPtr());
+    } catch (const data::mapping::MappingError& e) {
+      *m_error = e.errorStack().stacktrace();
+    } catch (...) {
+      *m_error = error->what();
+    }
+    return error;
+  }
+
+};
+
+/*
+ * Reads body as Object<Root>. Sync API answers 400 on mapping error, async API lets the error reach the error handler.
+ */
+class DtoHandler : public web::server::HttpRequestHandler {
+private:
+  std::shared_ptr<oatpp::json::ObjectMapper> m_mapper;
+public:
+
+  DtoHandler(const std::shared_ptr<oatpp::json::ObjectMapper>& mapper)
+    : m_mapper(mapper)
+  {}
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    try {
+      request->readBodyToDto<oatpp::Object<Root>>(m_mapper);
+    } catch (const data::mapping::MappingError&) {
+      return OutgoingResponse::createShared(Status::CODE_400, nullptr);
+    }
+    return OutgoingResponse::createShared(Status::CODE_200, nullptr);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class DtoCoroutine : public oatpp::async::CoroutineWithResult<DtoCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<IncomingRequest> m_request;
+      std::shared_ptr<oatpp::json::ObjectMapper> m_mapper;
+    public:
+
+      DtoCoroutine(const std::shared_ptr<IncomingRequest>& request, const std::shared_ptr<oatpp::json::ObjectMapper>& mapper)
+        : m_request(request)
+        , m_mapper(mapper)
+      {}
+
+      Action act() override {
+        return m_request->readBodyToDtoAsync<oatpp::Object<Root>>(m_mapper).callbackTo(&DtoCoroutine::onDto);
+      }
+
+      Action onDto(const oatpp::Object<Root>& dto) {
+        (void) dto;
+        return _return(OutgoingResponse::createShared(Status::CODE_200, nullptr));
+      }
+
+    };
+
+    return DtoCoroutine::startForResult(request, m_mapper);
+
+  }
+
+};
+
+class PingHandler : public web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return OutgoingResponse::createShared(Status::CODE_200, web::protocol::http::outgoing::BufferBody::createShared("pong"));
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class PingCoroutine : public oatpp::async::CoroutineWithResult<PingCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    public:
+
+      Action act() override {
+        return _return(OutgoingResponse::createShared(Status::CODE_200, web::protocol::http::outgoing::BufferBody::createShared("pong")));
+      }
+
+    };
+
+    (void) request;
+    return PingCoroutine::startForResult();
+
+  }
+
+};
+
+/*
+ * Send raw requests over one connection and read everything the server sends until it closes the connection.
+ */
+oatpp::String exchange(bool async, const std::shared_ptr<oatpp::json::ObjectMapper>& mapper, const oatpp::String& requests) {
+
+  auto router = web::server::HttpRouter::createShared();
+  router->route("POST", "/dto", std::make_shared<DtoHandler>(mapper));
+  router->route("GET", "/ping", std::make_shared<PingHandler>());
+
+  auto _interface = network::virtual_::Interface::obtainShared("ObjectReaderTest");
+  auto serverConnectionProvider = network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<network::ConnectionHandler> connectionHandler;
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    connectionHandler = web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+  } else {
+    connectionHandler = web::server::HttpConnectionHandler::createShared(router);
+  }
+
+  network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  data::stream::BufferOutputStream received;
+
+  {
+    auto connection = clientConnectionProvider->get();
+    connection.object->writeExactSizeDataSimple(requests->data(), static_cast<v_buff_size>(requests->size()));
+    v_char8 buffer[1024];
+    v_io_size res;
+    while((res = connection.object->readSimple(buffer, 1024)) > 0) {
+      received.writeSimple(buffer, res);
+    }
+    connection.invalidator->invalidate(connection.object);
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+  return received.toString();
+
+}
+
+v_int32 countResponses(const oatpp::String& received) {
+  v_int32 result = 0;
+  for(auto pos = received->find("HTTP/1.1 "); pos != std::string::npos; pos = received->find("HTTP/1.1 ", pos + 1)) {
+    result ++;
+  }
+  return result;
+}
+
+oatpp::String toChunkedBody(const oatpp::String& body, v_buff_size chunkSize) {
+  data::stream::BufferInputStream inStream(body);
+  data::stream::BufferOutputStream outStream;
+  web::protocol::http::encoding::EncoderChunked encoder;
+  std::vector<char> buffer(static_cast<size_t>(chunkSize));
+  data::stream::transfer(&inStream, &outStream, 0, buffer.data(), chunkSize, &encoder);
+  return outStream.toString();
+}
+
+}
+
+void ObjectReaderTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Same result as whole-document read - chunk by chunk, all config combinations...")
+
+    oatpp::json::ObjectMapper writer;
+    auto qualifiedJson = writer.writeToString(createRoot());
+    writer.serializerConfig().mapper.useUnqualifiedFieldNames = true;
+    writer.serializerConfig().mapper.useUnqualifiedEnumNames = true;
+    auto unqualifiedJson = writer.writeToString(createRoot());
+
+    for(v_int32 flags = 0; flags < 16; flags ++) {
+
+      oatpp::json::ObjectMapper mapper;
+      auto& config = mapper.deserializerConfig();
+      config.mapper.allowUnknownFields = (flags & 1) != 0;
+      config.mapper.allowLexicalCasting = (flags & 2) != 0;
+      config.mapper.useUnqualifiedFieldNames = (flags & 4) != 0;
+      config.mapper.useUnqualifiedEnumNames = (flags & 8) != 0;
+
+      assertSameResult(mapper, qualifiedJson, true);
+      assertSameResult(mapper, unqualifiedJson, true);
+
+      for(auto document : WELL_FORMED_DOCUMENTS) {
+        assertSameResult(mapper, document, true);
+      }
+
+      for(auto document : MALFORMED_DOCUMENTS) {
+        assertSameResult(mapper, document, false);
+      }
+
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Syntax errors...")
+
+    oatpp::json::ObjectMapper mapper;
+
+    auto result = readChunked(mapper, R"({"list":["a" : "b"]})", oatpp::Object<Root>::Class::getType(), 3);
+    OATPP_ASSERT(result.errors == "[oatpp::json::ObjectReader]: Error. Unexpected character. Position=13\n")
+
+    result = readChunked(mapper, R"({"list":["a")", oatpp::Object<Root>::Class::getType(), 3);
+    OATPP_ASSERT(result.errors == "[oatpp::json::ObjectReader]: Error. Unexpected end of document. Position=12\n")
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Limits...")
+
+    oatpp::json::ObjectMapper mapper;
+    mapper.deserializerConfig().reader.maxDocumentSize = 24;
+    mapper.deserializerConfig().reader.maxDepth = 2;
+
+    auto result = readChunked(mapper, R"({"requiredStr":"x","tree":{"a":1}})", oatpp::Object<Root>::Class::getType(), 4);
+    OATPP_ASSERT(result.errors == "[oatpp::json::ObjectReader]: Error. Document size exceeds the limit. Position=24\n")
+
+    result = readChunked(mapper, R"({"requiredStr":"x"})", oatpp::Object<Root>::Class::getType(), 4);
+    OATPP_ASSERT(!result.failed)
+
+    result = readChunked(mapper, R"({"tree":{"a":[1]}})", oatpp::Object<Root>::Class::getType(), 4);
+    OATPP_ASSERT(result.errors == "[oatpp::json::ObjectReader]: Error. Max nesting depth exceeded. Position=13\n")
+
+    auto reader = mapper.createReader(oatpp::Object<Root>::Class::getType());
+    OATPP_ASSERT(reader->writeSimple("{\"tree\":{\"a\":[", 14) == IOError::BROKEN_PIPE)
+    OATPP_ASSERT(reader->hasError())
+    OATPP_ASSERT(reader->writeSimple("1]}}", 4) == IOError::BROKEN_PIPE)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  auto mapper = std::make_shared<oatpp::json::ObjectMapper>();
+  auto decoder = std::make_shared<web::protocol::http::incoming::SimpleBodyDecoder>();
+
+  auto original = createRoot();
+  auto json = mapper->writeToString(original);
+
+  {
+    OATPP_LOGi(TAG, "Body decoding - sync...")
+
+    {
+      web::protocol::http::Headers headers;
+      headers.put(web::protocol::http::Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(json->size())));
+      data::stream::BufferInputStream body(json);
+      auto dto = decoder->decodeToDto<oatpp::Object<Root>>(headers, &body, nullptr, mapper.get());
+      OATPP_ASSERT(mapper->writeToString(dto) == json)
+    }
+
+    {
+      web::protocol::http::Headers headers;
+      headers.put(web::protocol::http::Header::TRANSFER_ENCODING, web::protocol::http::Header::Value::TRANSFER_ENCODING_CHUNKED);
+      data::stream::BufferInputStream body(toChunkedBody(json, 5));
+      auto dto = decoder->decodeToDto<oatpp::Object<Root>>(headers, &body, nullptr, mapper.get());
+      OATPP_ASSERT(mapper->writeToString(dto) == json)
+    }
+
+    {
+      /* reading stops at the first error - the rest of the body is discarded */
+      oatpp::String badJson = "{\"i32\":\"x\", \"list\":[" + oatpp::String(std::string(1 << 16, ' ')) + "]}";
+      web::protocol::http::Headers headers;
+      headers.put(web::protocol::http::Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(badJson->size())));
+      data::stream::BufferInputStream body(badJson);
+      bool thrown = false;
+      try {
+        decoder->decodeToDto<oatpp::Object<Root>>(headers, &body, nullptr, mapper.get());
+      } catch (const data::mapping::MappingError& e) {
+        OATPP_LOGd(TAG, "error='{}'", e.what())
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+      OATPP_ASSERT(body.getCurrentPosition() == static_cast<v_buff_size>(badJson->size()))
+    }
+
+    {
+      /* too much to discard - decoding stops early with HttpError */
+      auto padding = static_cast<size_t>(web::protocol::http::incoming::BodyDecoder::READER_DISCARD_MAX_SIZE * 2);
+      oatpp::String badJson = "{\"i32\":\"x\", \"list\":[" + oatpp::String(std::string(padding, ' ')) + "]}";
+      web::protocol::http::Headers headers;
+      headers.put(web::protocol::http::Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(badJson->size())));
+      data::stream::BufferInputStream body(badJson);
+      bool thrown = false;
+      try {
+        decoder->decodeToDto<oatpp::Object<Root>>(headers, &body, nullptr, mapper.get());
+      } catch (const web::protocol::http::HttpError& e) {
+        OATPP_ASSERT(e.getInfo().status.code == 400)
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+      OATPP_ASSERT(body.getCurrentPosition() < static_cast<v_buff_size>(badJson->size()))
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Body decoding - async...")
+
+    oatpp::async::Executor executor(1, 1, 1);
+
+    oatpp::Object<Root> result;
+    oatpp::String error;
+
+    {
+      web::protocol::http::Headers headers;
+      headers.put(web::protocol::http::Header::TRANSFER_ENCODING, web::protocol::http::Header::Value::TRANSFER_ENCODING_CHUNKED);
+      auto body = std::make_shared<data::stream::BufferInputStream>(toChunkedBody(json, 5));
+      executor.execute<ReadCoroutine>(decoder, headers, body, mapper, &result, &error);
+      executor.waitTasksFinished();
+      OATPP_ASSERT(error == nullptr)
+      OATPP_ASSERT(mapper->writeToString(result) == json)
+    }
+
+    {
+      oatpp::String badJson = R"({"children":[{"value":1},{"value":"x"}],"requiredStr":"x"})";
+      web::protocol::http::Headers headers;
+      headers.put(web::protocol::http::Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(badJson->size())));
+      auto body = std::make_shared<data::stream::BufferInputStream>(badJson);
+      result = nullptr;
+      executor.execute<ReadCoroutine>(decoder, headers, body, mapper, &result, &error);
+      executor.waitTasksFinished();
+      OATPP_ASSERT(result == nullptr)
+      OATPP_ASSERT(error == readWhole(*mapper, badJson, oatpp::Object<Root>::Class::getType()).errors)
+    }
+
+    executor.stop();
+    executor.join();
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Malformed body on keep-alive connection...")
+
+    oatpp::String badJson = "{\"i32\":\"x\", \"list\":[" + oatpp::String(std::string(1 << 16, ' ')) + "]}";
+    oatpp::String requests =
+      "POST /dto HTTP/1.1\r\nContent-Length: " + utils::Conversion::int64ToStr(static_cast<v_int64>(badJson->size())) + "\r\n\r\n" +
+      badJson +
+      "GET /ping HTTP/1.1\r\nConnection: close\r\n\r\n";
+
+    /* endpoint handles the error - the rest of the body is skipped and the next request is served */
+    auto received = exchange(false, mapper, requests);
+    OATPP_ASSERT(received->find("HTTP/1.1 400") == 0)
+    OATPP_ASSERT(countResponses(received) == 2)
+    OATPP_ASSERT(received->find("\r\n\r\npong") != std::string::npos)
+
+    /* error reaches the error handler - the connection is closed after the error response */
+    received = exchange(true, mapper, requests);
+    OATPP_ASSERT(received->find("HTTP/1.1 200") == std::string::npos)
+    OATPP_ASSERT(received->find("Connection: close") != std::string::npos)
+    OATPP_ASSERT(countResponses(received) == 1)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark - whole body vs incremental...")
+
+    oatpp::List<oatpp::Object<Root>> list({});
+    for(v_int32 i = 0; i < 10000; i ++) {
+      list->push_back(createRoot());
+    }
+    auto listJson = mapper->writeToString(list);
+    OATPP_LOGd(TAG, "json size={}", listJson->size())
+
+    web::protocol::http::Headers headers;
+    headers.put(web::protocol::http::Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(listJson->size())));
+
+    oatpp::List<oatpp::Object<Root>> wholeResult;
+    oatpp::List<oatpp::Object<Root>> incrementalResult;
+
+    {
+      oatpp::test::PerformanceChecker checker("Whole body");
+      data::stream::BufferInputStream body(listJson);
+      wholeResult = mapper->readFromString<oatpp::List<oatpp::Object<Root>>>(decoder->decodeToString(headers, &body, nullptr));
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Incremental");
+      data::stream::BufferInputStream body(listJson);
+      incrementalResult = decoder->decodeToDto<oatpp::List<oatpp::Object<Root>>>(headers, &body, nullptr, mapper.get());
+    }
+
+    OATPP_ASSERT(mapper->writeToString(wholeResult) == listJson)
+    OATPP_ASSERT(mapper->writeToString(incrementalResult) == listJson)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
@@ -0,0 +1,369 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectSerializerTest.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/json/Beautifier.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace json {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 1, "red"),
+  VALUE(GREEN, 2, "green")
+);
+
+class Child : public oatpp::DTO {
+
+  DTO_INIT(Child, DTO)
+
+  DTO_FIELD(String, name, "child-name");
+  DTO_FIELD(Int32, value);
+
+};
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(String, type);
+  DTO_FIELD(Any, payload);
+
+  DTO_FIELD_TYPE_SELECTOR(payload) {
+    if(type == "child") return Object<Child>::Class::getType();
+    if(type == "int") return Int32::Class::getType();
+    return Void::Class::getType();
+  }
+
+};
+
+class Root : public oatpp::DTO {
+
+  DTO_INIT(Root, DTO)
+
+  DTO_FIELD(String, str, "str-qualified");
+  DTO_FIELD(String, escaped);
+  DTO_FIELD(String, nullStr);
+
+  DTO_FIELD(Int8, i8);
+  DTO_FIELD(UInt8, u8);
+  DTO_FIELD(Int16, i16);
+  DTO_FIELD(UInt16, u16);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(UInt32, u32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(UInt64, u64);
+  DTO_FIELD(Float32, f32);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, b);
+
+  DTO_FIELD(Enum<Color>::AsString, colorStr);
+  DTO_FIELD(Enum<Color>::AsNumber, colorNum);
+  DTO_FIELD(Enum<Color>::AsString, nullColor);
+
+  DTO_FIELD_INFO(requiredStr) {
+    info->required = true;
+  }
+  DTO_FIELD(String, requiredStr);
+
+  DTO_FIELD(List<String>, list);
+  DTO_FIELD(Vector<Object<Child>>, children);
+  DTO_FIELD(UnorderedSet<Int32>, set);
+  DTO_FIELD(Fields<String>, fields);
+  DTO_FIELD(UnorderedFields<List<Int32>>, unorderedFields);
+  DTO_FIELD(List<Object<Item>>, items);
+
+  DTO_FIELD(Any, any);
+  DTO_FIELD(Any, anyNull);
+  DTO_FIELD(Tree, tree);
+  DTO_FIELD(Tree, treeNull);
+
+  DTO_FIELD(Object<Child>, child);
+  DTO_FIELD(Object<Child>, nullChild);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Root> createRoot() {
+
+  auto root = Root::createShared();
+
+  root->str = "Hello";
+  root->escaped = "quote\" backslash\\ tab\t new-line\n unicode-\xD0\x96";
+  root->i8 = -8;
+  root->u8 = 8;
+  root->i16 = -16;
+  root->u16 = 16;
+  root->i32 = -32;
+  root->u32 = 32;
+  root->i64 = -64;
+  root->u64 = 64;
+  root->f32 = 0.5f;
+  root->f64 = 1.25;
+  root->b = true;
+  root->colorStr = Color::RED;
+  root->colorNum = Color::GREEN;
+  root->requiredStr = "required";
+
+  root->list = {"a", nullptr, "c"};
+  root->children = {Child::createShared(), nullptr, Child::createShared()};
+  root->children[0]->name = "first";
+  root->children[0]->value = 1;
+  root->set = {1};
+  root->fields = {{"k1", "v1"}, {"k2", nullptr}, {"k1", "duplicate"}};
+  root->unorderedFields = {{"x", {1, 2}}, {"y", nullptr}};
+
+  root->items = {Item::createShared(), Item::createShared(), Item::createShared()};
+  root->items[0]->type = "child";
+  root->items[0]->payload = Child::createShared();
+  root->items[1]->type = "int";
+  root->items[1]->payload = oatpp::Int32(7);
+  root->items[2]->type = "none";
+
+  root->any = oatpp::String("any-string");
+  root->anyNull = oatpp::Any(oatpp::String(nullptr));
+
+  root->tree = oatpp::Tree({});
+  root->tree["a"] = 1;
+  root->tree["b"].setNull();
+  root->tree["c"].setVector(2);
+  root->tree["c"][0] = "x";
+  root->tree["c"][1].setNull();
+  root->treeNull = oatpp::Tree({});
+  root->treeNull->setNull();
+
+  root->child = Child::createShared();
+
+  return root;
+
+}
+
+oatpp::String writeViaTree(const oatpp::json::ObjectMapper& mapper, const oatpp::Void& value, data::mapping::ErrorStack& errorStack) {
+
+  data::mapping::Tree tree;
+  data::mapping::ObjectToTreeMapper::State mapperState;
+  mapperState.config = &mapper.serializerConfig().mapper;
+  mapperState.tree = &tree;
+  mapper.objectToTreeMapper().map(mapperState, value);
+  if(!mapperState.errorStack.empty()) {
+    errorStack = std::move(mapperState.errorStack);
+    return nullptr;
+  }
+
+  data::stream::BufferOutputStream stream;
+  oatpp::json::Serializer::State state;
+  state.config = &mapper.serializerConfig().json;
+  state.tree = &tree;
+  oatpp::json::Serializer::serializeToStream(&stream, state);
+  if(!state.errorStack.empty()) {
+    errorStack = std::move(state.errorStack);
+    return nullptr;
+  }
+
+  return stream.toString();
+
+}
+
+oatpp::String writeDirect(const oatpp::json::ObjectMapper& mapper, const oatpp::Void& value, data::mapping::ErrorStack& errorStack) {
+  data::stream::BufferOutputStream stream;
+  mapper.write(&stream, value, errorStack);
+  if(!errorStack.empty()) {
+    return nullptr;
+  }
+  return stream.toString();
+}
+
+void assertSameOutput(const oatpp::json::ObjectMapper& mapper, const oatpp::Void& value) {
+
+  data::mapping::ErrorStack treeErrors;
+  data::mapping::ErrorStack directErrors;
+
+  auto treeJson = writeViaTree(mapper, value, treeErrors);
+  auto directJson = writeDirect(mapper, value, directErrors);
+
+  if(treeJson != directJson) {
+    OATPP_LOGe("TEST[oatpp::json::ObjectSerializerTest]", "tree:   '{}'", treeJson ? treeJson->c_str() : "<error>")
+    OATPP_LOGe("TEST[oatpp::json::ObjectSerializerTest]", "direct: '{}'", directJson ? directJson->c_str() : "<error>")
+  }
+
+  OATPP_ASSERT(treeJson == directJson)
+  OATPP_ASSERT(treeErrors.empty() == directErrors.empty())
+
+}
+
+oatpp::List<oatpp::Object<Child>> createList(v_int32 size) {
+  oatpp::List<oatpp::Object<Child>> list({});
+  for(v_int32 i = 0; i < size; i ++) {
+    auto child = Child::createShared();
+    child->name = "child name number " + utils::Conversion::int32ToStr(i) + " with \"quotes\"";
+    child->value = i;
+    list->push_back(child);
+  }
+  return list;
+}
+
+}
+
+void ObjectSerializerTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Same output as tree serializer - all config combinations...")
+
+    auto root = createRoot();
+
+    for(v_int32 flags = 0; flags < 128; flags ++) {
+
+      oatpp::json::ObjectMapper mapper;
+      auto& config = mapper.serializerConfig();
+      config.mapper.includeNullFields = (flags & 1) != 0;
+      config.mapper.alwaysIncludeRequired = (flags & 2) != 0;
+      config.mapper.alwaysIncludeNullCollectionElements = (flags & 4) != 0;
+      config.mapper.useUnqualifiedFieldNames = (flags & 8) != 0;
+      config.mapper.useUnqualifiedEnumNames = (flags & 16) != 0;
+      config.json.includeNullElements = (flags & 32) != 0;
+      config.json.useBeautifier = (flags & 64) != 0;
+
+      assertSameOutput(mapper, root);
+      assertSameOutput(mapper, oatpp::Vector<oatpp::Object<Root>>({root, nullptr, root}));
+      assertSameOutput(mapper, oatpp::Fields<oatpp::Object<Root>>({{"first", nullptr}, {"second", root}}));
+
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Null first element is skipped without leading comma...")
+    oatpp::json::ObjectMapper mapper;
+    mapper.serializerConfig().json.includeNullElements = false;
+    auto json = mapper.writeToString(oatpp::List<oatpp::String>({nullptr, "a", nullptr, "b"}));
+    OATPP_ASSERT(json == "[\"a\",\"b\"]")
+    assertSameOutput(mapper, oatpp::List<oatpp::String>({nullptr, "a", nullptr, "b"}));
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Errors...")
+
+    oatpp::json::ObjectMapper mapper;
+
+    auto root = createRoot();
+    root->requiredStr = nullptr;
+    data::mapping::ErrorStack errorStack;
+    OATPP_ASSERT(writeDirect(mapper, root, errorStack) == nullptr)
+    OATPP_ASSERT(!errorStack.empty())
+    assertSameOutput(mapper, root);
+
+    { // partial json doesn't reach the stream
+      data::stream::BufferOutputStream stream;
+      stream << "prefix";
+      data::mapping::ErrorStack bufferErrors;
+      mapper.write(&stream, root, bufferErrors);
+      OATPP_ASSERT(!bufferErrors.empty())
+      OATPP_ASSERT(stream.toString() == "prefix")
+
+      data::stream::BufferOutputStream target;
+      oatpp::json::Beautifier beautifier(&target, "  ", "\n");
+      data::mapping::ErrorStack streamErrors;
+      mapper.write(&beautifier, root, streamErrors);
+      OATPP_ASSERT(!streamErrors.empty())
+      OATPP_ASSERT(target.getCurrentPosition() == 0)
+    }
+
+    oatpp::Fields<oatpp::Enum<Color>::AsString::NotNull> map = {{"color", nullptr}};
+    assertSameOutput(mapper, map);
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Custom tree mapper method is respected...")
+
+    oatpp::json::ObjectMapper mapper;
+    mapper.objectToTreeMapper().setMapperMethod(data::type::__class::Int32::CLASS_ID,
+      [](const data::mapping::ObjectToTreeMapper* treeMapper, data::mapping::ObjectToTreeMapper::State& state, const oatpp::Void& polymorph) {
+        (void) treeMapper;
+        if(polymorph) {
+          state.tree->setString("int:" + utils::Conversion::int32ToStr(*static_cast<v_int32*>(polymorph.get())));
+        } else {
+          state.tree->setNull();
+        }
+      });
+
+    auto child = Child::createShared();
+    child->name = "name";
+    child->value = 10;
+    auto json = mapper.writeToString(child);
+    OATPP_LOGd(TAG, "json='{}'", json->c_str())
+    OATPP_ASSERT(json == "{\"child-name\":\"name\",\"value\":\"int:10\"}")
+
+    assertSameOutput(mapper, createRoot());
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark - large list...")
+
+    oatpp::json::ObjectMapper mapper;
+    auto list = createList(100000);
+
+    data::mapping::ErrorStack errorStack;
+    oatpp::String treeJson;
+    oatpp::String directJson;
+
+    {
+      oatpp::test::PerformanceChecker checker("Tree path");
+      treeJson = writeViaTree(mapper, list, errorStack);
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Direct path");
+      directJson = writeDirect(mapper, list, errorStack);
+    }
+
+    OATPP_LOGd(TAG, "json size={}", directJson->size())
+    OATPP_ASSERT(errorStack.empty())
+    OATPP_ASSERT(treeJson == directJson)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
@@ -0,0 +1,373 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ObjectWriterTest.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace json {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+ENUM(Color, v_int32,
+  VALUE(RED, 1, "red"),
+  VALUE(GREEN, 2, "green")
+);
+
+class Child : public oatpp::DTO {
+
+  DTO_INIT(Child, DTO)
+
+  DTO_FIELD(String, name, "child-name");
+  DTO_FIELD(Int32, value);
+  DTO_FIELD(List<Object<Child>>, children);
+
+};
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(String, type);
+  DTO_FIELD(Any, payload);
+
+  DTO_FIELD_TYPE_SELECTOR(payload) {
+    if(type == "child") return Object<Child>::Class::getType();
+    if(type == "int") return Int32::Class::getType();
+    return Void::Class::getType();
+  }
+
+};
+
+class Root : public oatpp::DTO {
+
+  DTO_INIT(Root, DTO)
+
+  DTO_FIELD(String, str, "str-qualified");
+  DTO_FIELD(String, escaped);
+  DTO_FIELD(String, nullStr);
+
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(UInt8, u8);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, b);
+
+  DTO_FIELD(Enum<Color>::AsString, colorStr);
+  DTO_FIELD(Enum<Color>::AsNumber, colorNum);
+
+  DTO_FIELD_INFO(requiredStr) {
+    info->required = true;
+  }
+  DTO_FIELD(String, requiredStr);
+
+  DTO_FIELD(List<String>, list);
+  DTO_FIELD(Vector<Object<Child>>, children);
+  DTO_FIELD(UnorderedSet<Int32>, set);
+  DTO_FIELD(Fields<String>, fields);
+  DTO_FIELD(UnorderedFields<List<Int32>>, unorderedFields);
+  DTO_FIELD(List<Object<Item>>, items);
+
+  DTO_FIELD(Any, any);
+  DTO_FIELD(Tree, tree);
+
+  DTO_FIELD(Object<Child>, child);
+
+};
+
+class Broken : public oatpp::DTO {
+
+  DTO_INIT(Broken, DTO)
+
+  DTO_FIELD(List<Object<Child>>, children);
+  DTO_FIELD(Fields<String>, fields);
+  DTO_FIELD(UnorderedFields<Object<Root>>, roots);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Root> createRoot() {
+
+  auto root = Root::createShared();
+
+  root->str = "Hello";
+  root->escaped = "quote\" backslash\\ tab\t new-line\n unicode-\xD0\x96";
+  root->i32 = -32;
+  root->u8 = 8;
+  root->i64 = -64;
+  root->f64 = 1.25;
+  root->b = true;
+  root->colorStr = Color::RED;
+  root->colorNum = Color::GREEN;
+  root->requiredStr = "required";
+
+  root->list = {"a", nullptr, "c"};
+  root->children = {Child::createShared(), nullptr, Child::createShared()};
+  root->children[0]->name = "first";
+  root->children[0]->value = 1;
+  root->children[0]->children = {Child::createShared()};
+  root->set = {1};
+  root->fields = {{"k1", "v1"}, {"k2", nullptr}};
+  root->unorderedFields = {{"x", {1, 2}}};
+
+  root->items = {Item::createShared(), Item::createShared()};
+  root->items[0]->type = "child";
+  root->items[0]->payload = Child::createShared();
+  root->items[1]->type = "int";
+  root->items[1]->payload = oatpp::Int32(7);
+
+  root->any = oatpp::String("any-string");
+
+  root->tree = oatpp::Tree({});
+  root->tree["a"] = 1;
+  root->tree["b"].setNull();
+  root->tree["c"].setVector(2);
+  root->tree["c"][0] = "x";
+  root->tree["c"][1].setNull();
+
+  root->child = Child::createShared();
+
+  return root;
+
+}
+
+struct WriteResult {
+  oatpp::String json;
+  oatpp::String errors;
+};
+
+WriteResult writeWhole(const oatpp::json::ObjectMapper& mapper, const oatpp::Void& value) {
+  WriteResult result;
+  data::stream::BufferOutputStream stream;
+  data::mapping::ErrorStack errorStack;
+  mapper.write(&stream, value, errorStack);
+  if(errorStack.empty()) {
+    result.json = stream.toString();
+  } else {
+    result.errors = errorStack.stacktrace();
+  }
+  return result;
+}
+
+WriteResult writeChunked(const oatpp::json::ObjectMapper& mapper, const oatpp::Void& value, v_buff_size chunkSize) {
+
+  WriteResult result;
+  data::stream::BufferOutputStream stream;
+  std::vector<char> buffer(static_cast<size_t>(chunkSize));
+
+  auto writer = mapper.createWriter(value);
+
+  while(true) {
+    auto res = writer->readSimple(buffer.data(), chunkSize);
+    if(res <= 0) {
+      OATPP_ASSERT(res == 0 || writer->hasError())
+      break;
+    }
+    OATPP_ASSERT(res <= chunkSize)
+    stream.writeSimple(buffer.data(), res);
+  }
+
+  if(writer->hasError()) {
+    result.errors = writer->getErrorStack().stacktrace();
+  } else {
+    result.json = stream.toString();
+  }
+  return result;
+
+}
+
+void assertSameResult(const oatpp::json::ObjectMapper& mapper, const oatpp::Void& value) {
+
+  auto expected = writeWhole(mapper, value);
+
+  for(v_buff_size chunkSize : {1, 2, 7, 64, 1 << 20}) {
+
+    auto actual = writeChunked(mapper, value, chunkSize);
+    bool same = expected.json == actual.json && expected.errors == actual.errors;
+
+    if(!same) {
+      OATPP_LOGe("TEST[oatpp::json::ObjectWriterTest]", "chunk={}", chunkSize)
+      OATPP_LOGe("TEST[oatpp::json::ObjectWriterTest]", "whole:   json='{}', errors='{}'",
+                 expected.json ? expected.json->c_str() : "",
+                 expected.errors ? expected.errors->c_str() : "")
+      OATPP_LOGe("TEST[oatpp::json::ObjectWriterTest]", "chunked: json='{}', errors='{}'",
+                 actual.json ? actual.json->c_str() : "",
+                 actual.errors ? actual.errors->c_str() : "")
+    }
+
+    OATPP_ASSERT(same)
+
+  }
+
+}
+
+oatpp::Object<Broken> createBroken(v_int32 variant) {
+  auto broken = Broken::createShared();
+  switch(variant) {
+    case 0: {
+      auto root = createRoot();
+      root->requiredStr = nullptr;
+      broken->roots = {{"ok", createRoot()}, {"bad", root}};
+      break;
+    }
+    case 1:
+      broken->fields = oatpp::Fields<oatpp::String>({{nullptr, "value"}});
+      break;
+    case 2: {
+      auto child = Child::createShared();
+      child->children = {Child::createShared(), nullptr};
+      broken->children = {child};
+      broken->fields = oatpp::Fields<oatpp::String>({{"a", "b"}, {nullptr, nullptr}});
+      break;
+    }
+    default:
+      break;
+  }
+  return broken;
+}
+
+}
+
+void ObjectWriterTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Same result as whole-object write - chunk by chunk, all config combinations...")
+
+    oatpp::List<oatpp::Object<Root>> list({createRoot(), nullptr, createRoot()});
+    list[2]->children = {};
+    list[2]->fields = {};
+    list[2]->tree = nullptr;
+
+    const oatpp::Void values[] = {
+      createRoot(),
+      list,
+      oatpp::Fields<oatpp::Any>({{"a", oatpp::Any(createRoot())}, {"b", oatpp::Any()}, {"c", oatpp::Any(oatpp::Int32(1))}}),
+      oatpp::Vector<oatpp::Vector<oatpp::Int32>>({{}, nullptr, {1, 2}}),
+      oatpp::Any(oatpp::List<oatpp::String>({"x", nullptr})),
+      oatpp::Enum<Color>::AsString(Color::GREEN),
+      oatpp::String("string"),
+      oatpp::Int32(12),
+      oatpp::Object<Root>(nullptr),
+      createRoot()->tree,
+      createBroken(0),
+      createBroken(1),
+      createBroken(2)
+    };
+
+    for(v_int32 flags = 0; flags < 32; flags ++) {
+
+      oatpp::json::ObjectMapper mapper;
+      auto& config = mapper.serializerConfig();
+      config.mapper.includeNullFields = (flags & 1) != 0;
+      config.mapper.alwaysIncludeNullCollectionElements = (flags & 2) != 0;
+      config.mapper.useUnqualifiedFieldNames = (flags & 4) != 0;
+      config.json.includeNullElements = (flags & 8) != 0;
+      config.json.useBeautifier = (flags & 16) != 0;
+
+      for(auto& value : values) {
+        assertSameResult(mapper, value);
+      }
+
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Errors are reported with the same stacktrace...")
+
+    oatpp::json::ObjectMapper mapper;
+
+    for(v_int32 i = 0; i < 3; i ++) {
+      auto result = writeChunked(mapper, createBroken(i), 5);
+      OATPP_ASSERT(result.json == nullptr)
+      OATPP_ASSERT(result.errors)
+      OATPP_LOGd(TAG, "errors='{}'", result.errors->c_str())
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Custom tree mapper method is respected...")
+
+    oatpp::json::ObjectMapper mapper;
+    mapper.objectToTreeMapper().setMapperMethod(data::type::__class::Int32::CLASS_ID,
+      [](const data::mapping::ObjectToTreeMapper* treeMapper, data::mapping::ObjectToTreeMapper::State& state, const oatpp::Void& polymorph) {
+        (void) treeMapper;
+        state.tree->setString(polymorph ? "int" : "null-int");
+      });
+
+    assertSameResult(mapper, createRoot());
+    OATPP_ASSERT(writeChunked(mapper, oatpp::List<oatpp::Int32>({1, nullptr}), 3).json == R"(["int","null-int"])")
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark - large list...")
+
+    oatpp::json::ObjectMapper mapper;
+
+    oatpp::List<oatpp::Object<Root>> list({});
+    for(v_int32 i = 0; i < 10000; i ++) {
+      list->push_back(createRoot());
+    }
+
+    oatpp::String wholeJson;
+    data::stream::BufferOutputStream stream;
+
+    {
+      oatpp::test::PerformanceChecker checker("Whole");
+      wholeJson = mapper.writeToString(list);
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Incremental");
+      auto writer = mapper.createWriter(list);
+      v_char8 buffer[4096];
+      v_io_size res;
+      while((res = writer->readSimple(buffer, 4096)) > 0) {
+        stream.writeSimple(buffer, res);
+      }
+    }
+
+    OATPP_LOGd(TAG, "json size={}", wholeJson->size())
+    OATPP_ASSERT(stream.toString() == wholeJson)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
@@ -0,0 +1,187 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "UtilsTest.hpp"
+
+#include "oatpp/json/Utils.hpp"
+#include "oatpp/utils/CharScan.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace json {
+
+namespace {
+
+struct Special {
+  const char* raw;
+  const char* escaped;
+  const char* escapedAll;
+};
+
+const Special SPECIALS[] = {
+  {"\"", "\\\"", "\\\""},
+  {"\\", "\\\\", "\\\\"},
+  {"/", "/", "\\/"},
+  {"\n", "\\n", "\\n"},
+  {"\x01", "\\u0001", "\\u0001"},
+  {"\xD0\x96", "\xD0\x96", "\\u0416"},
+  {"\xF0\x9F\x98\x80", "\xF0\x9F\x98\x80", "\\uD83D\\uDE00"}
+};
+
+std::string generate(std::mt19937& rnd, size_t size, const std::vector<std::string>& alphabet, v_int32 specialChance) {
+  std::uniform_int_distribution<size_t> letter(0, alphabet.size() - 1);
+  std::uniform_int_distribution<v_int32> chance(0, 99);
+  std::string result;
+  while(result.size() < size) {
+    if(chance(rnd) < specialChance) {
+      result += alphabet[letter(rnd)];
+    } else {
+      result += static_cast<char>('a' + result.size() % 26);
+    }
+  }
+  return result;
+}
+
+void benchmark(const char* name, const std::string& corpus, v_uint32 flags, v_int32 iterations) {
+
+  oatpp::String escaped;
+  {
+    oatpp::test::PerformanceChecker checker(name);
+    for(v_int32 i = 0; i < iterations; i ++) {
+      escaped = Utils::escapeString(corpus.data(), static_cast<v_buff_size>(corpus.size()), flags);
+    }
+  }
+
+  v_int64 errorCode;
+  v_buff_size errorPosition;
+  oatpp::String unescaped;
+  {
+    oatpp::test::PerformanceChecker checker(name);
+    for(v_int32 i = 0; i < iterations; i ++) {
+      unescaped = Utils::unescapeString(escaped->data(), static_cast<v_buff_size>(escaped->size()), errorCode, errorPosition);
+    }
+  }
+
+  OATPP_ASSERT(errorCode == 0)
+  OATPP_ASSERT(unescaped == corpus)
+
+}
+
+}
+
+void UtilsTest::onRun() {
+
+  OATPP_LOGd(TAG, "CharScan implementation='{}'", utils::CharScan::getImplementationName())
+
+  {
+    OATPP_LOGi(TAG, "Special character at every position around block boundaries...")
+
+    for(auto& special : SPECIALS) {
+      for(size_t before = 0; before < 70; before ++) {
+        for(size_t after : {0u, 1u, 15u, 16u, 33u}) {
+
+          std::string raw = std::string(before, 'a') + special.raw + std::string(after, 'b');
+
+          auto escaped = Utils::escapeString(raw.data(), static_cast<v_buff_size>(raw.size()), Utils::FLAG_ESCAPE_UTF8CHAR);
+          std::string expected = std::string(special.raw) == "/" ? special.escaped : special.escapedAll;
+          OATPP_ASSERT(escaped == std::string(before, 'a') + expected + std::string(after, 'b'))
+
+          auto escapedAll = Utils::escapeString(raw.data(), static_cast<v_buff_size>(raw.size()), Utils::FLAG_ESCAPE_ALL);
+          OATPP_ASSERT(escapedAll == std::string(before, 'a') + special.escapedAll + std::string(after, 'b'))
+
+          auto escapedNone = Utils::escapeString(raw.data(), static_cast<v_buff_size>(raw.size()), 0);
+          OATPP_ASSERT(escapedNone == std::string(before, 'a') + special.escaped + std::string(after, 'b'))
+
+          v_int64 errorCode;
+          v_buff_size errorPosition;
+          auto unescaped = Utils::unescapeString(escapedAll->data(), static_cast<v_buff_size>(escapedAll->size()), errorCode, errorPosition);
+          OATPP_ASSERT(errorCode == 0)
+          OATPP_ASSERT(unescaped == raw)
+
+          std::string quoted = "\"" + *escapedAll + "\",";
+          utils::parser::Caret caret(quoted.data(), static_cast<v_buff_size>(quoted.size()));
+          OATPP_ASSERT(Utils::parseString(caret) == raw)
+          OATPP_ASSERT(caret.getPosition() == static_cast<v_buff_size>(quoted.size() - 1))
+
+        }
+      }
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Truncated UTF-8 sequence at the end...")
+    std::string raw = std::string(40, 'a') + "\xE2\x82";
+    auto escaped = Utils::escapeString(raw.data(), static_cast<v_buff_size>(raw.size()), 0);
+    OATPP_ASSERT(escaped == std::string(40, 'a') + "???")
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Random round trip...")
+
+    std::mt19937 rnd(3);
+    std::uniform_int_distribution<size_t> sizeDist(0, 300);
+    std::vector<std::string> alphabet = {" ", "\"", "\\", "/", "\t", "\x1F", "\xD0\x96", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+
+    for(v_int32 i = 0; i < 5000; i ++) {
+      auto raw = generate(rnd, sizeDist(rnd), alphabet, 10);
+      for(v_uint32 flags = 0; flags <= Utils::FLAG_ESCAPE_ALL; flags ++) {
+        auto escaped = Utils::escapeString(raw.data(), static_cast<v_buff_size>(raw.size()), flags);
+        v_int64 errorCode;
+        v_buff_size errorPosition;
+        auto unescaped = Utils::unescapeString(escaped->data(), static_cast<v_buff_size>(escaped->size()), errorCode, errorPosition);
+        OATPP_ASSERT(errorCode == 0)
+        OATPP_ASSERT(unescaped == raw)
+      }
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark...")
+
+    std::mt19937 rnd(4);
+
+    auto ascii = generate(rnd, 4096, {" ", ",", "."}, 10);
+    auto escapes = generate(rnd, 4096, {"\"", "\\", "\n", "\t", "/"}, 25);
+    auto multibyte = generate(rnd, 4096, {"\xD0\x96", "\xD0\xB8", "\xE2\x82\xAC", "\xE4\xB8\xAD", " "}, 70);
+
+    benchmark("ascii-heavy, escape all", ascii, Utils::FLAG_ESCAPE_ALL, 5000);
+    benchmark("escape-heavy, escape all", escapes, Utils::FLAG_ESCAPE_ALL, 5000);
+    benchmark("multibyte-heavy, escape all", multibyte, Utils::FLAG_ESCAPE_ALL, 5000);
+    benchmark("multibyte-heavy, keep utf-8", multibyte, 0, 5000);
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
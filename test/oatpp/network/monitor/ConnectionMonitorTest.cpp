@@ -37,6 +37,8 @@
 #include "oatpp/network/tcp/client/ConnectionProvider.hpp"
 #include "oatpp/network/tcp/server/ConnectionProvider.hpp"
 
+#include "oatpp-test/Checker.hpp"
+
 #include <thread>
 
 namespace oatpp { namespace test { namespace network { namespace monitor {
@@ -211,10 +213,257 @@ void runAsyncClient() {
 
 }
 
+/*
+ * Stream which accepts all writes and fills all reads - measures the monitoring overhead only.
+ */
+class NullStream : public oatpp::data::stream::IOStream, public oatpp::base::Countable {
+private:
+  oatpp::data::stream::DefaultInitializedContext m_context {oatpp::data::stream::StreamType::STREAM_INFINITE};
+public:
+
+  v_io_size write(const void *buff, v_buff_size count, async::Action& actions) override {
+    (void) buff;
+    (void) actions;
+    return count;
+  }
+
+  v_io_size read(void *buff, v_buff_size count, async::Action& action) override {
+    (void) buff;
+    (void) action;
+    return count;
+  }
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    (void) ioMode;
+  }
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getOutputStreamContext() override {
+    return m_context;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    (void) ioMode;
+  }
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getInputStreamContext() override {
+    return m_context;
+  }
+
+};
+
+class NullStreamProvider : public oatpp::network::ServerConnectionProvider {
+private:
+
+  class Invalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override {
+      (void) connection;
+    }
+  };
+
+private:
+  std::shared_ptr<Invalidator> m_invalidator = std::make_shared<Invalidator>();
+public:
+
+  oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> get() override {
+    return oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(std::make_shared<NullStream>(), m_invalidator);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&> getAsync() override {
+    throw std::runtime_error("Not implemented.");
+  }
+
+  void stop() override {
+    // DO NOTHING
+  }
+
+};
+
+/*
+ * Counts IO calls of each connection. Sums the counts of closed connections.
+ */
+class IOCallsCollector : public oatpp::network::monitor::StatCollector {
+public:
+  static constexpr const char* const METRIC_NAME = "test.io-calls";
+public:
+  std::atomic<v_int64> closedConnectionsCalls {0};
+public:
+
+  oatpp::String metricName() override {
+    return METRIC_NAME;
+  }
+
+  void* createMetricData() override {
+    return new v_int64(0);
+  }
+
+  void deleteMetricData(void* metricData) override {
+    auto calls = static_cast<v_int64*>(metricData);
+    closedConnectionsCalls += *calls;
+    delete calls;
+  }
+
+  void onRead(void* metricData, v_io_size readResult, v_int64 timestamp) override {
+    (void) readResult;
+    (void) timestamp;
+    (*static_cast<v_int64*>(metricData)) ++;
+  }
+
+  void onWrite(void* metricData, v_io_size writeResult, v_int64 timestamp) override {
+    (void) writeResult;
+    (void) timestamp;
+    (*static_cast<v_int64*>(metricData)) ++;
+  }
+
+};
+
+/*
+ * Records the stats seen by the monitor thread. Never closes connections.
+ */
+class RecordingChecker : public oatpp::network::monitor::MetricsChecker {
+public:
+  std::shared_ptr<IOCallsCollector> collector = std::make_shared<IOCallsCollector>();
+  std::atomic<v_int64> checks {0};
+  std::atomic<v_int64> minTotalRead {-1};
+  std::atomic<v_int64> minTotalWrite {-1};
+  std::atomic<v_int64> minIOCalls {-1};
+public:
+
+  std::vector<oatpp::String> getMetricsList() override {
+    return {IOCallsCollector::METRIC_NAME};
+  }
+
+  std::shared_ptr<oatpp::network::monitor::StatCollector> createStatCollector(const oatpp::String& metricName) override {
+    OATPP_ASSERT(metricName == IOCallsCollector::METRIC_NAME)
+    return collector;
+  }
+
+  bool check(const oatpp::network::monitor::ConnectionStats& stats, v_int64 currMicroTime) override {
+    (void) currMicroTime;
+    auto it = stats.metricsData.find(IOCallsCollector::METRIC_NAME);
+    v_int64 calls = it == stats.metricsData.end() ? 0 : *static_cast<v_int64*>(it->second);
+    updateMin(minTotalRead, stats.totalRead);
+    updateMin(minTotalWrite, stats.totalWrite);
+    updateMin(minIOCalls, calls);
+    checks ++;
+    return true;
+  }
+
+  static void updateMin(std::atomic<v_int64>& value, v_int64 candidate) {
+    v_int64 curr = value.load();
+    while((curr == -1 || candidate < curr) && !value.compare_exchange_weak(curr, candidate)) {}
+  }
+
+};
+
+void runIO(std::vector<oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>>& connections, v_int64 iterations) {
+  std::vector<std::thread> threads;
+  for(auto& connection : connections) {
+    threads.emplace_back([&connection, iterations]{
+      v_char8 buffer[16];
+      for(v_int64 i = 0; i < iterations; i ++) {
+        connection.object->writeSimple(buffer, 16);
+        connection.object->readSimple(buffer, 8);
+      }
+    });
+  }
+  for(auto& t : threads) {
+    t.join();
+  }
+}
+
 }
 
 void ConnectionMonitorTest::onRun() {
 
+  {
+    OATPP_LOGd(TAG, "run IO stats test")
+
+    const v_int64 connectionsCount = 8;
+    const v_int64 iterations = 100000;
+
+    auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(std::make_shared<NullStreamProvider>());
+    auto checker = std::make_shared<RecordingChecker>();
+    monitor->addMetricsChecker(checker);
+
+    std::vector<oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>> connections;
+    for(v_int64 i = 0; i < connectionsCount; i ++) {
+      connections.push_back(monitor->get());
+    }
+
+    runIO(connections, iterations);
+
+    auto waitChecks = [&checker](v_int64 count) {
+      auto checks = checker->checks.load();
+      while(checker->checks.load() < checks + count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+    };
+
+    /* drop the stats recorded while IO was running, then let the monitor thread check all connections again */
+    waitChecks(connectionsCount + 1);
+    checker->minTotalRead = -1;
+    checker->minTotalWrite = -1;
+    checker->minIOCalls = -1;
+    waitChecks(connectionsCount);
+
+    OATPP_ASSERT(checker->minTotalWrite == iterations * 16)
+    OATPP_ASSERT(checker->minTotalRead == iterations * 8)
+    OATPP_ASSERT(checker->minIOCalls == iterations * 2)
+
+    connections.clear();
+    OATPP_ASSERT(checker->collector->closedConnectionsCalls == connectionsCount * iterations * 2)
+
+    monitor->stop();
+  }
+
+  {
+    OATPP_LOGd(TAG, "run IO overhead benchmark")
+
+    const v_int64 iterations = 1000000;
+    v_int64 threadsCount = std::thread::hardware_concurrency();
+    if(threadsCount < 2) threadsCount = 2;
+    if(threadsCount > 32) threadsCount = 32;
+
+    auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(std::make_shared<NullStreamProvider>());
+    monitor->addMetricsChecker(
+      std::make_shared<oatpp::network::monitor::ConnectionMaxAgeChecker>(std::chrono::seconds(10))
+    );
+
+    std::vector<oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>> connections;
+    for(v_int64 i = 0; i < threadsCount; i ++) {
+      connections.push_back(monitor->get());
+    }
+
+    auto suffix = std::to_string(threadsCount) + " threads x " + std::to_string(iterations) + " write+read";
+
+    {
+      std::string tag = "stats only: " + suffix;
+      oatpp::test::PerformanceChecker timer(tag.c_str());
+      runIO(connections, iterations);
+    }
+
+    monitor->addStatCollector(std::make_shared<IOCallsCollector>());
+
+    {
+      std::string tag = "with stat collector: " + suffix;
+      oatpp::test::PerformanceChecker timer(tag.c_str());
+      runIO(connections, iterations);
+    }
+
+    connections.clear();
+    monitor->stop();
+  }
+
+
   auto connectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
     {"localhost", 8000});
   auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(connectionProvider);
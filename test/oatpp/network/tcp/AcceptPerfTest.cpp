@@ -0,0 +1,250 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AcceptPerfTest.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace network { namespace tcp {
+
+namespace {
+
+class CountingConnectionHandler : public oatpp::network::ConnectionHandler {
+public:
+  std::atomic<v_int64> counter {0};
+public:
+
+  void handleConnection(const provider::ResourceHandle<IOStream>& connection,
+                        const std::shared_ptr<const ParameterMap>& params) override
+  {
+    (void) params;
+    (void) connection;
+    ++ counter;
+  }
+
+  void stop() override {
+    // DO NOTHING
+  }
+
+};
+
+/*
+ * Every accept fails right away - like `accept()` failing with `EMFILE`.
+ * Odd attempts fail with a null handle, even attempts with a coroutine error.
+ */
+class FailingConnectionProvider : public oatpp::network::ServerConnectionProvider {
+public:
+  std::atomic<v_int64> attempts {0};
+public:
+
+  provider::ResourceHandle<oatpp::data::stream::IOStream> get() override {
+    return nullptr;
+  }
+
+  oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<oatpp::data::stream::IOStream>&> getAsync() override {
+
+    class AcceptCoroutine : public oatpp::async::CoroutineWithResult<AcceptCoroutine, const provider::ResourceHandle<oatpp::data::stream::IOStream>&> {
+    private:
+      FailingConnectionProvider* m_provider;
+    public:
+
+      AcceptCoroutine(FailingConnectionProvider* provider)
+        : m_provider(provider)
+      {}
+
+      Action act() override {
+        if((++ m_provider->attempts) % 2 == 0) {
+          return error<oatpp::async::Error>("Accept failed.");
+        }
+        return _return(nullptr);
+      }
+
+    };
+
+    return AcceptCoroutine::startForResult(this);
+
+  }
+
+  void stop() override {
+    // DO NOTHING
+  }
+
+};
+
+void runBenchmark(v_int32 acceptorsCount, v_int32 clientsCount, v_int32 connectionsPerClient, bool async) {
+
+  auto providers = oatpp::network::tcp::server::ConnectionProvider::createReusePortGroup(
+    {"127.0.0.1", 0, oatpp::network::Address::IP_4}, acceptorsCount
+  );
+
+  OATPP_ASSERT(static_cast<v_int32>(providers.size()) == acceptorsCount)
+
+  auto port = providers[0]->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+  for(auto& provider : providers) {
+    OATPP_ASSERT(provider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString() == port)
+  }
+
+  std::vector<std::shared_ptr<oatpp::network::ConnectionProvider>> serverProviders(providers.begin(), providers.end());
+  auto handler = std::make_shared<CountingConnectionHandler>();
+  oatpp::network::Server server(serverProviders, handler);
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::thread serverThread;
+
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    server.runAsync(executor);
+  } else {
+    serverThread = std::thread([&server]{
+      server.run();
+    });
+  }
+
+  auto clientProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+  );
+
+  v_int64 expected = static_cast<v_int64>(clientsCount) * connectionsPerClient;
+
+  OATPP_LOGd("AcceptPerfTest", "acceptors={}, async={}, clients={}, connections={}", acceptorsCount, async, clientsCount, expected)
+
+  {
+    PerformanceChecker checker("Accept");
+
+    std::vector<std::thread> clients;
+    for(v_int32 i = 0; i < clientsCount; i ++) {
+      clients.emplace_back([clientProvider, connectionsPerClient]{
+        for(v_int32 j = 0; j < connectionsPerClient; j ++) {
+          auto connection = clientProvider->get();
+          OATPP_ASSERT(connection)
+        }
+      });
+    }
+
+    for(auto& client : clients) {
+      client.join();
+    }
+
+    while(handler->counter.load() < expected) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto ticks = checker.getElapsedTicks();
+    OATPP_LOGd("AcceptPerfTest", "connections/second={}", ticks > 0 ? expected * 1000000 / ticks : 0)
+  }
+
+  server.stop();
+
+  if(async) {
+    OATPP_ASSERT(server.getStatus() == oatpp::network::Server::STATUS_DONE)
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  } else {
+    for(auto& provider : providers) {
+      provider->stop();
+    }
+    serverThread.join();
+  }
+
+  OATPP_ASSERT(handler->counter.load() == expected)
+
+}
+
+void runFailingAsyncAccept() {
+
+  auto provider = std::make_shared<FailingConnectionProvider>();
+  auto handler = std::make_shared<CountingConnectionHandler>();
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+
+  oatpp::network::Server server(provider, handler);
+  server.runAsync(executor);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  /* retries back off - 10ms, 20ms, 40ms... - instead of spinning */
+  auto attempts = provider->attempts.load();
+  OATPP_LOGd("AcceptPerfTest", "failed accept attempts in 500ms={}", attempts)
+  OATPP_ASSERT(attempts > 1 && attempts < 20)
+
+  server.stop();
+  OATPP_ASSERT(server.getStatus() == oatpp::network::Server::STATUS_DONE)
+
+  executor->waitTasksFinished(std::chrono::seconds(5));
+  OATPP_ASSERT(executor->getTasksCount() == 0)
+
+  executor->stop();
+  executor->join();
+
+}
+
+void runDestroyRunningAsyncServer() {
+
+  auto provider = oatpp::network::tcp::server::ConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto handler = std::make_shared<CountingConnectionHandler>();
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+
+  auto server = std::make_shared<oatpp::network::Server>(provider, handler);
+  server->runAsync(executor);
+
+  /* let the accept-coroutine park in the event loop */
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  /* destructor doesn't wait for accept-coroutines - it only wakes them up */
+  auto start = std::chrono::steady_clock::now();
+  server.reset();
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  OATPP_ASSERT(elapsed < std::chrono::milliseconds(1000))
+
+  executor->waitTasksFinished(std::chrono::seconds(5));
+  OATPP_ASSERT(executor->getTasksCount() == 0)
+
+  executor->stop();
+  executor->join();
+
+}
+
+}
+
+void AcceptPerfTest::onRun() {
+  runBenchmark(1, 4, 500, false);
+  runBenchmark(4, 4, 500, false);
+  runBenchmark(1, 4, 500, true);
+  runBenchmark(4, 4, 500, true);
+  runFailingAsyncAccept();
+  runDestroyRunningAsyncServer();
+}
+
+}}}}
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CharScanTest.hpp"
+
+#include "oatpp/utils/CharScan.hpp"
+
+#include <random>
+#include <string>
+
+namespace oatpp { namespace utils {
+
+namespace {
+
+v_buff_size referenceFindSectionEnd(const std::string& data, v_buff_size offset, v_buff_size size, v_uint32& accumulator) {
+  for(v_buff_size i = 0; i < size; i ++) {
+    accumulator <<= 8;
+    accumulator |= static_cast<v_char8>(data[static_cast<size_t>(offset + i)]);
+    if(accumulator == (('\r' << 24) | ('\n' << 16) | ('\r' << 8) | ('\n'))) {
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+v_buff_size referenceFindRN(const std::string& data) {
+  auto pos = data.find("\r\n");
+  return pos == std::string::npos ? -1 : static_cast<v_buff_size>(pos);
+}
+
+v_buff_size referenceFindCharOf(const std::string& data, char a, char b) {
+  for(size_t i = 0; i < data.size(); i ++) {
+    if(data[i] == a || data[i] == b) {
+      return static_cast<v_buff_size>(i);
+    }
+  }
+  return -1;
+}
+
+v_buff_size referenceFindJsonEscapable(const std::string& data, bool escapeSolidus) {
+  for(size_t i = 0; i < data.size(); i ++) {
+    auto a = static_cast<v_char8>(data[i]);
+    if(a < 0x20 || a >= 0x80 || a == '"' || a == '\\' || (escapeSolidus && a == '/')) {
+      return static_cast<v_buff_size>(i);
+    }
+  }
+  return -1;
+}
+
+std::string generateJsonString(std::mt19937& rnd, v_buff_size size) {
+  static const char alphabet[] = "abcdefgh \"\\/\x01\x1F\x7F\x80\xD0\xFF";
+  std::uniform_int_distribution<int> letter(0, 8);
+  std::uniform_int_distribution<int> special(9, 17);
+  std::uniform_int_distribution<int> chance(0, 31);
+  std::string result(static_cast<size_t>(size), 'x');
+  for(auto& c : result) {
+    c = alphabet[chance(rnd) == 0 ? special(rnd) : letter(rnd)];
+  }
+  return result;
+}
+
+std::string generate(std::mt19937& rnd, v_buff_size size) {
+  static const char alphabet[] = "abc:\r\n ";
+  std::uniform_int_distribution<int> letter(0, 6);
+  std::string result(static_cast<size_t>(size), 'x');
+  for(auto& c : result) {
+    c = alphabet[letter(rnd)];
+  }
+  return result;
+}
+
+}
+
+void CharScanTest::onRun() {
+
+  OATPP_LOGd(TAG, "implementation='{}'", CharScan::getImplementationName())
+
+  {
+    OATPP_LOGi(TAG, "findSectionEnd...")
+    std::string text = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\nbody";
+    v_uint32 acc = 0;
+    OATPP_ASSERT(CharScan::findSectionEnd(text.data(), static_cast<v_buff_size>(text.size()), acc) == static_cast<v_buff_size>(text.size() - 4))
+
+    /* section end split between chunks */
+    for(size_t split = 1; split < text.size(); split ++) {
+      acc = 0;
+      auto first = CharScan::findSectionEnd(text.data(), static_cast<v_buff_size>(split), acc);
+      if(first > 0) {
+        OATPP_ASSERT(first == static_cast<v_buff_size>(text.size() - 4))
+        continue;
+      }
+      auto second = CharScan::findSectionEnd(text.data() + split, static_cast<v_buff_size>(text.size() - split), acc);
+      OATPP_ASSERT(static_cast<v_buff_size>(split) + second == static_cast<v_buff_size>(text.size() - 4))
+    }
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "random data...")
+
+    std::mt19937 rnd(1);
+    std::uniform_int_distribution<v_buff_size> sizeDist(0, 200);
+
+    for(v_int32 i = 0; i < 10000; i ++) {
+
+      auto data = generate(rnd, sizeDist(rnd));
+      auto size = static_cast<v_buff_size>(data.size());
+
+      OATPP_ASSERT(CharScan::findRN(data.data(), size) == referenceFindRN(data))
+      OATPP_ASSERT(CharScan::findCharOf(data.data(), size, ':', ' ') == referenceFindCharOf(data, ':', ' '))
+      OATPP_ASSERT(CharScan::findChar(data.data(), size, 'c') == referenceFindCharOf(data, 'c', 'c'))
+
+      std::uniform_int_distribution<v_buff_size> splitDist(0, size);
+      auto split = splitDist(rnd);
+
+      v_uint32 acc = 0;
+      v_uint32 referenceAcc = 0;
+      auto first = CharScan::findSectionEnd(data.data(), split, acc);
+      OATPP_ASSERT(first == referenceFindSectionEnd(data, 0, split, referenceAcc))
+      if(first == -1) {
+        OATPP_ASSERT(acc == referenceAcc)
+        OATPP_ASSERT(CharScan::findSectionEnd(data.data() + split, size - split, acc) ==
+                     referenceFindSectionEnd(data, split, size - split, referenceAcc))
+      }
+
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "findJsonEscapable...")
+
+    std::mt19937 rnd(2);
+    std::uniform_int_distribution<v_buff_size> sizeDist(0, 200);
+
+    for(v_int32 i = 0; i < 10000; i ++) {
+      auto data = generateJsonString(rnd, sizeDist(rnd));
+      auto size = static_cast<v_buff_size>(data.size());
+      OATPP_ASSERT(CharScan::findJsonEscapable(data.data(), size, false) == referenceFindJsonEscapable(data, false))
+      OATPP_ASSERT(CharScan::findJsonEscapable(data.data(), size, true) == referenceFindJsonEscapable(data, true))
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
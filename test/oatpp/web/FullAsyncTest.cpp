@@ -58,14 +58,16 @@ typedef oatpp::web::protocol::http::outgoing::MultipartBody MultipartBody;
 class TestComponent {
 private:
   v_uint16 m_port;
+  v_int32 m_ioWorkerType;
 public:
 
-  TestComponent(v_uint16 port)
+  TestComponent(v_uint16 port, v_int32 ioWorkerType)
     : m_port(port)
+    , m_ioWorkerType(ioWorkerType)
   {}
 
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)([] {
-    return std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)([this] {
+    return std::make_shared<oatpp::async::Executor>(1, 1, 1, m_ioWorkerType);
   }());
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface)([] {
@@ -140,7 +142,7 @@ std::shared_ptr<PartList> createMultipart(const std::unordered_map<oatpp::String
   
 void FullAsyncTest::onRun() {
 
-  TestComponent component(m_port);
+  TestComponent component(m_port, m_ioWorkerType);
 
   oatpp::test::web::ClientServerTestRunner runner;
 
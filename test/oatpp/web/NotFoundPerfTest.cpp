@@ -0,0 +1,198 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "NotFoundPerfTest.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web {
+
+namespace {
+
+typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+typedef oatpp::web::protocol::http::Status Status;
+
+/*
+ * Renders just the error message.
+ * `throwing` - go through the exception created by &id:oatpp::web::server::handler::ErrorHandler::handleServerError; default implementation.
+ */
+class MessageErrorHandler : public oatpp::web::server::handler::DefaultErrorHandler {
+private:
+  bool m_throwing;
+public:
+
+  MessageErrorHandler(bool throwing)
+    : m_throwing(throwing)
+  {}
+
+  std::shared_ptr<OutgoingResponse> handleServerError(const std::shared_ptr<IncomingRequest>& request,
+                                                      const Status& status,
+                                                      const oatpp::String& message) override
+  {
+    if(m_throwing) {
+      return ErrorHandler::handleServerError(request, status, message);
+    }
+    return DefaultErrorHandler::handleServerError(request, status, message);
+  }
+
+  std::shared_ptr<OutgoingResponse> renderError(const HttpServerErrorStacktrace& stacktrace) override {
+    return OutgoingResponse::createShared(stacktrace.status, oatpp::web::protocol::http::outgoing::BufferBody::createShared(stacktrace.stack.front()));
+  }
+
+};
+
+/*
+ * Error handler alone - the server benchmark below is dominated by the connection setup.
+ */
+void runErrorHandlerBenchmark(const char* tag, bool throwing, v_int32 requestsCount) {
+  MessageErrorHandler errorHandler(throwing);
+  oatpp::test::PerformanceChecker checker(tag);
+  for(v_int32 i = 0; i < requestsCount; i ++) {
+    auto response = errorHandler.handleServerError(nullptr, Status::CODE_404, "No mapping");
+    OATPP_ASSERT(response->getStatus().code == 404)
+  }
+}
+
+void runBenchmark(const char* tag, bool throwing, v_int32 requestsCount) {
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  auto connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+  connectionHandler->setErrorHandler(std::make_shared<MessageErrorHandler>(throwing));
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+
+  {
+    oatpp::test::PerformanceChecker checker(tag);
+    for(v_int32 i = 0; i < requestsCount; i ++) {
+      /* the server closes the connection after 404 - same as the sync processor */
+      auto connection = requestExecutor.getConnection();
+      auto response = requestExecutor.execute("GET", "wp-login.php", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+      OATPP_ASSERT(response->getStatusCode() == 404)
+      OATPP_ASSERT(response->getHeader("Connection") == "close")
+      OATPP_ASSERT(response->readBodyToString() == "No mapping for HTTP-method: 'GET', URL: '/wp-login.php'")
+      requestExecutor.invalidateConnection(connection);
+    }
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+/*
+ * Malformed request headers are reported by value as well.
+ */
+void testInvalidHeaders() {
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  {
+    auto connection = clientConnectionProvider->get();
+    connection.object->writeExactSizeDataSimple("GET /\r\n\r\n", 9);
+
+    oatpp::data::stream::BufferOutputStream received;
+    v_char8 buffer[256];
+    v_io_size res;
+    while((res = connection.object->readSimple(buffer, 256)) > 0) {
+      received.writeSimple(buffer, res);
+    }
+
+    auto response = received.toStdString();
+    OATPP_LOGd("NotFoundPerfTest", "invalid headers response: '{}'", response.substr(0, response.find('\r')))
+    OATPP_ASSERT(response.find("HTTP/1.1 400 ") == 0)
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+}
+
+}
+
+void NotFoundPerfTest::onRun() {
+
+  const v_int32 requestsCount = 10000;
+
+  runErrorHandlerBenchmark("error handler - exception path", true, requestsCount);
+  runErrorHandlerBenchmark("error handler - error by value", false, requestsCount);
+
+  runBenchmark("404 - exception path", true, requestsCount / 10);
+  runBenchmark("404 - error by value", false, requestsCount / 10);
+
+  auto objectsCount = oatpp::Environment::getObjectsCount();
+  testInvalidHeaders();
+
+  /* the connection thread destroys its task right after the connection handler stops waiting for it */
+  for(v_int32 i = 0; i < 1000 && oatpp::Environment::getObjectsCount() > objectsCount; i ++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+}
+
+}}}
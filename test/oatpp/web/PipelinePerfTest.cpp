@@ -0,0 +1,202 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "PipelinePerfTest.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web {
+
+namespace {
+
+/*
+ * Every response has its own body - "Hello <i>" - so that a reordered or mixed up response fails the test.
+ */
+void writeRequest(oatpp::data::stream::BufferOutputStream& stream, v_int32 i) {
+  stream << "GET /hello?i=" << i << " HTTP/1.1\r\n"
+            "Connection: keep-alive\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n";
+}
+
+void writeExpectedResponse(oatpp::data::stream::BufferOutputStream& stream, v_int32 i) {
+  oatpp::String body = "Hello " + oatpp::utils::Conversion::int32ToStdStr(i);
+  stream << "HTTP/1.1 200 OK\r\n"
+            "Content-Length: " << static_cast<v_int32>(body->size()) << "\r\n"
+            "Connection: keep-alive\r\n"
+            "Server: oatpp/" OATPP_VERSION "\r\n"
+            "\r\n" << body;
+}
+
+std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> createResponse(const std::shared_ptr<oatpp::web::protocol::http::incoming::Request>& request) {
+  auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello " + request->getQueryParameter("i"));
+  return oatpp::web::protocol::http::outgoing::Response::createShared(oatpp::web::protocol::http::Status::CODE_200, body);
+}
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    return createResponse(request);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<IncomingRequest> m_request;
+    public:
+
+      HelloCoroutine(const std::shared_ptr<IncomingRequest>& request)
+        : m_request(request)
+      {}
+
+      Action act() override {
+        return _return(createResponse(m_request));
+      }
+
+    };
+
+    return HelloCoroutine::startForResult(request);
+
+  }
+
+};
+
+void runBenchmark(const char* tag, bool async, v_buff_size pipelineOutBufferMaxSize, v_int32 requestsCount) {
+
+  auto serverConnectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
+    {"127.0.0.1", 0, oatpp::network::Address::IP_4}
+  );
+  auto port = serverConnectionProvider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+  );
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/hello", std::make_shared<HelloHandler>());
+
+  auto config = std::make_shared<oatpp::web::server::HttpProcessor::Config>();
+  config->pipelineOutBufferMaxSize = pipelineOutBufferMaxSize;
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    auto components = std::make_shared<oatpp::web::server::HttpProcessor::Components>(router, config);
+    connectionHandler = std::make_shared<oatpp::web::server::AsyncHttpConnectionHandler>(components, executor);
+  } else {
+    connectionHandler = std::make_shared<oatpp::web::server::HttpConnectionHandler>(router, config);
+  }
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  oatpp::data::stream::BufferOutputStream pipelineStream;
+  oatpp::data::stream::BufferOutputStream expectedStream;
+  for (v_int32 i = 0; i < requestsCount; i++) {
+    writeRequest(pipelineStream, i);
+    writeExpectedResponse(expectedStream, i);
+  }
+  auto dataToSend = pipelineStream.toString();
+  auto expected = expectedStream.toString();
+  auto expectedSize = static_cast<v_io_size>(expected->size());
+
+  {
+    auto connection = clientConnectionProvider->get();
+    OATPP_ASSERT(connection)
+
+    oatpp::test::PerformanceChecker checker(tag);
+
+    std::thread pipeInThread([connection, dataToSend] {
+      connection.object->writeExactSizeDataSimple(dataToSend->data(), static_cast<v_buff_size>(dataToSend->size()));
+    });
+
+    oatpp::data::stream::BufferOutputStream receivedStream(expectedSize);
+    v_int64 readsCount = 0;
+    oatpp::data::buffer::IOBuffer ioBuffer;
+    while(receivedStream.getCurrentPosition() < expectedSize) {
+      auto res = connection.object->readSimple(ioBuffer.getData(), ioBuffer.getSize());
+      if(res > 0) {
+        receivedStream.writeSimple(ioBuffer.getData(), res);
+        readsCount ++;
+      } else if(res != IOError::RETRY_READ) {
+        break;
+      }
+    }
+
+    pipeInThread.join();
+
+    /* every response - status line, headers and body - in the order of requests */
+    OATPP_ASSERT(receivedStream.toString() == expected)
+    OATPP_LOGd("PipelinePerfTest", "{}: requests={}, client reads={}", tag, requestsCount, readsCount)
+
+    connectionHandler->stop();
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+}
+
+}
+
+void PipelinePerfTest::onRun() {
+
+  const v_int32 requestsCount = m_requestsCount;
+
+  runBenchmark("Sync server, pipelined responses sent one by one", false, 0, requestsCount);
+  runBenchmark("Sync server, pipelined responses coalesced", false, 65536, requestsCount);
+
+  runBenchmark("Async server, pipelined responses sent one by one", true, 0, requestsCount);
+  runBenchmark("Async server, pipelined responses coalesced", true, 65536, requestsCount);
+
+}
+
+}}}
@@ -0,0 +1,332 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "DtoBodyTest.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/DtoBody.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http {
+
+namespace {
+
+typedef oatpp::web::protocol::http::outgoing::ResponseFactory ResponseFactory;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+
+  DTO_INIT(ItemDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+
+  DTO_FIELD_INFO(required) {
+    info->required = true;
+  }
+  DTO_FIELD(String, required);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::List<oatpp::Object<ItemDto>> createItems(v_int32 count, bool broken) {
+  oatpp::List<oatpp::Object<ItemDto>> items({});
+  for(v_int32 i = 0; i < count; i ++) {
+    auto item = ItemDto::createShared();
+    item->id = i;
+    item->name = "item-name \"" + oatpp::utils::Conversion::int32ToStr(i) + "\"";
+    item->required = "required";
+    items->push_back(item);
+  }
+  if(broken) {
+    items[static_cast<v_buff_usize>(count - 1)]->required = nullptr;
+  }
+  return items;
+}
+
+class DtoHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> m_objectMapper;
+  oatpp::Void m_dto;
+public:
+
+  DtoHandler(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper, const oatpp::Void& dto)
+    : m_objectMapper(objectMapper)
+    , m_dto(dto)
+  {}
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return ResponseFactory::createResponse(Status::CODE_200, m_dto, m_objectMapper, true);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class DtoCoroutine : public oatpp::async::CoroutineWithResult<DtoCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<OutgoingResponse> m_response;
+    public:
+
+      DtoCoroutine(const std::shared_ptr<OutgoingResponse>& response)
+        : m_response(response)
+      {}
+
+      Action act() override {
+        return _return(m_response);
+      }
+
+    };
+
+    (void) request;
+    return DtoCoroutine::startForResult(ResponseFactory::createResponse(Status::CODE_200, m_dto, m_objectMapper, true));
+
+  }
+
+};
+
+class SendCoroutine : public oatpp::async::Coroutine<SendCoroutine> {
+private:
+  std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> m_response;
+  std::shared_ptr<data::stream::BufferOutputStream> m_stream;
+  std::shared_ptr<oatpp::web::protocol::http::encoding::EncoderProvider> m_encoder;
+  std::atomic<bool>* m_failed;
+public:
+
+  SendCoroutine(const std::shared_ptr<oatpp::web::protocol::http::outgoing::Response>& response,
+                const std::shared_ptr<data::stream::BufferOutputStream>& stream,
+                const std::shared_ptr<oatpp::web::protocol::http::encoding::EncoderProvider>& encoder,
+                std::atomic<bool>* failed)
+    : m_response(response)
+    , m_stream(stream)
+    , m_encoder(encoder)
+    , m_failed(failed)
+  {}
+
+  Action act() override {
+    return oatpp::web::protocol::http::outgoing::Response::sendAsync(m_response, m_stream, std::make_shared<data::stream::BufferOutputStream>(), m_encoder)
+      .next(finish());
+  }
+
+  Action handleError(Error* error) override {
+    *m_failed = true;
+    return Coroutine::handleError(error);
+  }
+
+};
+
+void runServer(const char* tag, bool async, v_int32 requests) {
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+  auto items = createItems(1000, false);
+  auto expected = objectMapper->writeToString(items);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/dto", std::make_shared<DtoHandler>(objectMapper, items));
+  router->route("GET", "/broken", std::make_shared<DtoHandler>(objectMapper, createItems(1000, true)));
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+  } else {
+    connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  }
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  {
+    oatpp::test::PerformanceChecker checker(tag);
+
+    oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+    auto connection = requestExecutor.getConnection();
+
+    for(v_int32 i = 0; i < requests; i ++) {
+      auto response = requestExecutor.execute("GET", "/dto", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      OATPP_ASSERT(response->getHeader("Transfer-Encoding") == "chunked")
+      OATPP_ASSERT(response->getHeader("Content-Length") == nullptr)
+      OATPP_ASSERT(response->getHeader("Content-Type") == "application/json")
+      auto body = response->readBodyToString();
+      OATPP_ASSERT(body == expected)
+    }
+
+    requestExecutor.invalidateConnection(connection);
+  }
+
+  {
+    /* serialization error in the middle of the body - connection is dropped, client never gets complete JSON */
+    oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+    auto connection = requestExecutor.getConnection();
+
+    bool complete = false;
+    try {
+      auto response = requestExecutor.execute("GET", "/broken", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+      auto body = response->readBodyToString();
+      objectMapper->readFromString<oatpp::List<oatpp::Object<ItemDto>>>(body);
+      complete = true;
+    } catch (const std::runtime_error&) {
+      // expected
+    }
+    OATPP_ASSERT(!complete)
+
+    requestExecutor.invalidateConnection(connection);
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+}
+
+}
+
+void DtoBodyTest::onRun() {
+
+  runServer("virtual", false, 10);
+  runServer("virtual async", true, 10);
+
+  {
+    OATPP_LOGi(TAG, "Serialization error with content encoder...")
+
+    /* encoded body is transferred via data::stream::transfer - the error must not be taken as the end of body */
+    auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+    auto encoder = std::make_shared<oatpp::web::protocol::http::encoding::ChunkedEncoderProvider>();
+    auto items = createItems(1000, true);
+
+    {
+      auto response = ResponseFactory::createResponse(oatpp::web::protocol::http::Status::CODE_200, items, objectMapper, true);
+      data::stream::BufferOutputStream stream;
+      data::stream::BufferOutputStream headersBuffer;
+      bool thrown = false;
+      try {
+        response->send(&stream, &headersBuffer, encoder.get());
+      } catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+      auto data = stream.toString();
+      OATPP_ASSERT(data->find("Content-Encoding: chunked") != std::string::npos)
+      OATPP_ASSERT(data->find("\r\n0\r\n\r\n") == std::string::npos)
+    }
+
+    {
+      auto response = ResponseFactory::createResponse(oatpp::web::protocol::http::Status::CODE_200, items, objectMapper, true);
+      auto stream = std::make_shared<data::stream::BufferOutputStream>();
+      std::atomic<bool> failed(false);
+
+      oatpp::async::Executor executor(1, 1, 1);
+      executor.execute<SendCoroutine>(response, stream, encoder, &failed);
+      executor.waitTasksFinished();
+      executor.stop();
+      executor.join();
+
+      OATPP_ASSERT(failed)
+      auto data = stream->toString();
+      OATPP_ASSERT(data->find("Content-Encoding: chunked") != std::string::npos)
+      OATPP_ASSERT(data->find("\r\n0\r\n\r\n") == std::string::npos)
+    }
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Body of a mapper without incremental writer...")
+
+    class PlainMapper : public oatpp::data::mapping::ObjectMapper {
+    private:
+      oatpp::json::ObjectMapper m_json;
+    public:
+
+      PlainMapper()
+        : oatpp::data::mapping::ObjectMapper(Info("text", "plain"))
+      {}
+
+      void write(data::stream::ConsistentOutputStream* stream, const oatpp::Void& variant, data::mapping::ErrorStack& errorStack) const override {
+        m_json.write(stream, variant, errorStack);
+      }
+
+      oatpp::Void read(utils::parser::Caret& caret, const oatpp::Type* type, data::mapping::ErrorStack& errorStack) const override {
+        return m_json.read(caret, type, errorStack);
+      }
+
+    };
+
+    auto objectMapper = std::make_shared<PlainMapper>();
+    auto items = createItems(10, false);
+    auto body = oatpp::web::protocol::http::outgoing::DtoBody::createShared(items, objectMapper);
+
+    oatpp::web::protocol::http::Headers headers;
+    body->declareHeaders(headers);
+    OATPP_ASSERT(headers.get("Content-Type") == "text/plain")
+    OATPP_ASSERT(body->getKnownSize() == -1)
+
+    data::stream::BufferOutputStream stream;
+    v_char8 buffer[16];
+    v_io_size res;
+    while((res = body->readSimple(buffer, 16)) > 0) {
+      stream.writeSimple(buffer, res);
+    }
+    OATPP_ASSERT(stream.toString() == objectMapper->writeToString(items))
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}}}
@@ -0,0 +1,345 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "FileBodyTest.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/FileBody.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/network/Server.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#if !defined(WIN32) && !defined(_WIN32)
+  #include <csignal>
+  #include <fcntl.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+#endif
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http {
+
+namespace {
+
+typedef oatpp::web::protocol::http::outgoing::FileBody FileBody;
+
+const char* const TEST_FILE = "FileBodyTest.tmp";
+
+class FileHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return OutgoingResponse::createShared(Status::CODE_200, FileBody::createShared(TEST_FILE, "application/octet-stream"));
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class FileCoroutine : public oatpp::async::CoroutineWithResult<FileCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    public:
+
+      Action act() override {
+        return _return(OutgoingResponse::createShared(Status::CODE_200, FileBody::createShared(TEST_FILE, "application/octet-stream")));
+      }
+
+    };
+
+    (void) request;
+    return FileCoroutine::startForResult();
+
+  }
+
+};
+
+oatpp::String createTestFile(v_int64 size) {
+  oatpp::String content(size);
+  for(v_int64 i = 0; i < size; i ++) {
+    content->data()[i] = static_cast<char>('a' + (i * 7) % 26);
+  }
+  std::ofstream file(TEST_FILE, std::ios::out | std::ios::binary);
+  file.write(content->data(), static_cast<std::streamsize>(content->size()));
+  return content;
+}
+
+/*
+ * Opens the file - the body size is known from here on - and then truncates it before the response is sent.
+ */
+class TruncatingFileHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+
+  static std::shared_ptr<OutgoingResponse> createResponse() {
+    auto body = FileBody::createShared(TEST_FILE, "application/octet-stream");
+    std::ofstream truncated(TEST_FILE, std::ios::out | std::ios::binary | std::ios::trunc);
+    truncated.write("x", 1);
+    return OutgoingResponse::createShared(Status::CODE_200, body);
+  }
+
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return createResponse();
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class FileCoroutine : public oatpp::async::CoroutineWithResult<FileCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    public:
+
+      Action act() override {
+        return _return(createResponse());
+      }
+
+    };
+
+    (void) request;
+    return FileCoroutine::startForResult();
+
+  }
+
+};
+
+void runServer(const char* tag,
+               const std::shared_ptr<oatpp::network::ServerConnectionProvider>& serverConnectionProvider,
+               const std::shared_ptr<oatpp::network::ClientConnectionProvider>& clientConnectionProvider,
+               bool async,
+               const oatpp::String& expected,
+               v_int32 requests,
+               bool truncate = false)
+{
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/file", std::make_shared<FileHandler>());
+  router->route("GET", "/truncated", std::make_shared<TruncatingFileHandler>());
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+  } else {
+    connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  }
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  {
+    oatpp::test::PerformanceChecker checker(tag);
+
+    oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider);
+    auto connection = requestExecutor.getConnection();
+
+    for(v_int32 i = 0; i < requests; i ++) {
+      auto response = requestExecutor.execute("GET", "/file", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      OATPP_ASSERT(response->getHeader("Content-Length") == oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(expected->size())))
+      OATPP_ASSERT(response->getHeader("Content-Type") == "application/octet-stream")
+      auto body = response->readBodyToString();
+      OATPP_ASSERT(body == expected)
+    }
+
+    if(truncate) {
+      /* the file is truncated after Content-Length is computed - the server must close the connection */
+      auto response = requestExecutor.execute("GET", "/truncated", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      OATPP_ASSERT(response->getHeader("Content-Length") == oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(expected->size())))
+      auto body = response->readBodyToString();
+      OATPP_ASSERT(body->size() < expected->size())
+    }
+
+    requestExecutor.invalidateConnection(connection);
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+}
+
+void runTcp(const char* tag, bool async, const oatpp::String& expected, v_int32 requests, bool truncate = false) {
+
+  auto serverConnectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
+    {"127.0.0.1", 0, oatpp::network::Address::IP_4}
+  );
+  auto port = serverConnectionProvider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+  );
+
+  runServer(tag, serverConnectionProvider, clientConnectionProvider, async, expected, requests, truncate);
+
+}
+
+void runVirtual(const char* tag, bool async, const oatpp::String& expected, v_int32 requests) {
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+  runServer(tag, serverConnectionProvider, clientConnectionProvider, async, expected, requests);
+}
+
+}
+
+void FileBodyTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Empty file...")
+    auto expected = createTestFile(0);
+    runTcp("tcp, empty file", false, expected, 2);
+    runTcp("tcp async, empty file", true, expected, 2);
+  }
+
+  {
+    OATPP_LOGi(TAG, "8MB file...")
+    auto expected = createTestFile(8 * 1024 * 1024);
+
+    /* tcp - sendfile */
+    runTcp("tcp, sendfile", false, expected, 10);
+    runTcp("tcp async, sendfile", true, expected, 10);
+
+    /* virtual connections - fallback to regular read */
+    runVirtual("virtual, read", false, expected, 2);
+    runVirtual("virtual async, read", true, expected, 2);
+  }
+
+  {
+    OATPP_LOGi(TAG, "File truncated before it is sent...")
+
+    auto expected = createTestFile(8 * 1024 * 1024);
+    runTcp("tcp, truncated", false, expected, 1, true);
+
+    expected = createTestFile(8 * 1024 * 1024);
+    runTcp("tcp async, truncated", true, expected, 1, true);
+  }
+
+#if !defined(WIN32) && !defined(_WIN32)
+  if(oatpp::network::tcp::Connection::isSendFileSupported()) {
+    OATPP_LOGi(TAG, "Broken pipe...")
+    createTestFile(64 * 1024);
+
+    int sockets[2];
+    OATPP_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0)
+    ::close(sockets[1]);
+    oatpp::network::tcp::Connection connection(sockets[0]);
+
+    int fileHandle = ::open(TEST_FILE, O_RDONLY);
+    OATPP_ASSERT(fileHandle >= 0)
+
+    oatpp::async::Action action;
+    auto res = connection.sendFile(fileHandle, 0, 64 * 1024, action);
+    ::close(fileHandle);
+    OATPP_ASSERT(res == oatpp::IOError::BROKEN_PIPE)
+
+    /* SIGPIPE is neither left blocked nor left pending */
+    sigset_t mask;
+    sigemptyset(&mask);
+    pthread_sigmask(SIG_SETMASK, nullptr, &mask);
+    OATPP_ASSERT(sigismember(&mask, SIGPIPE) == 0)
+    sigset_t pending;
+    sigemptyset(&pending);
+    sigpending(&pending);
+    OATPP_ASSERT(sigismember(&pending, SIGPIPE) == 0)
+  }
+#endif
+
+  {
+    OATPP_LOGi(TAG, "Same response sent twice...")
+    auto expected = createTestFile(100 * 1024);
+
+    auto response = oatpp::web::protocol::http::outgoing::Response::createShared(
+      oatpp::web::protocol::http::Status::CODE_200, FileBody::createShared(TEST_FILE)
+    );
+
+    for(v_int32 i = 0; i < 2; i ++) {
+      oatpp::data::stream::BufferOutputStream stream;
+      oatpp::data::stream::BufferOutputStream headersBuffer;
+      response->send(&stream, &headersBuffer, nullptr);
+      auto data = stream.toString();
+      OATPP_ASSERT(data->size() > expected->size())
+      OATPP_ASSERT(data->substr(data->size() - expected->size()) == *expected)
+    }
+  }
+
+  {
+    OATPP_LOGi(TAG, "Loaded file truncated in place...")
+    auto expected = createTestFile(64 * 1024);
+
+    auto file = FileBody::File::open(TEST_FILE, true);
+    OATPP_ASSERT(file->getData() != nullptr)
+    OATPP_ASSERT(file->getSize() == static_cast<v_int64>(expected->size()))
+
+    {
+      std::ofstream truncated(TEST_FILE, std::ios::out | std::ios::binary | std::ios::trunc);
+      truncated.write("x", 1);
+    }
+
+    auto body = FileBody::createShared(file, 0, file->getSize());
+    OATPP_ASSERT(body->getKnownSize() == static_cast<v_int64>(expected->size()))
+    OATPP_ASSERT(std::memcmp(body->getKnownData(), expected->data(), expected->size()) == 0)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Missing file...")
+    std::remove(TEST_FILE);
+    bool thrown = false;
+    try {
+      FileBody::createShared(TEST_FILE);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+  }
+
+}
+
+}}}}}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HeadersPerfTest.hpp"
+
+#include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/utils/CharScan.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <string>
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http {
+
+namespace {
+
+typedef oatpp::web::protocol::http::Parser Parser;
+
+/*
+ * Scalar scan of the headers section end - the way headers readers did it before CharScan.
+ */
+v_buff_size scalarFindSectionEnd(const char* data, v_buff_size size, v_uint32& accumulator) {
+  for(v_buff_size i = 0; i < size; i ++) {
+    accumulator <<= 8;
+    accumulator |= static_cast<v_char8>(data[i]);
+    if(accumulator == (('\r' << 24) | ('\n' << 16) | ('\r' << 8) | ('\n'))) {
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+std::string createHeadersBlock(v_buff_size approximateSize) {
+
+  std::string result =
+    "GET /api/v1/users/100500/posts?limit=20&offset=40 HTTP/1.1\r\n"
+    "Host: api.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+    "Accept: application/json, text/plain, */*\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Connection: keep-alive\r\n";
+
+  v_int32 index = 0;
+  while(static_cast<v_buff_size>(result.size()) < approximateSize - 2) {
+    result += "X-Custom-Header-" + std::to_string(index ++) + ": some-header-value-with-a-reasonable-length\r\n";
+  }
+
+  return result + "\r\n";
+
+}
+
+void runBenchmark(v_buff_size approximateSize, v_int32 iterations) {
+
+  auto block = createHeadersBlock(approximateSize);
+  auto size = static_cast<v_buff_size>(block.size());
+
+  v_uint32 acc = 0;
+  OATPP_ASSERT(utils::CharScan::findSectionEnd(block.data(), size, acc) == size)
+  acc = 0;
+  OATPP_ASSERT(scalarFindSectionEnd(block.data(), size, acc) == size)
+
+  OATPP_LOGd("HeadersPerfTest", "headers block size={}, iterations={}, implementation='{}'",
+             size, iterations, utils::CharScan::getImplementationName())
+
+  v_buff_size check = 0;
+
+  {
+    PerformanceChecker checker("Section end - scalar");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      acc = 0;
+      check += scalarFindSectionEnd(block.data(), size, acc);
+    }
+  }
+
+  {
+    PerformanceChecker checker("Section end - CharScan");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      acc = 0;
+      check -= utils::CharScan::findSectionEnd(block.data(), size, acc);
+    }
+  }
+
+  OATPP_ASSERT(check == 0)
+
+  {
+    PerformanceChecker checker("Parse headers");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      oatpp::utils::parser::Caret caret(block.data(), size);
+      oatpp::web::protocol::http::RequestStartingLine startingLine;
+      oatpp::web::protocol::http::Headers headers;
+      oatpp::web::protocol::http::Status status;
+      Parser::parseRequestStartingLine(startingLine, nullptr, caret, status);
+      Parser::parseHeaders(headers, nullptr, caret, status);
+      OATPP_ASSERT(status.code == 0)
+    }
+  }
+
+}
+
+}
+
+void HeadersPerfTest::onRun() {
+  runBenchmark(300, 100000);
+  runBenchmark(1024, 100000);
+  runBenchmark(8 * 1024, 10000);
+}
+
+}}}}}
@@ -119,6 +119,30 @@ void ChunkedTest::onRun() {
     OATPP_ASSERT(result == data)
   }
 
+  { // Vectored transfer
+    oatpp::data::stream::BufferInputStream inStream(data);
+    oatpp::data::stream::BufferOutputStream outStream;
+
+    const v_int32 bufferSize = 5;
+    v_char8 buffer[bufferSize];
+
+    auto count = oatpp::web::protocol::http::encoding::EncoderChunked::transfer(&inStream, &outStream, buffer, bufferSize);
+    auto result = outStream.toString();
+    OATPP_ASSERT(count == static_cast<v_io_size>(data->size()))
+    OATPP_ASSERT(result == encoded)
+  }
+
+  { // Vectored transfer - empty string
+    oatpp::data::stream::BufferInputStream inStream(oatpp::String(""));
+    oatpp::data::stream::BufferOutputStream outStream;
+
+    const v_int32 bufferSize = 5;
+    v_char8 buffer[bufferSize];
+
+    auto count = oatpp::web::protocol::http::encoding::EncoderChunked::transfer(&inStream, &outStream, buffer, bufferSize);
+    OATPP_ASSERT(count == 0)
+    OATPP_ASSERT(outStream.toString() == "0\r\n\r\n")
+  }
 
 }
 
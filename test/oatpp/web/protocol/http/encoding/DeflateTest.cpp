@@ -0,0 +1,433 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DeflateTest.hpp"
+
+#include "oatpp/web/protocol/http/encoding/Deflate.hpp"
+#include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/web/protocol/http/outgoing/StreamingBody.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace encoding {
+
+#if defined(OATPP_LINK_ZLIB)
+
+namespace {
+
+typedef oatpp::web::protocol::http::encoding::EncoderDeflate EncoderDeflate;
+typedef oatpp::web::protocol::http::encoding::DecoderDeflate DecoderDeflate;
+typedef oatpp::web::protocol::http::encoding::DeflateEncoderProvider DeflateEncoderProvider;
+typedef oatpp::web::protocol::http::encoding::GzipEncoderProvider GzipEncoderProvider;
+typedef oatpp::web::protocol::http::encoding::EncodedDataCache EncodedDataCache;
+typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+typedef oatpp::web::protocol::http::Status Status;
+
+oatpp::String generateJson(v_int32 itemsCount) {
+  oatpp::data::stream::BufferOutputStream stream;
+  stream << "[";
+  for(v_int32 i = 0; i < itemsCount; i ++) {
+    if(i > 0) stream << ",";
+    stream << "{\"id\":" << i << ",\"name\":\"item-" << i << "\",\"tags\":[\"oatpp\",\"zlib\"]}";
+  }
+  stream << "]";
+  return stream.toString();
+}
+
+oatpp::String process(const oatpp::String& data, const base::ObjectHandle<data::buffer::Processor>& processor, v_buff_size bufferSize) {
+  oatpp::data::stream::BufferInputStream inStream(data);
+  oatpp::data::stream::BufferOutputStream outStream;
+  std::unique_ptr<v_char8[]> buffer(new v_char8[static_cast<size_t>(bufferSize)]);
+  oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer.get(), bufferSize, processor);
+  return outStream.toString();
+}
+
+/*
+ * Returns the processor result, or status code of the HttpError thrown by the decoder.
+ */
+v_int32 decodeAll(const oatpp::String& data, v_int64 maxOutputSize = DecoderDeflate::DEFAULT_MAX_OUTPUT_SIZE) {
+  DecoderDeflate decoder(maxOutputSize);
+  oatpp::data::buffer::InlineReadData dataIn(data->data(), static_cast<v_buff_size>(data->size()));
+  oatpp::data::buffer::InlineReadData dataOut;
+  v_int32 res = oatpp::data::buffer::Processor::Error::OK;
+  try {
+    while(res == oatpp::data::buffer::Processor::Error::OK || res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT) {
+      dataOut.setEof();
+      res = decoder.iterate(dataIn, dataOut);
+      if(res == oatpp::data::buffer::Processor::Error::PROVIDE_DATA_IN) {
+        dataIn.set(nullptr, 0);
+        res = oatpp::data::buffer::Processor::Error::OK;
+      }
+    }
+  } catch (const oatpp::web::protocol::http::HttpError& e) {
+    return e.getInfo().status.code;
+  }
+  return res;
+}
+
+oatpp::String corrupt(const oatpp::String& encoded) {
+  oatpp::String result(encoded->data(), static_cast<v_buff_size>(encoded->size()));
+  for(size_t i = encoded->size() / 3; i < encoded->size() / 3 + 8; i ++) {
+    result->at(i) = static_cast<char>(result->at(i) ^ 0x5A);
+  }
+  return result;
+}
+
+/*
+ * POST echoes the decoded request body. GET returns data of the given size or streams all of it.
+ */
+class EchoHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+  oatpp::String m_data;
+public:
+
+  EchoHandler(const oatpp::String& data)
+    : m_data(data)
+  {}
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    if(request->getStartingLine().method == "POST") {
+      return OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared(request->readBodyToString()));
+    }
+    auto size = request->getQueryParameter("size");
+    if(size == "stream") {
+      auto stream = std::make_shared<oatpp::data::stream::BufferInputStream>(m_data);
+      return OutgoingResponse::createShared(Status::CODE_200, std::make_shared<oatpp::web::protocol::http::outgoing::StreamingBody>(stream));
+    }
+    auto data = m_data->substr(0, static_cast<size_t>(oatpp::utils::Conversion::strToInt64(size->c_str())));
+    return OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared(data));
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HandlerCoroutine : public oatpp::async::CoroutineWithResult<HandlerCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::shared_ptr<OutgoingResponse> m_response;
+    public:
+
+      HandlerCoroutine(const std::shared_ptr<OutgoingResponse>& response)
+        : m_response(response)
+      {}
+
+      Action act() override {
+        return _return(m_response);
+      }
+
+    };
+
+    /* GET only - request body is not read */
+    return HandlerCoroutine::startForResult(handle(request));
+
+  }
+
+};
+
+void testStreaming(EncoderDeflate::Format format, const oatpp::String& data) {
+
+  { // Small buffer - many iterations
+    EncoderDeflate encoder(format);
+    DecoderDeflate decoder;
+    oatpp::data::buffer::ProcessingPipeline pipeline({&encoder, &decoder});
+    OATPP_ASSERT(process(data, &pipeline, 5) == data)
+  }
+
+  { // Empty data
+    EncoderDeflate encoder(format);
+    auto encoded = process(oatpp::String(""), &encoder, 1024);
+    OATPP_ASSERT(encoded->size() > 0)
+    DecoderDeflate decoder;
+    OATPP_ASSERT(process(encoded, &decoder, 1024) == "")
+  }
+
+  { // Streaming and one-shot encodings are interchangeable
+    EncoderDeflate encoder(format, 9);
+    auto streamed = process(data, &encoder, 4096);
+    auto encoded = EncoderDeflate::encode(data->data(), static_cast<v_buff_size>(data->size()), format, 9);
+    OATPP_ASSERT(streamed == encoded)
+    OATPP_ASSERT(encoded->size() < data->size() / 4)
+
+    if(format == EncoderDeflate::Format::GZIP) {
+      OATPP_ASSERT(static_cast<v_uint8>(encoded->at(0)) == 0x1F && static_cast<v_uint8>(encoded->at(1)) == 0x8B)
+    } else {
+      OATPP_ASSERT(static_cast<v_uint8>(encoded->at(0)) == 0x78)
+    }
+
+    DecoderDeflate decoder;
+    OATPP_ASSERT(process(encoded, &decoder, 7) == data)
+
+    OATPP_ASSERT(decodeAll(encoded) == oatpp::data::buffer::Processor::Error::FINISHED)
+    OATPP_ASSERT(decodeAll(encoded->substr(0, encoded->size() / 2)) == 400)
+    OATPP_ASSERT(decodeAll(corrupt(encoded)) == 400)
+  }
+
+  { // Decoded size is limited
+    auto encoded = EncoderDeflate::encode(data->data(), static_cast<v_buff_size>(data->size()), format);
+    DecoderDeflate exactDecoder(static_cast<v_int64>(data->size()));
+    OATPP_ASSERT(process(encoded, &exactDecoder, 1024) == data)
+    OATPP_ASSERT(decodeAll(encoded, static_cast<v_int64>(data->size()) - 1) == 413)
+  }
+
+}
+
+void testCache() {
+
+  EncodedDataCache cache(100);
+
+  oatpp::String a(30);
+  oatpp::String b(30);
+  b->at(0) = 'b';
+
+  cache.put(a->data(), 30, "encoded-a");
+  cache.put(b->data(), 30, "encoded-b");
+  OATPP_ASSERT(cache.getEntriesCount() == 2)
+  OATPP_ASSERT(cache.getSize() == 78)
+
+  OATPP_ASSERT(cache.get(a->data(), 30) == "encoded-a")
+  OATPP_ASSERT(cache.get(b->data(), 30) == "encoded-b")
+  OATPP_ASSERT(cache.get(a->data(), 29) == nullptr)
+
+  { // 'b' is the most recently used - 'a' is evicted
+    oatpp::String c(30);
+    c->at(0) = 'c';
+    cache.put(c->data(), 30, "encoded-c");
+    OATPP_ASSERT(cache.getEntriesCount() == 2)
+    OATPP_ASSERT(cache.get(a->data(), 30) == nullptr)
+    OATPP_ASSERT(cache.get(b->data(), 30) == "encoded-b")
+    OATPP_ASSERT(cache.get(c->data(), 30) == "encoded-c")
+  }
+
+  { // Larger than the cache
+    oatpp::String d(95);
+    cache.put(d->data(), 95, "encoded-d");
+    OATPP_ASSERT(cache.get(d->data(), 95) == nullptr)
+    OATPP_ASSERT(cache.getEntriesCount() == 2)
+  }
+
+}
+
+void testProvider(const oatpp::String& data) {
+
+  DeflateEncoderProvider::Config config;
+  config.minBodySize = 1024;
+  config.cacheMaxSize = 1024 * 1024;
+
+  GzipEncoderProvider provider(config);
+  OATPP_ASSERT(provider.getEncodingName() == "gzip")
+  OATPP_ASSERT(!provider.shouldEncode(1023))
+  OATPP_ASSERT(provider.shouldEncode(1024))
+
+  /* mutable bodies don't touch the cache */
+  auto mutable1 = provider.encodeKnownData(data->data(), static_cast<v_buff_size>(data->size()), false);
+  auto mutable2 = provider.encodeKnownData(data->data(), static_cast<v_buff_size>(data->size()), false);
+  OATPP_ASSERT(mutable1 == mutable2)
+  OATPP_ASSERT(mutable1.get() != mutable2.get())
+  OATPP_ASSERT(provider.getCache()->getEntriesCount() == 0)
+
+  auto encoded1 = provider.encodeKnownData(data->data(), static_cast<v_buff_size>(data->size()), true);
+  auto copy = oatpp::String(data->data(), static_cast<v_buff_size>(data->size()));
+  auto encoded2 = provider.encodeKnownData(copy->data(), static_cast<v_buff_size>(copy->size()), true);
+
+  OATPP_ASSERT(encoded1.get() == encoded2.get()) // same content - encoded once
+  OATPP_ASSERT(provider.getCache()->getEntriesCount() == 1)
+
+  DeflateEncoderProvider noCacheProvider;
+  OATPP_ASSERT(noCacheProvider.getCache() == nullptr)
+
+}
+
+void testServer(const oatpp::String& data, bool async) {
+
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+  auto encoders = std::make_shared<oatpp::web::protocol::http::encoding::ProviderCollection>();
+  encoders->add(std::make_shared<GzipEncoderProvider>());
+  encoders->add(std::make_shared<DeflateEncoderProvider>());
+
+  auto decoders = std::make_shared<oatpp::web::protocol::http::encoding::ProviderCollection>();
+  decoders->add(std::make_shared<oatpp::web::protocol::http::encoding::GzipDecoderProvider>());
+  decoders->add(std::make_shared<oatpp::web::protocol::http::encoding::DeflateDecoderProvider>());
+  auto bodyDecoder = std::make_shared<oatpp::web::protocol::http::incoming::SimpleBodyDecoder>(decoders);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/data", std::make_shared<EchoHandler>(data));
+  router->route("POST", "/echo", std::make_shared<EchoHandler>(data));
+
+  auto components = std::make_shared<oatpp::web::server::HttpProcessor::Components>(router);
+  components->contentEncodingProviders = encoders;
+  components->bodyDecoder = bodyDecoder;
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+  if(async) {
+    connectionHandler = std::make_shared<oatpp::web::server::AsyncHttpConnectionHandler>(components, executor);
+  } else {
+    connectionHandler = std::make_shared<oatpp::web::server::HttpConnectionHandler>(components);
+  }
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  oatpp::web::client::HttpRequestExecutor requestExecutor(clientConnectionProvider, nullptr, bodyDecoder);
+  auto connection = requestExecutor.getConnection();
+
+  oatpp::web::protocol::http::Headers headers;
+  headers.put("Accept-Encoding", "gzip");
+
+  { // In-memory body - encoded at once, sent with Content-Length
+    auto response = requestExecutor.execute("GET", "data?size=65536", headers, nullptr, connection);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->getHeader("Content-Encoding") == "gzip")
+    OATPP_ASSERT(response->getHeader("Vary") == "Accept-Encoding")
+    OATPP_ASSERT(response->getHeader("Transfer-Encoding") == nullptr)
+    OATPP_ASSERT(response->getHeader("Content-Length") != nullptr)
+    OATPP_ASSERT(response->readBodyToString() == data->substr(0, 65536))
+  }
+
+  { // Below the min-size threshold - sent as is
+    auto response = requestExecutor.execute("GET", "data?size=100", headers, nullptr, connection);
+    OATPP_ASSERT(response->getHeader("Content-Encoding") == nullptr)
+    OATPP_ASSERT(response->getHeader("Vary") == nullptr)
+    OATPP_ASSERT(response->getHeader("Content-Length") == "100")
+    OATPP_ASSERT(response->readBodyToString() == data->substr(0, 100))
+  }
+
+  { // Body of unknown size - encoded on the fly, sent chunked
+    auto response = requestExecutor.execute("GET", "data?size=stream", headers, nullptr, connection);
+    OATPP_ASSERT(response->getHeader("Content-Encoding") == "gzip")
+    OATPP_ASSERT(response->getHeader("Vary") == "Accept-Encoding")
+    OATPP_ASSERT(response->getHeader("Transfer-Encoding") == "chunked")
+    OATPP_ASSERT(response->readBodyToString() == data)
+  }
+
+  if(!async) { // Encoded request body is decoded by the server
+    oatpp::web::protocol::http::Headers requestHeaders;
+    requestHeaders.put("Content-Encoding", "deflate");
+    auto encoded = EncoderDeflate::encode(data->data(), static_cast<v_buff_size>(data->size()), EncoderDeflate::Format::DEFLATE);
+    auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(encoded);
+    auto response = requestExecutor.execute("POST", "echo", requestHeaders, body, connection);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->getHeader("Content-Encoding") == nullptr)
+    OATPP_ASSERT(response->readBodyToString() == data)
+  }
+
+  if(!async) { // Truncated or corrupted request body is rejected - not passed to the handler shortened
+    auto encoded = EncoderDeflate::encode(data->data(), static_cast<v_buff_size>(data->size()), EncoderDeflate::Format::GZIP);
+    oatpp::web::protocol::http::Headers requestHeaders;
+    requestHeaders.put("Content-Encoding", "gzip");
+    for(auto& invalid : {oatpp::String(encoded->substr(0, encoded->size() / 2)), corrupt(encoded)}) {
+      auto badConnection = requestExecutor.getConnection();
+      auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(invalid);
+      auto response = requestExecutor.execute("POST", "echo", requestHeaders, body, badConnection);
+      OATPP_ASSERT(response->getStatusCode() == 400)
+      OATPP_ASSERT(response->getHeader("Connection") == "close")
+      response->readBodyToString();
+      requestExecutor.invalidateConnection(badConnection);
+    }
+  }
+
+  requestExecutor.invalidateConnection(connection);
+  connection.reset();
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+void runBenchmark(const oatpp::String& data, v_int32 iterationsCount) {
+
+  DeflateEncoderProvider::Config config;
+  DeflateEncoderProvider provider(config);
+  config.cacheMaxSize = 1024 * 1024;
+  DeflateEncoderProvider cachingProvider(config);
+
+  OATPP_LOGd("DeflateTest", "body size={}, encoded size={}", data->size(),
+             provider.encodeKnownData(data->data(), static_cast<v_buff_size>(data->size()), true)->size())
+
+  {
+    oatpp::test::PerformanceChecker checker("deflate - no cache");
+    for(v_int32 i = 0; i < iterationsCount; i ++) {
+      OATPP_ASSERT(provider.encodeKnownData(data->data(), static_cast<v_buff_size>(data->size()), true))
+    }
+  }
+
+  {
+    oatpp::test::PerformanceChecker checker("deflate - cache");
+    for(v_int32 i = 0; i < iterationsCount; i ++) {
+      OATPP_ASSERT(cachingProvider.encodeKnownData(data->data(), static_cast<v_buff_size>(data->size()), true))
+    }
+  }
+
+}
+
+}
+
+void DeflateTest::onRun() {
+
+  auto data = generateJson(2000);
+
+  testStreaming(EncoderDeflate::Format::DEFLATE, data);
+  testStreaming(EncoderDeflate::Format::GZIP, data);
+  testCache();
+  testProvider(data);
+  testServer(data, false);
+  testServer(data, true);
+  runBenchmark(data, 100);
+
+}
+
+#else
+
+void DeflateTest::onRun() {
+  OATPP_LOGi(TAG, "oatpp is built without zlib. Skipped.")
+}
+
+#endif
+
+}}}}}}
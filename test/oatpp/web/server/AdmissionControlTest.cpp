@@ -0,0 +1,417 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AdmissionControlTest.hpp"
+
+#include "oatpp/web/server/AdmissionControl.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace web { namespace server {
+
+namespace {
+
+typedef oatpp::web::server::AdmissionControl AdmissionControl;
+typedef oatpp::web::client::HttpRequestExecutor::ConnectionHandle ConnectionHandle;
+
+/*
+ * Async endpoint busy for the given time - CPU work when spin is true, a timer wait otherwise.
+ */
+class WorkHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+  std::chrono::microseconds m_duration;
+  bool m_spin;
+public:
+
+  WorkHandler(const std::chrono::microseconds& duration, bool spin)
+    : m_duration(duration)
+    , m_spin(spin)
+  {}
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class WorkCoroutine : public oatpp::async::CoroutineWithResult<WorkCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    private:
+      std::chrono::microseconds m_duration;
+      bool m_spin;
+      bool m_waited;
+    public:
+
+      WorkCoroutine(const std::chrono::microseconds& duration, bool spin)
+        : m_duration(duration)
+        , m_spin(spin)
+        , m_waited(false)
+      {}
+
+      Action act() override {
+        if(m_spin) {
+          auto end = std::chrono::steady_clock::now() + m_duration;
+          while(std::chrono::steady_clock::now() < end) {}
+        } else if(!m_waited) {
+          m_waited = true;
+          return waitRepeat(m_duration);
+        }
+        return _return(OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello")));
+      }
+
+    };
+
+    (void) request;
+    return WorkCoroutine::startForResult(m_duration, m_spin);
+
+  }
+
+};
+
+class TestServer {
+public:
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<oatpp::network::tcp::server::ConnectionProvider> serverConnectionProvider;
+  std::shared_ptr<oatpp::web::server::AsyncHttpConnectionHandler> connectionHandler;
+  std::shared_ptr<oatpp::network::Server> server;
+  std::thread serverThread;
+  std::shared_ptr<oatpp::network::tcp::client::ConnectionProvider> clientConnectionProvider;
+  std::shared_ptr<oatpp::web::client::HttpRequestExecutor> requestExecutor;
+public:
+
+  TestServer(const std::shared_ptr<AdmissionControl>& admissionControl, const std::chrono::microseconds& work, bool spin) {
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    router->route("GET", "/", std::make_shared<WorkHandler>(std::chrono::microseconds(0), true));
+    router->route("GET", "/work", std::make_shared<WorkHandler>(work, spin));
+
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    serverConnectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+    connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+    connectionHandler->setAdmissionControl(admissionControl);
+    server = oatpp::network::Server::createShared(serverConnectionProvider, connectionHandler);
+
+    serverThread = std::thread([this]{
+      server->run();
+    });
+
+    auto port = serverConnectionProvider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+    clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+      {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+    );
+
+    requestExecutor = std::make_shared<oatpp::web::client::HttpRequestExecutor>(clientConnectionProvider);
+
+  }
+
+  ~TestServer() {
+    server->stop();
+    serverConnectionProvider->stop();
+    serverThread.join();
+    connectionHandler->stop();
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+  std::shared_ptr<oatpp::web::client::HttpRequestExecutor::Response>
+  request(const oatpp::String& path, const std::shared_ptr<ConnectionHandle>& connection = nullptr) {
+    return requestExecutor->execute("GET", path, oatpp::web::protocol::http::Headers({}), nullptr, connection);
+  }
+
+  /*
+   * Read what server sends to a new connection without sending a request.
+   */
+  oatpp::String readUntilClosed() {
+    auto connection = clientConnectionProvider->get();
+    oatpp::data::stream::BufferOutputStream stream;
+    v_char8 buffer[256];
+    v_io_size res;
+    while((res = connection.object->readSimple(buffer, 256)) > 0) {
+      stream.writeSimple(buffer, res);
+    }
+    return stream.toString();
+  }
+
+  void waitConnections(v_int64 expected) {
+    for(v_int32 i = 0; i < 1000 && connectionHandler->getMetrics().admission.connections != expected; i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    OATPP_ASSERT(connectionHandler->getMetrics().admission.connections == expected)
+  }
+
+};
+
+struct LoadResult {
+  v_int64 served;
+  v_int64 shed;
+  v_int64 avgLatency;
+  v_int64 maxLatency;
+};
+
+/*
+ * Clients fire requests at a CPU-bound endpoint faster than a single executor thread can serve them.
+ */
+LoadResult runLoad(const std::shared_ptr<AdmissionControl>& admissionControl, v_int32 clientsCount, v_int32 requestsPerClient) {
+
+  TestServer server(admissionControl, std::chrono::microseconds(1000), true);
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> shed(0);
+  std::atomic<v_int64> latencySum(0);
+  std::atomic<v_int64> maxLatency(0);
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientsCount; i ++) {
+    clients.emplace_back([&]{
+      for(v_int32 j = 0; j < requestsPerClient; j ++) {
+        auto start = std::chrono::steady_clock::now();
+        auto response = server.request("work");
+        auto body = response->readBodyToString();
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if(response->getStatusCode() == 200) {
+          served ++;
+          latencySum += latency;
+          v_int64 currMax = maxLatency.load();
+          while(latency > currMax && !maxLatency.compare_exchange_weak(currMax, latency)) {}
+        } else {
+          OATPP_ASSERT(response->getStatusCode() == 503)
+          shed ++;
+        }
+      }
+    });
+  }
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  return {served.load(), shed.load(), served.load() > 0 ? latencySum.load() / served.load() : 0, maxLatency.load()};
+
+}
+
+}
+
+void AdmissionControlTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Limits...")
+
+    AdmissionControl::Config config;
+    config.maxConnections = 2;
+    config.maxInFlightRequests = 1;
+    AdmissionControl control(config);
+
+    OATPP_ASSERT(control.admitConnection())
+    OATPP_ASSERT(control.admitConnection())
+    OATPP_ASSERT(!control.admitConnection())
+    control.onConnectionEnd();
+    OATPP_ASSERT(control.admitConnection())
+
+    OATPP_ASSERT(control.admitRequest())
+    OATPP_ASSERT(!control.admitRequest())
+    control.onRequestEnd();
+    OATPP_ASSERT(control.admitRequest())
+    control.onRequestEnd();
+
+    auto metrics = control.getMetrics();
+    OATPP_ASSERT(metrics.connections == 2)
+    OATPP_ASSERT(metrics.inFlightRequests == 0)
+    OATPP_ASSERT(metrics.admittedConnections == 3)
+    OATPP_ASSERT(metrics.shedConnections == 1)
+    OATPP_ASSERT(metrics.shedRequests == 1)
+
+    auto response = control.createRejectResponse();
+    OATPP_ASSERT(response->getStatus().code == 503)
+    OATPP_ASSERT(response->getHeader("Retry-After") == "1")
+    OATPP_ASSERT(control.getRejectMessage()->find("HTTP/1.1 503 Service Unavailable\r\n") == 0)
+
+    config.policy = AdmissionControl::Policy::CLOSE;
+    AdmissionControl closing(config);
+    OATPP_ASSERT(closing.createRejectResponse() == nullptr)
+    OATPP_ASSERT(closing.getRejectMessage() == nullptr)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Queue latency...")
+
+    AdmissionControl::Config config;
+    config.maxQueueLatency = std::chrono::milliseconds(10);
+    config.latencyWindow = std::chrono::milliseconds(100);
+    AdmissionControl control(config);
+
+    control.addQueueLatencySample(std::chrono::milliseconds(1));
+    OATPP_ASSERT(control.admitConnection())
+
+    control.addQueueLatencySample(std::chrono::milliseconds(100));
+    OATPP_ASSERT(control.getMetrics().queueLatency == 1000 + (100000 - 1000) / 8)
+    OATPP_ASSERT(!control.admitConnection())
+    OATPP_ASSERT(!control.admitRequest())
+
+    /* no fresh samples - estimate expires and connections probe the queue again */
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    OATPP_ASSERT(control.admitConnection())
+    OATPP_ASSERT(control.admitRequest())
+
+    /* stale estimate is replaced by the new sample */
+    control.addQueueLatencySample(std::chrono::milliseconds(2));
+    OATPP_ASSERT(control.getMetrics().queueLatency == 2000)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Shed connection - 503...")
+
+    AdmissionControl::Config config;
+    config.maxConnections = 1;
+    config.retryAfter = 2;
+    auto control = std::make_shared<AdmissionControl>(config);
+    TestServer server(control, std::chrono::microseconds(0), true);
+
+    auto connection = server.requestExecutor->getConnection();
+    OATPP_ASSERT(server.request("", connection)->getStatusCode() == 200)
+
+    auto message = server.readUntilClosed();
+    OATPP_ASSERT(message->find("HTTP/1.1 503 Service Unavailable\r\n") == 0)
+    OATPP_ASSERT(message->find("Retry-After: 2\r\n") != std::string::npos)
+
+    /* the first connection is still served */
+    OATPP_ASSERT(server.request("", connection)->getStatusCode() == 200)
+    server.requestExecutor->invalidateConnection(connection);
+
+    server.waitConnections(0);
+    OATPP_ASSERT(server.request("")->getStatusCode() == 200)
+
+    auto metrics = server.connectionHandler->getMetrics();
+    OATPP_ASSERT(metrics.admission.shedConnections == 1)
+    OATPP_ASSERT(metrics.admission.admittedConnections == 2)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Shed connection - close...")
+
+    AdmissionControl::Config config;
+    config.maxConnections = 1;
+    config.policy = AdmissionControl::Policy::CLOSE;
+    auto control = std::make_shared<AdmissionControl>(config);
+    TestServer server(control, std::chrono::microseconds(0), true);
+
+    auto connection = server.requestExecutor->getConnection();
+    OATPP_ASSERT(server.request("", connection)->getStatusCode() == 200)
+    OATPP_ASSERT(server.readUntilClosed()->empty())
+    server.requestExecutor->invalidateConnection(connection);
+  }
+
+  {
+    OATPP_LOGi(TAG, "Shed request...")
+
+    AdmissionControl::Config config;
+    config.maxInFlightRequests = 1;
+    auto control = std::make_shared<AdmissionControl>(config);
+    TestServer server(control, std::chrono::microseconds(300 * 1000), false);
+
+    std::thread slowClient([&server]{
+      auto response = server.request("work");
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      OATPP_ASSERT(response->readBodyToString() == "Hello")
+    });
+
+    for(v_int32 i = 0; i < 1000 && control->getMetrics().inFlightRequests == 0; i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto response = server.request("");
+    OATPP_ASSERT(response->getStatusCode() == 503)
+    OATPP_ASSERT(response->getHeader("Retry-After") == "1")
+    OATPP_ASSERT(response->getHeader("Connection") == "close")
+
+    slowClient.join();
+
+    /* the request ends once its response is written - client may see the response a bit earlier */
+    for(v_int32 i = 0; i < 1000 && control->getMetrics().inFlightRequests != 0; i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    OATPP_ASSERT(server.request("")->getStatusCode() == 200)
+
+    auto metrics = control->getMetrics();
+    OATPP_ASSERT(metrics.shedRequests == 1)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Admission control set while serving...")
+
+    TestServer server(nullptr, std::chrono::microseconds(0), true);
+
+    auto before = server.requestExecutor->getConnection();
+    OATPP_ASSERT(server.request("", before)->getStatusCode() == 200)
+
+    auto control = std::make_shared<AdmissionControl>(AdmissionControl::Config());
+    server.connectionHandler->setAdmissionControl(control);
+
+    auto after = server.requestExecutor->getConnection();
+    OATPP_ASSERT(server.request("", after)->getStatusCode() == 200)
+    OATPP_ASSERT(server.request("", before)->getStatusCode() == 200)
+    server.waitConnections(1);
+
+    /* connection accepted before admission control was set is not reported to it */
+    server.requestExecutor->invalidateConnection(before);
+    server.requestExecutor->invalidateConnection(after);
+    for(v_int32 i = 0; i < 1000 && server.connectionHandler->getConnectionsCount() != 0; i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto metrics = control->getMetrics();
+    OATPP_ASSERT(metrics.connections == 0)
+    OATPP_ASSERT(metrics.inFlightRequests == 0)
+    OATPP_ASSERT(metrics.admittedConnections == 1)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Overload - 16 clients, 1ms of CPU work per request, 1 executor thread...")
+
+    auto unlimited = runLoad(nullptr, 16, 50);
+    OATPP_LOGd(TAG, "no admission control: served={}, shed={}, avg latency={}(micro), max latency={}(micro)",
+               unlimited.served, unlimited.shed, unlimited.avgLatency, unlimited.maxLatency)
+    OATPP_ASSERT(unlimited.shed == 0)
+
+    AdmissionControl::Config config;
+    config.maxInFlightRequests = 2;
+    auto limited = runLoad(std::make_shared<AdmissionControl>(config), 16, 50);
+    OATPP_LOGd(TAG, "maxInFlightRequests=2: served={}, shed={}, avg latency={}(micro), max latency={}(micro)",
+               limited.served, limited.shed, limited.avgLatency, limited.maxLatency)
+    OATPP_ASSERT(limited.served + limited.shed == 16 * 50)
+    OATPP_ASSERT(limited.served > 0)
+  }
+
+}
+
+}}}}
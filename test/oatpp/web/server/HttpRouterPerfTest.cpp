@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HttpRouterPerfTest.hpp"
+
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/Types.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <list>
+
+namespace oatpp { namespace test { namespace web { namespace server {
+
+namespace {
+
+typedef oatpp::web::url::mapping::Pattern Pattern;
+typedef oatpp::web::url::mapping::Router<v_int32> NumRouter;
+
+/*
+ * Sequential scan of all patterns - the way routes were resolved before PatternTree.
+ */
+class ListRouter {
+private:
+  std::list<std::pair<std::shared_ptr<Pattern>, v_int32>> m_patterns;
+public:
+
+  void route(const oatpp::String& pathPattern, v_int32 endpoint) {
+    m_patterns.push_back({Pattern::parse(pathPattern), endpoint});
+  }
+
+  v_int32 getRoute(const oatpp::data::share::StringKeyLabel& path) const {
+    for(auto& pair : m_patterns) {
+      Pattern::MatchMap matchMap;
+      if(pair.first->match(path, matchMap)) {
+        return pair.second;
+      }
+    }
+    return -1;
+  }
+
+};
+
+void runBenchmark(v_int32 routesCount, v_int32 iterations) {
+
+  NumRouter router;
+  ListRouter listRouter;
+
+  /* each collection adds two routes */
+  for(v_int32 i = 0; i < routesCount / 2; i ++) {
+    auto index = oatpp::utils::Conversion::int32ToStr(i);
+    oatpp::String collection = "api/v1/collection_" + index;
+    oatpp::String item = collection + "/{itemId}/details";
+    router.route(collection, i * 2);
+    router.route(item, i * 2 + 1);
+    listRouter.route(collection, i * 2);
+    listRouter.route(item, i * 2 + 1);
+  }
+
+  oatpp::String lastHit = "/api/v1/collection_" + oatpp::utils::Conversion::int32ToStr(routesCount / 2 - 1) + "/100500/details";
+  oatpp::String miss = "/api/v1/unknown/100500/details";
+
+  OATPP_ASSERT(router.getRoute(lastHit).getEndpoint() == listRouter.getRoute(lastHit))
+  OATPP_ASSERT(!router.getRoute(miss))
+  OATPP_ASSERT(listRouter.getRoute(miss) == -1)
+
+  OATPP_LOGd("HttpRouterPerfTest", "routes={}, iterations={}", routesCount, iterations)
+
+  {
+    PerformanceChecker checker("PatternTree - hit");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      router.getRoute(lastHit);
+    }
+  }
+
+  {
+    PerformanceChecker checker("List scan - hit");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      listRouter.getRoute(lastHit);
+    }
+  }
+
+  {
+    PerformanceChecker checker("PatternTree - miss");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      router.getRoute(miss);
+    }
+  }
+
+  {
+    PerformanceChecker checker("List scan - miss");
+    for(v_int32 i = 0; i < iterations; i ++) {
+      listRouter.getRoute(miss);
+    }
+  }
+
+}
+
+}
+
+void HttpRouterPerfTest::onRun() {
+  runBenchmark(10, 10000);
+  runBenchmark(100, 10000);
+  runBenchmark(1000, 10000);
+}
+
+}}}}
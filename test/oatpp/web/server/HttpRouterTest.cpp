@@ -33,6 +33,23 @@ namespace {
 
 typedef oatpp::web::server::HttpRouterTemplate<v_int32> NumRouter;
 
+/*
+ * Resolve route the same way as sequential matching of each pattern does.
+ */
+v_int32 matchSequentially(const std::vector<oatpp::String>& patterns,
+                          const oatpp::String& path,
+                          oatpp::web::url::mapping::Pattern::MatchMap& matchMap)
+{
+  for(size_t i = 0; i < patterns.size(); i ++) {
+    oatpp::web::url::mapping::Pattern::MatchMap map;
+    if(oatpp::web::url::mapping::Pattern::parse(patterns[i])->match(path, map)) {
+      matchMap = map;
+      return static_cast<v_int32>(i);
+    }
+  }
+  return -1;
+}
+
 }
 
 void HttpRouterTest::onRun() {
@@ -186,6 +203,117 @@ void HttpRouterTest::onRun() {
     OATPP_ASSERT(r.getMatchMap().getTail() == "?q1=1&q2=2")
   }
 
+  {
+    OATPP_LOGi(TAG, "Case 17 - precedence")
+    NumRouter precedenceRouter;
+    precedenceRouter.route("GET", "users/{id}", 1);
+    precedenceRouter.route("GET", "users/me", 2);
+    precedenceRouter.route("GET", "users/me/{field}", 3);
+    precedenceRouter.route("GET", "users/{id}/name", 4);
+
+    auto r = precedenceRouter.getRoute("GET", "users/me");
+    OATPP_ASSERT(r)
+    OATPP_ASSERT(r.getEndpoint() == 1)
+    OATPP_ASSERT(r.getMatchMap().getVariable("id") == "me")
+
+    r = precedenceRouter.getRoute("GET", "users/me/name");
+    OATPP_ASSERT(r)
+    OATPP_ASSERT(r.getEndpoint() == 3)
+    OATPP_ASSERT(r.getMatchMap().getVariable("field") == "name")
+
+    r = precedenceRouter.getRoute("GET", "users/5/name");
+    OATPP_ASSERT(r)
+    OATPP_ASSERT(r.getEndpoint() == 4)
+    OATPP_ASSERT(r.getMatchMap().getVariable("id") == "5")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case 18 - same result as sequential match")
+
+    std::vector<oatpp::String> patterns = {
+      "/", "api/v1/users", "api/v1/users/{id}", "api/v1/{resource}/{id}", "api/v1/users/{id}/posts/*",
+      "api/*", "api/v1/users/{userId}/posts/{postId}", "files/*", "files/{name}", "a/b/c", "a/{x}/c/{y}",
+      "a/b/{z}", "q/{v}/tail", "q/const", "*"
+    };
+
+    std::vector<oatpp::String> paths = {
+      "", "/", "//", "api", "api/v1/users", "/api/v1/users/", "api/v1/users?x=1", "api/v1/users/10",
+      "api/v1/users/10?x=1", "api/v1/posts/10", "api/v1/users/10/posts", "api/v1/users/10/posts/20",
+      "api/v1/users/10/posts/20/comments", "api/v1/users/10?x=1/posts/20", "files", "files/a.txt",
+      "files/dir/a.txt", "a/b/c", "a/b/c/d", "a/b/d", "a/q/c/w", "a/q/c/w?x", "q/1/tail", "q/1?x/tail",
+      "q/const?x=y", "q/const/more", "unknown/path", "?only=query"
+    };
+
+    NumRouter mixedRouter;
+    for(size_t i = 0; i < patterns.size(); i ++) {
+      mixedRouter.route("GET", patterns[i], static_cast<v_int32>(i));
+    }
+
+    for(auto& path : paths) {
+
+      oatpp::web::url::mapping::Pattern::MatchMap expectedMap;
+      auto expected = matchSequentially(patterns, path, expectedMap);
+      auto r = mixedRouter.getRoute("GET", path);
+
+      OATPP_LOGd(TAG, "path='{}' -> {}", path, expected)
+
+      if(expected == -1) {
+        OATPP_ASSERT(!r)
+        continue;
+      }
+
+      OATPP_ASSERT(r)
+      OATPP_ASSERT(r.getEndpoint() == expected)
+      OATPP_ASSERT(r.getMatchMap().getTail() == expectedMap.getTail())
+      OATPP_ASSERT(r.getMatchMap().getVariables().size() == expectedMap.getVariables().size())
+      for(auto& pair : expectedMap.getVariables()) {
+        OATPP_ASSERT(r.getMatchMap().getVariable(pair.first) == pair.second.toString())
+      }
+
+    }
+
+    OATPP_ASSERT(!mixedRouter.getRoute("POST", "api/v1/users"))
+
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case 19 - variables exceeding inline capacity")
+    NumRouter varsRouter;
+    varsRouter.route("GET", "{a}/{b}/{c}/{d}/{e}/{f}", 1);
+
+    auto r = varsRouter.getRoute("GET", "1/2/3/4/5/6?q=1");
+    OATPP_ASSERT(r)
+    OATPP_ASSERT(r.getMatchMap().getVariables().size() == 6)
+    OATPP_ASSERT(r.getMatchMap().getVariable("a") == "1")
+    OATPP_ASSERT(r.getMatchMap().getVariable("d") == "4")
+    OATPP_ASSERT(r.getMatchMap().getVariable("f") == "6")
+    OATPP_ASSERT(r.getMatchMap().getVariable("g") == nullptr)
+    OATPP_ASSERT(r.getMatchMap().getTail() == "?q=1")
+
+    auto copy = r.getMatchMap();
+    OATPP_ASSERT(copy.getVariable("e") == "5")
+
+    const auto& vars = copy.getVariables();
+    OATPP_ASSERT(vars.at("b") == "2")
+    OATPP_ASSERT(vars.count("c") == 1)
+    OATPP_ASSERT(vars.count("g") == 0)
+    OATPP_ASSERT(vars.find("g") == vars.end())
+
+    bool thrown = false;
+    try {
+      vars.at("g");
+    } catch (const std::out_of_range&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+
+    v_int32 count = 0;
+    for(auto it = vars.cbegin(); it != vars.cend(); it ++) {
+      count ++;
+    }
+    OATPP_ASSERT(count == 6)
+  }
+
 }
 
 }}}}
@@ -0,0 +1,316 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HttpWorkerPoolTest.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace web { namespace server {
+
+namespace {
+
+typedef oatpp::web::client::HttpRequestExecutor::ConnectionHandle ConnectionHandle;
+
+const char* const SAMPLE_IN =
+  "GET / HTTP/1.1\r\n"
+  "Connection: keep-alive\r\n"
+  "Content-Length: 0\r\n"
+  "\r\n";
+
+const char* const SAMPLE_OUT =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Length: 5\r\n"
+  "Connection: keep-alive\r\n"
+  "Server: oatpp/" OATPP_VERSION "\r\n"
+  "\r\n"
+  "Hello";
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared("Hello"));
+  }
+
+};
+
+class TestServer {
+public:
+  std::shared_ptr<oatpp::network::tcp::server::ConnectionProvider> serverConnectionProvider;
+  std::shared_ptr<oatpp::web::server::HttpConnectionHandler> connectionHandler;
+  std::shared_ptr<oatpp::network::Server> server;
+  std::thread serverThread;
+  std::shared_ptr<oatpp::network::tcp::client::ConnectionProvider> clientConnectionProvider;
+  std::shared_ptr<oatpp::web::client::HttpRequestExecutor> requestExecutor;
+public:
+
+  TestServer(const oatpp::web::server::HttpWorkerPool::Config& poolConfig) {
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    router->route("GET", "/", std::make_shared<HelloHandler>());
+
+    serverConnectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+    connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router, poolConfig);
+    server = oatpp::network::Server::createShared(serverConnectionProvider, connectionHandler);
+
+    serverThread = std::thread([this]{
+      server->run();
+    });
+
+    auto port = serverConnectionProvider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+    clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+      {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+    );
+
+    requestExecutor = std::make_shared<oatpp::web::client::HttpRequestExecutor>(clientConnectionProvider);
+
+  }
+
+  ~TestServer() {
+    server->stop();
+    serverConnectionProvider->stop();
+    serverThread.join();
+    connectionHandler->stop();
+  }
+
+  void request(const std::shared_ptr<ConnectionHandle>& connection) {
+    auto response = requestExecutor->execute("GET", "/", oatpp::web::protocol::http::Headers({}), nullptr, connection);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString() == "Hello")
+  }
+
+  oatpp::web::server::HttpWorkerPool::Metrics waitParked(v_int64 expected) {
+    auto metrics = connectionHandler->getWorkerPool()->getMetrics();
+    for(v_int32 i = 0; i < 1000 && metrics.parkedConnections != expected; i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      metrics = connectionHandler->getWorkerPool()->getMetrics();
+    }
+    return metrics;
+  }
+
+};
+
+}
+
+void HttpWorkerPoolTest::onRun() {
+
+  if(!oatpp::web::server::HttpWorkerPool::isParkingSupported()) {
+    OATPP_LOGi(TAG, "Connection parking is not supported on this platform. Skipping...")
+    return;
+  }
+
+  {
+    OATPP_LOGi(TAG, "More idle keep-alive connections than workers...")
+
+    oatpp::web::server::HttpWorkerPool::Config config;
+    config.workersCount = 2;
+
+    TestServer testServer(config);
+
+    const v_int32 connectionsCount = 32;
+    std::vector<std::shared_ptr<ConnectionHandle>> connections;
+    for(v_int32 i = 0; i < connectionsCount; i ++) {
+      connections.push_back(testServer.requestExecutor->getConnection());
+    }
+
+    /* round-robin over the connections - it would stall if idle connections were pinning workers */
+    for(v_int32 round = 0; round < 5; round ++) {
+      for(auto& connection : connections) {
+        testServer.request(connection);
+      }
+    }
+
+    auto metrics = testServer.waitParked(connectionsCount);
+    OATPP_LOGd(TAG, "connections={}, parked={}, busy={}, maxQueueDepth={}",
+               metrics.connections, metrics.parkedConnections, metrics.busyWorkers, metrics.maxQueueDepth)
+
+    OATPP_ASSERT(metrics.connections == connectionsCount)
+    OATPP_ASSERT(metrics.parkedConnections == connectionsCount)
+    OATPP_ASSERT(metrics.busyWorkers == 0)
+    OATPP_ASSERT(metrics.queueDepth == 0)
+
+    for(auto& connection : connections) {
+      testServer.requestExecutor->invalidateConnection(connection);
+    }
+    connections.clear();
+
+    for(v_int32 i = 0; i < 1000 && testServer.connectionHandler->getConnectionsCount() > 0; i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    OATPP_ASSERT(testServer.connectionHandler->getConnectionsCount() == 0)
+    OATPP_ASSERT(testServer.connectionHandler->getWorkerPool()->getMetrics().connections == 0)
+  }
+
+  {
+    OATPP_LOGi(TAG, "Pipelined requests...")
+
+    oatpp::web::server::HttpWorkerPool::Config config;
+    config.workersCount = 1;
+
+    TestServer testServer(config);
+
+    const v_int32 pipelineSize = 100;
+    auto connection = testServer.clientConnectionProvider->get();
+    connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+    connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+    oatpp::data::stream::BufferOutputStream pipelineStream;
+    for(v_int32 i = 0; i < pipelineSize; i ++) {
+      pipelineStream << SAMPLE_IN;
+    }
+    auto dataToSend = pipelineStream.toString();
+    OATPP_ASSERT(connection.object->writeExactSizeDataSimple(dataToSend->data(), static_cast<v_buff_size>(dataToSend->size())) == static_cast<v_io_size>(dataToSend->size()))
+
+    oatpp::String sample = SAMPLE_OUT;
+    oatpp::data::stream::BufferOutputStream receiveStream;
+    oatpp::data::buffer::IOBuffer ioBuffer;
+    v_io_size transferSize = static_cast<v_io_size>(sample->size() * static_cast<size_t>(pipelineSize));
+    oatpp::data::stream::transfer(connection.object.get(), &receiveStream, transferSize, ioBuffer.getData(), ioBuffer.getSize());
+
+    OATPP_ASSERT(receiveStream.getCurrentPosition() == transferSize)
+
+    connection.invalidator->invalidate(connection.object);
+  }
+
+  {
+    OATPP_LOGi(TAG, "Partial request headers don't hold a worker...")
+
+    oatpp::web::server::HttpWorkerPool::Config config;
+    config.workersCount = 1;
+
+    TestServer testServer(config);
+
+    auto slowConnection = testServer.clientConnectionProvider->get();
+    slowConnection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+    slowConnection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+    /* send the request in two parts - the only worker must not wait for the rest */
+    oatpp::String request = SAMPLE_IN;
+    v_buff_size firstPartSize = 10;
+    OATPP_ASSERT(slowConnection.object->writeExactSizeDataSimple(request->data(), firstPartSize) == firstPartSize)
+    testServer.waitParked(1);
+
+    auto connection = testServer.requestExecutor->getConnection();
+    testServer.request(connection);
+
+    v_buff_size restSize = static_cast<v_buff_size>(request->size()) - firstPartSize;
+    OATPP_ASSERT(slowConnection.object->writeExactSizeDataSimple(request->data() + firstPartSize, restSize) == restSize)
+
+    oatpp::String sample = SAMPLE_OUT;
+    oatpp::data::stream::BufferOutputStream receiveStream;
+    oatpp::data::buffer::IOBuffer ioBuffer;
+    v_io_size transferSize = static_cast<v_io_size>(sample->size());
+    oatpp::data::stream::transfer(slowConnection.object.get(), &receiveStream, transferSize, ioBuffer.getData(), ioBuffer.getSize());
+    OATPP_ASSERT(receiveStream.toString() == sample)
+
+    testServer.requestExecutor->invalidateConnection(connection);
+    slowConnection.invalidator->invalidate(slowConnection.object);
+  }
+
+  {
+    OATPP_LOGi(TAG, "Stop the pool with parked connections...")
+
+    oatpp::web::server::HttpWorkerPool::Config config;
+    config.workersCount = 2;
+
+    TestServer testServer(config);
+
+    const v_int32 connectionsCount = 8;
+    std::vector<std::shared_ptr<ConnectionHandle>> connections;
+    for(v_int32 i = 0; i < connectionsCount; i ++) {
+      connections.push_back(testServer.requestExecutor->getConnection());
+      testServer.request(connections.back());
+    }
+
+    OATPP_ASSERT(testServer.waitParked(connectionsCount).parkedConnections == connectionsCount)
+    OATPP_ASSERT(testServer.connectionHandler->getConnectionsCount() == static_cast<v_uint64>(connectionsCount))
+
+    /* parked connections are released by the pool - tasks end and the handler forgets the connections */
+    testServer.connectionHandler->getWorkerPool()->stop();
+
+    auto metrics = testServer.connectionHandler->getWorkerPool()->getMetrics();
+    OATPP_ASSERT(metrics.connections == 0)
+    OATPP_ASSERT(metrics.parkedConnections == 0)
+    OATPP_ASSERT(testServer.connectionHandler->getConnectionsCount() == 0)
+
+    connections.clear();
+  }
+
+  {
+    OATPP_LOGi(TAG, "Backpressure...")
+
+    oatpp::web::server::HttpWorkerPool::Config config;
+    config.workersCount = 2;
+    config.maxConnections = 4;
+
+    TestServer testServer(config);
+
+    std::vector<std::shared_ptr<ConnectionHandle>> connections;
+    for(v_int32 i = 0; i < config.maxConnections; i ++) {
+      connections.push_back(testServer.requestExecutor->getConnection());
+      testServer.request(connections.back());
+    }
+
+    std::atomic<bool> served(false);
+    std::thread extraClient([&testServer, &served]{
+      auto connection = testServer.requestExecutor->getConnection();
+      testServer.request(connection);
+      served = true;
+      testServer.requestExecutor->invalidateConnection(connection);
+    });
+
+    /* extra connection waits in the acceptor until one of the connections is done */
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    OATPP_ASSERT(!served)
+    OATPP_ASSERT(testServer.connectionHandler->getWorkerPool()->getMetrics().backpressureWaits == 1)
+
+    testServer.requestExecutor->invalidateConnection(connections.back());
+    connections.pop_back();
+
+    extraClient.join();
+    OATPP_ASSERT(served)
+
+    for(auto& connection : connections) {
+      testServer.requestExecutor->invalidateConnection(connection);
+    }
+  }
+
+}
+
+}}}}
@@ -0,0 +1,407 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "StaticFilesHandlerTest.hpp"
+
+#include "oatpp/web/server/handler/StaticFilesHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/FileBody.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace server { namespace handler {
+
+namespace {
+
+typedef oatpp::web::server::handler::StaticFilesHandler StaticFilesHandler;
+typedef oatpp::web::protocol::http::outgoing::FileBody FileBody;
+typedef oatpp::web::protocol::http::Headers Headers;
+typedef oatpp::web::client::HttpRequestExecutor HttpRequestExecutor;
+typedef std::function<void(HttpRequestExecutor&, const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>&)> ClientFunction;
+
+const char* const ROOT = "StaticFilesHandlerTest.dir";
+
+/*
+ * Write through a temporary file and rename - the handler sees either the old or the new file.
+ */
+oatpp::String writeFile(const std::string& name, v_int64 size, v_int64 seed) {
+  oatpp::String content(size);
+  for(v_int64 i = 0; i < size; i ++) {
+    content->data()[i] = static_cast<char>('a' + (i * 7 + seed) % 26);
+  }
+  std::string path = std::string(ROOT) + "/" + name;
+  {
+    std::ofstream file(path + ".tmp", std::ios::out | std::ios::binary);
+    file.write(content->data(), static_cast<std::streamsize>(content->size()));
+  }
+  std::filesystem::rename(path + ".tmp", path);
+  return content;
+}
+
+/*
+ * Baseline - file opened and stat-ed on every request.
+ */
+class FileBodyHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    return OutgoingResponse::createShared(Status::CODE_200, FileBody::createShared(
+      std::string(ROOT) + "/" + *request->getPathTail(), "text/html")
+    );
+  }
+
+};
+
+void runServer(const std::shared_ptr<oatpp::network::ServerConnectionProvider>& serverConnectionProvider,
+               const std::shared_ptr<oatpp::network::ClientConnectionProvider>& clientConnectionProvider,
+               const std::shared_ptr<oatpp::web::server::HttpRequestHandler>& handler,
+               bool async,
+               const ClientFunction& client)
+{
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/static/*", handler);
+
+  std::shared_ptr<oatpp::async::Executor> executor;
+  std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler;
+  if(async) {
+    executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+  } else {
+    connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  }
+
+  oatpp::network::Server server(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([&server]{
+    server.run();
+  });
+
+  {
+    HttpRequestExecutor requestExecutor(clientConnectionProvider);
+    auto connection = requestExecutor.getConnection();
+    client(requestExecutor, connection);
+    requestExecutor.invalidateConnection(connection);
+  }
+
+  server.stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+}
+
+void runTcp(const std::shared_ptr<oatpp::web::server::HttpRequestHandler>& handler, bool async, const ClientFunction& client) {
+
+  auto serverConnectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
+    {"127.0.0.1", 0, oatpp::network::Address::IP_4}
+  );
+  auto port = serverConnectionProvider->getProperty(oatpp::network::ConnectionProvider::PROPERTY_PORT).toString();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared(
+    {"127.0.0.1", static_cast<v_uint16>(oatpp::utils::Conversion::strToInt32(port->c_str())), oatpp::network::Address::IP_4}
+  );
+
+  runServer(serverConnectionProvider, clientConnectionProvider, handler, async, client);
+
+}
+
+void runVirtual(const std::shared_ptr<oatpp::web::server::HttpRequestHandler>& handler, bool async, const ClientFunction& client) {
+  auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+  runServer(serverConnectionProvider, clientConnectionProvider, handler, async, client);
+}
+
+std::shared_ptr<HttpRequestExecutor::Response> get(HttpRequestExecutor& executor,
+                                                   const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection,
+                                                   const oatpp::String& path,
+                                                   const Headers& headers = Headers({}))
+{
+  return executor.execute("GET", "static/" + path, headers, nullptr, connection);
+}
+
+Headers header(const oatpp::String& key, const oatpp::String& value) {
+  Headers headers;
+  headers.put(key, value);
+  return headers;
+}
+
+void testFull(HttpRequestExecutor& executor,
+              const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection,
+              const oatpp::String& path,
+              const oatpp::String& expected)
+{
+  auto response = get(executor, connection, path);
+  OATPP_ASSERT(response->getStatusCode() == 200)
+  OATPP_ASSERT(response->getHeader("Content-Length") == oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(expected->size())))
+  OATPP_ASSERT(response->getHeader("Accept-Ranges") == "bytes")
+  OATPP_ASSERT(response->getHeader("ETag"))
+  OATPP_ASSERT(response->getHeader("Last-Modified"))
+  OATPP_ASSERT(response->readBodyToString() == expected)
+}
+
+void testRange(HttpRequestExecutor& executor,
+               const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection,
+               const oatpp::String& path,
+               const oatpp::String& expected,
+               const oatpp::String& range,
+               v_int64 start,
+               v_int64 end)
+{
+  auto response = get(executor, connection, path, header("Range", range));
+  OATPP_ASSERT(response->getStatusCode() == 206)
+  OATPP_ASSERT(response->getHeader("Content-Range") == "bytes " + oatpp::utils::Conversion::int64ToStr(start) + "-" +
+                                                       oatpp::utils::Conversion::int64ToStr(end) + "/" +
+                                                       oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(expected->size())))
+  OATPP_ASSERT(response->readBodyToString() == expected->substr(static_cast<size_t>(start), static_cast<size_t>(end - start + 1)))
+}
+
+}
+
+void StaticFilesHandlerTest::onRun() {
+
+  std::filesystem::remove_all(ROOT);
+  std::filesystem::create_directories(std::string(ROOT) + "/sub");
+
+  auto index = writeFile("index.html", 1000, 0);
+  auto data = writeFile("sub/data.json", 100, 1);
+  auto big = writeFile("big.bin", 3 * 1024 * 1024, 2);
+
+  {
+    OATPP_LOGi(TAG, "Content type...")
+    OATPP_ASSERT(std::strcmp(StaticFilesHandler::getContentType("a/index.HTML"), "text/html; charset=utf-8") == 0)
+    OATPP_ASSERT(std::strcmp(StaticFilesHandler::getContentType("app.js"), "text/javascript; charset=utf-8") == 0)
+    OATPP_ASSERT(std::strcmp(StaticFilesHandler::getContentType("a.b/file"), "application/octet-stream") == 0)
+    OATPP_ASSERT(std::strcmp(StaticFilesHandler::getContentType("file.unknown"), "application/octet-stream") == 0)
+  }
+
+  auto handler = std::make_shared<StaticFilesHandler>(ROOT);
+
+  ClientFunction conditionalAndRanges = [&](HttpRequestExecutor& executor, const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection) {
+
+    testFull(executor, connection, "index.html", index);
+    testFull(executor, connection, "sub/data.json", data);
+    testFull(executor, connection, "big.bin", big);
+    testFull(executor, connection, "index.html?v=2", index);
+
+    {
+      auto response = get(executor, connection, "sub/data.json");
+      OATPP_ASSERT(response->getHeader("Content-Type") == "application/json")
+      response->readBodyToString();
+    }
+
+    auto response = get(executor, connection, "index.html");
+    auto etag = response->getHeader("ETag");
+    auto lastModified = response->getHeader("Last-Modified");
+    response->readBodyToString();
+
+    /* conditional requests */
+
+    response = get(executor, connection, "index.html", header("If-None-Match", etag));
+    OATPP_ASSERT(response->getStatusCode() == 304)
+    OATPP_ASSERT(response->getHeader("ETag") == etag)
+    response->readBodyToString();
+
+    response = get(executor, connection, "index.html", header("If-None-Match", "W/\"other\", " + etag));
+    OATPP_ASSERT(response->getStatusCode() == 304)
+    response->readBodyToString();
+
+    response = get(executor, connection, "index.html", header("If-None-Match", "\"other\""));
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    response->readBodyToString();
+
+    response = get(executor, connection, "index.html", header("If-Modified-Since", lastModified));
+    OATPP_ASSERT(response->getStatusCode() == 304)
+    response->readBodyToString();
+
+    response = get(executor, connection, "index.html", header("If-Modified-Since", "Thu, 01 Jan 1970 00:00:00 GMT"));
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    response->readBodyToString();
+
+    response = get(executor, connection, "index.html", header("If-Modified-Since", "not a date"));
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    response->readBodyToString();
+
+    /* ranges */
+
+    testRange(executor, connection, "index.html", index, "bytes=10-19", 10, 19);
+    testRange(executor, connection, "index.html", index, "bytes=900-", 900, 999);
+    testRange(executor, connection, "index.html", index, "bytes=-100", 900, 999);
+    testRange(executor, connection, "index.html", index, "bytes=990-5000", 990, 999);
+    testRange(executor, connection, "index.html", index, "bytes=-5000", 0, 999);
+    testRange(executor, connection, "big.bin", big, "bytes=1000000-2999999", 1000000, 2999999);
+
+    {
+      Headers headers;
+      headers.put("Range", "bytes=0-9");
+      headers.put("If-Range", etag);
+      response = get(executor, connection, "index.html", headers);
+      OATPP_ASSERT(response->getStatusCode() == 206)
+      response->readBodyToString();
+    }
+
+    {
+      Headers headers;
+      headers.put("Range", "bytes=0-9");
+      headers.put("If-Range", "\"stale\"");
+      response = get(executor, connection, "index.html", headers);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      OATPP_ASSERT(response->readBodyToString() == index)
+    }
+
+    response = get(executor, connection, "index.html", header("Range", "bytes=0-9, 20-29"));
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString() == index)
+
+    response = get(executor, connection, "index.html", header("Range", "bytes=1000-"));
+    OATPP_ASSERT(response->getStatusCode() == 416)
+    OATPP_ASSERT(response->getHeader("Content-Range") == "bytes */1000")
+    response->readBodyToString();
+
+    response = get(executor, connection, "index.html", header("Range", "bytes=-0"));
+    OATPP_ASSERT(response->getStatusCode() == 416)
+    response->readBodyToString();
+
+    /* errors - server closes the connection */
+
+    response = get(executor, nullptr, "missing.html");
+    OATPP_ASSERT(response->getStatusCode() == 404)
+    response->readBodyToString();
+
+    response = get(executor, nullptr, "sub");
+    OATPP_ASSERT(response->getStatusCode() == 404)
+    response->readBodyToString();
+
+    response = get(executor, nullptr, "sub/../index.html");
+    OATPP_ASSERT(response->getStatusCode() == 400)
+    response->readBodyToString();
+
+    response = get(executor, nullptr, "sub/%2e%2e/index.html");
+    OATPP_ASSERT(response->getStatusCode() == 400)
+    response->readBodyToString();
+
+  };
+
+  {
+    OATPP_LOGi(TAG, "tcp - sendfile...")
+    runTcp(handler, false, conditionalAndRanges);
+    runTcp(handler, true, conditionalAndRanges);
+  }
+
+  {
+    OATPP_LOGi(TAG, "virtual - read...")
+    runVirtual(handler, false, conditionalAndRanges);
+    runVirtual(handler, true, conditionalAndRanges);
+  }
+
+  OATPP_ASSERT(handler->getOpenFilesCount() == 3)
+
+  {
+    OATPP_LOGi(TAG, "Revalidation...")
+
+    StaticFilesHandler::Config config;
+    config.revalidateInterval = std::chrono::seconds(0);
+    config.maxOpenFiles = 2;
+    config.cacheControl = "max-age=60";
+    auto revalidatingHandler = std::make_shared<StaticFilesHandler>(ROOT, config);
+
+    runVirtual(revalidatingHandler, false, [&](HttpRequestExecutor& executor, const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection) {
+
+      auto response = get(executor, connection, "index.html");
+      OATPP_ASSERT(response->getHeader("Cache-Control") == "max-age=60")
+      auto etag = response->getHeader("ETag");
+      OATPP_ASSERT(response->readBodyToString() == index)
+
+      auto updated = writeFile("index.html", 1200, 3);
+      response = get(executor, connection, "index.html");
+      OATPP_ASSERT(response->getHeader("ETag") != etag)
+      OATPP_ASSERT(response->readBodyToString() == updated)
+      index = updated;
+
+      testFull(executor, connection, "sub/data.json", data);
+      testFull(executor, connection, "big.bin", big);
+      OATPP_ASSERT(revalidatingHandler->getOpenFilesCount() == 2)
+
+      std::filesystem::remove(std::string(ROOT) + "/big.bin");
+      response = get(executor, nullptr, "big.bin");
+      OATPP_ASSERT(response->getStatusCode() == 404)
+      response->readBodyToString();
+      OATPP_ASSERT(revalidatingHandler->getOpenFilesCount() == 1)
+
+    });
+
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark...")
+
+    const v_int32 requests = 5000;
+
+    auto benchmark = [&](const oatpp::String& tag) {
+      return [&, tag](HttpRequestExecutor& executor, const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection) {
+        oatpp::test::PerformanceChecker checker(tag->c_str());
+        for(v_int32 i = 0; i < requests; i ++) {
+          auto response = get(executor, connection, "index.html");
+          OATPP_ASSERT(response->getStatusCode() == 200)
+          OATPP_ASSERT(response->readBodyToString()->size() == index->size())
+        }
+      };
+    };
+
+    runVirtual(std::make_shared<FileBodyHandler>(), false, benchmark("FileBody - open per request"));
+    runVirtual(std::make_shared<StaticFilesHandler>(ROOT), false, benchmark("StaticFilesHandler - cached, in memory"));
+
+  }
+
+  handler->clear();
+  OATPP_ASSERT(handler->getOpenFilesCount() == 0)
+
+  std::filesystem::remove_all(ROOT);
+
+}
+
+}}}}}
@@ -0,0 +1,346 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResponseCacheTest.hpp"
+
+#include "oatpp/web/server/interceptor/ResponseCache.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace server { namespace interceptor {
+
+namespace {
+
+typedef oatpp::web::server::interceptor::ResponseCache ResponseCache;
+typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+typedef oatpp::web::protocol::http::Status Status;
+typedef oatpp::web::protocol::http::Headers Headers;
+
+/*
+ * Serializes the same list of items on every call - a "hot" GET endpoint.
+ */
+class ItemsHandler : public oatpp::web::server::HttpRequestHandler {
+private:
+  oatpp::json::ObjectMapper m_mapper;
+  v_int32 m_itemsCount;
+  oatpp::String m_cacheControl;
+  oatpp::String m_vary;
+public:
+
+  std::atomic<v_int32> calls;
+
+  ItemsHandler(v_int32 itemsCount, const oatpp::String& cacheControl = nullptr, const oatpp::String& vary = nullptr)
+    : m_itemsCount(itemsCount)
+    , m_cacheControl(cacheControl)
+    , m_vary(vary)
+    , calls(0)
+  {}
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+
+    calls ++;
+
+    auto items = oatpp::Vector<oatpp::Fields<oatpp::Any>>::createShared();
+    for(v_int32 i = 0; i < m_itemsCount; i ++) {
+      items->push_back({
+        {"id", oatpp::Int32(i)},
+        {"name", oatpp::String("item-" + std::to_string(i))},
+        {"lang", request->getHeader("Accept-Language")}
+      });
+    }
+
+    auto response = OutgoingResponse::createShared(Status::CODE_200,
+      oatpp::web::protocol::http::outgoing::BufferBody::createShared(m_mapper.writeToString(items), "application/json"));
+
+    if(m_cacheControl) {
+      response->putHeader("Cache-Control", m_cacheControl);
+    }
+    if(m_vary) {
+      response->putHeader("Vary", m_vary);
+    }
+
+    return response;
+
+  }
+
+};
+
+class TestServer {
+private:
+  std::shared_ptr<oatpp::network::virtual_::server::ConnectionProvider> m_serverConnectionProvider;
+  std::shared_ptr<oatpp::web::server::HttpConnectionHandler> m_connectionHandler;
+  std::unique_ptr<oatpp::network::Server> m_server;
+  std::thread m_thread;
+public:
+
+  std::shared_ptr<oatpp::web::client::HttpRequestExecutor> client;
+  std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle> connection;
+
+  TestServer(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const std::shared_ptr<ResponseCache>& cache) {
+
+    auto _interface = oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+    m_serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+    auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+    m_connectionHandler = std::make_shared<oatpp::web::server::HttpConnectionHandler>(router);
+    if(cache) {
+      m_connectionHandler->addRequestInterceptor(std::make_shared<oatpp::web::server::interceptor::ResponseCacheRequestInterceptor>(cache));
+      m_connectionHandler->addResponseInterceptor(std::make_shared<oatpp::web::server::interceptor::ResponseCacheResponseInterceptor>(cache));
+    }
+
+    m_server.reset(new oatpp::network::Server(m_serverConnectionProvider, m_connectionHandler));
+    m_thread = std::thread([this]{
+      m_server->run();
+    });
+
+    client = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+    connection = client->getConnection();
+
+  }
+
+  ~TestServer() {
+    client->invalidateConnection(connection);
+    connection.reset();
+    m_server->stop();
+    m_serverConnectionProvider->stop();
+    m_thread.join();
+    m_connectionHandler->stop();
+  }
+
+  std::shared_ptr<oatpp::web::protocol::http::incoming::Response> get(const oatpp::String& path, const Headers& headers = Headers()) {
+    return client->execute("GET", path, headers, nullptr, connection);
+  }
+
+};
+
+void testETag() {
+
+  auto etag = ResponseCache::generateETag("hello", 5);
+  OATPP_ASSERT(etag == ResponseCache::generateETag("hello", 5))
+  OATPP_ASSERT(etag != ResponseCache::generateETag("hellO", 5))
+  OATPP_ASSERT(etag->front() == '"' && etag->back() == '"')
+
+  OATPP_ASSERT(ResponseCache::matchETag(etag, etag))
+  OATPP_ASSERT(ResponseCache::matchETag(oatpp::String("W/" + *etag), etag))
+  OATPP_ASSERT(ResponseCache::matchETag(oatpp::String("\"other\", " + *etag + " "), etag))
+  OATPP_ASSERT(ResponseCache::matchETag("*", etag))
+  OATPP_ASSERT(!ResponseCache::matchETag("\"other\"", etag))
+  OATPP_ASSERT(!ResponseCache::matchETag(nullptr, etag))
+
+}
+
+void testServer() {
+
+  ResponseCache::Config config;
+  config.varyHeaders = {"Accept-Language"};
+  auto cache = std::make_shared<ResponseCache>(config);
+
+  auto hot = std::make_shared<ItemsHandler>(10);
+  auto noStore = std::make_shared<ItemsHandler>(10, "no-store");
+  auto lang = std::make_shared<ItemsHandler>(10, "max-age=60", "Accept-Language");
+  auto other = std::make_shared<ItemsHandler>(10, nullptr, "X-Other");
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/hot", hot);
+  router->route("GET", "/no-store", noStore);
+  router->route("GET", "/lang", lang);
+  router->route("GET", "/other", other);
+
+  TestServer server(router, cache);
+
+  oatpp::String etag;
+  oatpp::String body;
+
+  { // miss - response is stored
+    auto response = server.get("hot");
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    etag = response->getHeader("ETag");
+    body = response->readBodyToString();
+    OATPP_ASSERT(etag)
+    OATPP_ASSERT(hot->calls == 1)
+    OATPP_ASSERT(cache->getMissesCount() == 1 && cache->getHitsCount() == 0)
+  }
+
+  { // hit - handler is not called
+    auto response = server.get("hot");
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->getHeader("ETag") == etag)
+    OATPP_ASSERT(response->getHeader("Content-Type") == "application/json")
+    OATPP_ASSERT(response->readBodyToString() == body)
+    OATPP_ASSERT(hot->calls == 1)
+    OATPP_ASSERT(cache->getHitsCount() == 1)
+  }
+
+  { // query is a part of the key
+    auto response = server.get("hot?page=2");
+    OATPP_ASSERT(response->readBodyToString() == body)
+    OATPP_ASSERT(hot->calls == 2)
+  }
+
+  { // 304 before routing
+    Headers headers;
+    headers.put("If-None-Match", etag);
+    auto response = server.get("hot", headers);
+    OATPP_ASSERT(response->getStatusCode() == 304)
+    OATPP_ASSERT(response->getHeader("ETag") == etag)
+    OATPP_ASSERT(response->readBodyToString() == "")
+    OATPP_ASSERT(hot->calls == 2)
+    OATPP_ASSERT(cache->getNotModifiedCount() == 1)
+  }
+
+  { // 304 on miss - response is not sent, but stored
+    Headers headers;
+    headers.put("If-None-Match", etag);
+    auto response = server.get("hot?page=3", headers);
+    OATPP_ASSERT(response->getStatusCode() == 304)
+    OATPP_ASSERT(hot->calls == 3)
+    OATPP_ASSERT(server.get("hot?page=3")->readBodyToString() == body)
+    OATPP_ASSERT(hot->calls == 3)
+  }
+
+  { // requests with credentials or request Cache-Control: no-store bypass cached entries
+    Headers auth;
+    auth.put("Authorization", "Bearer token");
+    OATPP_ASSERT(server.get("hot", auth)->readBodyToString() == body)
+    OATPP_ASSERT(hot->calls == 4)
+    Headers noStoreRequest;
+    noStoreRequest.put("Cache-Control", "no-cache, no-store");
+    OATPP_ASSERT(server.get("hot", noStoreRequest)->readBodyToString() == body)
+    OATPP_ASSERT(hot->calls == 5)
+    Headers cookie;
+    cookie.put("Cookie", "session=1");
+    OATPP_ASSERT(server.get("hot", cookie)->readBodyToString() == body)
+    OATPP_ASSERT(hot->calls == 6)
+  }
+
+  { // Cache-Control: no-store
+    server.get("no-store")->readBodyToString();
+    auto response = server.get("no-store");
+    OATPP_ASSERT(response->getHeader("ETag") == nullptr)
+    response->readBodyToString();
+    OATPP_ASSERT(noStore->calls == 2)
+  }
+
+  { // configured Vary header is a part of the key
+    Headers en;
+    en.put("Accept-Language", "en");
+    Headers uk;
+    uk.put("Accept-Language", "uk");
+    auto enBody = server.get("lang", en)->readBodyToString();
+    auto ukBody = server.get("lang", uk)->readBodyToString();
+    OATPP_ASSERT(enBody != ukBody)
+    OATPP_ASSERT(server.get("lang", en)->readBodyToString() == enBody)
+    OATPP_ASSERT(server.get("lang", uk)->readBodyToString() == ukBody)
+    OATPP_ASSERT(lang->calls == 2)
+  }
+
+  { // response varies on a header which is not a part of the key
+    server.get("other")->readBodyToString();
+    server.get("other")->readBodyToString();
+    OATPP_ASSERT(other->calls == 2)
+  }
+
+}
+
+void testLimits() {
+
+  { // TTL
+    ResponseCache::Config config;
+    config.ttl = std::chrono::milliseconds(1);
+    ResponseCache cache(config);
+    auto entry = std::make_shared<ResponseCache::Entry>();
+    entry->body = "body";
+    entry->expiresAt = oatpp::Environment::getMicroTickCount() + config.ttl.count();
+    cache.put("GET /", entry);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    OATPP_ASSERT(cache.get("GET /") == nullptr)
+    OATPP_ASSERT(cache.getEntriesCount() == 0)
+  }
+
+  { // Byte-size cap - LRU eviction
+    ResponseCache::Config config;
+    config.shardsCount = 1;
+    config.maxSize = 4096;
+    ResponseCache cache(config);
+    for(v_int32 i = 0; i < 100; i ++) {
+      auto entry = std::make_shared<ResponseCache::Entry>();
+      entry->body = oatpp::String(1000);
+      entry->expiresAt = oatpp::Environment::getMicroTickCount() + config.ttl.count();
+      cache.put("GET /" + std::to_string(i), entry);
+      OATPP_ASSERT(cache.getSize() <= config.maxSize)
+    }
+    OATPP_ASSERT(cache.getEntriesCount() == 3)
+    OATPP_ASSERT(cache.get("GET /99") != nullptr)
+    OATPP_ASSERT(cache.get("GET /0") == nullptr)
+  }
+
+}
+
+void runBenchmark(const char* tag, bool withCache, v_int32 requestsCount) {
+
+  auto cache = withCache ? std::make_shared<ResponseCache>() : nullptr;
+  auto handler = std::make_shared<ItemsHandler>(100);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->route("GET", "/hot", handler);
+
+  TestServer server(router, cache);
+
+  oatpp::test::PerformanceChecker checker(tag);
+  for(v_int32 i = 0; i < requestsCount; i ++) {
+    auto response = server.get("hot");
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString())
+  }
+
+}
+
+}
+
+void ResponseCacheTest::onRun() {
+
+  testETag();
+  testServer();
+  testLimits();
+
+  runBenchmark("GET - no cache", false, 5000);
+  runBenchmark("GET - cache", true, 5000);
+
+}
+
+}}}}}